@@ -141,6 +141,14 @@ protected:
     bool _used;
     // a flag indicating whether or not to reuse the IDs of destroyed variables
     bool _reuseIDs;
+    // a flag indicating whether or not to simplify the operation graph before generating source code
+    bool _simplify;
+    // a flag indicating whether or not to schedule operations to reduce the number of live temporary variables
+    bool _schedule;
+    // the number of operation nodes before the last simplification of the operation graph
+    size_t _nodesBeforeSimplification;
+    // the number of operation nodes after the last simplification of the operation graph
+    size_t _nodesAfterSimplification;
     // scope color/index counter
     ScopeIDType _scopeColorCount;
     // the current scope color/index counter
@@ -197,6 +205,58 @@ public:
      */
     inline bool isReuseVariableIDs() const;
 
+    /**
+     * Defines whether or not to simplify the operation graph before
+     * generating source code (constant folding, removal of algebraic
+     * identities, and merging of equivalent operations).
+     * The operation graph is modified in place but all variables remain
+     * valid (see GraphSimplifier).
+     * Identities which do not hold for infinite values, NaNs or zero
+     * (e.g. x - x -> 0 and x / x -> 1) are not applied, with the exception
+     * of multiplications and divisions of a parameter zero (e.g. 0 * x -> 0)
+     * which are already simplified by the arithmetic operators of CG.
+     */
+    inline void setSimplifyOperations(bool simplify);
+
+    /**
+     * Whether or not the operation graph is simplified before generating
+     * source code.
+     */
+    inline bool isSimplifyOperations() const;
+
+    /**
+     * Defines whether or not to reschedule the evaluation of operations
+     * before generating source code.
+     * Operations in the same block (without loops, conditional blocks,
+     * arrays, or atomic function calls in between) are reordered so that
+     * temporary variables are released as soon as possible and so that
+     * operations reading the same variables are evaluated close to each
+     * other.
+     * This typically reduces the number of temporary variables when
+     * combined with setReuseVariableIDs(true).
+     */
+    inline void setScheduleOperations(bool schedule);
+
+    /**
+     * Whether or not the evaluation of operations is rescheduled before
+     * generating source code.
+     */
+    inline bool isScheduleOperations() const;
+
+    /**
+     * Provides the number of operation nodes (excluding aliases and
+     * independent variables) used by the dependents before the last
+     * simplification performed by ::generateCode.
+     */
+    inline size_t getNodeCountBeforeSimplification() const;
+
+    /**
+     * Provides the number of operation nodes (excluding aliases and
+     * independent variables) used by the dependents after the last
+     * simplification performed by ::generateCode.
+     */
+    inline size_t getNodeCountAfterSimplification() const;
+
     /**
      * Marks the provided variables as being independent variables.
      *
@@ -697,6 +757,22 @@ protected:
 
     inline void reduceTemporaryVariables(ArrayView<CGB>& dependent);
 
+    /**
+     * Changes the evaluation order (before it is saved in the nodes) using
+     * a list scheduling heuristic inside blocks of schedulable operations:
+     * from a sliding window of operations ready to be evaluated it selects
+     * the one which releases the most temporary variables (minus the
+     * temporary variables it creates) and, in case of a tie, the one
+     * reading the most variables in common with the previous operation.
+     */
+    inline void scheduleOperations();
+
+    /**
+     * Whether or not an operation type can be freely moved inside the
+     * evaluation queue (as long as its arguments are evaluated first).
+     */
+    inline static bool isSchedulable(CGOpCode op);
+
     /**
      * Change operation order so that the total number of temporary variables is
      * reduced.
@@ -38,6 +38,10 @@ CodeHandler<Base>::CodeHandler(size_t varCount) :
         _atomicFunctionsOrder(nullptr),
         _used(false),
         _reuseIDs(true),
+        _simplify(false),
+        _schedule(false),
+        _nodesBeforeSimplification(0),
+        _nodesAfterSimplification(0),
         _scopeColorCount(0),
         _currentScopeColor(0),
         _lang(nullptr),
@@ -72,6 +76,36 @@ inline bool CodeHandler<Base>::isReuseVariableIDs() const {
     return _reuseIDs;
 }
 
+template<class Base>
+inline void CodeHandler<Base>::setSimplifyOperations(bool simplify) {
+    _simplify = simplify;
+}
+
+template<class Base>
+inline bool CodeHandler<Base>::isSimplifyOperations() const {
+    return _simplify;
+}
+
+template<class Base>
+inline void CodeHandler<Base>::setScheduleOperations(bool schedule) {
+    _schedule = schedule;
+}
+
+template<class Base>
+inline bool CodeHandler<Base>::isScheduleOperations() const {
+    return _schedule;
+}
+
+template<class Base>
+inline size_t CodeHandler<Base>::getNodeCountBeforeSimplification() const {
+    return _nodesBeforeSimplification;
+}
+
+template<class Base>
+inline size_t CodeHandler<Base>::getNodeCountAfterSimplification() const {
+    return _nodesAfterSimplification;
+}
+
 template<class Base>
 inline void CodeHandler<Base>::makeVariables(std::vector<AD<CGB> >& variables) {
     for (auto& v : variables) {
@@ -314,6 +348,16 @@ void CodeHandler<Base>::generateCode(std::ostream& out,
     }
     _used = true;
 
+    /**
+     * simplify the operations (changes the graph in place)
+     */
+    if (_simplify) {
+        GraphSimplifier<Base> simplifier(*this);
+        simplifier.simplify(dependent);
+        _nodesBeforeSimplification = simplifier.getNodeCountBefore();
+        _nodesAfterSimplification = simplifier.getNodeCountAfter();
+    }
+
     /**
      * the first variable IDs are for the independent variables
      */
@@ -390,6 +434,13 @@ void CodeHandler<Base>::generateCode(std::ostream& out,
         CPPADCG_ASSERT_UNKNOWN(_variableOrder.size() == e)
     }
 
+    /**
+     * Reduce the number of live temporary variables
+     */
+    if (_schedule) {
+        scheduleOperations();
+    }
+
     for (size_t p = 0; p < _variableOrder.size(); p++) {
         Node& arg = *_variableOrder[p];
         setEvaluationOrder(arg, p + 1);
@@ -469,6 +520,11 @@ void CodeHandler<Base>::generateCode(std::ostream& out,
         duration<float> dt = steady_clock::now() - beginTime;
         std::cout << "done [" << std::fixed << std::setprecision(3) << dt.count() << "]" << std::endl;
     }
+
+    if (_simplify && (_jobTimer != nullptr ? _jobTimer->isVerbose() : _verbose)) {
+        std::cout << "   simplified operation graph: " << _nodesBeforeSimplification << " -> "
+                << _nodesAfterSimplification << " nodes" << std::endl;
+    }
 }
 
 template<class Base>
@@ -1712,6 +1768,226 @@ inline void CodeHandler<Base>::reduceTemporaryVariables(ArrayView<CGB>& dependen
     _idSparseArrayCount = sparseArrayComp.getIdCount();
 }
 
+template<class Base>
+inline void CodeHandler<Base>::scheduleOperations() {
+    const size_t window = 64; // maximum number of candidates from the original order
+    const size_t n = _variableOrder.size();
+    if (n < 3)
+        return;
+
+    /**
+     * location in the evaluation queue (zero if it is not in the queue)
+     */
+    CodeHandlerVector<Base, size_t> position(*this);
+    position.adjustSize();
+    for (size_t p = 0; p < n; ++p) {
+        position[*_variableOrder[p]] = p + 1;
+    }
+
+    /**
+     * variables (in the queue) and independents read by each queue element,
+     * directly or through arguments which do not create variables
+     */
+    CodeHandlerVector<Base, size_t> lastVisit(*this);
+    lastVisit.adjustSize();
+    std::vector<std::vector<Node*>> reads(n);
+    std::vector<size_t> remainingUses(n, 0);
+    std::vector<Node*> stack;
+
+    for (size_t p = 0; p < n; ++p) {
+        std::vector<Node*>& r = reads[p];
+        stack.push_back(_variableOrder[p]);
+        while (!stack.empty()) {
+            Node* node = stack.back();
+            stack.pop_back();
+            for (const Arg& a : node->getArguments()) {
+                Node* arg = a.getOperation();
+                if (arg == nullptr || lastVisit[*arg] == p + 1)
+                    continue;
+                lastVisit[*arg] = p + 1;
+
+                if (position[*arg] != 0) {
+                    if (position[*arg] < p + 1) {
+                        r.push_back(arg);
+                        remainingUses[position[*arg] - 1]++;
+                    }
+                } else if (isIndependent(*arg)) {
+                    r.push_back(arg);
+                } else {
+                    stack.push_back(arg);
+                }
+            }
+        }
+        std::sort(r.begin(), r.end());
+    }
+
+    // the number of read variables in common
+    auto countShared = [](const std::vector<Node*>& r1, const std::vector<Node*>& r2) {
+        size_t shared = 0;
+        auto it1 = r1.begin();
+        auto it2 = r2.begin();
+        while (it1 != r1.end() && it2 != r2.end()) {
+            if (*it1 < *it2) {
+                ++it1;
+            } else if (*it2 < *it1) {
+                ++it2;
+            } else {
+                ++shared;
+                ++it1;
+                ++it2;
+            }
+        }
+        return shared;
+    };
+
+    // temporary variables released minus temporary variables created
+    auto score = [&](size_t p) {
+        long s = isTemporary(*_variableOrder[p]) ? -1 : 0;
+        for (Node* arg : reads[p]) {
+            size_t pos = position[*arg];
+            if (pos != 0 && remainingUses[pos - 1] == 1 && isTemporary(*arg))
+                s++;
+        }
+        return s;
+    };
+
+    auto evaluated = [&](size_t p) {
+        for (Node* arg : reads[p]) {
+            size_t pos = position[*arg];
+            if (pos != 0)
+                remainingUses[pos - 1]--;
+        }
+    };
+
+    std::vector<Node*> newOrder;
+    newOrder.reserve(n);
+    std::vector<size_t> missing(n, 0); // arguments not evaluated yet
+    std::vector<std::vector<size_t>> users(n);
+
+    size_t b = 0;
+    while (b < n) {
+        Node& first = *_variableOrder[b];
+        if (!isSchedulable(first.getOperationType())) {
+            evaluated(b);
+            newOrder.push_back(&first);
+            b++;
+            continue;
+        }
+
+        /**
+         * a block of operations in the same scope which can be reordered
+         */
+        size_t e = b + 1;
+        while (e < n && isSchedulable(_variableOrder[e]->getOperationType()) &&
+               _scope[*_variableOrder[e]] == _scope[first]) {
+            e++;
+        }
+
+        std::set<size_t> ready;
+        std::deque<size_t> recent; // operations which have just become ready
+        for (size_t p = b; p < e; ++p) {
+            for (Node* arg : reads[p]) {
+                size_t pos = position[*arg];
+                if (pos > b) { // pos - 1 >= b
+                    missing[p]++;
+                    users[pos - 1].push_back(p);
+                }
+            }
+            if (missing[p] == 0)
+                ready.insert(p);
+        }
+
+        size_t last = n; // the previously scheduled operation
+        while (!ready.empty()) {
+            size_t best = *ready.begin();
+            long bestScore = score(best);
+            size_t bestShared = last < n ? countShared(reads[best], reads[last]) : 0;
+
+            auto consider = [&](size_t p) {
+                long s = score(p);
+                if (s < bestScore)
+                    return;
+                size_t shared = last < n ? countShared(reads[p], reads[last]) : 0;
+                if (s > bestScore || shared > bestShared || (shared == bestShared && p < best)) {
+                    best = p;
+                    bestScore = s;
+                    bestShared = shared;
+                }
+            };
+
+            size_t c = 0;
+            for (auto it = ready.begin(); it != ready.end() && c < window; ++it, ++c) {
+                consider(*it);
+            }
+            for (size_t p : recent) {
+                if (ready.find(p) != ready.end())
+                    consider(p);
+            }
+
+            ready.erase(best);
+            evaluated(best);
+            newOrder.push_back(_variableOrder[best]);
+            last = best;
+
+            for (size_t u : users[best]) {
+                if (--missing[u] == 0) {
+                    ready.insert(u);
+                    recent.push_back(u);
+                    if (recent.size() > window)
+                        recent.pop_front();
+                }
+            }
+        }
+
+        CPPADCG_ASSERT_UNKNOWN(newOrder.size() == e)
+        b = e;
+    }
+
+    _variableOrder.swap(newOrder);
+}
+
+template<class Base>
+inline bool CodeHandler<Base>::isSchedulable(CGOpCode op) {
+    switch (op) {
+        case CGOpCode::Abs:
+        case CGOpCode::Acos:
+        case CGOpCode::Acosh:
+        case CGOpCode::Add:
+        case CGOpCode::Asin:
+        case CGOpCode::Asinh:
+        case CGOpCode::Atan:
+        case CGOpCode::Atanh:
+        case CGOpCode::ComLt:
+        case CGOpCode::ComLe:
+        case CGOpCode::ComEq:
+        case CGOpCode::ComGe:
+        case CGOpCode::ComGt:
+        case CGOpCode::ComNe:
+        case CGOpCode::Cosh:
+        case CGOpCode::Cos:
+        case CGOpCode::Div:
+        case CGOpCode::Erf:
+        case CGOpCode::Erfc:
+        case CGOpCode::Exp:
+        case CGOpCode::Expm1:
+        case CGOpCode::Log:
+        case CGOpCode::Log1p:
+        case CGOpCode::Mul:
+        case CGOpCode::Pow:
+        case CGOpCode::Sign:
+        case CGOpCode::Sinh:
+        case CGOpCode::Sin:
+        case CGOpCode::Sqrt:
+        case CGOpCode::Sub:
+        case CGOpCode::Tanh:
+        case CGOpCode::Tan:
+        case CGOpCode::UnMinus:
+            return true;
+        default:
+            return false;
+    }
+}
+
 template<class Base>
 inline void CodeHandler<Base>::reorderOperations(ArrayView<CGB>& dependent) {
     // determine the location of the last temporary variable used for each dependent
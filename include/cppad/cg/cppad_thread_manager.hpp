@@ -0,0 +1,239 @@
+#ifndef CPPAD_CG_CPPAD_THREAD_MANAGER_INCLUDED
+#define CPPAD_CG_CPPAD_THREAD_MANAGER_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Provides CppAD thread numbers to the threads created by CppADCodeGen
+ * (e.g. to generate source code in parallel or to create a model library
+ * asynchronously).
+ *
+ * CppAD manages memory per thread: it must be configured for multiple
+ * threads in sequential mode, before any other thread uses it, and memory
+ * allocated by a thread in parallel mode must be returned by the same
+ * thread.
+ * CppAD is configured only once for the maximum number of threads and it is
+ * in parallel mode while thread numbers are reserved.
+ * Threads which did not receive a thread number (e.g. the thread which
+ * reserves thread numbers) use the thread number 0.
+ *
+ * Thread numbers are not provided if CppAD was configured for multiple
+ * threads by someone else.
+ */
+class CppADThreadManager {
+public:
+    class ThreadScope;
+private:
+    /**
+     * the thread numbers in use (0 is never reserved)
+     */
+    std::vector<bool> used_;
+    /**
+     * the number of reserved thread numbers
+     */
+    std::atomic<size_t> reserved_;
+    /**
+     * whether or not CppAD was configured by this class
+     */
+    bool configured_;
+    std::mutex mutex_;
+public:
+
+    /**
+     * Reserves consecutive thread numbers for new threads.
+     * CppAD is configured for multiple threads and for the type
+     * CG<Base> in sequential mode (if it has not been done before).
+     *
+     * @param n the number of thread numbers
+     * @return the first thread number or 0 if it was not possible to
+     *         reserve thread numbers
+     */
+    template<class Base>
+    static inline size_t reserve(size_t n) {
+        CppADThreadManager& m = instance();
+        std::lock_guard<std::mutex> lock(m.mutex_);
+
+        if (n == 0)
+            return 0;
+
+        if (!m.configured_) {
+            if (getThreadNumber() != 0 ||
+                CppAD::thread_alloc::num_threads() != 1 || // configured for multiple threads by someone else
+                CppAD::thread_alloc::in_parallel()) {
+                return 0;
+            }
+            CppAD::thread_alloc::parallel_setup(CPPAD_MAX_NUM_THREADS, isInParallel, getThreadNumber);
+            m.configured_ = true;
+        }
+
+        bool& parallelAD = isParallelADDone<Base>();
+        if (!parallelAD) {
+            if (m.reserved_ > 0)
+                return 0; // parallel_ad() must be called in sequential mode
+            CppAD::parallel_ad<CG<Base> >();
+            parallelAD = true;
+        }
+
+        size_t first = 1;
+        for (size_t t = 1; t < m.used_.size(); ++t) {
+            if (m.used_[t]) {
+                first = t + 1;
+            } else if (t + 1 - first == n) {
+                for (size_t i = first; i <= t; ++i)
+                    m.used_[i] = true;
+                m.reserved_ += n;
+                return first;
+            }
+        }
+
+        return 0; // not enough threads
+    }
+
+    /**
+     * Releases thread numbers provided by reserve().
+     * The threads which used them must have returned their CppAD memory.
+     * CppAD is placed back in its original configuration when the last
+     * thread numbers are released by the thread with the thread number 0.
+     *
+     * @param first the first thread number
+     * @param n the number of thread numbers
+     */
+    static inline void release(size_t first,
+                               size_t n) {
+        CppADThreadManager& m = instance();
+        std::lock_guard<std::mutex> lock(m.mutex_);
+
+        for (size_t t = first; t < first + n; ++t) {
+            CPPADCG_ASSERT_UNKNOWN(m.used_[t])
+            m.used_[t] = false;
+        }
+        m.reserved_ -= n;
+
+        if (m.reserved_ == 0 && m.configured_ && getThreadNumber() == 0) {
+            // sequential mode
+            for (size_t t = 1; t < m.used_.size(); ++t) {
+                CppAD::thread_alloc::free_available(t);
+            }
+            CppAD::thread_alloc::parallel_setup(1, nullptr, nullptr);
+            m.configured_ = false;
+        }
+    }
+
+    /**
+     * Whether or not reserve() could provide thread numbers without
+     * changing the configuration defined by someone else.
+     */
+    static inline bool isAvailable() {
+        CppADThreadManager& m = instance();
+        std::lock_guard<std::mutex> lock(m.mutex_);
+        return m.configured_ ||
+               (CppAD::thread_alloc::num_threads() == 1 && !CppAD::thread_alloc::in_parallel());
+    }
+
+    /**
+     * Defines the CppAD thread number of the current thread.
+     * Must be called by a new thread before it uses CppAD and reset to 0
+     * after it has returned its CppAD memory.
+     *
+     * @param thread a thread number provided by reserve() or 0
+     */
+    static inline void setThreadNumber(size_t thread) {
+        threadNumber() = thread;
+    }
+
+    /**
+     * The CppAD thread number of the current thread.
+     */
+    static inline size_t getThreadNumber() {
+        return threadNumber();
+    }
+
+    /**
+     * Returns the memory which is available for the current thread
+     * (but not in use) to the system.
+     */
+    static inline void freeAvailable() {
+        CppAD::thread_alloc::free_available(CppAD::thread_alloc::thread_num());
+    }
+
+private:
+
+    inline CppADThreadManager() :
+            used_(CPPAD_MAX_NUM_THREADS, false),
+            reserved_(0),
+            configured_(false) {
+    }
+
+    static inline CppADThreadManager& instance() {
+        static CppADThreadManager m;
+        return m;
+    }
+
+    static inline bool isInParallel() {
+        return instance().reserved_ > 0;
+    }
+
+    static inline size_t& threadNumber() {
+        static thread_local size_t thread = 0;
+        return thread;
+    }
+
+    template<class Base>
+    static inline bool& isParallelADDone() {
+        static bool done = false;
+        return done;
+    }
+};
+
+/**
+ * Uses a thread number provided by CppADThreadManager::reserve() in the
+ * current thread while this object exists.
+ * The memory available for the thread is returned at the end, however the
+ * thread number is not released: it must be released by the thread which
+ * reserved it (so that CppAD can be placed back in sequential mode).
+ */
+class CppADThreadManager::ThreadScope {
+private:
+    const size_t thread_;
+public:
+
+    /**
+     * @param thread a thread number provided by CppADThreadManager::reserve()
+     *               (nothing is done for 0)
+     */
+    inline explicit ThreadScope(size_t thread) :
+        thread_(thread) {
+        if (thread_ != 0)
+            CppADThreadManager::setThreadNumber(thread_);
+    }
+
+    ThreadScope(const ThreadScope&) = delete;
+    ThreadScope& operator=(const ThreadScope&) = delete;
+
+    inline ~ThreadScope() {
+        if (thread_ != 0) {
+            CppADThreadManager::freeAvailable();
+            CppADThreadManager::setThreadNumber(0);
+        }
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -32,6 +32,7 @@ static_assert(false,
 #include <array>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <cerrno>
 #include <fstream>
 #include <iomanip>
@@ -55,7 +56,11 @@ static_assert(false,
 #include <cstring>
 #include <chrono>
 #include <thread>
+#include <atomic>
+#include <future>
+#include <mutex>
 #include <functional>
+#include <unordered_map>
 
 // ---------------------------------------------------------------------------
 // operating system detection
@@ -103,6 +108,7 @@ static_assert(false,
 #include <cppad/cg/patterns/index/linear_index_pattern.hpp>
 #include <cppad/cg/patterns/index/sectioned_index_pattern.hpp>
 #include <cppad/cg/patterns/index/plane_2d_index_pattern.hpp>
+#include <cppad/cg/patterns/index/affine_nd_index_pattern.hpp>
 #include <cppad/cg/patterns/index/random_index_pattern.hpp>
 #include <cppad/cg/patterns/index/random_1d_index_pattern.hpp>
 #include <cppad/cg/patterns/index/random_2d_index_pattern.hpp>
@@ -147,6 +153,8 @@ static_assert(false,
 #include <cppad/cg/code_handler_impl.hpp>
 #include <cppad/cg/code_handler_vector.hpp>
 #include <cppad/cg/code_handler_loops.hpp>
+#include <cppad/cg/graph_simplifier.hpp>
+#include <cppad/cg/dependent_partitioner.hpp>
 
 // ---------------------------------------------------------------------------
 #include <cppad/cg/base_double.hpp>
@@ -165,10 +173,13 @@ static_assert(false,
 // ---------------------------------------------------------------------------
 // additional utilities
 #include <cppad/cg/util.hpp>
+#include <cppad/cg/cppad_thread_manager.hpp>
 #include <cppad/cg/evaluator/evaluator.hpp>
 #include <cppad/cg/evaluator/evaluator_ad.hpp>
 #include <cppad/cg/evaluator/evaluator_adcg.hpp>
 #include <cppad/cg/evaluator/evaluator_cg.hpp>
+#include <cppad/cg/evaluator/bytecode_program.hpp>
+#include <cppad/cg/evaluator/evaluator_parallel.hpp>
 #include <cppad/cg/operation_path_node.hpp>
 #include <cppad/cg/operation_path.hpp>
 #include <cppad/cg/solver.hpp>
@@ -190,10 +201,12 @@ static_assert(false,
 #include <cppad/cg/patterns/independent_node_sorter.hpp>
 #include <cppad/cg/patterns/equation_group.hpp>
 #include <cppad/cg/patterns/iter_equation_group.hpp>
+#include <cppad/cg/patterns/thread_local_tapes.hpp>
 #include <cppad/cg/patterns/loop_model.hpp>
 #include <cppad/cg/patterns/loop_free_model.hpp>
 #include <cppad/cg/patterns/equation_pattern.hpp>
 #include <cppad/cg/patterns/loop.hpp>
+#include <cppad/cg/patterns/dependent_structure_hasher.hpp>
 #include <cppad/cg/patterns/dependent_pattern_matcher.hpp>
 
 // ---------------------------------------------------------------------------
@@ -205,23 +218,30 @@ static_assert(false,
 #include <cppad/cg/lang/c/language_c_double.hpp>
 #include <cppad/cg/lang/c/language_c_float.hpp>
 #include <cppad/cg/lang/c/language_c_loops.hpp>
+#include <cppad/cg/lang/c/language_c_math.hpp>
+#include <cppad/cg/lang/c/language_c_split.hpp>
 #include <cppad/cg/lang/c/lang_c_default_var_name_gen.hpp>
 #include <cppad/cg/lang/c/lang_c_default_hessian_var_name_gen.hpp>
 #include <cppad/cg/lang/c/lang_c_default_reverse2_var_name_gen.hpp>
 #include <cppad/cg/lang/c/lang_c_custom_var_name_gen.hpp>
+#include <cppad/cg/lang/c/lang_c_dependent_subset_var_name_gen.hpp>
 #include <cppad/cg/lang/c/lang_c_util.hpp>
 
 //
 #include <cppad/cg/model/threadpool/multi_threading_type.hpp>
 #include <cppad/cg/model/threadpool/thread_pool_schedule_strategy.hpp>
+#include <cppad/cg/model/threadpool/thread_pool_time_reference.hpp>
+#include <cppad/cg/model/threadpool/thread_pool_executor.hpp>
 #include <cppad/cg/model/external_function_wrapper.hpp>
 #include <cppad/cg/model/atomic_external_function_wrapper.hpp>
 #include <cppad/cg/model/generic_model_external_function_wrapper.hpp>
+#include <cppad/cg/model/source_sink.hpp>
 #include <cppad/cg/model/model_library_processor.hpp>
 #include <cppad/cg/model/model_library.hpp>
 #include <cppad/cg/model/generic_model.hpp>
 #include <cppad/cg/model/functor_generic_model.hpp>
 #include <cppad/cg/model/functor_model_library.hpp>
+#include <cppad/cg/model/bytecode_generic_model.hpp>
 #include <cppad/cg/model/save_files_model_library_processor.hpp>
 
 // automated static library creation
@@ -239,6 +259,8 @@ static_assert(false,
 #include <cppad/cg/model/threadpool/pthread_pool_h.hpp>
 #include <cppad/cg/model/threadpool/openmp_c.hpp>
 #include <cppad/cg/model/threadpool/openmp_h.hpp>
+#include <cppad/cg/model/threadpool/executor_c.hpp>
+#include <cppad/cg/model/threadpool/executor_h.hpp>
 #include <cppad/cg/model/model_c_source_gen.hpp>
 #include <cppad/cg/model/model_c_source_gen_impl.hpp>
 #include <cppad/cg/model/model_library_c_source_gen.hpp>
@@ -250,6 +272,7 @@ static_assert(false,
 #include <cppad/cg/model/model_c_source_gen_rev2.hpp>
 #include <cppad/cg/model/model_c_source_gen_jac.hpp>
 #include <cppad/cg/model/model_c_source_gen_hes.hpp>
+#include <cppad/cg/model/model_c_source_gen_partition.hpp>
 #include <cppad/cg/model/patterns/model_c_source_gen_loops.hpp>
 #include <cppad/cg/model/patterns/model_c_source_gen_loops_for0.hpp>
 #include <cppad/cg/model/patterns/model_c_source_gen_loops_for1.hpp>
@@ -259,6 +282,7 @@ static_assert(false,
 #include <cppad/cg/model/patterns/model_c_source_gen_loops_rev1.hpp>
 #include <cppad/cg/model/patterns/model_c_source_gen_loops_rev2.hpp>
 #include <cppad/cg/model/patterns/model_c_source_gen_loops_hess_r2.hpp>
+#include <cppad/cg/model/patterns/model_c_source_gen_loops_mt.hpp>
 #include <cppad/cg/model/patterns/hessian_with_loops_info.hpp>
 
 // automated dynamic library creation
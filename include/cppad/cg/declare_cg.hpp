@@ -56,6 +56,9 @@ class CodeHandlerVectorSync;
 template<class Base, class T>
 class CodeHandlerVector;
 
+template<class Base>
+class GraphSimplifier;
+
 template<class Base>
 class CG;
 
@@ -113,6 +116,7 @@ class IndexedDependentLoopInfo;
 class IndexPattern;
 class LinearIndexPattern;
 class Plane2DIndexPattern;
+class AffineNDIndexPattern;
 class RandomIndexPattern;
 class SectionedIndexPattern;
 
@@ -300,7 +304,17 @@ enum class IndexPatternType {
     Sectioned, // several index patterns
     Random1D,
     Random2D,
-    Plane2D // y = f(x) + f(z)
+    Plane2D, // y = f(x) + f(z)
+    AffineND // y = b + sum_k ((x / stride_k) % extent_k) * dy_k
+};
+
+/**
+ * How multiply-add operations are written in generated C source code
+ */
+enum class FusedMultiplyAdd {
+    Compiler, // a * b + c (contracted or not depending on the compiler flags)
+    Explicit, // fma(a, b, c) where detected (other operations can still be contracted by the compiler)
+    Deterministic // fma(a, b, c) where detected and contraction disabled everywhere else
 };
 
 } // END cg namespace
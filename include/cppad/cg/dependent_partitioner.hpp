@@ -0,0 +1,253 @@
+#ifndef CPPAD_CG_DEPENDENT_PARTITIONER_INCLUDED
+#define CPPAD_CG_DEPENDENT_PARTITIONER_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Splits a set of dependent variables into groups which can be evaluated
+ * independently (e.g. by different threads).
+ *
+ * The operations shared by dependents in different groups must be
+ * evaluated once per group, therefore the dependents are assigned greedily
+ * (in their original order) to the group which already contains most of
+ * the operations they require, as long as the number of operations in that
+ * group does not exceed the average by more than the allowed imbalance.
+ * Aliases and independent variables are not considered operations.
+ */
+template<class Base>
+class DependentPartitioner {
+public:
+    using CGB = CG<Base>;
+    using Node = OperationNode<Base>;
+    using Arg = Argument<Base>;
+private:
+    CodeHandler<Base>& handler_;
+    /**
+     * the maximum relative number of operations of a group above the
+     * average number of operations per group
+     */
+    double maxImbalance_;
+    /**
+     * the number of operations used by all the dependents
+     */
+    size_t totalOperations_;
+    /**
+     * the number of operations in each group of the last partition
+     */
+    std::vector<size_t> groupOperations_;
+public:
+
+    inline explicit DependentPartitioner(CodeHandler<Base>& handler) :
+        handler_(handler),
+        maxImbalance_(0.1),
+        totalOperations_(0) {
+    }
+
+    inline double getMaxImbalance() const {
+        return maxImbalance_;
+    }
+
+    /**
+     * Defines how much larger than the average a group can become before
+     * dependents which share operations with it are placed in other groups.
+     *
+     * @param maxImbalance relative increase above the average number of
+     *                     operations per group (e.g. 0.1 for 10%)
+     */
+    inline void setMaxImbalance(double maxImbalance) {
+        CPPADCG_ASSERT_KNOWN(maxImbalance >= 0, "The maximum imbalance cannot be negative")
+        maxImbalance_ = maxImbalance;
+    }
+
+    /**
+     * @return the number of operations used by all the dependents in the
+     *         last partition (each operation is counted once)
+     */
+    inline size_t getTotalOperations() const {
+        return totalOperations_;
+    }
+
+    /**
+     * @return the number of operations evaluated by all the groups in the
+     *         last partition (shared operations are counted once per group)
+     */
+    inline size_t getPartitionedOperations() const {
+        size_t total = 0;
+        for (size_t ops : groupOperations_)
+            total += ops;
+        return total;
+    }
+
+    /**
+     * @return the number of operations evaluated by each group in the last
+     *         partition
+     */
+    inline const std::vector<size_t>& getGroupOperations() const {
+        return groupOperations_;
+    }
+
+    /**
+     * Splits the dependent variables into groups.
+     *
+     * @param dependents the dependent variables which must belong to the
+     *                   code handler used by this object
+     * @param groups the maximum number of groups
+     * @return the indexes of the dependents in each group (empty groups
+     *         are not returned)
+     */
+    inline std::vector<std::vector<size_t> > partition(const ArrayView<CGB>& dependents,
+                                                       size_t groups) {
+        CPPADCG_ASSERT_KNOWN(groups > 0, "The number of groups must be positive")
+
+        size_t nNodes = handler_.getManagedNodesCount();
+        std::vector<std::vector<bool> > owned(groups, std::vector<bool>(nNodes, false));
+        std::vector<size_t> ownerCount(nNodes, 0);
+        std::vector<size_t> stamp(nNodes, 0);
+        std::vector<Node*> cone;
+        std::vector<size_t> newOps(groups);
+
+        std::vector<size_t> load(groups, 0);
+        std::vector<std::vector<size_t> > members(groups);
+
+        /**
+         * the operations used by all dependents
+         */
+        cone.clear();
+        for (size_t i = 0; i < dependents.size(); ++i) {
+            findCone(dependents[i].getOperationNode(), 1, stamp, ownerCount, groups, cone);
+        }
+        totalOperations_ = cone.size();
+
+        double capacity = double(totalOperations_) / groups * (1.0 + maxImbalance_);
+        size_t last = 0;
+
+        for (size_t i = 0; i < dependents.size(); ++i) {
+            cone.clear();
+            findCone(dependents[i].getOperationNode(), i + 2, stamp, ownerCount, groups, cone);
+
+            if (cone.empty()) {
+                // parameters and independents should not create new groups
+                members[last].push_back(i);
+                continue;
+            }
+
+            for (size_t g = 0; g < groups; ++g) {
+                size_t count = 0;
+                for (Node* node : cone) {
+                    if (!owned[g][node->getHandlerPosition()])
+                        count++;
+                }
+                newOps[g] = count;
+            }
+
+            /**
+             * prefer the group which requires fewer new operations
+             * (and which is the least loaded) while the capacity is
+             * not exceeded
+             */
+            size_t best = groups;
+            for (size_t g = 0; g < groups; ++g) {
+                if (load[g] + newOps[g] > capacity)
+                    continue;
+                if (best == groups || newOps[g] < newOps[best] ||
+                    (newOps[g] == newOps[best] && load[g] < load[best])) {
+                    best = g;
+                }
+            }
+
+            if (best == groups) {
+                // all groups are full
+                best = 0;
+                for (size_t g = 1; g < groups; ++g) {
+                    if (load[g] + newOps[g] < load[best] + newOps[best])
+                        best = g;
+                }
+            }
+
+            for (Node* node : cone) {
+                size_t pos = node->getHandlerPosition();
+                if (!owned[best][pos]) {
+                    owned[best][pos] = true;
+                    ownerCount[pos]++;
+                }
+            }
+            load[best] += newOps[best];
+            members[best].push_back(i);
+            last = best;
+        }
+
+        std::vector<std::vector<size_t> > result;
+        groupOperations_.clear();
+        for (size_t g = 0; g < groups; ++g) {
+            if (!members[g].empty()) {
+                result.push_back(std::move(members[g]));
+                groupOperations_.push_back(load[g]);
+            }
+        }
+
+        return result;
+    }
+
+private:
+
+    /**
+     * Determines the operations used by a node which have not been visited
+     * with the same mark.
+     * Nodes used by every group (and their arguments) are not included.
+     */
+    inline void findCone(Node* root,
+                         size_t mark,
+                         std::vector<size_t>& stamp,
+                         const std::vector<size_t>& ownerCount,
+                         size_t groups,
+                         std::vector<Node*>& cone) const {
+        if (root == nullptr || stamp[root->getHandlerPosition()] == mark)
+            return;
+
+        std::vector<Node*> stack;
+        stamp[root->getHandlerPosition()] = mark;
+        stack.push_back(root);
+
+        while (!stack.empty()) {
+            Node* node = stack.back();
+            stack.pop_back();
+
+            size_t pos = node->getHandlerPosition();
+            if (ownerCount[pos] == groups)
+                continue; // all its arguments are also in every group
+
+            CGOpCode op = node->getOperationType();
+            if (op != CGOpCode::Alias && op != CGOpCode::Inv)
+                cone.push_back(node);
+
+            for (const Arg& a : node->getArguments()) {
+                Node* arg = a.getOperation();
+                if (arg != nullptr && stamp[arg->getHandlerPosition()] != mark) {
+                    stamp[arg->getHandlerPosition()] = mark;
+                    stack.push_back(arg);
+                }
+            }
+        }
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,577 @@
+#ifndef CPPAD_CG_BYTECODE_PROGRAM_INCLUDED
+#define CPPAD_CG_BYTECODE_PROGRAM_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A register based representation of an operation graph which is compiled
+ * once and can then be evaluated numerically many times.
+ *
+ * The operations required by a set of dependent variables are converted
+ * into a flat list of instructions which read from and write to a dense
+ * array of values (slots).
+ * The slots hold the independent variables, followed by the registers used
+ * for temporary values and finally the constants.
+ * Registers are reused as soon as the value they hold is no longer needed.
+ *
+ * The evaluation does not recurse, allocate memory, or depend on the
+ * CodeHandler which was used to create the program.
+ * Atomic functions, arrays and loops are not supported.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class BytecodeProgram {
+public:
+    /**
+     * A single instruction
+     */
+    struct Instruction {
+        /**
+         * the operation type
+         */
+        CGOpCode op;
+        /**
+         * the slot where the result is saved
+         */
+        uint32_t out;
+        /**
+         * the slots of the arguments
+         */
+        uint32_t arg[4];
+    };
+protected:
+    /**
+     * marks a slot index which is still relative to the constant section
+     * (only used while compiling)
+     */
+    static const uint32_t CONSTANT_FLAG = uint32_t(1) << 31;
+    /**
+     * number of independent variables
+     */
+    size_t _n;
+    /**
+     * number of registers used for temporary values
+     */
+    size_t _nRegisters;
+    /**
+     * the instructions
+     */
+    std::vector<Instruction> _instructions;
+    /**
+     * the constant values
+     */
+    std::vector<Base> _constants;
+    /**
+     * the slot of each dependent variable
+     */
+    std::vector<uint32_t> _dependents;
+    /**
+     * workspace used by the methods which do not receive one
+     */
+    std::vector<Base> _slots;
+public:
+
+    /**
+     * Compiles the operations required to determine a set of dependent
+     * variables.
+     *
+     * @param handler The source code handler which owns the operations
+     * @param dependents The dependent variables
+     * @throws CGException if the graph contains an unsupported operation
+     */
+    inline BytecodeProgram(CodeHandler<Base>& handler,
+                           ArrayView<const CG<Base> > dependents) :
+        _n(handler.getIndependentVariableSize()),
+        _nRegisters(0) {
+        compile(handler, dependents);
+    }
+
+    inline virtual ~BytecodeProgram() = default;
+
+    /**
+     * @return the number of independent variables
+     */
+    inline size_t getIndependentSize() const {
+        return _n;
+    }
+
+    /**
+     * @return the number of dependent variables
+     */
+    inline size_t getDependentSize() const {
+        return _dependents.size();
+    }
+
+    /**
+     * @return the number of instructions
+     */
+    inline size_t getInstructionCount() const {
+        return _instructions.size();
+    }
+
+    /**
+     * @return the number of registers used for temporary values
+     */
+    inline size_t getRegisterCount() const {
+        return _nRegisters;
+    }
+
+    /**
+     * @return the number of constants
+     */
+    inline size_t getConstantCount() const {
+        return _constants.size();
+    }
+
+    /**
+     * @return the size of a workspace required to evaluate this program
+     */
+    inline size_t getSlotCount() const {
+        return _n + _nRegisters + _constants.size();
+    }
+
+    /**
+     * @return the instructions of this program
+     */
+    inline const std::vector<Instruction>& getInstructions() const {
+        return _instructions;
+    }
+
+    /**
+     * Prepares a workspace so that it can be used in evaluate().
+     * A workspace can only be used by one evaluation at a time.
+     *
+     * @param slots The workspace
+     */
+    inline void prepareWorkspace(std::vector<Base>& slots) const {
+        slots.resize(getSlotCount());
+        std::copy(_constants.begin(), _constants.end(), slots.begin() + _n + _nRegisters);
+    }
+
+    /**
+     * Determines the values of the dependent variables.
+     * This method uses an internal workspace and therefore it must not be
+     * called simultaneously from different threads.
+     *
+     * @param x The independent variable values
+     * @return The dependent variable values
+     */
+    inline std::vector<Base> evaluate(ArrayView<const Base> x) {
+        std::vector<Base> y(_dependents.size());
+        evaluate(x, y, _slots);
+        return y;
+    }
+
+    /**
+     * Determines the values of the dependent variables.
+     * This method uses an internal workspace and therefore it must not be
+     * called simultaneously from different threads.
+     *
+     * @param x The independent variable values
+     * @param y The dependent variable values
+     */
+    inline void evaluate(ArrayView<const Base> x,
+                         ArrayView<Base> y) {
+        evaluate(x, y, _slots);
+    }
+
+    /**
+     * Determines the values of the dependent variables using a caller
+     * provided workspace.
+     * Different threads can evaluate the same program as long as each one
+     * uses its own workspace.
+     *
+     * @param x The independent variable values
+     * @param y The dependent variable values
+     * @param slots The workspace (it is prepared if required)
+     */
+    inline void evaluate(ArrayView<const Base> x,
+                         ArrayView<Base> y,
+                         std::vector<Base>& slots) const {
+        using std::abs;
+        using std::acos;
+        using std::acosh;
+        using std::asin;
+        using std::asinh;
+        using std::atan;
+        using std::atanh;
+        using std::cos;
+        using std::cosh;
+        using std::erf;
+        using std::erfc;
+        using std::exp;
+        using std::expm1;
+        using std::log;
+        using std::log1p;
+        using std::pow;
+        using std::sin;
+        using std::sinh;
+        using std::sqrt;
+        using std::tan;
+        using std::tanh;
+
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(y.size() == _dependents.size(), "Invalid dependent array size")
+
+        if (slots.size() != getSlotCount()) {
+            prepareWorkspace(slots);
+        }
+
+        Base* v = slots.data();
+        std::copy(x.data(), x.data() + _n, v);
+
+        for (const Instruction& ins : _instructions) {
+            const uint32_t* a = ins.arg;
+            Base& r = v[ins.out];
+
+            switch (ins.op) {
+                case CGOpCode::Assign:
+                case CGOpCode::Alias:
+                case CGOpCode::Pri:
+                    r = v[a[0]];
+                    break;
+                case CGOpCode::Abs:
+                    r = abs(v[a[0]]);
+                    break;
+                case CGOpCode::Acos:
+                    r = acos(v[a[0]]);
+                    break;
+                case CGOpCode::Acosh:
+                    r = acosh(v[a[0]]);
+                    break;
+                case CGOpCode::Add:
+                    r = v[a[0]] + v[a[1]];
+                    break;
+                case CGOpCode::Asin:
+                    r = asin(v[a[0]]);
+                    break;
+                case CGOpCode::Asinh:
+                    r = asinh(v[a[0]]);
+                    break;
+                case CGOpCode::Atan:
+                    r = atan(v[a[0]]);
+                    break;
+                case CGOpCode::Atanh:
+                    r = atanh(v[a[0]]);
+                    break;
+                case CGOpCode::ComLt:
+                    r = v[a[0]] < v[a[1]] ? v[a[2]] : v[a[3]];
+                    break;
+                case CGOpCode::ComLe:
+                    r = v[a[0]] <= v[a[1]] ? v[a[2]] : v[a[3]];
+                    break;
+                case CGOpCode::ComEq:
+                    r = v[a[0]] == v[a[1]] ? v[a[2]] : v[a[3]];
+                    break;
+                case CGOpCode::ComGe:
+                    r = v[a[0]] >= v[a[1]] ? v[a[2]] : v[a[3]];
+                    break;
+                case CGOpCode::ComGt:
+                    r = v[a[0]] > v[a[1]] ? v[a[2]] : v[a[3]];
+                    break;
+                case CGOpCode::ComNe:
+                    r = v[a[0]] != v[a[1]] ? v[a[2]] : v[a[3]];
+                    break;
+                case CGOpCode::Cosh:
+                    r = cosh(v[a[0]]);
+                    break;
+                case CGOpCode::Cos:
+                    r = cos(v[a[0]]);
+                    break;
+                case CGOpCode::Div:
+                    r = v[a[0]] / v[a[1]];
+                    break;
+                case CGOpCode::Erf:
+                    r = erf(v[a[0]]);
+                    break;
+                case CGOpCode::Erfc:
+                    r = erfc(v[a[0]]);
+                    break;
+                case CGOpCode::Exp:
+                    r = exp(v[a[0]]);
+                    break;
+                case CGOpCode::Expm1:
+                    r = expm1(v[a[0]]);
+                    break;
+                case CGOpCode::Log:
+                    r = log(v[a[0]]);
+                    break;
+                case CGOpCode::Log1p:
+                    r = log1p(v[a[0]]);
+                    break;
+                case CGOpCode::Mul:
+                    r = v[a[0]] * v[a[1]];
+                    break;
+                case CGOpCode::Pow:
+                    r = pow(v[a[0]], v[a[1]]);
+                    break;
+                case CGOpCode::Sign:
+                    r = v[a[0]] > Base(0) ? Base(1) : (v[a[0]] == Base(0) ? Base(0) : Base(-1));
+                    break;
+                case CGOpCode::Sinh:
+                    r = sinh(v[a[0]]);
+                    break;
+                case CGOpCode::Sin:
+                    r = sin(v[a[0]]);
+                    break;
+                case CGOpCode::Sqrt:
+                    r = sqrt(v[a[0]]);
+                    break;
+                case CGOpCode::Sub:
+                    r = v[a[0]] - v[a[1]];
+                    break;
+                case CGOpCode::Tanh:
+                    r = tanh(v[a[0]]);
+                    break;
+                case CGOpCode::Tan:
+                    r = tan(v[a[0]]);
+                    break;
+                case CGOpCode::UnMinus:
+                    r = -v[a[0]];
+                    break;
+                default:
+                    CPPADCG_ASSERT_UNKNOWN(false) // validated during compilation
+                    break;
+            }
+        }
+
+        for (size_t i = 0; i < _dependents.size(); i++) {
+            y[i] = v[_dependents[i]];
+        }
+    }
+
+protected:
+
+    /**
+     * @return the number of arguments of an operation type or 0 if the
+     *         operation type is not supported
+     */
+    static inline size_t getArgumentCount(CGOpCode op) {
+        switch (op) {
+            case CGOpCode::Assign:
+            case CGOpCode::Alias:
+            case CGOpCode::Pri:
+            case CGOpCode::Abs:
+            case CGOpCode::Acos:
+            case CGOpCode::Acosh:
+            case CGOpCode::Asin:
+            case CGOpCode::Asinh:
+            case CGOpCode::Atan:
+            case CGOpCode::Atanh:
+            case CGOpCode::Cosh:
+            case CGOpCode::Cos:
+            case CGOpCode::Erf:
+            case CGOpCode::Erfc:
+            case CGOpCode::Exp:
+            case CGOpCode::Expm1:
+            case CGOpCode::Log:
+            case CGOpCode::Log1p:
+            case CGOpCode::Sign:
+            case CGOpCode::Sinh:
+            case CGOpCode::Sin:
+            case CGOpCode::Sqrt:
+            case CGOpCode::Tanh:
+            case CGOpCode::Tan:
+            case CGOpCode::UnMinus:
+                return 1;
+
+            case CGOpCode::Add:
+            case CGOpCode::Div:
+            case CGOpCode::Mul:
+            case CGOpCode::Pow:
+            case CGOpCode::Sub:
+                return 2;
+
+            case CGOpCode::ComLt:
+            case CGOpCode::ComLe:
+            case CGOpCode::ComEq:
+            case CGOpCode::ComGe:
+            case CGOpCode::ComGt:
+            case CGOpCode::ComNe:
+                return 4;
+
+            default:
+                return 0;
+        }
+    }
+
+    inline uint32_t addConstant(const Base& value) {
+        _constants.push_back(value);
+        return CONSTANT_FLAG | uint32_t(_constants.size() - 1);
+    }
+
+    inline void compile(CodeHandler<Base>& handler,
+                        ArrayView<const CG<Base> > dependents) {
+        using Node = OperationNode<Base>;
+
+        const uint32_t NONE = std::numeric_limits<uint32_t>::max();
+        const size_t nNodes = handler.getManagedNodesCount();
+
+        /**
+         * determine the evaluation order (non-recursive depth-first search)
+         */
+        std::vector<bool> visited(nNodes, false);
+        std::vector<uint32_t> position(nNodes, NONE); // position in the evaluation order
+        std::vector<Node*> order;
+        std::vector<std::pair<Node*, size_t> > stack;
+
+        for (size_t i = 0; i < dependents.size(); i++) {
+            Node* root = dependents[i].getOperationNode();
+            if (root == nullptr || visited[root->getHandlerPosition()])
+                continue;
+
+            visited[root->getHandlerPosition()] = true;
+            stack.emplace_back(root, 0);
+
+            while (!stack.empty()) {
+                Node* node = stack.back().first;
+                const std::vector<Argument<Base> >& args = node->getArguments();
+                size_t& a = stack.back().second;
+
+                if (a < args.size()) {
+                    Node* arg = args[a].getOperation();
+                    a++;
+                    if (arg != nullptr && !visited[arg->getHandlerPosition()]) {
+                        visited[arg->getHandlerPosition()] = true;
+                        stack.emplace_back(arg, 0); // invalidates 'a'
+                    }
+                } else {
+                    position[node->getHandlerPosition()] = uint32_t(order.size());
+                    order.push_back(node);
+                    stack.pop_back();
+                }
+            }
+        }
+
+        /**
+         * determine when each value is used for the last time
+         */
+        std::vector<uint32_t> lastUse(order.size(), 0);
+        for (size_t i = 0; i < order.size(); i++) {
+            for (const Argument<Base>& arg : order[i]->getArguments()) {
+                if (arg.getOperation() != nullptr) {
+                    lastUse[position[arg.getOperation()->getHandlerPosition()]] = uint32_t(i);
+                }
+            }
+        }
+        for (size_t i = 0; i < dependents.size(); i++) {
+            const Node* node = dependents[i].getOperationNode();
+            if (node != nullptr) {
+                lastUse[position[node->getHandlerPosition()]] = NONE; // never released
+            }
+        }
+
+        /**
+         * create the instructions
+         */
+        std::vector<uint32_t> slot(order.size(), NONE);
+        std::vector<uint32_t> freeRegisters;
+        _instructions.reserve(order.size());
+
+        for (size_t i = 0; i < order.size(); i++) {
+            Node& node = *order[i];
+            CGOpCode op = node.getOperationType();
+
+            if (op == CGOpCode::Inv) {
+                slot[i] = uint32_t(handler.getIndependentVariableIndex(node));
+                continue;
+            }
+
+            const std::vector<Argument<Base> >& args = node.getArguments();
+            size_t nArgs = getArgumentCount(op);
+            if (nArgs == 0) {
+                throw CGException("Bytecode evaluation does not support the operation '", op, "'");
+            } else if (nArgs != args.size()) {
+                throw CGException("Invalid number of arguments for the operation '", op, "'");
+            }
+
+            Instruction ins;
+            ins.op = op;
+            ins.arg[0] = ins.arg[1] = ins.arg[2] = ins.arg[3] = 0;
+            for (size_t a = 0; a < nArgs; a++) {
+                if (args[a].getOperation() != nullptr) {
+                    ins.arg[a] = slot[position[args[a].getOperation()->getHandlerPosition()]];
+                } else {
+                    ins.arg[a] = addConstant(*args[a].getParameter());
+                }
+            }
+
+            // release registers which are no longer needed (the result can use one of them)
+            for (size_t a = 0; a < nArgs; a++) {
+                if (args[a].getOperation() != nullptr) {
+                    uint32_t p = position[args[a].getOperation()->getHandlerPosition()];
+                    if (lastUse[p] == i && slot[p] >= _n) {
+                        freeRegisters.push_back(slot[p]);
+                        lastUse[p] = NONE - 1; // released
+                    }
+                }
+            }
+
+            if (freeRegisters.empty()) {
+                ins.out = uint32_t(_n + _nRegisters);
+                _nRegisters++;
+            } else {
+                ins.out = freeRegisters.back();
+                freeRegisters.pop_back();
+            }
+
+            slot[i] = ins.out;
+            _instructions.push_back(ins);
+        }
+
+        _dependents.resize(dependents.size());
+        for (size_t i = 0; i < dependents.size(); i++) {
+            const Node* node = dependents[i].getOperationNode();
+            if (node != nullptr) {
+                _dependents[i] = slot[position[node->getHandlerPosition()]];
+            } else {
+                _dependents[i] = addConstant(dependents[i].getValue());
+            }
+        }
+
+        if (getSlotCount() >= size_t(CONSTANT_FLAG)) {
+            throw CGException("Operation graph is too large for a bytecode program");
+        }
+
+        /**
+         * constants are placed after the registers
+         */
+        const uint32_t constantStart = uint32_t(_n + _nRegisters);
+        auto relocate = [&](uint32_t& s) {
+            if (s & CONSTANT_FLAG) {
+                s = constantStart + (s & ~CONSTANT_FLAG);
+            }
+        };
+
+        for (Instruction& ins : _instructions) {
+            for (uint32_t& s : ins.arg)
+                relocate(s);
+        }
+        for (uint32_t& s : _dependents)
+            relocate(s);
+
+        prepareWorkspace(_slots);
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -26,6 +26,122 @@ class EvaluatorOperations;
 template<class ScalarIn, class ScalarOut, class ActiveOut, class Operations>
 class EvaluatorBase;
 
+/**
+ * Contiguous storage for the results of an evaluator which are indexed by the
+ * position of the operation nodes in their code handler.
+ * The memory is kept between evaluations so that repeated evaluations of the
+ * same operation graph do not require new allocations.
+ *
+ * @tparam Base the base type of the code handler
+ * @tparam T the type of the stored results
+ */
+template<class Base, class T>
+class EvaluationStorage : public CodeHandlerVectorSync<Base> {
+private:
+    /**
+     * the results (one per node in the code handler)
+     */
+    std::vector<T> values_;
+    /**
+     * whether or not a result was already defined for a node
+     */
+    std::vector<char> defined_;
+    /**
+     * the positions of all defined results
+     */
+    std::vector<size_t> used_;
+public:
+
+    inline explicit EvaluationStorage(CodeHandler<Base>& handler) :
+        CodeHandlerVectorSync<Base>(handler) {
+    }
+
+    /**
+     * Makes sure there is space for all the nodes currently managed by the
+     * code handler.
+     */
+    inline void adjustSize() {
+        size_t s = this->handler_->getManagedNodesCount();
+        if (s > values_.size()) {
+            values_.resize(s);
+            defined_.resize(s, 0);
+        }
+    }
+
+    /**
+     * @return a pointer to the result for a node or null if it has not been
+     *         defined yet
+     */
+    inline T* operator[](const OperationNode<Base>& node) {
+        CPPADCG_ASSERT_UNKNOWN(node.getCodeHandler() == this->handler_)
+
+        size_t p = node.getHandlerPosition();
+        if (p >= defined_.size() || !defined_[p])
+            return nullptr;
+        return &values_[p];
+    }
+
+    /**
+     * Marks the result for a node as defined.
+     *
+     * @return the location of the result for the node which should be
+     *         filled in by the caller
+     */
+    inline T& define(const OperationNode<Base>& node) {
+        CPPADCG_ASSERT_UNKNOWN(node.getCodeHandler() == this->handler_)
+
+        size_t p = node.getHandlerPosition();
+        if (p == (std::numeric_limits<size_t>::max)())
+            throw CGException("An operation node is not managed by this code handler");
+        CPPADCG_ASSERT_UNKNOWN(p < values_.size())
+        CPPADCG_ASSERT_UNKNOWN(!defined_[p]) // not supposed to override existing result
+
+        defined_[p] = 1;
+        used_.push_back(p);
+        return values_[p];
+    }
+
+    /**
+     * Releases all the defined results while keeping the allocated memory.
+     */
+    inline void clear() {
+        for (size_t p : used_) {
+            defined_[p] = 0;
+            release(values_[p]);
+        }
+        used_.clear();
+    }
+
+protected:
+
+    void nodesErased(size_t start,
+                     size_t end) override {
+        if (start < values_.size()) {
+            end = std::min<size_t>(end, values_.size());
+            values_.erase(values_.begin() + start, values_.begin() + end);
+            defined_.erase(defined_.begin() + start, defined_.begin() + end);
+
+            used_.clear();
+            for (size_t p = 0; p < defined_.size(); ++p) {
+                if (defined_[p])
+                    used_.push_back(p);
+            }
+        }
+    }
+
+private:
+
+    template<class U>
+    static inline void release(U& v) {
+        v = U();
+    }
+
+    template<class U>
+    static inline void release(std::vector<U>& v) {
+        v.clear(); // keep the capacity
+    }
+};
+
 /**
  * A base class for evaluators.
  * Evaluators allow to reprocess operations defined in an operation graph
@@ -37,9 +153,10 @@ class EvaluatorBase;
  * pattern (CRTP). Therefore the default behaviour can be overridden without
  * the use of virtual methods.
  *
- * This class should not be instantiated directly.
+ * The operation graph is navigated without recursion (using an explicit
+ * stack) so that there are no stack limit issues for deep graphs.
  *
- * @todo implement nonrecursive algorithm (so that there will never be any stack limit issues)
+ * This class should not be instantiated directly.
  */
 template<class ScalarIn, class ScalarOut, class ActiveOut, class FinalEvaluatorType>
 class EvaluatorBase {
@@ -49,12 +166,16 @@ protected:
 protected:
     CodeHandler<ScalarIn>& handler_;
     const ActiveOut* indep_;
-    CodeHandlerVector<ScalarIn, std::unique_ptr<ActiveOut>> evals_;
-    std::map<size_t, std::vector<ActiveOut>* > evalsArrays_;
-    std::map<size_t, std::vector<ActiveOut>* > evalsSparseArrays_;
+    EvaluationStorage<ScalarIn, ActiveOut> evals_;
+    EvaluationStorage<ScalarIn, std::vector<ActiveOut>> evalsArrays_;
+    EvaluationStorage<ScalarIn, std::vector<ActiveOut>> evalsSparseArrays_;
     bool underEval_;
     size_t depth_;
     SourceCodePath path_;
+    /**
+     * used to navigate the operation graph without recursion
+     */
+    OperationStack<ScalarIn> stack_;
 public:
 
     /**
@@ -64,6 +185,8 @@ public:
         handler_(handler),
         indep_(nullptr),
         evals_(handler),
+        evalsArrays_(handler),
+        evalsSparseArrays_(handler),
         underEval_(false),
         depth_(0) { // not really required (but it avoids warnings)
     }
@@ -154,6 +277,8 @@ public:
 
         clear(); // clean-up from any previous call that might have failed
         evals_.adjustSize();
+        evalsArrays_.adjustSize();
+        evalsSparseArrays_.adjustSize();
 
         depth_ = 0;
         path_.clear();
@@ -196,18 +321,22 @@ protected:
      */
     inline void clear() {
         evals_.clear();
-
-        for (const auto& p : evalsArrays_) {
-            delete p.second;
-        }
         evalsArrays_.clear();
-
-        for (const auto& p : evalsSparseArrays_) {
-            delete p.second;
-        }
         evalsSparseArrays_.clear();
     }
 
+    /**
+     * Whether or not evalOperation() always evaluates all the arguments of
+     * a node in the original operation graph.
+     * If true, the arguments are determined before the node itself without
+     * recursion.
+     * Override this method (returning false) when the evaluation does not
+     * follow the original operation graph.
+     */
+    inline bool followsOriginalGraph() const {
+        return true;
+    }
+
     inline void analyzeOutIndeps(const ActiveOut* indep,
                                  size_t n) {
         // empty
@@ -243,13 +372,87 @@ protected:
         CPPADCG_ASSERT_KNOWN(node.getHandlerPosition() < handler_.getManagedNodesCount(), "this node is not managed by the code handler")
 
         // check if this node was previously determined
-        if (evals_[node] != nullptr) {
-            return *evals_[node];
+        const ActiveOut* saved = evals_[node];
+        if (saved != nullptr) {
+            return *saved;
         }
 
         // first evaluation of this node
         FinalEvaluatorType& thisOps = static_cast<FinalEvaluatorType&>(*this);
 
+        if (thisOps.followsOriginalGraph()) {
+            evalArgumentsWithoutRecursion(node);
+        }
+
+        return evalNewOperation(node);
+    }
+
+    /**
+     * Determines all the nodes which the arguments of a node depend on
+     * (which were not evaluated yet) using a depth first navigation with an
+     * explicit stack.
+     * Nodes are evaluated after all of their arguments, therefore later calls
+     * to evalArg() will only use previously saved results.
+     *
+     * @param root the node whose arguments are evaluated
+     */
+    inline void evalArgumentsWithoutRecursion(OperationNode<ScalarIn>& root) {
+        const size_t start = stack_.size(); // there could be another navigation in progress
+
+        stack_.pushNodeArguments(root, 0);
+
+        while (stack_.size() > start) {
+            size_t i = stack_.size() - 1; // do not use a reference because the stack may be resized
+
+            if (stack_[i].nextStep == StackNavigationStep::Analyze) {
+                OperationNode<ScalarIn>& node = stack_[i].node();
+                if (isEvaluated(node)) {
+                    stack_.pop_back();
+                } else {
+                    stack_[i].nextStep = StackNavigationStep::ChildrenVisited;
+                    stack_.pushNodeArguments(node, 0);
+                }
+
+            } else {
+                OperationNode<ScalarIn>& node = stack_[i].node();
+                stack_.pop_back();
+
+                if (!isEvaluated(node) && isValueOperation(node)) {
+                    evalNewOperation(node);
+                }
+            }
+        }
+    }
+
+    inline bool isEvaluated(const OperationNode<ScalarIn>& node) {
+        if (evals_[node] != nullptr)
+            return true;
+
+        CGOpCode op = node.getOperationType();
+        if (op == CGOpCode::ArrayCreation)
+            return evalsArrays_[node] != nullptr;
+        else if (op == CGOpCode::SparseArrayCreation)
+            return evalsSparseArrays_[node] != nullptr;
+
+        return false;
+    }
+
+    /**
+     * @return false for nodes which are not evaluated through evalOperation()
+     *         (arrays and atomic functions are determined when an array
+     *         element is evaluated)
+     */
+    static inline bool isValueOperation(const OperationNode<ScalarIn>& node) {
+        CGOpCode op = node.getOperationType();
+        return op != CGOpCode::ArrayCreation &&
+               op != CGOpCode::SparseArrayCreation &&
+               op != CGOpCode::AtomicForward &&
+               op != CGOpCode::AtomicReverse;
+    }
+
+    inline const ActiveOut& evalNewOperation(OperationNode<ScalarIn>& node) {
+        FinalEvaluatorType& thisOps = static_cast<FinalEvaluatorType&>(*this);
+
         path_.push_back(OperationPathNode<ScalarIn>(&node, -1));
         depth_++;
 
@@ -266,16 +469,15 @@ protected:
 
     inline ActiveOut* saveEvaluation(const OperationNode<ScalarIn>& node,
                                      ActiveOut&& result) {
-        std::unique_ptr<ActiveOut>& resultPtr = evals_[node];
-        CPPADCG_ASSERT_UNKNOWN(resultPtr == nullptr); // not supposed to override existing result
-        resultPtr.reset(new ActiveOut(std::move(result)));
+        ActiveOut& saved = evals_.define(node);
+        saved = std::move(result);
 
-        ActiveOut* resultPtr2 = resultPtr.get(); // do not use a reference (just in case evals_ is resized)
+        ActiveOut* resultPtr = &saved; // the storage is not resized during an evaluation
 
         FinalEvaluatorType& thisOps = static_cast<FinalEvaluatorType&>(*this);
-        thisOps.processActiveOut(node, *resultPtr2);
+        thisOps.processActiveOut(node, *resultPtr);
 
-        return resultPtr2;
+        return resultPtr;
     }
 
     inline std::vector<ActiveOut>& evalArrayCreationOperation(const OperationNode<ScalarIn>& node) {
@@ -284,23 +486,23 @@ protected:
         CPPADCG_ASSERT_KNOWN(node.getHandlerPosition() < handler_.getManagedNodesCount(), "this node is not managed by the code handler")
 
         // check if this node was previously determined
-        auto it = evalsArrays_.find(node.getHandlerPosition());
-        if (it != evalsArrays_.end()) {
-            return *it->second;
+        std::vector<ActiveOut>* saved = evalsArrays_[node];
+        if (saved != nullptr) {
+            return *saved;
         }
 
         const std::vector<Argument<ScalarIn> >& args = node.getArguments();
-        auto* resultArray = new std::vector<ActiveOut>(args.size());
 
-        // save it for reuse
-        evalsArrays_[node.getHandlerPosition()] = resultArray;
+        // save it for reuse (the memory from previous evaluations is reused)
+        std::vector<ActiveOut>& resultArray = evalsArrays_.define(node);
+        resultArray.resize(args.size());
 
         // define its elements
         for (size_t a = 0; a < args.size(); a++) {
-            (*resultArray)[a] = evalArg(args, a);
+            resultArray[a] = evalArg(args, a);
         }
 
-        return *resultArray;
+        return resultArray;
     }
 
     inline std::vector<ActiveOut>& evalSparseArrayCreationOperation(const OperationNode<ScalarIn>& node) {
@@ -309,23 +511,23 @@ protected:
         CPPADCG_ASSERT_KNOWN(node.getHandlerPosition() < handler_.getManagedNodesCount(), "this node is not managed by the code handler")
 
         // check if this node was previously determined
-        auto it = evalsSparseArrays_.find(node.getHandlerPosition());
-        if (it != evalsSparseArrays_.end()) {
-            return *it->second;
+        std::vector<ActiveOut>* saved = evalsSparseArrays_[node];
+        if (saved != nullptr) {
+            return *saved;
         }
 
         const std::vector<Argument<ScalarIn> >& args = node.getArguments();
-        auto* resultArray = new std::vector<ActiveOut>(args.size());
 
-        // save it for reuse
-        evalsSparseArrays_[node.getHandlerPosition()] = resultArray;
+        // save it for reuse (the memory from previous evaluations is reused)
+        std::vector<ActiveOut>& resultArray = evalsSparseArrays_.define(node);
+        resultArray.resize(args.size());
 
         // define its elements
         for (size_t a = 0; a < args.size(); a++) {
-            (*resultArray)[a] = evalArg(args, a);
+            resultArray[a] = evalArg(args, a);
         }
 
-        return *resultArray;
+        return resultArray;
     }
 
 };
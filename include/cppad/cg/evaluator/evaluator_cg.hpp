@@ -276,10 +276,10 @@ protected:
 
         if (node.getOperationType() == CGOpCode::ArrayCreation) {
             result = makeDenseArray(node);
-            arrayActiveOut = this->evalsArrays_[node.getHandlerPosition()];
+            arrayActiveOut = this->evalsArrays_[node];
         } else {
             result = makeSparseArray(node);
-            arrayActiveOut = this->evalsSparseArrays_[node.getHandlerPosition()];
+            arrayActiveOut = this->evalsSparseArrays_[node];
         }
 
         processArray(*arrayActiveOut, values, valuesDefined, allParameters);
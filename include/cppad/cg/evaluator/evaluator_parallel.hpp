@@ -0,0 +1,277 @@
+#ifndef CPPAD_CG_EVALUATOR_PARALLEL_INCLUDED
+#define CPPAD_CG_EVALUATOR_PARALLEL_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Evaluates groups of dependent variables which do not share any operation
+ * node (disjoint dependency cones) concurrently using several threads.
+ * Each thread uses its own evaluator and the results are placed in the
+ * same positions as in a sequential evaluation.
+ *
+ * The evaluation of different groups must not share any state, therefore
+ * this can only be used with plain values (e.g. double) or with variables
+ * where each group uses a different CodeHandler.
+ *
+ * @tparam ScalarIn the base type of the original code handler
+ * @tparam ScalarOut the base type of the new variables
+ * @tparam ActiveOut the type of the new variables
+ * @tparam EvaluatorType the evaluator used by each thread
+ */
+template<class ScalarIn,
+         class ScalarOut,
+         class ActiveOut = ScalarOut,
+         class EvaluatorType = Evaluator<ScalarIn, ScalarOut, ActiveOut> >
+class ParallelEvaluator {
+protected:
+    /**
+     * the original code handler
+     */
+    CodeHandler<ScalarIn>& handler_;
+    /**
+     * the maximum number of threads
+     */
+    size_t nThreads_;
+public:
+
+    /**
+     * @param handler the original source code handler
+     * @param nThreads the maximum number of threads used for the evaluation
+     */
+    inline explicit ParallelEvaluator(CodeHandler<ScalarIn>& handler,
+                                      size_t nThreads = std::thread::hardware_concurrency()) :
+        handler_(handler),
+        nThreads_(nThreads) {
+    }
+
+    inline virtual ~ParallelEvaluator() = default;
+
+    inline size_t getNumberOfThreads() const {
+        return nThreads_;
+    }
+
+    /**
+     * @param nThreads the maximum number of threads used for the evaluation
+     *                 (zero or one for a sequential evaluation)
+     */
+    inline void setNumberOfThreads(size_t nThreads) {
+        nThreads_ = nThreads;
+    }
+
+    /**
+     * Determines groups of dependent variables which do not share any
+     * operation node (other than independent variables).
+     * The groups are sorted by their first dependent index and the indexes in
+     * each group are sorted, so the result does not depend on the traversal
+     * order.
+     *
+     * @param depOld the dependent variables from the original code handler
+     * @return the indexes of the dependents in each group
+     */
+    inline std::vector<std::vector<size_t>> findIndependentCones(ArrayView<const CG<ScalarIn> > depOld) const {
+        const size_t m = depOld.size();
+        const size_t none = (std::numeric_limits<size_t>::max)();
+
+        // union-find over the dependent indexes
+        std::vector<size_t> parent(m);
+        for (size_t i = 0; i < m; ++i)
+            parent[i] = i;
+
+        auto findRoot = [&parent](size_t i) {
+            while (parent[i] != i) {
+                parent[i] = parent[parent[i]];
+                i = parent[i];
+            }
+            return i;
+        };
+
+        std::vector<size_t> owner(handler_.getManagedNodesCount(), none);
+        std::vector<OperationNode<ScalarIn>*> stack;
+
+        for (size_t i = 0; i < m; ++i) {
+            OperationNode<ScalarIn>* node = depOld[i].getOperationNode();
+            if (node == nullptr)
+                continue; // a parameter
+
+            stack.push_back(node);
+            while (!stack.empty()) {
+                OperationNode<ScalarIn>* n = stack.back();
+                stack.pop_back();
+
+                if (n->getOperationType() == CGOpCode::Inv)
+                    continue; // independent variables can be used by all groups
+
+                size_t p = n->getHandlerPosition();
+                CPPADCG_ASSERT_KNOWN(p < owner.size(), "this node is not managed by the code handler")
+
+                if (owner[p] != none) {
+                    // already visited from this or another dependent
+                    size_t r1 = findRoot(i);
+                    size_t r2 = findRoot(owner[p]);
+                    if (r1 != r2)
+                        parent[std::max(r1, r2)] = std::min(r1, r2);
+                    continue;
+                }
+
+                owner[p] = i;
+                for (const Argument<ScalarIn>& a : n->getArguments()) {
+                    if (a.getOperation() != nullptr)
+                        stack.push_back(a.getOperation());
+                }
+            }
+        }
+
+        std::vector<std::vector<size_t>> cones;
+        std::vector<size_t> coneIndex(m, none);
+        for (size_t i = 0; i < m; ++i) {
+            size_t r = findRoot(i);
+            if (coneIndex[r] == none) {
+                coneIndex[r] = cones.size();
+                cones.emplace_back();
+            }
+            cones[coneIndex[r]].push_back(i);
+        }
+
+        return cones;
+    }
+
+    /**
+     * Performs all the operations required to calculate the dependent
+     * variables using the same independent variables in all threads.
+     * Only available for plain values (such as double).
+     *
+     * @param indepNew The new independent variables.
+     * @param depOld Dependent variable vector representing the operations that
+     *               are going to be executed to determine the new variables
+     * @return The dependent variable values
+     * @throws CGException on error (such as an unhandled operation type)
+     */
+    inline std::vector<ActiveOut> evaluate(ArrayView<const ActiveOut> indepNew,
+                                           ArrayView<const CG<ScalarIn> > depOld) {
+        std::vector<ActiveOut> depNew(depOld.size());
+
+        evaluate(indepNew, depNew, depOld);
+
+        return depNew;
+    }
+
+    /**
+     * Performs all the operations required to calculate the dependent
+     * variables using the same independent variables in all threads.
+     * Only available for plain values (such as double).
+     *
+     * @param indepNew The new independent variables.
+     * @param depNew The new dependent variable vector to be computed.
+     * @param depOld Dependent variable vector representing the operations that
+     *               are going to be executed to determine the new variables
+     * @throws CGException on error (such as an unhandled operation type)
+     */
+    inline void evaluate(ArrayView<const ActiveOut> indepNew,
+                         ArrayView<ActiveOut> depNew,
+                         ArrayView<const CG<ScalarIn> > depOld) {
+        static_assert(std::is_arithmetic<ActiveOut>::value,
+                      "The independent variables can only be shared by all threads for plain values. "
+                      "Provide independent variables for each group instead.");
+
+        std::vector<std::vector<size_t>> cones = findIndependentCones(depOld);
+        std::vector<ArrayView<const ActiveOut>> indeps(cones.size(), indepNew);
+
+        evaluate(cones, indeps, depNew, depOld);
+    }
+
+    /**
+     * Performs all the operations required to calculate the dependent
+     * variables using different independent variables for each group of
+     * dependents (e.g. variables from a different CodeHandler per group).
+     *
+     * @param cones The groups of dependents which do not share operation
+     *              nodes (see findIndependentCones()).
+     * @param indepNew The new independent variables for each group.
+     * @param depNew The new dependent variable vector to be computed.
+     * @param depOld Dependent variable vector representing the operations that
+     *               are going to be executed to determine the new variables
+     * @throws CGException on error (such as an unhandled operation type)
+     */
+    inline void evaluate(const std::vector<std::vector<size_t>>& cones,
+                         const std::vector<ArrayView<const ActiveOut>>& indepNew,
+                         ArrayView<ActiveOut> depNew,
+                         ArrayView<const CG<ScalarIn> > depOld) {
+        if (depNew.size() != depOld.size()) {
+            throw CGException("Dependent array sizes are different.");
+        }
+        if (indepNew.size() != cones.size()) {
+            throw CGException("Invalid number of independent variable arrays. Expected ", cones.size(), " but got ", indepNew.size(), ".");
+        }
+
+        size_t nThreads = std::max<size_t>(1, std::min(nThreads_, cones.size()));
+
+        // evaluators must be created and deleted by this thread since they register themselves in the code handler
+        std::vector<std::unique_ptr<EvaluatorType>> evaluators(nThreads);
+        for (auto& e : evaluators)
+            e.reset(new EvaluatorType(handler_));
+
+        std::atomic<size_t> next(0);
+        std::vector<std::exception_ptr> errors(nThreads);
+
+        auto work = [&](size_t t) {
+            std::vector<CG<ScalarIn>> coneDepOld;
+            std::vector<ActiveOut> coneDepNew;
+
+            try {
+                for (size_t c = next++; c < cones.size(); c = next++) {
+                    const std::vector<size_t>& cone = cones[c];
+
+                    coneDepOld.resize(cone.size());
+                    coneDepNew.resize(cone.size());
+                    for (size_t k = 0; k < cone.size(); ++k)
+                        coneDepOld[k] = depOld[cone[k]];
+
+                    const ArrayView<const ActiveOut>& indep = indepNew[c];
+                    evaluators[t]->evaluate(indep.data(), indep.size(), coneDepNew.data(), coneDepOld.data(), cone.size());
+
+                    for (size_t k = 0; k < cone.size(); ++k)
+                        depNew[cone[k]] = coneDepNew[k]; // each dependent belongs to a single group
+                }
+            } catch (...) {
+                errors[t] = std::current_exception();
+                next = cones.size(); // stop the other threads
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(nThreads - 1);
+        for (size_t t = 1; t < nThreads; ++t)
+            threads.emplace_back(work, t);
+
+        work(0);
+
+        for (auto& th : threads)
+            th.join();
+
+        for (const auto& e : errors) {
+            if (e != nullptr)
+                std::rethrow_exception(e);
+        }
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -133,6 +133,17 @@ public:
 
 protected:
 
+    /**
+     * The arguments of the nodes are only evaluated when they are not
+     * replaced (it depends on the path to the node).
+     *
+     * @note overrides the default followsOriginalGraph() even though this
+     *       method is not virtual (hides a method in EvaluatorBase)
+     */
+    inline bool followsOriginalGraph() const {
+        return false;
+    }
+
     /**
      * @note overrides the default evalOperation() even though this method
      *        is not virtual (hides a method in EvaluatorOperations)
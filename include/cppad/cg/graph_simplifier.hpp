@@ -0,0 +1,578 @@
+#ifndef CPPAD_CG_GRAPH_SIMPLIFIER_INCLUDED
+#define CPPAD_CG_GRAPH_SIMPLIFIER_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Simplifies the operations used by a set of dependent variables:
+ *  - folds operations whose arguments are all parameters,
+ *  - removes algebraic identities (e.g. x * 1, x + 0, -(-x), pow(x, 1)),
+ *  - replaces some operations with cheaper ones (e.g. pow(x, 2) -> x * x),
+ *  - orders the arguments of commutative operations, and
+ *  - merges equivalent operations (same operation type and arguments).
+ *
+ * The graph is modified in place: simplified nodes become aliases to the
+ * equivalent node or parameter (like CodeHandler::substituteIndependent()),
+ * therefore other variables using these nodes remain valid.
+ * Graphs with loops or conditional blocks are currently not modified.
+ * Just like the arithmetic operators of CG, the possibility of infinite
+ * values or NaNs is not considered when multiplying or dividing a
+ * parameter zero (e.g. 0 * x -> 0).
+ * However, identities which only hold for finite non-zero values of a
+ * variable (e.g. x - x -> 0 and x / x -> 1) are not applied.
+ */
+template<class Base>
+class GraphSimplifier {
+public:
+    using CGB = CG<Base>;
+    using Node = OperationNode<Base>;
+    using Arg = Argument<Base>;
+private:
+    CodeHandler<Base>& handler_;
+    /**
+     * the number of operation nodes (excluding aliases and independent
+     * variables) used by the dependents before the last simplification
+     */
+    size_t nodesBefore_;
+    /**
+     * the number of operation nodes (excluding aliases and independent
+     * variables) used by the dependents after the last simplification
+     */
+    size_t nodesAfter_;
+public:
+
+    inline explicit GraphSimplifier(CodeHandler<Base>& handler) :
+        handler_(handler),
+        nodesBefore_(0),
+        nodesAfter_(0) {
+    }
+
+    inline size_t getNodeCountBefore() const {
+        return nodesBefore_;
+    }
+
+    inline size_t getNodeCountAfter() const {
+        return nodesAfter_;
+    }
+
+    /**
+     * Simplifies the operations used by the dependent variables.
+     *
+     * @param dependents the dependent variables which must belong to the
+     *                   code handler used by this object
+     */
+    inline void simplify(ArrayView<CGB>& dependents) {
+        std::vector<Node*> order;
+        bool structured = false;
+
+        nodesBefore_ = findNodes(dependents, order, structured);
+
+        if (structured) {
+            /**
+             * aliases and merged nodes could change the scope where nodes are
+             * used (loops and conditional blocks)
+             */
+            nodesAfter_ = nodesBefore_;
+            return;
+        }
+
+        std::unordered_multimap<size_t, Node*> equivalent;
+        equivalent.reserve(order.size());
+
+        // the arguments of each node are always visited first
+        for (Node* node : order) {
+            if (!isSimplifiable(node->getOperationType()))
+                continue;
+
+            resolveAliases(*node);
+
+            if (simplifyNode(*node))
+                continue; // it is now an alias
+
+            sortArguments(*node);
+
+            size_t h = hash(*node);
+            bool found = false;
+            auto range = equivalent.equal_range(h);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (isEquivalent(*it->second, *node)) {
+                    node->makeAlias(Arg(*it->second));
+                    found = true;
+                    break;
+                }
+            }
+            if (!found)
+                equivalent.emplace(h, node);
+        }
+
+        std::vector<Node*> finalOrder;
+        nodesAfter_ = findNodes(dependents, finalOrder, structured);
+    }
+
+    /**
+     * Simplifies the operations used by the dependent variables.
+     *
+     * @param handler the code handler which owns the dependents
+     * @param dependents the dependent variables
+     */
+    static inline void simplify(CodeHandler<Base>& handler,
+                                ArrayView<CGB>& dependents) {
+        GraphSimplifier<Base> simplifier(handler);
+        simplifier.simplify(dependents);
+    }
+
+private:
+
+    /**
+     * Determines the nodes used by the dependents (arguments first).
+     *
+     * @return the number of nodes which are not aliases nor independents
+     */
+    inline size_t findNodes(ArrayView<CGB>& dependents,
+                            std::vector<Node*>& order,
+                            bool& structured) const {
+        std::vector<bool> visited(handler_.getManagedNodesCount(), false);
+        std::vector<std::pair<Node*, size_t> > stack;
+        size_t count = 0;
+
+        for (size_t i = 0; i < dependents.size(); ++i) {
+            Node* root = dependents[i].getOperationNode();
+            if (root == nullptr || visited[root->getHandlerPosition()])
+                continue;
+
+            visited[root->getHandlerPosition()] = true;
+            stack.emplace_back(root, 0);
+
+            while (!stack.empty()) {
+                Node* node = stack.back().first;
+                size_t& a = stack.back().second;
+                const std::vector<Arg>& args = node->getArguments();
+
+                // visit the arguments first
+                bool pushed = false;
+                for (; a < args.size(); ++a) {
+                    Node* arg = args[a].getOperation();
+                    if (arg != nullptr && !visited[arg->getHandlerPosition()]) {
+                        visited[arg->getHandlerPosition()] = true;
+                        ++a;
+                        stack.emplace_back(arg, 0);
+                        pushed = true;
+                        break;
+                    }
+                }
+                if (pushed)
+                    continue;
+
+                stack.pop_back();
+
+                CGOpCode op = node->getOperationType();
+                if (op != CGOpCode::Alias && op != CGOpCode::Inv)
+                    count++;
+                if (isStructural(op))
+                    structured = true;
+
+                order.push_back(node);
+            }
+        }
+
+        return count;
+    }
+
+    static inline bool isSimplifiable(CGOpCode op) {
+        switch (op) {
+            case CGOpCode::Abs:
+            case CGOpCode::Acos:
+            case CGOpCode::Acosh:
+            case CGOpCode::Add:
+            case CGOpCode::Asin:
+            case CGOpCode::Asinh:
+            case CGOpCode::Atan:
+            case CGOpCode::Atanh:
+            case CGOpCode::Cosh:
+            case CGOpCode::Cos:
+            case CGOpCode::Div:
+            case CGOpCode::Erf:
+            case CGOpCode::Erfc:
+            case CGOpCode::Exp:
+            case CGOpCode::Expm1:
+            case CGOpCode::Log:
+            case CGOpCode::Log1p:
+            case CGOpCode::Mul:
+            case CGOpCode::Pow:
+            case CGOpCode::Sign:
+            case CGOpCode::Sinh:
+            case CGOpCode::Sin:
+            case CGOpCode::Sqrt:
+            case CGOpCode::Sub:
+            case CGOpCode::Tanh:
+            case CGOpCode::Tan:
+            case CGOpCode::UnMinus:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * @return true for operations which define loops, conditional blocks, or
+     *         operations with side effects
+     */
+    static inline bool isStructural(CGOpCode op) {
+        switch (op) {
+            case CGOpCode::DependentMultiAssign:
+            case CGOpCode::DependentRefRhs:
+            case CGOpCode::IndexDeclaration:
+            case CGOpCode::Index:
+            case CGOpCode::IndexAssign:
+            case CGOpCode::LoopStart:
+            case CGOpCode::LoopIndexedIndep:
+            case CGOpCode::LoopIndexedDep:
+            case CGOpCode::LoopIndexedTmp:
+            case CGOpCode::LoopEnd:
+            case CGOpCode::TmpDcl:
+            case CGOpCode::Tmp:
+            case CGOpCode::IndexCondExpr:
+            case CGOpCode::StartIf:
+            case CGOpCode::ElseIf:
+            case CGOpCode::Else:
+            case CGOpCode::EndIf:
+            case CGOpCode::CondResult:
+            case CGOpCode::Pri:
+            case CGOpCode::UserCustom:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * Makes the arguments point directly to the aliased nodes/parameters.
+     */
+    static inline void resolveAliases(Node& node) {
+        for (Arg& a : node.getArguments()) {
+            while (a.getOperation() != nullptr && a.getOperation()->getOperationType() == CGOpCode::Alias) {
+                Arg aa = a.getOperation()->getArguments()[0];
+                a = aa;
+            }
+        }
+    }
+
+    /**
+     * @return true if the node was transformed into an alias
+     */
+    inline bool simplifyNode(Node& node) {
+        std::vector<Arg>& args = node.getArguments();
+        CGOpCode op = node.getOperationType();
+
+        bool allParameters = true;
+        for (const Arg& a : args) {
+            if (a.getParameter() == nullptr) {
+                allParameters = false;
+                break;
+            }
+        }
+
+        if (allParameters) {
+            Base r;
+            if (evaluateParameters(op, args, r)) {
+                node.makeAlias(Arg(r));
+                return true;
+            }
+            return false;
+        }
+
+        if (op == CGOpCode::UnMinus) {
+            Node* a = args[0].getOperation();
+            if (a->getOperationType() == CGOpCode::UnMinus) {
+                node.makeAlias(a->getArguments()[0]); // -(-x) -> x
+                return true;
+            }
+            return false;
+        }
+
+        if (args.size() != 2)
+            return false;
+
+        const Base* p0 = args[0].getParameter();
+        const Base* p1 = args[1].getParameter();
+        Node* n0 = args[0].getOperation();
+        Node* n1 = args[1].getOperation();
+
+        switch (op) {
+            case CGOpCode::Add:
+                if (p0 != nullptr && CppAD::IdenticalZero(*p0)) {
+                    node.makeAlias(args[1]);
+                    return true;
+                } else if (p1 != nullptr && CppAD::IdenticalZero(*p1)) {
+                    node.makeAlias(args[0]);
+                    return true;
+                } else if (n1 != nullptr && n1->getOperationType() == CGOpCode::UnMinus) {
+                    node.setOperation(CGOpCode::Sub, {args[0], n1->getArguments()[0]}); // a + (-b) -> a - b
+                } else if (n0 != nullptr && n0->getOperationType() == CGOpCode::UnMinus) {
+                    node.setOperation(CGOpCode::Sub, {args[1], n0->getArguments()[0]}); // (-a) + b -> b - a
+                }
+                return false;
+
+            case CGOpCode::Sub:
+                if (p1 != nullptr && CppAD::IdenticalZero(*p1)) {
+                    node.makeAlias(args[0]);
+                    return true;
+                } else if (p0 != nullptr && CppAD::IdenticalZero(*p0)) {
+                    node.setOperation(CGOpCode::UnMinus, {args[1]}); // 0 - a -> -a
+                } else if (n1 != nullptr && n1->getOperationType() == CGOpCode::UnMinus) {
+                    node.setOperation(CGOpCode::Add, {args[0], n1->getArguments()[0]}); // a - (-b) -> a + b
+                }
+                return false;
+
+            case CGOpCode::Mul: {
+                const Base* p = p0 != nullptr ? p0 : p1;
+                const Arg& other = p0 != nullptr ? args[1] : args[0];
+                if (p != nullptr) {
+                    if (CppAD::IdenticalZero(*p)) {
+                        node.makeAlias(Arg(Base(0.0)));
+                        return true;
+                    } else if (CppAD::IdenticalOne(*p)) {
+                        node.makeAlias(other);
+                        return true;
+                    } else if (*p == Base(-1.0)) {
+                        node.setOperation(CGOpCode::UnMinus, {other}); // -1 * a -> -a
+                    }
+                }
+                return false;
+            }
+            case CGOpCode::Div:
+                if (p0 != nullptr && CppAD::IdenticalZero(*p0)) {
+                    node.makeAlias(Arg(Base(0.0)));
+                    return true;
+                } else if (p1 != nullptr && CppAD::IdenticalOne(*p1)) {
+                    node.makeAlias(args[0]);
+                    return true;
+                } else if (p1 != nullptr && *p1 == Base(-1.0)) {
+                    node.setOperation(CGOpCode::UnMinus, {args[0]}); // a / -1 -> -a
+                }
+                return false;
+
+            case CGOpCode::Pow:
+                if (p1 != nullptr) {
+                    if (CppAD::IdenticalZero(*p1)) {
+                        node.makeAlias(Arg(Base(1.0)));
+                        return true;
+                    } else if (CppAD::IdenticalOne(*p1)) {
+                        node.makeAlias(args[0]);
+                        return true;
+                    } else if (*p1 == Base(2.0)) {
+                        node.setOperation(CGOpCode::Mul, {args[0], args[0]}); // pow(a, 2) -> a * a
+                    } else if (*p1 == Base(-1.0)) {
+                        node.setOperation(CGOpCode::Div, {Arg(Base(1.0)), args[0]}); // pow(a, -1) -> 1 / a
+                    }
+                }
+                return false;
+
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * Determines the result of an operation whose arguments are all
+     * parameters.
+     *
+     * @return true if the result could be determined
+     */
+    static inline bool evaluateParameters(CGOpCode op,
+                                          const std::vector<Arg>& args,
+                                          Base& result) {
+        CGB a(*args[0].getParameter());
+        CGB r;
+        switch (op) {
+            case CGOpCode::Abs:
+                r = CppAD::abs(a);
+                break;
+            case CGOpCode::Acos:
+                r = CppAD::acos(a);
+                break;
+            case CGOpCode::Asin:
+                r = CppAD::asin(a);
+                break;
+            case CGOpCode::Atan:
+                r = CppAD::atan(a);
+                break;
+            case CGOpCode::Cosh:
+                r = CppAD::cosh(a);
+                break;
+            case CGOpCode::Cos:
+                r = CppAD::cos(a);
+                break;
+            case CGOpCode::Exp:
+                r = CppAD::exp(a);
+                break;
+            case CGOpCode::Log:
+                r = CppAD::log(a);
+                break;
+            case CGOpCode::Sign:
+                r = CppAD::sign(a);
+                break;
+            case CGOpCode::Sinh:
+                r = CppAD::sinh(a);
+                break;
+            case CGOpCode::Sin:
+                r = CppAD::sin(a);
+                break;
+            case CGOpCode::Sqrt:
+                r = CppAD::sqrt(a);
+                break;
+            case CGOpCode::Tanh:
+                r = CppAD::tanh(a);
+                break;
+            case CGOpCode::Tan:
+                r = CppAD::tan(a);
+                break;
+            case CGOpCode::UnMinus:
+                r = -a;
+                break;
+#if CPPAD_USE_CPLUSPLUS_2011
+            case CGOpCode::Acosh:
+                r = CppAD::acosh(a);
+                break;
+            case CGOpCode::Asinh:
+                r = CppAD::asinh(a);
+                break;
+            case CGOpCode::Atanh:
+                r = CppAD::atanh(a);
+                break;
+            case CGOpCode::Erf:
+                r = CppAD::erf(a);
+                break;
+            case CGOpCode::Erfc:
+                r = CppAD::erfc(a);
+                break;
+            case CGOpCode::Expm1:
+                r = CppAD::expm1(a);
+                break;
+            case CGOpCode::Log1p:
+                r = CppAD::log1p(a);
+                break;
+#endif
+            case CGOpCode::Add:
+                r = a + CGB(*args[1].getParameter());
+                break;
+            case CGOpCode::Sub:
+                r = a - CGB(*args[1].getParameter());
+                break;
+            case CGOpCode::Mul:
+                r = a * CGB(*args[1].getParameter());
+                break;
+            case CGOpCode::Div:
+                r = a / CGB(*args[1].getParameter());
+                break;
+            case CGOpCode::Pow:
+                r = CppAD::pow(a, CGB(*args[1].getParameter()));
+                break;
+            default:
+                return false; // unable to fold
+        }
+
+        CPPADCG_ASSERT_UNKNOWN(r.isParameter())
+        result = r.getValue();
+        return true;
+    }
+
+    /**
+     * Places the arguments of commutative operations in a predefined order
+     * (variables ordered by their creation and then parameters) so that
+     * equivalent operations can be merged.
+     */
+    static inline void sortArguments(Node& node) {
+        CGOpCode op = node.getOperationType();
+        if (op != CGOpCode::Add && op != CGOpCode::Mul)
+            return;
+
+        std::vector<Arg>& args = node.getArguments();
+        CPPADCG_ASSERT_UNKNOWN(args.size() == 2)
+        Node* n0 = args[0].getOperation();
+        Node* n1 = args[1].getOperation();
+
+        if ((n0 == nullptr && n1 != nullptr) ||
+            (n0 != nullptr && n1 != nullptr && n1->getHandlerPosition() < n0->getHandlerPosition())) {
+            std::swap(args[0], args[1]);
+        }
+    }
+
+    static inline size_t hash(const Node& node) {
+        size_t h = size_t(node.getOperationType());
+
+        const std::vector<size_t>& info = node.getInfo();
+        h = combine(h, info.size());
+        for (size_t e : info)
+            h = combine(h, e);
+
+        const std::vector<Arg>& args = node.getArguments();
+        h = combine(h, args.size());
+        for (const Arg& a : args) {
+            if (a.getOperation() != nullptr) {
+                h = combine(h, a.getOperation()->getHandlerPosition());
+            } else {
+                h = combine(h, hashValue(*a.getParameter()));
+            }
+        }
+
+        return h;
+    }
+
+    static inline bool isEquivalent(const Node& n1,
+                                    const Node& n2) {
+        if (n1.getOperationType() != n2.getOperationType() || n1.getInfo() != n2.getInfo())
+            return false;
+
+        const std::vector<Arg>& args1 = n1.getArguments();
+        const std::vector<Arg>& args2 = n2.getArguments();
+        if (args1.size() != args2.size())
+            return false;
+
+        for (size_t a = 0; a < args1.size(); ++a) {
+            if (args1[a].getOperation() != args2[a].getOperation())
+                return false;
+            if (args1[a].getOperation() == nullptr && !(*args1[a].getParameter() == *args2[a].getParameter()))
+                return false;
+        }
+
+        return true;
+    }
+
+    static inline size_t combine(size_t seed, size_t value) {
+        return seed ^ (value + size_t(0x9e3779b97f4a7c15ull) + (seed << 6) + (seed >> 2));
+    }
+
+    template<class T = Base>
+    static inline typename std::enable_if<std::is_arithmetic<T>::value, size_t>::type hashValue(const T& value) {
+        if (value == T(0))
+            return 0; // the same for +0 and -0
+        return std::hash<T>()(value);
+    }
+
+    template<class T = Base>
+    static inline typename std::enable_if<!std::is_arithmetic<T>::value, size_t>::type hashValue(const T&) {
+        return 0; // parameters will be compared by isEquivalent()
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
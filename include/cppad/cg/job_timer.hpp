@@ -216,12 +216,51 @@ private:
      *
      */
     std::set<JobListener*> _listeners;
+    /**
+     * Whether or not a cancellation was requested (possibly from another
+     * thread)
+     */
+    std::atomic<bool> _cancelRequested;
+    /**
+     * The timer of the jobs which started the jobs of this timer in another
+     * thread (cancellation requests and listeners are shared)
+     */
+    JobTimer* _parent;
+    /**
+     * Serializes the notifications of the parent listeners
+     */
+    std::mutex* _parentMutex;
 public:
 
     JobTimer() :
         _verbose(false),
         _maxLineWidth(80),
-        _indent(2) {
+        _indent(2),
+        _cancelRequested(false),
+        _parent(nullptr),
+        _parentMutex(nullptr) {
+    }
+
+    /**
+     * Creates a timer for jobs executed by another thread on behalf of the
+     * current job of a parent timer (e.g. source generation in parallel).
+     * Cancellation requests of the parent also cancel these jobs and the
+     * parent listeners are notified (from the other thread) with the jobs
+     * of the parent followed by the jobs of this timer.
+     * The parent jobs must not change while this timer is used.
+     *
+     * @param parent the timer of the job which started the other thread
+     * @param mutex used to notify the parent listeners by a single thread
+     *              at a time (shared by all the timers with the same parent)
+     */
+    JobTimer(JobTimer& parent,
+             std::mutex& mutex) :
+        _verbose(false),
+        _maxLineWidth(parent._maxLineWidth),
+        _indent(parent._indent),
+        _cancelRequested(false),
+        _parent(&parent),
+        _parentMutex(&mutex) {
     }
 
     inline bool isVerbose() const {
@@ -257,10 +296,51 @@ public:
         return _listeners.erase(&l) > 0;
     }
 
+    /**
+     * Requests the cancellation of the current and any following jobs.
+     * Cancellation is cooperative: the next call to startingJob() will
+     * throw a CGException and discard the jobs which were started.
+     * This method can be called from a different thread from the one
+     * running the jobs.
+     */
+    inline void requestCancel() {
+        _cancelRequested = true;
+    }
+
+    /**
+     * @return whether or not a cancellation was requested
+     */
+    inline bool isCancelRequested() const {
+        return _cancelRequested || (_parent != nullptr && _parent->isCancelRequested());
+    }
+
+    /**
+     * Allows new jobs to start after a cancellation request.
+     */
+    inline void clearCancelRequest() {
+        _cancelRequested = false;
+    }
+
+    /**
+     * Throws a CGException and discards the jobs which were started if a
+     * cancellation was requested (startingJob() does it automatically).
+     *
+     * @param next a description of what would be done next
+     */
+    inline void checkCancelRequest(const std::string& next) {
+        if (isCancelRequested()) {
+            // the jobs which were started will not finish
+            _jobs.clear();
+            throw CGException("Cancelled before ", next);
+        }
+    }
+
     inline void startingJob(const std::string& jobName,
                             const JobType& type = JobTypeHolder<>::DEFAULT,
                             const std::string& prefix = "") {
 
+        checkCancelRequest(type.getActionName() + " " + jobName);
+
         _jobs.push_back(Job(type, jobName));
 
         if (_verbose) {
@@ -293,6 +373,37 @@ public:
         for (JobListener* l : _listeners) {
             l->jobStarted(_jobs);
         }
+        if (_parent != nullptr) {
+            std::lock_guard<std::mutex> lock(*_parentMutex);
+            std::vector<Job> jobs = _parent->nestJobs(_jobs);
+            for (JobListener* l : _parent->_listeners) {
+                l->jobStarted(jobs);
+            }
+        }
+    }
+
+    /**
+     * Prints a message nested in the current job when the output is
+     * verbose.
+     * It must be called by the thread which starts and finishes the jobs.
+     *
+     * @param message the message (without a new line)
+     */
+    inline void printMessage(const std::string& message) {
+        if (!_verbose)
+            return;
+
+        OStreamConfigRestore osr(std::cout);
+
+        if (!_jobs.empty()) {
+            Job& parent = _jobs.back();
+            if (!parent._nestedJobs) {
+                parent._nestedJobs = true;
+                std::cout << "\n";
+            }
+        }
+
+        std::cout << std::string(_indent * _jobs.size(), ' ') << message << std::endl;
     }
 
     inline void finishedJob() {
@@ -325,10 +436,29 @@ public:
         for (JobListener* l : _listeners) {
             l->jobEndended(_jobs, elapsed);
         }
+        if (_parent != nullptr) {
+            std::lock_guard<std::mutex> lock(*_parentMutex);
+            std::vector<Job> jobs = _parent->nestJobs(_jobs);
+            for (JobListener* l : _parent->_listeners) {
+                l->jobEndended(jobs, elapsed);
+            }
+        }
 
         _jobs.pop_back();
     }
 
+private:
+
+    /**
+     * @return the current jobs (including the jobs of the parent timers)
+     *         followed by the provided jobs
+     */
+    inline std::vector<Job> nestJobs(const std::vector<Job>& nested) const {
+        std::vector<Job> jobs = _parent != nullptr ? _parent->nestJobs(_jobs) : _jobs;
+        jobs.insert(jobs.end(), nested.begin(), nested.end());
+        return jobs;
+    }
+
 };
 
 } // END cg namespace
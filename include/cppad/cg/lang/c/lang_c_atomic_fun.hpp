@@ -68,6 +68,13 @@ struct LangCAtomicFun {
                    const Array tx[],
                    Array* px,
                    const Array py[]);
+    /**
+     * Memory for the temporary arrays of the generated functions (only used
+     * when the source code was generated with a temporary workspace).
+     * Multithreaded functions provide each worker with its own part of the
+     * workspace.
+     */
+    void* workspace;
 };
 
 }
@@ -99,10 +99,7 @@ public:
             return _nameGen->generateIndependent(independent, id);
         }
 
-        _ss.clear();
-        _ss.str("");
-        _ss << _multName << "[" << (id - _minMultiplierID) << "]";
-        return _ss.str();
+        return LanguageC<Base>::arrayElementName(_multName, id - _minMultiplierID);
     }
 
     std::string generateTemporary(const OperationNode<Base>& variable,
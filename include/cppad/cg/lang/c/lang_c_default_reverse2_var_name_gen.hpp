@@ -110,14 +110,11 @@ public:
         if (id < _minLevel1ID) {
             return _nameGen->generateIndependent(independent, id);
         } else {
-            _ss.clear();
-            _ss.str("");
             if (id < _minLevel2ID) {
-                _ss << _level1Name << "[" << (id - _minLevel1ID) << "]";
+                return LanguageC<Base>::arrayElementName(_level1Name, id - _minLevel1ID);
             } else {
-                _ss << _level2Name << "[" << (id - _minLevel2ID) << "]";
+                return LanguageC<Base>::arrayElementName(_level2Name, id - _minLevel2ID);
             }
-            return _ss.str();
         }
     }
 
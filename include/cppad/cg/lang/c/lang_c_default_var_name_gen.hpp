@@ -27,7 +27,7 @@ namespace cg {
 template<class Base>
 class LangCDefaultVariableNameGenerator : public VariableNameGenerator<Base> {
 protected:
-    // auxiliary string stream
+    // auxiliary string stream (not used for the most common names)
     std::stringstream _ss;
     // array name of the dependent variables
     std::string _depName;
@@ -90,60 +90,37 @@ public:
     }
 
     inline std::string generateDependent(size_t index) override {
-        _ss.clear();
-        _ss.str("");
-
-        _ss << _depName << "[" << index << "]";
-
-        return _ss.str();
+        return LanguageC<Base>::arrayElementName(_depName, index);
     }
 
     inline std::string generateIndependent(const OperationNode<Base>& independent,
                                            size_t id) override {
-        _ss.clear();
-        _ss.str("");
-
-        _ss << _indepName << "[" << (id - 1) << "]";
-
-        return _ss.str();
+        return LanguageC<Base>::arrayElementName(_indepName, id - 1);
     }
 
     inline std::string generateTemporary(const OperationNode<Base>& variable,
                                          size_t id) override {
-        _ss.clear();
-        _ss.str("");
-
         if (this->_temporary[0].array) {
-            _ss << _tmpName << "[" << (id - this->_minTemporaryID) << "]";
+            return LanguageC<Base>::arrayElementName(_tmpName, id - this->_minTemporaryID);
         } else {
-            _ss << _tmpName << id;
+            std::string name(_tmpName);
+            LanguageC<Base>::appendInteger(name, id);
+            return name;
         }
-
-        return _ss.str();
     }
 
     std::string generateTemporaryArray(const OperationNode<Base>& variable,
                                        size_t id) override {
-        _ss.clear();
-        _ss.str("");
-
         CPPADCG_ASSERT_UNKNOWN(variable.getOperationType() == CGOpCode::ArrayCreation)
 
-        _ss << "&" << _tmpArrayName << "[" << (id - 1) << "]";
-
-        return _ss.str();
+        return LanguageC<Base>::arrayElementName(_tmpArrayName, id - 1, true);
     }
 
     std::string generateTemporarySparseArray(const OperationNode<Base>& variable,
                                              size_t id) override {
-        _ss.clear();
-        _ss.str("");
-
         CPPADCG_ASSERT_UNKNOWN(variable.getOperationType() == CGOpCode::SparseArrayCreation)
 
-        _ss << "&" << _tmpSparseArrayName << "[" << (id - 1) << "]";
-
-        return _ss.str();
+        return LanguageC<Base>::arrayElementName(_tmpSparseArrayName, id - 1, true);
     }
 
     std::string generateIndexedDependent(const OperationNode<Base>& var,
@@ -0,0 +1,188 @@
+#ifndef CPPAD_CG_LANG_C_DEPENDENT_SUBSET_VAR_NAME_GEN_INCLUDED
+#define CPPAD_CG_LANG_C_DEPENDENT_SUBSET_VAR_NAME_GEN_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Creates variables names for the source code of a function which only
+ * evaluates a subset of the dependent variables of another function.
+ * The dependents are still saved in their original location of the
+ * dependent array.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class LangCDependentSubsetVarNameGenerator : public VariableNameGenerator<Base> {
+protected:
+    VariableNameGenerator<Base>* _nameGen;
+    // the location of each dependent in the original dependent array
+    const std::vector<size_t> _locations;
+public:
+
+    LangCDependentSubsetVarNameGenerator(VariableNameGenerator<Base>* nameGen,
+                                         std::vector<size_t> locations) :
+        _nameGen(nameGen),
+        _locations(std::move(locations)) {
+
+        CPPADCG_ASSERT_KNOWN(_nameGen != nullptr, "The name generator must not be null")
+    }
+
+    inline virtual ~LangCDependentSubsetVarNameGenerator() = default;
+
+    inline const std::vector<size_t>& getLocations() const {
+        return _locations;
+    }
+
+    const std::vector<FuncArgument>& getDependent() const override {
+        return _nameGen->getDependent();
+    }
+
+    const std::vector<FuncArgument>& getIndependent() const override {
+        return _nameGen->getIndependent();
+    }
+
+    const std::vector<FuncArgument>& getTemporary() const override {
+        return _nameGen->getTemporary();
+    }
+
+    size_t getMinTemporaryVariableID() const override {
+        return _nameGen->getMinTemporaryVariableID();
+    }
+
+    size_t getMaxTemporaryVariableID() const override {
+        return _nameGen->getMaxTemporaryVariableID();
+    }
+
+    size_t getMaxTemporaryArrayVariableID() const override {
+        return _nameGen->getMaxTemporaryArrayVariableID();
+    }
+
+    size_t getMaxTemporarySparseArrayVariableID() const override {
+        return _nameGen->getMaxTemporarySparseArrayVariableID();
+    }
+
+    std::string generateDependent(size_t index) override {
+        CPPADCG_ASSERT_KNOWN(index < _locations.size(), "Invalid dependent index")
+        return _nameGen->generateDependent(_locations[index]);
+    }
+
+    std::string generateIndependent(const OperationNode<Base>& independent,
+                                    size_t id) override {
+        return _nameGen->generateIndependent(independent, id);
+    }
+
+    std::string generateTemporary(const OperationNode<Base>& variable,
+                                  size_t id) override {
+        return _nameGen->generateTemporary(variable, id);
+    }
+
+    std::string generateTemporaryArray(const OperationNode<Base>& variable,
+                                       size_t id) override {
+        return _nameGen->generateTemporaryArray(variable, id);
+    }
+
+    std::string generateTemporarySparseArray(const OperationNode<Base>& variable,
+                                             size_t id) override {
+        return _nameGen->generateTemporarySparseArray(variable, id);
+    }
+
+    std::string generateIndexedDependent(const OperationNode<Base>& var,
+                                         size_t id,
+                                         const IndexPattern& ip) override {
+        return _nameGen->generateIndexedDependent(var, id, ip);
+    }
+
+    std::string generateIndexedIndependent(const OperationNode<Base>& indexedIndep,
+                                           size_t id,
+                                           const IndexPattern& ip) override {
+        return _nameGen->generateIndexedIndependent(indexedIndep, id, ip);
+    }
+
+    const std::string& getIndependentArrayName(const OperationNode<Base>& indep,
+                                               size_t id) override {
+        return _nameGen->getIndependentArrayName(indep, id);
+    }
+
+    size_t getIndependentArrayIndex(const OperationNode<Base>& indep,
+                                    size_t id) override {
+        return _nameGen->getIndependentArrayIndex(indep, id);
+    }
+
+    bool isConsecutiveInIndepArray(const OperationNode<Base>& indepFirst,
+                                   size_t id1,
+                                   const OperationNode<Base>& indepSecond,
+                                   size_t id2) override {
+        return _nameGen->isConsecutiveInIndepArray(indepFirst, id1, indepSecond, id2);
+    }
+
+    bool isInSameIndependentArray(const OperationNode<Base>& indep1,
+                                  size_t id1,
+                                  const OperationNode<Base>& indep2,
+                                  size_t id2) override {
+        return _nameGen->isInSameIndependentArray(indep1, id1, indep2, id2);
+    }
+
+    void setTemporaryVariableID(size_t minTempID,
+                                size_t maxTempID,
+                                size_t maxTempArrayID,
+                                size_t maxTempSparseArrayID) override {
+        _nameGen->setTemporaryVariableID(minTempID, maxTempID, maxTempArrayID, maxTempSparseArrayID);
+    }
+
+    const std::string& getTemporaryVarArrayName(const OperationNode<Base>& var,
+                                                size_t id) override {
+        return _nameGen->getTemporaryVarArrayName(var, id);
+    }
+
+    size_t getTemporaryVarArrayIndex(const OperationNode<Base>& var,
+                                     size_t id) override {
+        return _nameGen->getTemporaryVarArrayIndex(var, id);
+    }
+
+    bool isConsecutiveInTemporaryVarArray(const OperationNode<Base>& varFirst,
+                                          size_t idFirst,
+                                          const OperationNode<Base>& varSecond,
+                                          size_t idSecond) override {
+        return _nameGen->isConsecutiveInTemporaryVarArray(varFirst, idFirst, varSecond, idSecond);
+    }
+
+    bool isInSameTemporaryVarArray(const OperationNode<Base>& var1,
+                                   size_t id1,
+                                   const OperationNode<Base>& var2,
+                                   size_t id2) override {
+        return _nameGen->isInSameTemporaryVarArray(var1, id1, var2, id2);
+    }
+
+    void customFunctionVariableDeclarations(std::ostream& out) override {
+        _nameGen->customFunctionVariableDeclarations(out);
+    }
+
+    void prepareCustomFunctionVariables(std::ostream& out) override {
+        _nameGen->prepareCustomFunctionVariables(out);
+    }
+
+    void finalizeCustomFunctionVariables(std::ostream& out) override {
+        _nameGen->finalizeCustomFunctionVariables(out);
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
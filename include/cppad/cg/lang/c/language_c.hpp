@@ -38,6 +38,64 @@ public:
 public:
     static const std::string U_INDEX_TYPE;
     static const std::string ATOMICFUN_STRUCT_DEFINITION;
+    static const std::string FP_CONTRACT_OFF_DEFINITION;
+    static const std::string APPROXIMATE_MATH_DEFINITION;
+    static const size_t WORKSPACE_ALIGNMENT;
+
+    /**
+     * Parameters of the cost model used to automatically split the source
+     * code into several functions (see setAutomaticFunctionSplitting()).
+     * Costs are measured in (estimated) operations.
+     */
+    struct FunctionSplitCostModel {
+        /**
+         * The function size (operations plus live temporary variables) at
+         * which the compilation cost per operation doubles.
+         * Compilers typically require time and memory which grow faster
+         * than linearly with the size of straight-line functions.
+         */
+        double compileScale = 20000;
+        /**
+         * The weight of one unit of compilation cost relative to one unit
+         * of runtime cost
+         */
+        double compileWeight = 0.01;
+        /**
+         * The runtime cost of calling a function
+         */
+        double callCost = 50;
+        /**
+         * The runtime cost of each temporary variable used across functions
+         * (it must be stored to and loaded from memory)
+         */
+        double liveCost = 2;
+        /**
+         * The maximum compilation cost of a function (it can be violated
+         * when it is not possible to split the code, e.g. inside loops)
+         */
+        double maxCompileCost = 2e6;
+    };
+
+    /**
+     * A group of consecutive operations placed in the same function by the
+     * automatic function splitting
+     */
+    struct FunctionChunk {
+        // the position of the first operation in the evaluation order
+        size_t begin;
+        // the position after the last operation in the evaluation order
+        size_t end;
+        // the estimated number of operations
+        size_t operations;
+        // the maximum number of live temporary variables
+        size_t maxLive;
+        // the number of temporary variables used by the following functions
+        size_t liveOut;
+        // the estimated compilation cost
+        double compileCost;
+        // the estimated runtime cost (including the function call)
+        double runtimeCost;
+    };
 protected:
     static const std::string _C_COMP_OP_LT;
     static const std::string _C_COMP_OP_LE;
@@ -47,12 +105,31 @@ protected:
     static const std::string _C_COMP_OP_NE;
     static const std::string _C_STATIC_INDEX_ARRAY;
     static const std::string _C_SPARSE_INDEX_ARRAY;
+    static const std::string _C_CONSTANT_POOL;
     static const std::string _ATOMIC_TX;
     static const std::string _ATOMIC_TY;
     static const std::string _ATOMIC_PX;
     static const std::string _ATOMIC_PY;
+    static const std::string _C_APPROX_EXP;
+    static const std::string _C_APPROX_LOG;
+    static const std::string _C_APPROX_POW;
+    static const std::string _C_APPROX_TANH;
 private:
     class AtomicFuncArray; //forward declaration
+protected:
+    /**
+     * Information required to print a loop with vectorization hints
+     */
+    struct VectorizableLoop {
+        // loop invariant operations evaluated before the loop
+        std::vector<Node*> invariants;
+        // the variable names of the loop invariants
+        std::vector<std::string> invariantNames;
+        // the temporary variables local to each iteration
+        std::vector<std::string> locals;
+        // the indexes assigned inside the loop
+        std::vector<std::string> privateIndexes;
+    };
 protected:
     // the type name of the Base class (e.g. "double")
     const std::string _baseTypeName;
@@ -110,6 +187,44 @@ protected:
     std::vector<const LoopStartOperationNode<Base>*> _currentLoops;
     // the maximum precision used to print values
     size_t _parameterPrecision;
+    // whether or not values are printed with the fewest digits which preserve their exact value
+    bool _roundTripParameters;
+    // whether or not constant values are saved in a static array (constant pool)
+    bool _constantPool;
+    // the constant values in the constant pool of the current function
+    std::vector<std::string> _constantPoolValues;
+    // maps the constant values to their position in the constant pool
+    std::map<std::string, size_t> _constantPoolIndex;
+    // whether or not to generate vectorization hints for loops
+    bool _loopVectorization;
+    // loops (LoopStart nodes) which can be vectorized
+    std::map<const Node*, VectorizableLoop> _vectorizableLoops;
+    // loop invariant operations which are evaluated before the loop
+    std::set<const Node*> _hoistedLoopNodes;
+    // temporary variables declared locally for vectorized loops
+    std::set<const Node*> _loopLocalNodes;
+    // whether or not to replace mathematical functions with cheaper equivalent forms
+    bool _mathLowering;
+    // sin/cos operations of the same argument evaluated by a single call (first -> second)
+    std::map<const Node*, Node*> _sinCosPairs;
+    // sin/cos operations already evaluated by a previous sincos call
+    std::set<const Node*> _sinCosEvaluated;
+    // operations determined from other variables with the same argument (e.g. cosh(x) from exp(x))
+    std::map<const Node*, std::pair<Node*, Node*> > _loweredOps;
+    // how multiply-add operations are printed
+    FusedMultiplyAdd _fma;
+    // whether or not to use approximate implementations of exp, log, pow, and tanh
+    bool _approximateMath;
+    // whether or not the temporary arrays are placed in a workspace provided by the caller
+    bool _temporaryWorkspace;
+    // the number of bytes of the workspace used by the last generated function
+    size_t _workspaceSize;
+    // whether or not to determine the functions from a cost model instead of the maximum number of assignments
+    bool _automaticFunctionSplitting;
+    // the cost model used to split the source code into functions
+    FunctionSplitCostModel _splitCost;
+    // the functions created by the last automatic function splitting
+    std::vector<FunctionChunk> _functionPartition;
 private:
     std::vector<std::string> funcArgDcl_;
     std::vector<std::string> localFuncArgDcl_;
@@ -142,7 +257,16 @@ public:
         _maxAssignmentsPerFunction(0),
         _maxOperationsPerAssignment((std::numeric_limits<size_t>::max)()),
         _sources(nullptr),
-        _parameterPrecision(std::numeric_limits<Base>::digits10) {
+        _parameterPrecision(std::numeric_limits<Base>::digits10),
+        _roundTripParameters(false),
+        _constantPool(false),
+        _loopVectorization(false),
+        _mathLowering(false),
+        _fma(FusedMultiplyAdd::Compiler),
+        _approximateMath(false),
+        _temporaryWorkspace(false),
+        _workspaceSize(0),
+        _automaticFunctionSplitting(false) {
     }
 
     inline virtual ~LanguageC() = default;
@@ -238,6 +362,264 @@ public:
         _parameterPrecision = p;
     }
 
+    /**
+     * Whether or not constant values are printed with the fewest digits
+     * which are converted back to exactly the same value.
+     *
+     * @return true if the parameter precision is determined for each value
+     */
+    inline bool isRoundTripParameters() const {
+        return _roundTripParameters;
+    }
+
+    /**
+     * Defines whether or not constant values are printed with the fewest
+     * digits which are converted back to exactly the same value (e.g. 0.1
+     * instead of 0.10000000000000001) instead of using the parameter
+     * precision.
+     * This is only available for float and double.
+     *
+     * @param roundTrip whether or not to print the shortest round-trip
+     *                  representation of constant values
+     */
+    inline void setRoundTripParameters(bool roundTrip) {
+        _roundTripParameters = roundTrip;
+    }
+
+    /**
+     * Whether or not the constant values used in expressions are saved in a
+     * static array (a constant pool) of each source file.
+     *
+     * @return true if a constant pool is used
+     */
+    inline bool isConstantPool() const {
+        return _constantPool;
+    }
+
+    /**
+     * Defines whether or not the constant values used in expressions are
+     * saved in a static array (a constant pool) declared at the beginning
+     * of each source file and referenced by index (e.g. cst[3]).
+     * Each distinct value is printed only once per source file, which
+     * reduces the source size and the parsing time when the same constants
+     * are used many times.
+     * Values whose literal is not longer than the array reference are still
+     * printed directly.
+     * When no function is created (see setGenerateFunction()), the
+     * constant pool must be declared by the caller using
+     * generateConstantPoolDeclaration().
+     *
+     * @param pool whether or not to use a constant pool
+     */
+    inline void setConstantPool(bool pool) {
+        _constantPool = pool;
+    }
+
+    /**
+     * Provides the literals in the constant pool of the last function
+     * generated (or of the code generated without a function).
+     *
+     * @return the constant values ordered by their index in the pool
+     */
+    inline const std::vector<std::string>& getConstantPool() const {
+        return _constantPoolValues;
+    }
+
+    /**
+     * Declares the static array with the constant pool of the last
+     * generated code.
+     *
+     * @return the declaration (an empty string if the pool is empty)
+     */
+    inline std::string generateConstantPoolDeclaration() const {
+        if (_constantPoolValues.empty())
+            return "";
+
+        std::string dcl = "static const " + _baseTypeName + " " + _C_CONSTANT_POOL + "[";
+        appendInteger(dcl, _constantPoolValues.size());
+        dcl += "] = {";
+        for (size_t i = 0; i < _constantPoolValues.size(); ++i) {
+            if (i > 0)
+                dcl += ",";
+            dcl += (i % 4 == 0) ? "\n   " : " ";
+            dcl += _constantPoolValues[i];
+        }
+        dcl += "\n};\n\n";
+
+        return dcl;
+    }
+
+    /**
+     * Whether or not vectorization hints are generated for loops created by
+     * the pattern detection.
+     *
+     * @return true if loops which can be vectorized are marked with
+     *         '#pragma omp simd'
+     */
+    inline bool isLoopVectorization() const {
+        return _loopVectorization;
+    }
+
+    /**
+     * Defines whether or not to generate vectorization hints for loops
+     * created by the pattern detection.
+     * Loops without conditions, atomic functions, reductions, and where
+     * each iteration writes to different dependent elements are marked with
+     * '#pragma omp simd' (requires -fopenmp-simd or -fopenmp), their
+     * temporary variables become local to each iteration, and operations
+     * which do not depend on the loop index are evaluated before the loop.
+     * The independent and dependent arrays are also declared with restrict
+     * and, therefore, they must never overlap.
+     *
+     * @param vectorize whether or not to generate vectorization hints
+     */
+    inline void setLoopVectorization(bool vectorize) {
+        _loopVectorization = vectorize;
+    }
+
+    /**
+     * Whether or not some mathematical functions are replaced by cheaper
+     * equivalent forms in the generated source code.
+     *
+     * @return true if the mathematical functions are lowered
+     */
+    inline bool isMathLowering() const {
+        return _mathLowering;
+    }
+
+    /**
+     * Defines whether or not to replace some mathematical functions by
+     * cheaper equivalent forms in the generated source code:
+     *  - pow(a, b) with a constant exponent b in {+-1, +-2, +-3, +-4} or
+     *    {+-0.5, +-1.5, +-2.5} becomes a product of a and/or sqrt(a);
+     *  - sin(x) and cos(x) saved in variables are evaluated by a single
+     *    sincos call (GCC/Clang builtin);
+     *  - cosh(x) is determined from exp(x) when it is still available in a
+     *    variable;
+     *  - pow(a, b) becomes exp(b * log(a)) when log(a) is still available
+     *    in a variable and a is known to be positive (e.g. a = cosh(x)).
+     * The bases of pow() are always saved in variables.
+     * Results can differ from the original functions in the last digits.
+     *
+     * @param lowering whether or not to lower mathematical functions
+     */
+    inline void setMathLowering(bool lowering) {
+        _mathLowering = lowering;
+    }
+
+    /**
+     * Provides how multiply-add operations are printed.
+     *
+     * @return the fused multiply-add mode
+     */
+    inline FusedMultiplyAdd getFusedMultiplyAdd() const {
+        return _fma;
+    }
+
+    /**
+     * Defines how multiply-add operations are printed.
+     * With FusedMultiplyAdd::Explicit and FusedMultiplyAdd::Deterministic,
+     * additions and subtractions with a multiplication evaluated in the same
+     * expression are printed using fma() (a single rounding).
+     * FusedMultiplyAdd::Deterministic also disables the contraction of any
+     * other operation by the compiler (using pragmas in the generated
+     * source files) so that results do not depend on the compiler flags.
+     * The generated code should be compiled with hardware support for FMA
+     * (e.g. -mfma or -march=native), otherwise fma() can be slow.
+     *
+     * @param fma the fused multiply-add mode
+     */
+    inline void setFusedMultiplyAdd(FusedMultiplyAdd fma) {
+        _fma = fma;
+    }
+
+    /**
+     * Whether or not exp(), log(), pow(), and tanh() are evaluated by
+     * approximate implementations defined in the generated source files.
+     *
+     * @return true if the approximate implementations are used
+     */
+    inline bool isApproximateMath() const {
+        return _approximateMath;
+    }
+
+    /**
+     * Defines whether or not exp(), log(), pow(), and tanh() are evaluated
+     * by approximate implementations (polynomials without branches) defined
+     * in the generated source files instead of the C math library.
+     * The maximum relative errors are:
+     *  - exp: 3.0e-13 (1400 ulp),
+     *  - log: 3.4e-14 (160 ulp),
+     *  - tanh: 8.5e-13 (3900 ulp),
+     *  - pow(a, b): 3.0e-13 + 3.5e-14 * |b * log(a)|.
+     * These implementations are only faster when the generated code is
+     * vectorized (e.g. loops compiled with -O3 for the target architecture);
+     * scalar code can be slower than with the C math library.
+     * The generated code must not be compiled with -ffast-math.
+     * The approximate implementations are only available for double since
+     * they rely on the IEEE 754 binary64 representation.
+     *
+     * @param approximate whether or not to use the approximate implementations
+     * @throws CGException if Base is not double
+     */
+    inline void setApproximateMath(bool approximate) {
+        if (approximate && !std::is_same<Base, double>::value)
+            throw CGException("Approximate math functions are only available for double");
+        _approximateMath = approximate;
+    }
+
+    /**
+     * Whether or not the temporary arrays are placed in a workspace provided
+     * by the caller instead of the stack.
+     *
+     * @return true if the temporary arrays are placed in the workspace
+     */
+    inline bool isTemporaryWorkspace() const {
+        return _temporaryWorkspace;
+    }
+
+    /**
+     * Defines whether or not the temporary arrays (temporary variables,
+     * arrays, and sparse arrays) are placed in a workspace provided by the
+     * caller instead of being declared in the stack of the generated function.
+     * The workspace is provided through the workspace field of the atomic
+     * function argument and it must be aligned to WORKSPACE_ALIGNMENT bytes.
+     * Each array starts at an offset which is also a multiple of
+     * WORKSPACE_ALIGNMENT.
+     *
+     * @param workspace whether or not to use a workspace provided by the caller
+     */
+    inline void setTemporaryWorkspace(bool workspace) {
+        _temporaryWorkspace = workspace;
+    }
+
+    /**
+     * Provides the number of bytes of the workspace used by the last function
+     * generated with a workspace for the temporary arrays.
+     *
+     * @return the workspace size in bytes (zero if the temporary arrays are
+     *         declared in the stack)
+     */
+    inline size_t getWorkspaceSize() const {
+        return _workspaceSize;
+    }
+
+    /**
+     * Provides the preprocessor directives and auxiliary functions which
+     * must be added to the source files with code created by this object
+     * (after the includes).
+     *
+     * @return the source code (possibly empty)
+     */
+    inline std::string generateFilePreamble() const {
+        std::string preamble;
+        if (_fma == FusedMultiplyAdd::Deterministic)
+            preamble += FP_CONTRACT_OFF_DEFINITION + "\n";
+        if (_approximateMath)
+            preamble += APPROXIMATE_MATH_DEFINITION + "\n";
+        return preamble;
+    }
+
     /**
      * Defines the maximum number of assignment per generated function.
      * Zero means it is disabled (no limit).
@@ -255,6 +637,60 @@ public:
         _sources = sources;
     }
 
+    inline bool isAutomaticFunctionSplitting() const {
+        return _automaticFunctionSplitting;
+    }
+
+    /**
+     * Defines whether or not the points where the source code is split into
+     * several functions are determined from a cost model
+     * (see setFunctionSplitCostModel()) instead of the maximum number of
+     * assignments per function.
+     * The split points balance the estimated compilation cost of each
+     * function (operations and live temporary variables) against the
+     * runtime cost of the function calls and of the temporary variables
+     * used across functions.
+     * It is only used when the sources map was provided to
+     * setMaxAssignmentsPerFunction() (the maximum number of assignments is
+     * ignored).
+     *
+     * @param automatic whether or not to use the cost model
+     */
+    inline void setAutomaticFunctionSplitting(bool automatic) {
+        _automaticFunctionSplitting = automatic;
+    }
+
+    inline const FunctionSplitCostModel& getFunctionSplitCostModel() const {
+        return _splitCost;
+    }
+
+    /**
+     * Defines the cost model used by the automatic function splitting.
+     */
+    inline void setFunctionSplitCostModel(const FunctionSplitCostModel& cost) {
+        _splitCost = cost;
+    }
+
+    /**
+     * Provides the functions chosen by the automatic function splitting
+     * for the last generated source code.
+     *
+     * @return the chunks of the evaluation order in each function (empty
+     *         if the automatic function splitting was not used)
+     */
+    inline const std::vector<FunctionChunk>& getFunctionPartition() const {
+        return _functionPartition;
+    }
+
+    /**
+     * Provides the name of the function to be created.
+     *
+     * @return the function name (empty if no function is created)
+     */
+    inline const std::string& getGenerateFunction() const {
+        return _functionName;
+    }
+
     /**
      * The maximum number of operations per variable assignment.
      *
@@ -318,13 +754,14 @@ public:
                              "There must be two temporary variables")
 
         _ss << _spaces << "// auxiliary variables\n";
+        _workspaceSize = 0;
         /**
          * temporary variables
          */
         if (tmpArg[0].array) {
             size_t size = _nameGen->getMaxTemporaryVariableID() + 1 - _nameGen->getMinTemporaryVariableID();
             if (size > 0 || isWrapperFunction) {
-                _ss << _spaces << _baseTypeName << " " << tmpArg[0].name << "[" << size << "];\n";
+                printTemporaryArrayDeclaration(_baseTypeName, tmpArg[0].name, sizeof(Base), size);
             }
         } else if (_temporary.size() > 0) {
             for (const std::pair<size_t, Node*>& p : _temporary) {
@@ -350,7 +787,7 @@ public:
          */
         size_t arraySize = _nameGen->getMaxTemporaryArrayVariableID();
         if (arraySize > 0 || isWrapperFunction) {
-            _ss << _spaces << _baseTypeName << " " << tmpArg[1].name << "[" << arraySize << "];\n";
+            printTemporaryArrayDeclaration(_baseTypeName, tmpArg[1].name, sizeof(Base), arraySize);
         }
 
         /**
@@ -358,8 +795,8 @@ public:
          */
         size_t sArraySize = _nameGen->getMaxTemporarySparseArrayVariableID();
         if (sArraySize > 0 || isWrapperFunction) {
-            _ss << _spaces << _baseTypeName << " " << tmpArg[2].name << "[" << sArraySize << "];\n";
-            _ss << _spaces << U_INDEX_TYPE << " " << _C_SPARSE_INDEX_ARRAY << "[" << sArraySize << "];\n";
+            printTemporaryArrayDeclaration(_baseTypeName, tmpArg[2].name, sizeof(Base), sArraySize);
+            printTemporaryArrayDeclaration(U_INDEX_TYPE, _C_SPARSE_INDEX_ARRAY, sizeof(unsigned long), sArraySize);
         }
 
         if (!isWrapperFunction) {
@@ -421,7 +858,7 @@ public:
 
         _ss << _spaces << "//dependent variables\n";
         for (size_t i = 0; i < depArg.size(); i++) {
-            _ss << _spaces << argumentDeclaration(depArg[i]) << " = " << _outArgName << "[" << i << "];\n";
+            _ss << _spaces << argumentDeclaration(depArg[i], _loopVectorization) << " = " << _outArgName << "[" << i << "];\n";
         }
 
         std::string code = _ss.str();
@@ -429,6 +866,31 @@ public:
         return code;
     }
 
+    /**
+     * Declares a temporary array either in the stack or in the workspace
+     * provided by the caller (see setTemporaryWorkspace()).
+     *
+     * @param typeName the element type name
+     * @param name the array name
+     * @param elementSize the number of bytes of each element
+     * @param size the number of elements
+     */
+    inline void printTemporaryArrayDeclaration(const std::string& typeName,
+                                               const std::string& name,
+                                               size_t elementSize,
+                                               size_t size) {
+        if (!_temporaryWorkspace) {
+            _ss << _spaces << typeName << " " << name << "[" << size << "];\n";
+            return;
+        }
+
+        _ss << _spaces << typeName << "* restrict " << name << " = (" << typeName << "*) "
+                "((char*) " << _atomicArgName << ".workspace + " << _workspaceSize << ");\n";
+
+        size_t bytes = size * elementSize;
+        _workspaceSize += (bytes + WORKSPACE_ALIGNMENT - 1) / WORKSPACE_ALIGNMENT * WORKSPACE_ALIGNMENT;
+    }
+
     virtual std::string generateIndependentVariableDeclaration() {
         const std::vector<FuncArgument>& indArg = _nameGen->getIndependent();
         CPPADCG_ASSERT_KNOWN(!indArg.empty(),
@@ -436,7 +898,7 @@ public:
 
         _ss << _spaces << "//independent variables\n";
         for (size_t i = 0; i < indArg.size(); i++) {
-            _ss << _spaces << "const " << argumentDeclaration(indArg[i]) << " = " << _inArgName << "[" << i << "];\n";
+            _ss << _spaces << "const " << argumentDeclaration(indArg[i], _loopVectorization) << " = " << _inArgName << "[" << i << "];\n";
         }
 
         std::string code = _ss.str();
@@ -515,6 +977,7 @@ public:
     CPPAD_CG_C_LANG_FUNCNAME(tanh)
     CPPAD_CG_C_LANG_FUNCNAME(tan)
     CPPAD_CG_C_LANG_FUNCNAME(pow)
+    CPPAD_CG_C_LANG_FUNCNAME(fma)
 
 #if CPPAD_USE_CPLUSPLUS_2011
     CPPAD_CG_C_LANG_FUNCNAME(erf)
@@ -526,6 +989,15 @@ public:
     CPPAD_CG_C_LANG_FUNCNAME(log1p)
 #endif
 
+    /**
+     * @return the function which determines both the sine and the cosine
+     *         (empty if not available)
+     */
+    inline virtual const std::string& sincosFuncName() {
+        static const std::string name; // empty string
+        return name;
+    }
+
     /**
      * Prints a function declaration where each argument is in a different line.
      *
@@ -605,6 +1077,39 @@ public:
                                               const std::string& name,
                                               const std::map<size_t, std::map<size_t, size_t> >& values);
 
+    /**
+     * Appends the decimal representation of an integer to a string
+     * (much faster than using a string stream).
+     */
+    static inline void appendInteger(std::string& out,
+                                     size_t value) {
+        char buffer[20];
+        char* end = buffer + sizeof(buffer);
+        char* begin = end;
+        do {
+            *--begin = char('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        out.append(begin, end);
+    }
+
+    /**
+     * Creates the name of an array element (e.g. "x[2]" or "&x[2]").
+     */
+    static inline std::string arrayElementName(const std::string& array,
+                                               size_t index,
+                                               bool address = false) {
+        std::string name;
+        name.reserve(array.size() + 24);
+        if (address)
+            name += '&';
+        name += array;
+        name += '[';
+        appendInteger(name, index);
+        name += ']';
+        return name;
+    }
+
     /***********************************************************************
      * index patterns
      **********************************************************************/
@@ -632,6 +1137,9 @@ public:
     static inline std::string linearIndexPattern2String(const LinearIndexPattern& lip,
                                                         const std::string& index);
 
+    static inline std::string affineNDIndexPattern2String(const AffineNDIndexPattern& aip,
+                                                          const std::string& index);
+
     static inline bool isOffsetBy(const IndexPattern* ip,
                                   const IndexPattern* refIp,
                                   long offset);
@@ -664,7 +1172,9 @@ protected:
                             std::unique_ptr<LanguageGenerationData<Base> > info) override {
 
         const bool createFunction = !_functionName.empty();
-        const bool multiFunction = createFunction && _maxAssignmentsPerFunction > 0 && _sources != nullptr;
+        const bool multiFunction = createFunction && _sources != nullptr &&
+                (_maxAssignmentsPerFunction > 0 || _automaticFunctionSplitting);
+        const bool automaticSplit = multiFunction && _automaticFunctionSplitting;
 
         // clean up
         _code.str("");
@@ -676,8 +1186,18 @@ protected:
         localFuncArgs_ = "";
         auxArrayName_ = "";
         _currentLoops.clear();
+        _vectorizableLoops.clear();
+        _hoistedLoopNodes.clear();
+        _loopLocalNodes.clear();
+        _sinCosPairs.clear();
+        _sinCosEvaluated.clear();
+        _loweredOps.clear();
+        _workspaceSize = 0;
+        _functionPartition.clear();
         _atomicFuncArrays.clear();
         _streamStack.clear();
+        _constantPoolValues.clear();
+        _constantPoolIndex.clear();
 
         // save some info
         _info = std::move(info);
@@ -781,7 +1301,7 @@ protected:
 
         // the names of local functions
         std::vector<std::string> localFuncNames;
-        if (multiFunction) {
+        if (multiFunction && !automaticSplit) {
             localFuncNames.reserve(variableOrder.size() / _maxAssignmentsPerFunction);
         }
 
@@ -804,6 +1324,19 @@ protected:
                 }
             }
 
+            if (_loopVectorization) {
+                findVectorizableLoops(variableOrder);
+            }
+
+            if (_mathLowering) {
+                findMathLowering(variableOrder);
+            }
+
+            if (automaticSplit) {
+                findFunctionPartition(variableOrder);
+                localFuncNames.reserve(_functionPartition.size());
+            }
+
             /**
              * Source code generation magic!
              */
@@ -823,17 +1356,30 @@ protected:
             }
 
             size_t assignCount = 0;
+            size_t nextChunk = 1; // the next function from the automatic function splitting
             for (size_t i = 0; i < variableOrder.size(); ++i) {
                 Node* it = variableOrder[i];
 
                 // check if a new function should start
-                if (assignCount >= _maxAssignmentsPerFunction && multiFunction && _currentLoops.empty()) {
+                if (automaticSplit) {
+                    if (nextChunk < _functionPartition.size() && i >= _functionPartition[nextChunk].begin &&
+                        assignCount > 0 && _currentLoops.empty()) {
+                        assignCount = 0;
+                        saveLocalFunction(localFuncNames, localFuncNames.empty() && _info->zeroDependents);
+                        while (nextChunk < _functionPartition.size() && i >= _functionPartition[nextChunk].begin)
+                            nextChunk++;
+                    }
+                } else if (assignCount >= _maxAssignmentsPerFunction && multiFunction && _currentLoops.empty()) {
                     assignCount = 0;
                     saveLocalFunction(localFuncNames, localFuncNames.empty() && _info->zeroDependents);
                 }
 
                 Node& node = *it;
 
+                if (!_hoistedLoopNodes.empty() && _hoistedLoopNodes.find(&node) != _hoistedLoopNodes.end()) {
+                    continue; // printed before the loop
+                }
+
                 // a dependent variable assigned by a loop does require any source code (its done inside the loop)
                 if (node.getOperationType() == CGOpCode::DependentRefRhs) {
                     continue; // nothing to do (this operation is right hand side only)
@@ -845,6 +1391,17 @@ protected:
                     continue;
                 }
 
+                if (!_sinCosPairs.empty()) {
+                    if (_sinCosEvaluated.find(&node) != _sinCosEvaluated.end()) {
+                        continue; // already evaluated by sincos
+                    }
+                    auto itSinCos = _sinCosPairs.find(&node);
+                    if (itSinCos != _sinCosPairs.end()) {
+                        assignCount += printSinCos(node, *itSinCos->second);
+                        continue;
+                    }
+                }
+
                 assignCount += printAssignment(node);
                 
                 CPPAD_ASSERT_KNOWN(_streamStack.empty(), "Error writing all operations to output stream")
@@ -928,7 +1485,9 @@ protected:
             if (localFuncNames.empty()) {
                 _ss << "#include <math.h>\n"
                         "#include <stdio.h>\n\n"
-                    << ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+                    << generateFilePreamble()
+                    << ATOMICFUN_STRUCT_DEFINITION << "\n\n"
+                    << generateConstantPoolDeclaration();
                 printFunctionDeclaration(_ss, "void", _functionName, funcArgDcl_);
                 _ss << " {\n";
                 _nameGen->customFunctionVariableDeclarations(_ss);
@@ -1014,7 +1573,7 @@ protected:
     inline virtual void pushAssignmentStart(Node& node,
                                             const std::string& varName,
                                             bool isDep) {
-        if (!isDep) {
+        if (!isDep && (_loopLocalNodes.empty() || _loopLocalNodes.find(&node) == _loopLocalNodes.end())) {
             _temporary[getVariableID(node)] = &node;
         }
 
@@ -1036,10 +1595,13 @@ protected:
         _streamStack << ";\n";
     }
 
-    virtual std::string argumentDeclaration(const FuncArgument& funcArg) const {
+    virtual std::string argumentDeclaration(const FuncArgument& funcArg,
+                                            bool restrictPointer = false) const {
         std::string dcl = _baseTypeName;
         if (funcArg.array) {
             dcl += "*";
+            if (restrictPointer)
+                dcl += " restrict";
         }
         return dcl + " " + funcArg.name;
     }
@@ -1052,7 +1614,9 @@ protected:
 
         _ss << "#include <math.h>\n"
                 "#include <stdio.h>\n\n"
-                << ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+                << generateFilePreamble()
+                << ATOMICFUN_STRUCT_DEFINITION << "\n\n"
+                << generateConstantPoolDeclaration();
         printFunctionDeclaration(_ss, "void", funcName, localFuncArgDcl_);
         _ss << " {\n";
         _nameGen->customFunctionVariableDeclarations(_ss);
@@ -1085,6 +1649,8 @@ protected:
 
         _code.str("");
         _ss.str("");
+        _constantPoolValues.clear();
+        _constantPoolIndex.clear();
     }
 
     bool createsNewVariable(const Node& var,
@@ -1163,7 +1729,8 @@ protected:
     }
 
     bool requiresVariableArgument(enum CGOpCode op, size_t argIndex) const override {
-        return op == CGOpCode::Sign || op == CGOpCode::CondResult || op == CGOpCode::Pri;
+        return op == CGOpCode::Sign || op == CGOpCode::CondResult || op == CGOpCode::Pri ||
+                (_mathLowering && op == CGOpCode::Pow && argIndex == 0); // the base can be used several times
     }
 
     inline const std::string& createVariableName(Node& var) {
@@ -1438,6 +2005,14 @@ protected:
     virtual void pushUnaryFunction(Node& op) {
         CPPADCG_ASSERT_KNOWN(op.getArguments().size() == 1, "Invalid number of arguments for unary function")
 
+        if (!_loweredOps.empty()) {
+            auto it = _loweredOps.find(&op);
+            if (it != _loweredOps.end()) {
+                pushLoweredFunction(op, it->second.first, it->second.second);
+                return;
+            }
+        }
+
         switch (op.getOperationType()) {
             case CGOpCode::Abs:
                 _streamStack << absFuncName();
@@ -1458,10 +2033,10 @@ protected:
                 _streamStack << cosFuncName();
                 break;
             case CGOpCode::Exp:
-                _streamStack << expFuncName();
+                _streamStack << (_approximateMath ? _C_APPROX_EXP : expFuncName());
                 break;
             case CGOpCode::Log:
-                _streamStack << logFuncName();
+                _streamStack << (_approximateMath ? _C_APPROX_LOG : logFuncName());
                 break;
             case CGOpCode::Sinh:
                 _streamStack << sinhFuncName();
@@ -1473,7 +2048,7 @@ protected:
                 _streamStack << sqrtFuncName();
                 break;
             case CGOpCode::Tanh:
-                _streamStack << tanhFuncName();
+                _streamStack << (_approximateMath ? _C_APPROX_TANH : tanhFuncName());
                 break;
             case CGOpCode::Tan:
                 _streamStack << tanFuncName();
@@ -1513,13 +2088,169 @@ protected:
     virtual void pushPowFunction(Node& op) {
         CPPADCG_ASSERT_KNOWN(op.getArguments().size() == 2, "Invalid number of arguments for pow() function")
 
-        _streamStack <<powFuncName() << "(";
+        if (_mathLowering) {
+            auto it = _loweredOps.find(&op);
+            if (it != _loweredOps.end()) {
+                pushLoweredFunction(op, it->second.first, it->second.second);
+                return;
+            }
+
+            int halves;
+            if (isPowLowerable(op, halves)) {
+                pushPowLowered(op, halves);
+                return;
+            }
+        }
+
+        _streamStack << (_approximateMath ? _C_APPROX_POW : powFuncName()) << "(";
         push(op.getArguments()[0]);
         _streamStack << ", ";
         push(op.getArguments()[1]);
         _streamStack << ")";
     }
 
+    /**
+     * Determines whether or not pow(a, b) can be replaced by a product of
+     * a and/or sqrt(a).
+     *
+     * @param op the pow operation
+     * @param halves the exponent multiplied by two
+     * @return true if the exponent is a constant in {+-1, +-2, +-3, +-4}
+     *         or {+-0.5, +-1.5, +-2.5} and the base is saved in a variable
+     */
+    inline bool isPowLowerable(const Node& op,
+                               int& halves) const {
+        const Arg& base = op.getArguments()[0];
+        const Arg& exponent = op.getArguments()[1];
+        if (base.getOperation() == nullptr || getVariableID(*base.getOperation()) == 0 ||
+            exponent.getParameter() == nullptr)
+            return false;
+
+        const Base& e = *exponent.getParameter();
+        if (!(std::abs(e) <= Base(4))) // also excludes NaN
+            return false;
+
+        halves = int(e * Base(2));
+        if (Base(halves) != e * Base(2) || halves == 0)
+            return false;
+
+        int h = std::abs(halves);
+        return h % 2 == 0 || h <= 5;
+    }
+
+    virtual void pushPowLowered(Node& op,
+                                int halves) {
+        const Arg& base = op.getArguments()[0];
+
+        bool negative = halves < 0;
+        int h = std::abs(halves);
+        int n = h / 2;
+        bool root = h % 2 != 0;
+        int factors = n + (root ? 1 : 0);
+
+        bool enclose = negative || factors > 1;
+        if (enclose) {
+            _streamStack << "(";
+        }
+        if (negative) {
+            pushParameter(Base(1));
+            _streamStack << " / ";
+            if (factors > 1)
+                _streamStack << "(";
+        }
+
+        for (int i = 0; i < n; ++i) {
+            if (i > 0)
+                _streamStack << " * ";
+            push(base);
+        }
+        if (root) {
+            if (n > 0)
+                _streamStack << " * ";
+            _streamStack << sqrtFuncName() << "(";
+            push(base);
+            _streamStack << ")";
+        }
+
+        if (negative && factors > 1) {
+            _streamStack << ")";
+        }
+        if (enclose) {
+            _streamStack << ")";
+        }
+    }
+
+    /**
+     * Prints an operation using the values of other operations with the same
+     * argument which are still available in variables.
+     *
+     * @param op the operation (cosh or pow)
+     * @param var1 exp(x) for cosh(x) and log(a) for pow(a, b)
+     * @param var2 not used
+     */
+    virtual void pushLoweredFunction(Node& op,
+                                     Node* var1,
+                                     Node* var2) {
+        switch (op.getOperationType()) {
+            case CGOpCode::Cosh: {
+                // cosh(x) = (exp(x) + 1 / exp(x)) / 2
+                const std::string& e = createVariableName(*var1);
+                _streamStack << "(";
+                pushParameter(Base(0.5));
+                _streamStack << " * (" << e << " + 1 / " << e << "))";
+                break;
+            }
+            case CGOpCode::Pow: {
+                // pow(a, b) = exp(b * log(a))
+                const Arg& exponent = op.getArguments()[1];
+                bool enclose = encloseInParenthesesMul(exponent.getOperation());
+                _streamStack << (_approximateMath ? _C_APPROX_EXP : expFuncName()) << "(";
+                if (enclose) {
+                    _streamStack << "(";
+                }
+                push(exponent);
+                if (enclose) {
+                    _streamStack << ")";
+                }
+                _streamStack << " * " << createVariableName(*var1) << ")";
+                break;
+            }
+            default:
+                throw CGException("Unable to lower the operation code '", op.getOperationType(), "'.");
+        }
+    }
+
+    /**
+     * Evaluates sin(x) and cos(x) with a single function call.
+     *
+     * @param first the first of the two operations in the evaluation order
+     * @param second the other operation (sin or cos)
+     * @return the number of assignments
+     */
+    virtual unsigned printSinCos(Node& first,
+                                 Node& second) {
+        bool sinFirst = first.getOperationType() == CGOpCode::Sin;
+        Node& sinOp = sinFirst ? first : second;
+        Node& cosOp = sinFirst ? second : first;
+
+        _temporary[getVariableID(sinOp)] = &sinOp;
+        _temporary[getVariableID(cosOp)] = &cosOp;
+
+        _streamStack << _indentation << sincosFuncName() << "(";
+        push(first.getArguments()[0]);
+        _streamStack << ", &" << createVariableName(sinOp) << ", &" << createVariableName(cosOp) << ");\n";
+
+        // print the operations in the argument
+        while (true) {
+            _streamStack.flush();
+            if (_streamStack.empty())
+                break;
+            pushExpressionNoVarCheck(_streamStack.startNewOperationNode());
+        }
+
+        return 1;
+    }
+
     virtual void pushSignFunction(Node& op) {
         CPPADCG_ASSERT_KNOWN(op.getArguments().size() == 1, "Invalid number of arguments for sign() function")
         CPPADCG_ASSERT_UNKNOWN(op.getArguments()[0].getOperation() != nullptr)
@@ -1550,6 +2281,10 @@ protected:
     virtual void pushOperationAdd(Node& op) {
         CPPADCG_ASSERT_KNOWN(op.getArguments().size() == 2, "Invalid number of arguments for addition")
 
+        if (_fma != FusedMultiplyAdd::Compiler && pushFusedMultiplyAdd(op)) {
+            return;
+        }
+
         const Arg& left = op.getArguments()[0];
         const Arg& right = op.getArguments()[1];
 
@@ -1568,6 +2303,10 @@ protected:
     virtual void pushOperationMinus(Node& op) {
         CPPADCG_ASSERT_KNOWN(op.getArguments().size() == 2, "Invalid number of arguments for subtraction")
 
+        if (_fma != FusedMultiplyAdd::Compiler && pushFusedMultiplyAdd(op)) {
+            return;
+        }
+
         const Arg& left = op.getArguments()[0];
         const Arg& right = op.getArguments()[1];
 
@@ -1591,6 +2330,77 @@ protected:
         }
     }
 
+    /**
+     * Prints an addition or a subtraction using fma() when one of its
+     * arguments is a multiplication evaluated in the same expression:
+     *  a * b + c -> fma(a, b, c)
+     *  a * b - c -> fma(a, b, -c)
+     *  c - a * b -> fma(-a, b, c)
+     *
+     * @param op the addition or subtraction
+     * @return true if fma() was used
+     */
+    virtual bool pushFusedMultiplyAdd(Node& op) {
+        const Arg& left = op.getArguments()[0];
+        const Arg& right = op.getArguments()[1];
+        bool add = op.getOperationType() == CGOpCode::Add;
+
+        bool mulLeft;
+        if (isFusableMultiplication(left)) {
+            mulLeft = true;
+        } else if (isFusableMultiplication(right)) {
+            mulLeft = false;
+        } else {
+            return false;
+        }
+
+        const Node& mul = *(mulLeft ? left : right).getOperation();
+        const Arg& a = mul.getArguments()[0];
+        const Arg& b = mul.getArguments()[1];
+        const Arg& c = mulLeft ? right : left;
+
+        _streamStack << fmaFuncName() << "(";
+        if (!add && !mulLeft) {
+            pushNegated(a);
+        } else {
+            push(a);
+        }
+        _streamStack << ", ";
+        push(b);
+        _streamStack << ", ";
+        if (!add && mulLeft) {
+            pushNegated(c);
+        } else {
+            push(c);
+        }
+        _streamStack << ")";
+
+        return true;
+    }
+
+    inline bool isFusableMultiplication(const Arg& arg) const {
+        const Node* node = arg.getOperation();
+        return node != nullptr &&
+                getVariableID(*node) == 0 &&
+                node->getOperationType() == CGOpCode::Mul;
+    }
+
+    virtual void pushNegated(const Arg& arg) {
+        if (arg.getParameter() != nullptr) {
+            pushParameter(-*arg.getParameter());
+        } else {
+            bool enclose = encloseInParenthesesMul(arg.getOperation());
+            _streamStack << "-";
+            if (enclose) {
+                _streamStack << "(";
+            }
+            push(arg);
+            if (enclose) {
+                _streamStack << ")";
+            }
+        }
+    }
+
     inline bool encloseInParenthesesDiv(const Node* node) const {
         while (node != nullptr) {
             if (getVariableID(*node) != 0)
@@ -1916,11 +2726,45 @@ protected:
             iterationCount = oss.str();
         }
 
+        const VectorizableLoop* vLoop = nullptr;
+        auto itv = _vectorizableLoops.find(&node);
+        if (itv != _vectorizableLoops.end()) {
+            vLoop = &itv->second;
+
+            if (!vLoop->invariants.empty()) {
+                _streamStack << _indentation << _baseTypeName << " " << implode(vLoop->invariantNames, ", ") << ";\n";
+                for (Node* inv : vLoop->invariants) {
+                    printAssignment(*inv);
+                }
+            }
+
+            /**
+             * Elements with random index patterns are read and written in
+             * the vectorized loop itself (no staging into contiguous
+             * buffers): the pragma forces the vectorization of indirect
+             * accesses (with gather/scatter instructions or by inserting
+             * scalar loads), which is what a separate staging loop would
+             * do, without the extra store and reload of every element and
+             * without a buffer with one element per iteration.
+             * Scatters are valid since each iteration writes different
+             * dependents (see isLoopDependentWriteUnique()).
+             */
+            _streamStack << "#pragma omp simd";
+            if (!vLoop->privateIndexes.empty()) {
+                _streamStack << " private(" << implode(vLoop->privateIndexes, ", ") << ")";
+            }
+            _streamStack << "\n";
+        }
+
         _streamStack << _spaces << "for("
                      << jj << " = 0; "
                      << jj << " < " << iterationCount << "; "
                      << jj << "++) {\n";
         _indentation += _spaces;
+
+        if (vLoop != nullptr && !vLoop->locals.empty()) {
+            _streamStack << _indentation << _baseTypeName << " " << implode(vLoop->locals, ", ") << ";\n";
+        }
     }
 
     virtual void pushLoopEnd(Node& node) {
@@ -1934,6 +2778,47 @@ protected:
     }
 
 
+    /**
+     * Determines which loops can be marked for vectorization, which
+     * operations can be evaluated before each loop, and renames the
+     * temporary variables used inside those loops.
+     *
+     * @param variableOrder the operations in their evaluation order
+     */
+    virtual void findVectorizableLoops(const std::vector<Node*>& variableOrder);
+
+    /**
+     * Determines which sin/cos operations are evaluated together and which
+     * operations can use other variables with the same argument
+     * (see setMathLowering()).
+     *
+     * @param variableOrder the operations in their evaluation order
+     */
+    virtual void findMathLowering(const std::vector<Node*>& variableOrder);
+
+    static bool isMathLoweringBarrier(CGOpCode op);
+
+    /**
+     * Whether or not the result of an operation is always positive.
+     */
+    static bool isPositive(const Node* node);
+
+    /**
+     * Determines where the source code is split into several functions
+     * using the cost model (see setAutomaticFunctionSplitting()).
+     *
+     * @param variableOrder the operations in their evaluation order
+     */
+    virtual void findFunctionPartition(const std::vector<Node*>& variableOrder);
+
+    virtual bool isLoopVariant(const Node& node,
+                               const std::map<const Node*, size_t>& position,
+                               std::map<const Node*, bool>& variant) const;
+
+    virtual bool isLoopDependentWriteUnique(const Node& loopStart,
+                                            const Node& dependent,
+                                            std::set<long>& written) const;
+
     virtual size_t printLoopIndexDeps(const std::vector<Node*>& variableOrder,
                                       size_t pos);
 
@@ -2084,20 +2969,67 @@ protected:
     }
 
     virtual void pushParameter(const Base& value) {
-        writeParameter(value, _streamStack);
+        if (!_constantPool) {
+            writeParameter(value, _streamStack);
+            return;
+        }
+
+        std::string literal;
+        StringAppender out{literal};
+        writeParameter(value, out);
+
+        auto it = _constantPoolIndex.find(literal);
+        size_t index = (it != _constantPoolIndex.end()) ? it->second : _constantPoolValues.size();
+
+        std::string ref = arrayElementName(_C_CONSTANT_POOL, index);
+        if (literal.size() <= ref.size()) {
+            _streamStack << std::move(literal); // short values are not worth it
+            return;
+        }
+
+        if (it == _constantPoolIndex.end()) {
+            _constantPoolIndex[literal] = index;
+            _constantPoolValues.push_back(std::move(literal));
+        }
+        _streamStack << std::move(ref);
     }
 
+    /**
+     * Appends text to a string using the stream operator
+     */
+    struct StringAppender {
+        std::string& str;
+
+        inline StringAppender& operator<<(const char* text) {
+            str += text;
+            return *this;
+        }
+
+        inline StringAppender& operator<<(char c) {
+            str += c;
+            return *this;
+        }
+    };
+
     template<class Output>
     void writeParameter(const Base& value, Output& output) {
         // make sure all digits of floating point values are printed
-        std::ostringstream os;
-        os << std::setprecision(_parameterPrecision) << value;
+        char buffer[64];
+        std::string number;
+        const char* str = buffer;
+        size_t n = formatParameter(value, buffer, sizeof(buffer));
+        if (n == 0) {
+            std::ostringstream os;
+            os << std::setprecision(_parameterPrecision) << value;
+            number = os.str();
+            str = number.c_str();
+            n = number.size();
+        }
 
-        std::string number = os.str();
-        output << number;
+        output << str;
 
         if (std::abs(value) > Base(0) && value != Base(1) && value != Base(-1)) {
-            if (number.find('.') == std::string::npos && number.find('e') == std::string::npos) {
+            if (std::find(str, str + n, '.') == str + n && std::find(str, str + n, 'e') == str + n) {
                 // also make sure there is always a '.' after the number in
                 // order to avoid integer overflows
                 output << '.';
@@ -2105,6 +3037,66 @@ protected:
         }
     }
 
+    /**
+     * Writes a constant value into a character buffer without the use of
+     * streams (which is considerably faster).
+     * Only specializations for floating point types write anything.
+     *
+     * @param value the constant value
+     * @param buffer the destination
+     * @param size the buffer size
+     * @return the number of characters written (zero if the value must be
+     *         written with a stream)
+     */
+    inline size_t formatParameter(const Base& value,
+                                  char* buffer,
+                                  size_t size) {
+        return 0;
+    }
+
+    /**
+     * Writes a floating point value using the same format as a stream with
+     * the parameter precision or, for round-trip parameters, with the fewest
+     * digits which are converted back to the same value.
+     */
+    template<class T>
+    inline size_t formatFloatingPoint(T value,
+                                      char* buffer,
+                                      size_t size) {
+        int precision = int(_parameterPrecision);
+        if (_roundTripParameters)
+            precision = std::numeric_limits<T>::digits10;
+
+        int n = std::snprintf(buffer, size, "%.*g", precision, double(value));
+
+        if (_roundTripParameters && value == value) {
+            // values with up to digits10 digits are always recovered
+            while (precision < std::numeric_limits<T>::max_digits10 &&
+                   parseFloatingPoint(buffer, value) != value) {
+                precision++;
+                n = std::snprintf(buffer, size, "%.*g", precision, double(value));
+            }
+        }
+
+        if (n <= 0 || size_t(n) >= size)
+            return 0; // use a stream
+        return size_t(n);
+    }
+
+    /**
+     * Reads a value in the same floating point type as the original value
+     * (converting a double to float could round it twice).
+     */
+    static inline float parseFloatingPoint(const char* str,
+                                           float) {
+        return std::strtof(str, nullptr);
+    }
+
+    static inline double parseFloatingPoint(const char* str,
+                                            double) {
+        return std::strtod(str, nullptr);
+    }
+
     virtual const std::string& getComparison(enum CGOpCode op) const {
         switch (op) {
             case CGOpCode::ComLt:
@@ -2199,6 +3191,9 @@ private:
 template<class Base>
 const std::string LanguageC<Base>::U_INDEX_TYPE = "unsigned long"; // NOLINT(cert-err58-cpp)
 
+template<class Base>
+const size_t LanguageC<Base>::WORKSPACE_ALIGNMENT = 64;
+
 template<class Base>
 const std::string LanguageC<Base>::_C_COMP_OP_LT = "<"; // NOLINT(cert-err58-cpp)
 template<class Base>
@@ -2218,6 +3213,9 @@ const std::string LanguageC<Base>::_C_STATIC_INDEX_ARRAY = "index"; // NOLINT(ce
 template<class Base>
 const std::string LanguageC<Base>::_C_SPARSE_INDEX_ARRAY = "idx"; // NOLINT(cert-err58-cpp)
 
+template<class Base>
+const std::string LanguageC<Base>::_C_CONSTANT_POOL = "cst"; // NOLINT(cert-err58-cpp)
+
 template<class Base>
 const std::string LanguageC<Base>::_ATOMIC_TX = "atx"; // NOLINT(cert-err58-cpp)
 
@@ -2230,6 +3228,28 @@ const std::string LanguageC<Base>::_ATOMIC_PX = "apx"; // NOLINT(cert-err58-cpp)
 template<class Base>
 const std::string LanguageC<Base>::_ATOMIC_PY = "apy"; // NOLINT(cert-err58-cpp)
 
+template<class Base>
+const std::string LanguageC<Base>::_C_APPROX_EXP = "cppadcg_exp_approx"; // NOLINT(cert-err58-cpp)
+
+template<class Base>
+const std::string LanguageC<Base>::_C_APPROX_LOG = "cppadcg_log_approx"; // NOLINT(cert-err58-cpp)
+
+template<class Base>
+const std::string LanguageC<Base>::_C_APPROX_POW = "cppadcg_pow_approx"; // NOLINT(cert-err58-cpp)
+
+template<class Base>
+const std::string LanguageC<Base>::_C_APPROX_TANH = "cppadcg_tanh_approx"; // NOLINT(cert-err58-cpp)
+
+template<class Base>
+const std::string LanguageC<Base>::FP_CONTRACT_OFF_DEFINITION = // NOLINT(cert-err58-cpp)
+"#ifdef __clang__\n"
+"#pragma STDC FP_CONTRACT OFF\n"
+"#elif defined(__GNUC__)\n"
+"#pragma GCC optimize (\"fp-contract=off\")\n"
+"#else\n"
+"#pragma STDC FP_CONTRACT OFF\n"
+"#endif\n";
+
 template<class Base>
 const std::string LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION = // NOLINT(cert-err58-cpp)
 "typedef struct Array {\n"
@@ -2254,6 +3274,7 @@ const std::string LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION = // NOLINT(cert-
 "                   const Array tx[],\n"
 "                   Array* px,\n"
 "                   const Array py[]);\n"
+"    void* workspace;\n"
 "};";
 
 } // END cg namespace
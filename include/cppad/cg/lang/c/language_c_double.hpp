@@ -35,6 +35,19 @@ inline const std::string& LanguageC<double>::getPrintfBaseFormat() {
     return format;
 }
 
+template<>
+inline const std::string& LanguageC<double>::sincosFuncName() {
+    static const std::string name("__builtin_sincos"); // GCC and Clang
+    return name;
+}
+
+template<>
+inline size_t LanguageC<double>::formatParameter(const double& value,
+                                                 char* buffer,
+                                                 size_t size) {
+    return formatFloatingPoint(value, buffer, size);
+}
+
 } // END cg namespace
 } // END CppAD namespace
 
@@ -101,6 +101,12 @@ inline const std::string& LanguageC<float>::tanFuncName() {
     return name;
 }
 
+template<>
+inline const std::string& LanguageC<float>::fmaFuncName() {
+    static const std::string name("fmaf"); // C99
+    return name;
+}
+
 #if CPPAD_USE_CPLUSPLUS_2011
 template<>
 inline const std::string& LanguageC<float>::erfFuncName() {
@@ -146,6 +152,19 @@ inline const std::string& LanguageC<float>::getPrintfBaseFormat() {
     return format;
 }
 
+template<>
+inline const std::string& LanguageC<float>::sincosFuncName() {
+    static const std::string name("__builtin_sincosf"); // GCC and Clang
+    return name;
+}
+
+template<>
+inline size_t LanguageC<float>::formatParameter(const float& value,
+                                                char* buffer,
+                                                size_t size) {
+    return formatFloatingPoint(value, buffer, size);
+}
+
 } // END cg namespace
 } // END CppAD namespace
 
@@ -253,6 +253,12 @@ inline std::string LanguageC<Base>::indexPattern2String(const IndexPattern& ip,
 
             return indexExpr;
         }
+        case IndexPatternType::AffineND: // y = b + sum_k ((x / stride_k) % extent_k) * dy_k
+        {
+            CPPADCG_ASSERT_KNOWN(indexes.size() == 1, "Invalid number of indexes")
+            const auto& aip = static_cast<const AffineNDIndexPattern&> (ip);
+            return affineNDIndexPattern2String(aip, *indexes[0]);
+        }
         case IndexPatternType::Random1D:
         {
             CPPADCG_ASSERT_KNOWN(indexes.size() == 1, "Invalid number of indexes")
@@ -315,6 +321,63 @@ inline std::string LanguageC<Base>::linearIndexPattern2String(const LinearIndexP
     return ss.str();
 }
 
+template<class Base>
+inline std::string LanguageC<Base>::affineNDIndexPattern2String(const AffineNDIndexPattern& aip,
+                                                                const std::string& index) {
+    long dx = aip.getStrideDx();
+    long xOffset = aip.getXOffset();
+    const std::vector<size_t>& strides = aip.getStrides();
+    const std::vector<size_t>& extents = aip.getExtents();
+    const std::vector<long>& dy = aip.getSlopes();
+    long b = aip.getConstantTerm();
+
+    // the position in the grid
+    std::string i = index;
+    if (xOffset != 0) {
+        i = "(" + i + " - " + std::to_string(xOffset) + ")";
+    }
+    if (dx != 1) {
+        i = "(" + i + " / " + std::to_string(dx) + ")";
+    }
+
+    std::stringstream ss;
+    bool first = true;
+    for (size_t k = 0; k < strides.size(); ++k) {
+        if (dy[k] == 0)
+            continue;
+
+        if (!first)
+            ss << " + ";
+        first = false;
+
+        bool parens = strides[k] != 1 || extents[k] != 0;
+        if (parens && dy[k] != 1) ss << "(";
+
+        if (strides[k] != 1 && extents[k] != 0) {
+            ss << "(" << i << " / " << strides[k] << ") % " << extents[k];
+        } else if (strides[k] != 1) {
+            ss << i << " / " << strides[k];
+        } else if (extents[k] != 0) {
+            ss << i << " % " << extents[k];
+        } else {
+            ss << i;
+        }
+
+        if (parens && dy[k] != 1) ss << ")";
+        if (dy[k] != 1) ss << " * " << dy[k];
+    }
+
+    if (b != 0) {
+        if (!first)
+            ss << " + ";
+        ss << b;
+    } else if (first) {
+        ss << "0"; // when all dy == 0 and b == 0
+    }
+
+    return ss.str();
+}
+
 template<class Base>
 bool LanguageC<Base>::isOffsetBy(const IndexPattern* ip,
                                  const IndexPattern* refIp,
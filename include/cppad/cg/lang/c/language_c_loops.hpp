@@ -172,8 +172,278 @@ inline size_t LanguageC<Base>::printLoopIndexedDepsUsingLoop(const std::vector<O
     return i - 1;
 }
 
+template<class Base>
+void LanguageC<Base>::findVectorizableLoops(const std::vector<Node*>& variableOrder) {
+    const size_t none = (std::numeric_limits<size_t>::max)();
+
+    /**
+     * find the loops which do not contain other loops
+     */
+    std::vector<std::pair<size_t, size_t> > loops; // positions of LoopStart and LoopEnd
+    size_t depth = 0;
+    size_t start = 0;
+    bool nested = false;
+    for (size_t i = 0; i < variableOrder.size(); ++i) {
+        CGOpCode op = variableOrder[i]->getOperationType();
+        if (op == CGOpCode::LoopStart) {
+            if (depth == 0) {
+                start = i;
+                nested = false;
+            } else {
+                nested = true;
+            }
+            depth++;
+        } else if (op == CGOpCode::LoopEnd) {
+            CPPADCG_ASSERT_UNKNOWN(depth > 0)
+            depth--;
+            if (depth == 0 && !nested) {
+                loops.emplace_back(start, i);
+            }
+        }
+    }
+
+    if (loops.empty())
+        return;
+
+    std::map<const Node*, size_t> position;
+    for (size_t i = 0; i < variableOrder.size(); ++i)
+        position[variableOrder[i]] = i;
+
+    std::vector<VectorizableLoop> info(loops.size());
+    std::vector<std::vector<Node*> > temporaries(loops.size());
+    std::vector<bool> valid(loops.size(), true);
+    std::map<const Node*, size_t> temp2Loop;
+    std::map<const Node*, bool> variant;
+
+    /**
+     * check the operations inside each loop
+     */
+    for (size_t l = 0; l < loops.size(); ++l) {
+        const Node& loopStart = *variableOrder[loops[l].first];
+        if (static_cast<const LoopStartOperationNode<Base>&> (loopStart).getIterationCountNode() != nullptr) {
+            valid[l] = false; // the dependent elements assigned by the loop are unknown
+            continue;
+        }
+
+        VectorizableLoop& vLoop = info[l];
+        std::set<long> written;
+
+        for (size_t i = loops[l].first + 1; i < loops[l].second && valid[l]; ++i) {
+            Node& node = *variableOrder[i];
+
+            switch (node.getOperationType()) {
+                case CGOpCode::IndexDeclaration:
+                    break;
+                case CGOpCode::IndexAssign: {
+                    const std::string& index = *static_cast<IndexAssignOperationNode<Base>&> (node).getIndex().getName();
+                    if (std::find(vLoop.privateIndexes.begin(), vLoop.privateIndexes.end(), index) == vLoop.privateIndexes.end())
+                        vLoop.privateIndexes.push_back(index);
+                    break;
+                }
+                case CGOpCode::LoopIndexedDep:
+                    valid[l] = isLoopDependentWriteUnique(loopStart, node, written);
+                    break;
+                case CGOpCode::ArrayCreation:
+                case CGOpCode::SparseArrayCreation:
+                case CGOpCode::ArrayElement:
+                case CGOpCode::AtomicForward:
+                case CGOpCode::AtomicReverse:
+                case CGOpCode::StartIf:
+                case CGOpCode::ElseIf:
+                case CGOpCode::Else:
+                case CGOpCode::EndIf:
+                case CGOpCode::CondResult:
+                case CGOpCode::LoopIndexedTmp:
+                case CGOpCode::Tmp:
+                case CGOpCode::TmpDcl:
+                case CGOpCode::DependentMultiAssign:
+                case CGOpCode::DependentRefRhs:
+                case CGOpCode::Pri:
+                    valid[l] = false;
+                    break;
+                default:
+                    if (isDependent(node)) {
+                        valid[l] = false; // the same element would be assigned in every iteration
+                        break;
+                    }
+
+                    bool v = false;
+                    for (const Arg& a : node.getArguments()) {
+                        if (a.getOperation() != nullptr && isLoopVariant(*a.getOperation(), position, variant)) {
+                            v = true;
+                            break;
+                        }
+                    }
+                    variant[&node] = v;
+                    temp2Loop[&node] = l;
+                    temporaries[l].push_back(&node);
+                    if (!v) {
+                        vLoop.invariants.push_back(&node);
+                    }
+            }
+        }
+    }
+
+    /**
+     * the temporary variables created inside a loop cannot be used outside
+     * of that loop
+     */
+    std::set<const Node*> visited;
+    std::vector<const Node*> stack;
+    size_t l = 0;
+    for (size_t i = 0; i < variableOrder.size(); ++i) {
+        while (l < loops.size() && i > loops[l].second)
+            l++;
+        size_t region = (l < loops.size() && i > loops[l].first && i < loops[l].second) ? l : none;
+
+        CGOpCode op = variableOrder[i]->getOperationType();
+        if (op == CGOpCode::LoopStart || op == CGOpCode::LoopEnd)
+            continue;
+
+        stack.push_back(variableOrder[i]);
+        while (!stack.empty()) {
+            const Node* node = stack.back();
+            stack.pop_back();
+
+            for (const Arg& a : node->getArguments()) {
+                const Node* arg = a.getOperation();
+                if (arg == nullptr)
+                    continue;
+
+                auto itt = temp2Loop.find(arg);
+                if (itt != temp2Loop.end()) {
+                    if (itt->second != region)
+                        valid[itt->second] = false;
+                } else if (position.find(arg) == position.end() && visited.insert(arg).second) {
+                    stack.push_back(arg); // printed where it is used
+                }
+            }
+        }
+    }
+
+    /**
+     * temporary variables of the loops become local variables
+     */
+    const std::string& tmpName = _nameGen->getTemporary()[0].name;
+    size_t nInvariants = 0;
+
+    for (l = 0; l < loops.size(); ++l) {
+        if (!valid[l])
+            continue;
+
+        VectorizableLoop& vLoop = info[l];
+        std::set<const Node*> invariants(vLoop.invariants.begin(), vLoop.invariants.end());
+        std::set<std::string> locals;
+
+        for (Node* node : temporaries[l]) {
+            _loopLocalNodes.insert(node);
+
+            if (invariants.find(node) != invariants.end()) {
+                node->setName(tmpName + "_h" + std::to_string(nInvariants++));
+                vLoop.invariantNames.push_back(*node->getName());
+                _hoistedLoopNodes.insert(node);
+            } else {
+                // variables with the same ID are never used at the same time
+                node->setName(tmpName + "_" + std::to_string(getVariableID(*node)));
+                if (locals.insert(*node->getName()).second)
+                    vLoop.locals.push_back(*node->getName());
+            }
+        }
+
+        _vectorizableLoops[variableOrder[loops[l].first]] = std::move(vLoop);
+    }
+}
+
+template<class Base>
+bool LanguageC<Base>::isLoopVariant(const Node& node,
+                                    const std::map<const Node*, size_t>& position,
+                                    std::map<const Node*, bool>& variant) const {
+    switch (node.getOperationType()) {
+        case CGOpCode::Inv:
+            return false;
+        case CGOpCode::LoopIndexedIndep:
+        case CGOpCode::LoopIndexedDep:
+        case CGOpCode::LoopIndexedTmp:
+        case CGOpCode::LoopStart:
+        case CGOpCode::Index:
+        case CGOpCode::IndexAssign:
+        case CGOpCode::IndexDeclaration:
+        case CGOpCode::Tmp:
+        case CGOpCode::TmpDcl:
+            return true;
+        default:
+            break;
+    }
+
+    auto itv = variant.find(&node);
+    if (itv != variant.end())
+        return itv->second;
+
+    if (position.find(&node) != position.end()) {
+        return false; // a variable created before the loop
+    }
+
+    // an operation printed where it is used
+    bool v = false;
+    for (const Arg& a : node.getArguments()) {
+        if (a.getOperation() != nullptr && isLoopVariant(*a.getOperation(), position, variant)) {
+            v = true;
+            break;
+        }
+    }
+    variant[&node] = v;
+    return v;
+}
+
+template<class Base>
+bool LanguageC<Base>::isLoopDependentWriteUnique(const Node& loopStart,
+                                                 const Node& dependent,
+                                                 std::set<long>& written) const {
+    const std::vector<Arg>& args = dependent.getArguments();
+    if (args.size() != 2 || args[1].getOperation() == nullptr || args[1].getOperation()->getOperationType() != CGOpCode::Index)
+        return false;
+
+    const auto& index = static_cast<const IndexOperationNode<Base>&> (*args[1].getOperation());
+    if (&index.getIndexCreationNode() != &loopStart)
+        return false; // the index is not the loop iteration
+
+    size_t iterations = static_cast<const LoopStartOperationNode<Base>&> (loopStart).getIterationCount();
+    const IndexPattern* ip = _info->loopDependentIndexPatterns[dependent.getInfo()[0]];
+
+    if (ip->getType() == IndexPatternType::Linear) {
+        const auto* lip = static_cast<const LinearIndexPattern*> (ip);
+        if (lip->getLinearSlopeDy() == 0 || lip->getLinearSlopeDx() != 1)
+            return false;
+
+        for (size_t it = 0; it < iterations; ++it) {
+            if (!written.insert(lip->evaluate(long(it))).second)
+                return false;
+        }
+
+    } else if (ip->getType() == IndexPatternType::AffineND) {
+        const auto* aip = static_cast<const AffineNDIndexPattern*> (ip);
+        for (size_t it = 0; it < iterations; ++it) {
+            if (!written.insert(aip->evaluate(long(it))).second)
+                return false;
+        }
+
+    } else if (ip->getType() == IndexPatternType::Random1D) {
+        const std::map<size_t, size_t>& values = static_cast<const Random1DIndexPattern*> (ip)->getValues();
+        for (size_t it = 0; it < iterations; ++it) {
+            auto itv = values.find(it);
+            if (itv == values.end() || !written.insert(long(itv->second)).second)
+                return false;
+        }
+
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
 
 } // END cg namespace
 } // END CppAD namespace
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,336 @@
+#ifndef CPPAD_CG_LANGUAGE_C_MATH_INCLUDED
+#define CPPAD_CG_LANGUAGE_C_MATH_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+template<class Base>
+void LanguageC<Base>::findMathLowering(const std::vector<Node*>& variableOrder) {
+    const size_t n = variableOrder.size();
+
+    /**
+     * where the temporary variables are assigned and where they are used
+     * for the last time
+     */
+    std::map<const Node*, size_t> assigned;
+    std::map<const Node*, size_t> lastUse;
+    std::map<std::string, std::vector<size_t> > nameAssigned;
+    // the number of barrier operations (loops, conditions, ...) before each position
+    std::vector<size_t> barriers(n + 1, 0);
+    // the unary functions saved in variables for each argument
+    std::map<const Node*, std::vector<Node*> > sameArg;
+
+    std::vector<Node*> stack;
+
+    for (size_t i = 0; i < n; ++i) {
+        Node* node = variableOrder[i];
+        CGOpCode op = node->getOperationType();
+
+        barriers[i + 1] = barriers[i] + (isMathLoweringBarrier(op) ? 1 : 0);
+
+        // the variables used by the expression printed at this position
+        stack.push_back(node);
+        while (!stack.empty()) {
+            Node* o = stack.back();
+            stack.pop_back();
+            for (const Arg& a : o->getArguments()) {
+                Node* aNode = a.getOperation();
+                if (aNode == nullptr)
+                    continue;
+                if (getVariableID(*aNode) > 0)
+                    lastUse[aNode] = i;
+                else
+                    stack.push_back(aNode);
+            }
+        }
+
+        if (isMathLoweringBarrier(op) || op == CGOpCode::ArrayCreation || op == CGOpCode::SparseArrayCreation ||
+            getVariableID(*node) == 0 || isDependent(*node)) {
+            continue;
+        }
+
+        assigned[node] = i;
+        nameAssigned[createVariableName(*node)].push_back(i);
+
+        if ((op == CGOpCode::Sin || op == CGOpCode::Cos || op == CGOpCode::Exp || op == CGOpCode::Log) &&
+            node->getArguments()[0].getOperation() != nullptr) {
+            sameArg[node->getArguments()[0].getOperation()].push_back(node);
+        }
+    }
+
+    if (sameArg.empty())
+        return;
+
+    /**
+     * an operation is available at a position if it is assigned before
+     * and still used afterwards (its variable is not reused in between)
+     */
+    auto available = [&](CGOpCode op, const Node* x, size_t pos) -> Node* {
+        auto it = sameArg.find(x);
+        if (it == sameArg.end())
+            return nullptr;
+        for (Node* o : it->second) {
+            if (o->getOperationType() != op)
+                continue;
+            size_t a = assigned[o];
+            auto itUse = lastUse.find(o);
+            if (a < pos && itUse != lastUse.end() && itUse->second >= pos && barriers[a + 1] == barriers[pos])
+                return o;
+        }
+        return nullptr;
+    };
+
+    /**
+     * cosh and pow determined from other variables
+     */
+    for (size_t i = 0; i < n; ++i) {
+        Node* node = variableOrder[i];
+        if (isMathLoweringBarrier(node->getOperationType()) ||
+            _hoistedLoopNodes.find(node) != _hoistedLoopNodes.end()) {
+            continue; // printed elsewhere
+        }
+
+        // the operations printed at this position
+        stack.push_back(node);
+        while (!stack.empty()) {
+            Node* o = stack.back();
+            stack.pop_back();
+
+            const std::vector<Arg>& args = o->getArguments();
+            CGOpCode op = o->getOperationType();
+            if (op == CGOpCode::Cosh) {
+                /**
+                 * sqrt(1 + sinh(x)^2) and sinh(x) / cosh(x) are not used
+                 * since sinh(x)^2 overflows for |x| > ~355
+                 */
+                Node* v = available(CGOpCode::Exp, args[0].getOperation(), i);
+                if (v != nullptr)
+                    _loweredOps[o] = std::make_pair(v, nullptr);
+
+            } else if (op == CGOpCode::Pow) {
+                int halves;
+                if (!isPowLowerable(*o, halves) && isPositive(args[0].getOperation())) {
+                    Node* l = available(CGOpCode::Log, args[0].getOperation(), i);
+                    if (l != nullptr)
+                        _loweredOps[o] = std::make_pair(l, nullptr);
+                }
+            }
+
+            for (const Arg& a : args) {
+                if (a.getOperation() != nullptr && getVariableID(*a.getOperation()) == 0)
+                    stack.push_back(a.getOperation());
+            }
+        }
+    }
+
+    /**
+     * sin(x) and cos(x) evaluated together where the first one is assigned
+     */
+    if (sincosFuncName().empty())
+        return;
+
+    for (const auto& it : sameArg) {
+        Node* s = nullptr;
+        Node* c = nullptr;
+        for (Node* o : it.second) {
+            if (o->getOperationType() == CGOpCode::Sin && s == nullptr)
+                s = o;
+            else if (o->getOperationType() == CGOpCode::Cos && c == nullptr)
+                c = o;
+        }
+        if (s == nullptr || c == nullptr ||
+            _hoistedLoopNodes.find(s) != _hoistedLoopNodes.end() || _loopLocalNodes.find(s) != _loopLocalNodes.end() ||
+            _hoistedLoopNodes.find(c) != _hoistedLoopNodes.end() || _loopLocalNodes.find(c) != _loopLocalNodes.end()) {
+            continue;
+        }
+
+        bool sinFirst = assigned[s] < assigned[c];
+        Node* first = sinFirst ? s : c;
+        Node* second = sinFirst ? c : s;
+        size_t p1 = assigned[first];
+        size_t p2 = assigned[second];
+
+        if (barriers[p1 + 1] != barriers[p2])
+            continue;
+
+        /**
+         * the variable of the second operation is assigned earlier and,
+         * therefore, it cannot be used by any other operation in between
+         */
+        const std::string& name = *second->getName();
+        if (name == *first->getName())
+            continue; // the first one is no longer used
+
+        const std::vector<size_t>& positions = nameAssigned[name];
+        auto itPos = std::upper_bound(positions.begin(), positions.end(), p1);
+        if (itPos != positions.end() && *itPos < p2)
+            continue; // reused in between
+
+        itPos = std::lower_bound(positions.begin(), positions.end(), p1);
+        if (itPos != positions.begin()) {
+            auto itUse = lastUse.find(variableOrder[*(itPos - 1)]);
+            if (itUse != lastUse.end() && itUse->second > p1)
+                continue; // still used by the previous variable with the same name
+        }
+
+        _sinCosPairs[first] = second;
+        _sinCosEvaluated.insert(second);
+    }
+}
+
+template<class Base>
+bool LanguageC<Base>::isPositive(const Node* node) {
+    if (node == nullptr)
+        return false;
+
+    switch (node->getOperationType()) {
+        case CGOpCode::Cosh: // cosh(x) >= 1 (exp(x) can underflow to 0)
+            return true;
+        case CGOpCode::Alias:
+            return isPositive(node->getArguments()[0].getOperation());
+        default:
+            return false;
+    }
+}
+
+template<class Base>
+bool LanguageC<Base>::isMathLoweringBarrier(CGOpCode op) {
+    switch (op) {
+        case CGOpCode::AtomicForward:
+        case CGOpCode::AtomicReverse:
+        case CGOpCode::CondResult:
+        case CGOpCode::DependentMultiAssign:
+        case CGOpCode::DependentRefRhs:
+        case CGOpCode::Else:
+        case CGOpCode::ElseIf:
+        case CGOpCode::EndIf:
+        case CGOpCode::Index:
+        case CGOpCode::IndexAssign:
+        case CGOpCode::IndexDeclaration:
+        case CGOpCode::LoopEnd:
+        case CGOpCode::LoopIndexedDep:
+        case CGOpCode::LoopIndexedTmp:
+        case CGOpCode::LoopStart:
+        case CGOpCode::Pri:
+        case CGOpCode::StartIf:
+        case CGOpCode::Tmp:
+        case CGOpCode::TmpDcl:
+        case CGOpCode::UserCustom:
+            return true;
+        default:
+            return false;
+    }
+}
+
+template<class Base>
+const std::string LanguageC<Base>::APPROXIMATE_MATH_DEFINITION = // NOLINT(cert-err58-cpp)
+"/*\n"
+" * Approximate mathematical functions (double precision, no branches so\n"
+" * that loops can be vectorized). Maximum relative errors:\n"
+" *  - exp:  3.0e-13 (1400 ulp)\n"
+" *  - log:  3.4e-14 (160 ulp)\n"
+" *  - tanh: 8.5e-13 (3900 ulp)\n"
+" *  - pow:  3.0e-13 + 3.5e-14 * |b * log(a)|\n"
+" * Results of exp below 2.2e-308 (subnormal) have a reduced precision.\n"
+" * Must not be compiled with -ffast-math (-fassociative-math).\n"
+" */\n"
+"typedef union {\n"
+"    double d;\n"
+"    unsigned long long u;\n"
+"} cppadcg_approx_bits;\n"
+"\n"
+"/* rounds to the nearest integer (|x| < 2^51) */\n"
+"static inline double cppadcg_approx_round(double x) {\n"
+"    return (x + 6755399441055744.0) - 6755399441055744.0;\n"
+"}\n"
+"\n"
+"/* 2^k for an integer k in [-1022, 1023] */\n"
+"static inline double cppadcg_approx_pow2(double k) {\n"
+"    cppadcg_approx_bits t;\n"
+"    t.d = k + 6755399441055744.0;\n"
+"    t.u = (t.u + 1023) << 52;\n"
+"    return t.d;\n"
+"}\n"
+"\n"
+"/* expm1(r) for |r| <= log(2)/2 */\n"
+"static inline double cppadcg_approx_expm1_r(double r) {\n"
+"    return r * (1.0 + r * (1.0 / 2 + r * (1.0 / 6 + r * (1.0 / 24 + r * (1.0 / 120 + r * (1.0 / 720 +\n"
+"           r * (1.0 / 5040 + r * (1.0 / 40320 + r * (1.0 / 362880 + r * (1.0 / 3628800))))))))));\n"
+"}\n"
+"\n"
+"/* x - k * log(2) */\n"
+"static inline double cppadcg_approx_reduce(double x, double k) {\n"
+"    return (x - k * 6.93147180369123816490e-01) - k * 1.90821492927058770002e-10;\n"
+"}\n"
+"\n"
+"static inline double cppadcg_exp_approx(double x) {\n"
+"    double xc = x > 710.0 ? 710.0 : (x < -746.0 ? -746.0 : x);\n"
+"    double k = cppadcg_approx_round(xc * 1.4426950408889634);\n"
+"    double k1 = cppadcg_approx_round(0.5 * k);\n"
+"    double r = cppadcg_approx_reduce(xc, k);\n"
+"    double y = cppadcg_approx_pow2(k1) * (1.0 + cppadcg_approx_expm1_r(r)) * cppadcg_approx_pow2(k - k1);\n"
+"    return x != x ? x : y;\n"
+"}\n"
+"\n"
+"static inline double cppadcg_log_approx(double x) {\n"
+"    cppadcg_approx_bits b, e;\n"
+"    double subnormal = x < 2.2250738585072014e-308 ? 54.0 : 0.0;\n"
+"    double k, m, s, z, y;\n"
+"    b.d = subnormal != 0.0 ? x * 18014398509481984.0 : x;\n"
+"    e.u = (b.u >> 52) | 0x4330000000000000ULL;\n"
+"    k = e.d - 4503599627371519.0 - subnormal;\n"
+"    b.u = (b.u & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL;\n"
+"    m = b.d > 1.4142135623730951 ? 0.5 * b.d : b.d;\n"
+"    k = b.d > 1.4142135623730951 ? k + 1.0 : k;\n"
+"    /* log(m) = 2 atanh(s) */\n"
+"    s = (m - 1.0) / (m + 1.0);\n"
+"    z = s * s;\n"
+"    y = 2.0 * s + 2.0 * s * z * (1.0 / 3 + z * (1.0 / 5 + z * (1.0 / 7 + z * (1.0 / 9 + z * (1.0 / 11 +\n"
+"        z * (1.0 / 13 + z * (1.0 / 15)))))));\n"
+"    y = k * 6.93147180369123816490e-01 + (y + k * 1.90821492927058770002e-10);\n"
+"    y = x < 0.0 ? NAN : y;\n"
+"    y = x == 0.0 ? -HUGE_VAL : y;\n"
+"    return x < HUGE_VAL ? y : x;\n"
+"}\n"
+"\n"
+"static inline double cppadcg_pow_approx(double a, double b) {\n"
+"    double aa = a < 0.0 ? -a : a;\n"
+"    double ab = b < 0.0 ? -b : b;\n"
+"    double bh = 0.5 * ab;\n"
+"    /* rounded to integers (all values above 2^52 are integers) */\n"
+"    double bi = ab < 4503599627370496.0 ? (ab + 4503599627370496.0) - 4503599627370496.0 : ab;\n"
+"    double bhi = bh < 4503599627370496.0 ? (bh + 4503599627370496.0) - 4503599627370496.0 : bh;\n"
+"    double sign = a < 0.0 ? (bi != ab ? NAN : (bhi != bh ? -1.0 : 1.0)) : 1.0;\n"
+"    double y = cppadcg_exp_approx(b * cppadcg_log_approx(aa));\n"
+"    return b == 0.0 ? 1.0 : (a == 1.0 ? 1.0 : sign * y);\n"
+"}\n"
+"\n"
+"static inline double cppadcg_tanh_approx(double x) {\n"
+"    double ax = x < 0.0 ? -x : x;\n"
+"    /* expm1(2 |x|) */\n"
+"    double x2 = 2.0 * (ax > 20.0 ? 20.0 : ax);\n"
+"    double k = cppadcg_approx_round(x2 * 1.4426950408889634);\n"
+"    double p = cppadcg_approx_pow2(k);\n"
+"    double e = p * cppadcg_approx_expm1_r(cppadcg_approx_reduce(x2, k)) + (p - 1.0);\n"
+"    double t = e / (e + 2.0);\n"
+"    return x < 0.0 ? -t : (x > 0.0 ? t : x);\n"
+"}\n";
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef CPPAD_CG_LANGUAGE_C_SPLIT_INCLUDED
+#define CPPAD_CG_LANGUAGE_C_SPLIT_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+template<class Base>
+void LanguageC<Base>::findFunctionPartition(const std::vector<Node*>& variableOrder) {
+    const size_t n = variableOrder.size();
+    const FunctionSplitCostModel& cost = _splitCost;
+
+    _functionPartition.clear();
+    if (n == 0)
+        return;
+
+    std::map<const Node*, size_t> position;
+    for (size_t i = 0; i < n; ++i) {
+        position[variableOrder[i]] = i;
+    }
+
+    /**
+     * the estimated number of operations (accumulated), where each
+     * variable is used for the last time, and where the code can be split
+     */
+    std::vector<size_t> ops(n + 1, 0);
+    std::vector<size_t> lastUse(n, 0);
+    std::vector<bool> splittable(n + 1, false);
+    splittable[0] = true;
+
+    std::vector<Node*> stack;
+    std::set<const Node*> visited;
+    size_t depth = 0; // loops and conditional blocks
+
+    for (size_t i = 0; i < n; ++i) {
+        Node* node = variableOrder[i];
+        CGOpCode op = node->getOperationType();
+
+        size_t o = 1;
+        if (op == CGOpCode::ArrayCreation || op == CGOpCode::SparseArrayCreation) {
+            o += node->getArguments().size(); // each element is assigned
+        }
+
+        // the variables used by the expression printed at this position
+        visited.clear();
+        stack.push_back(node);
+        while (!stack.empty()) {
+            Node* e = stack.back();
+            stack.pop_back();
+            for (const Arg& a : e->getArguments()) {
+                Node* aNode = a.getOperation();
+                if (aNode == nullptr)
+                    continue;
+                if (getVariableID(*aNode) > 0) {
+                    auto it = position.find(aNode);
+                    if (it != position.end() && it->second < i)
+                        lastUse[it->second] = i;
+                } else if (visited.insert(aNode).second) {
+                    o++;
+                    stack.push_back(aNode);
+                }
+            }
+        }
+
+        ops[i + 1] = ops[i] + o;
+
+        if (op == CGOpCode::LoopStart || op == CGOpCode::StartIf) {
+            depth++;
+        } else if ((op == CGOpCode::LoopEnd || op == CGOpCode::EndIf) && depth > 0) {
+            depth--;
+        }
+        splittable[i + 1] = depth == 0;
+    }
+    splittable[n] = true;
+
+    /**
+     * the number of temporary variables live between two positions
+     * (live[i] is the number of variables used at or after position i
+     *  which were assigned before i)
+     */
+    std::vector<long> liveDelta(n + 2, 0);
+    for (size_t i = 0; i < n; ++i) {
+        const Node& node = *variableOrder[i];
+        CGOpCode op = node.getOperationType();
+        if (lastUse[i] > i && !isDependent(node) && requiresVariableName(node) &&
+            op != CGOpCode::ArrayCreation && op != CGOpCode::SparseArrayCreation) {
+            liveDelta[i + 1]++;
+            liveDelta[lastUse[i] + 1]--;
+        }
+    }
+    std::vector<size_t> live(n + 1, 0);
+    long l = 0;
+    for (size_t i = 0; i <= n; ++i) {
+        l += liveDelta[i];
+        live[i] = size_t(l);
+    }
+
+    /**
+     * choose the end of each function so that the total (compilation and
+     * runtime) cost per operation is minimal
+     */
+    auto compileCost = [&](double w, double maxLive) {
+        return w + w * (w + maxLive) / cost.compileScale;
+    };
+
+    size_t a = 0;
+    while (a < n) {
+        bool found = false;
+        size_t best = n;
+        double bestScore = 0;
+        FunctionChunk chunk{};
+
+        size_t maxLive = live[a];
+        for (size_t b = a + 1; b <= n; ++b) {
+            maxLive = std::max(maxLive, live[b]);
+            double w = double(ops[b] - ops[a]);
+            double c = compileCost(w, double(maxLive));
+
+            // the compilation cost per operation only increases
+            if (found && (cost.compileWeight * c / w >= bestScore || c > cost.maxCompileCost))
+                break;
+
+            if (!splittable[b])
+                continue;
+
+            size_t liveOut = b < n ? live[b] : 0;
+            double runtime = cost.callCost + cost.liveCost * double(liveOut);
+            double score = (cost.compileWeight * c + runtime) / w;
+            if (!found || score < bestScore) {
+                found = true;
+                best = b;
+                bestScore = score;
+                chunk.operations = ops[b] - ops[a];
+                chunk.maxLive = maxLive;
+                chunk.liveOut = liveOut;
+                chunk.compileCost = c;
+                chunk.runtimeCost = w + runtime;
+            }
+        }
+
+        chunk.begin = a;
+        chunk.end = best;
+        _functionPartition.push_back(chunk);
+        a = best;
+    }
+}
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
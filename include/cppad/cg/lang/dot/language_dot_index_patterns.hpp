@@ -197,6 +197,23 @@ inline void LanguageDot<Base>::indexPattern2String(std::ostream& os,
 
             return;
         }
+        case IndexPatternType::AffineND: // y = b + sum_k ((x / stride_k) % extent_k) * dy_k
+        {
+            CPPADCG_ASSERT_KNOWN(indexes.size() == 1, "Invalid number of indexes")
+            const auto& aip = static_cast<const AffineNDIndexPattern&> (ip);
+            for (size_t k = 0; k < aip.getDimensions(); ++k) {
+                os << "(";
+                if (aip.getXOffset() != 0) os << "(";
+                os << (*indexes[0]->getName());
+                if (aip.getXOffset() != 0) os << " -" << aip.getXOffset() << ")";
+                if (aip.getStrideDx() != 1) os << "/" << aip.getStrideDx();
+                if (aip.getStrides()[k] != 1) os << "/" << aip.getStrides()[k];
+                if (aip.getExtents()[k] != 0) os << "%" << aip.getExtents()[k];
+                os << ")×" << aip.getSlopes()[k] << "+";
+            }
+            os << aip.getConstantTerm();
+            return;
+        }
         case IndexPatternType::Random1D:
         {
             CPPADCG_ASSERT_KNOWN(indexes.size() == 1, "Invalid number of indexes")
@@ -96,7 +96,16 @@ public:
         return *node;
     }
 
-    friend inline LangStreamStack<Base>& operator<<(LangStreamStack<Base>& lss, std::string text) {
+    friend inline LangStreamStack<Base>& operator<<(LangStreamStack<Base>& lss, const std::string& text) {
+        if (lss._it == lss._cache.before_begin()) {
+            lss._out << text;
+        } else {
+            lss._it = lss._cache.emplace_after(lss._it, text);
+        }
+        return lss;
+    }
+
+    friend inline LangStreamStack<Base>& operator<<(LangStreamStack<Base>& lss, std::string&& text) {
         if (lss._it == lss._cache.before_begin()) {
             lss._out << text;
         } else {
@@ -105,32 +114,41 @@ public:
         return lss;
     }
 
+    friend inline LangStreamStack<Base>& operator<<(LangStreamStack<Base>& lss, const char* text) {
+        if (lss._it == lss._cache.before_begin()) {
+            lss._out << text; // avoids the creation of a string
+        } else {
+            lss._it = lss._cache.emplace_after(lss._it, std::string(text));
+        }
+        return lss;
+    }
+
     friend inline LangStreamStack<Base>& operator<<(LangStreamStack<Base>& lss, int i) {
-        return (lss << std::to_string(i));
+        return lss.writeValue(i);
     }
 
     friend inline LangStreamStack<Base>& operator<<(LangStreamStack<Base>& lss, long int i) {
-        return (lss << std::to_string(i));
+        return lss.writeValue(i);
     }
 
     friend inline LangStreamStack<Base>& operator<<(LangStreamStack<Base>& lss, long long int i) {
-        return (lss << std::to_string(i));
+        return lss.writeValue(i);
     }
 
     friend inline LangStreamStack<Base>& operator<<(LangStreamStack<Base>& lss, unsigned int i) {
-        return (lss << std::to_string(i));
+        return lss.writeValue(i);
     }
 
     friend inline LangStreamStack<Base>& operator<<(LangStreamStack<Base>& lss, long unsigned int i) {
-        return (lss << std::to_string(i));
+        return lss.writeValue(i);
     }
 
     friend inline LangStreamStack<Base>& operator<<(LangStreamStack<Base>& lss, long long unsigned int i) {
-        return (lss << std::to_string(i));
+        return lss.writeValue(i);
     }
 
     friend inline LangStreamStack<Base>& operator<<(LangStreamStack<Base>& lss, char text) {
-        return (lss << std::string(1, text));
+        return lss.writeValue(text);
     }
 
     friend inline LangStreamStack<Base>& operator<<(LangStreamStack<Base>& lss, OperationNode<Base>& node) {
@@ -138,6 +156,20 @@ public:
 
         return lss;
     }
+
+private:
+
+    template<class T>
+    inline LangStreamStack<Base>& writeValue(T value) {
+        if (_it == _cache.before_begin()) {
+            _out << value; // no need to create a string
+        } else {
+            std::ostringstream os;
+            os << value;
+            _it = _cache.emplace_after(_it, os.str());
+        }
+        return *this;
+    }
 };
 
 } // END cg namespace
@@ -210,6 +210,26 @@ inline std::string LanguageLatex<Base>::indexPattern2String(const IndexPattern&
 
             return indexExpr;
         }
+        case IndexPatternType::AffineND: // y = b + sum_k ((x / stride_k) % extent_k) * dy_k
+        {
+            CPPADCG_ASSERT_KNOWN(indexes.size() == 1, "Invalid number of indexes")
+            const auto& aip = static_cast<const AffineNDIndexPattern&> (ip);
+            std::string i = *indexes[0]->getName();
+            if (aip.getXOffset() != 0)
+                i = "\\left(" + i + " - " + std::to_string(aip.getXOffset()) + "\\right)";
+            if (aip.getStrideDx() != 1)
+                i = "\\left(" + i + " / " + std::to_string(aip.getStrideDx()) + "\\right)";
+
+            for (size_t k = 0; k < aip.getDimensions(); ++k) {
+                ss << "\\left(" << i;
+                if (aip.getStrides()[k] != 1) ss << " / " << aip.getStrides()[k];
+                if (aip.getExtents()[k] != 0) ss << " \\bmod " << aip.getExtents()[k];
+                ss << "\\right) \\cdot " << aip.getSlopes()[k] << " + ";
+            }
+            ss << aip.getConstantTerm();
+
+            return ss.str();
+        }
         case IndexPatternType::Random1D:
         {
             CPPADCG_ASSERT_KNOWN(indexes.size() == 1, "Invalid number of indexes")
@@ -210,6 +210,23 @@ inline void LanguageMathML<Base>::indexPattern2String(std::ostream& os,
 
             return;
         }
+        case IndexPatternType::AffineND: // y = b + sum_k ((x / stride_k) % extent_k) * dy_k
+        {
+            CPPADCG_ASSERT_KNOWN(indexes.size() == 1, "Invalid number of indexes")
+            const auto& aip = static_cast<const AffineNDIndexPattern&> (ip);
+            for (size_t k = 0; k < aip.getDimensions(); ++k) {
+                os << "<mfenced><mrow>";
+                if (aip.getXOffset() != 0) os << "<mfenced><mrow>";
+                os << "<mi class='index'>" << (*indexes[0]->getName()) << "</mi>";
+                if (aip.getXOffset() != 0) os << "<mo>-</mo><mn>" << aip.getXOffset() << "</mn></mrow></mfenced>";
+                if (aip.getStrideDx() != 1) os << "<mo>/</mo><mn>" << aip.getStrideDx() << "</mn>";
+                if (aip.getStrides()[k] != 1) os << "<mo>/</mo><mn>" << aip.getStrides()[k] << "</mn>";
+                if (aip.getExtents()[k] != 0) os << "<mo>mod</mo><mn>" << aip.getExtents()[k] << "</mn>";
+                os << "</mrow></mfenced><mo>&sdot;</mo><mn>" << aip.getSlopes()[k] << "</mn><mo>+</mo>";
+            }
+            os << "<mn>" << aip.getConstantTerm() << "</mn>";
+            return;
+        }
         case IndexPatternType::Random1D:
         {
             CPPADCG_ASSERT_KNOWN(indexes.size() == 1, "Invalid number of indexes")
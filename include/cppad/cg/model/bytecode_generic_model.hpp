@@ -0,0 +1,573 @@
+#ifndef CPPAD_CG_BYTECODE_GENERIC_MODEL_INCLUDED
+#define CPPAD_CG_BYTECODE_GENERIC_MODEL_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A generic model which evaluates bytecode programs instead of compiled
+ * source code.
+ * It can be used where no C compiler is available or to validate the
+ * results of a compiled model.
+ *
+ * The operation graphs are created from the taped function the first time
+ * each type of evaluation is requested.
+ * Only the zero order forward mode, the dense and sparse Jacobians, and
+ * the dense and sparse Hessians are available.
+ * Atomic functions are not supported.
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class BytecodeGenericModel : public GenericModel<Base> {
+public:
+    using CGBase = CG<Base>;
+protected:
+    /**
+     * the taped model (must only be deleted after this object)
+     */
+    ADFun<CGBase>* _fun;
+    /**
+     * the model name
+     */
+    const std::string _name;
+    /**
+     * number of independent variables
+     */
+    const size_t _n;
+    /**
+     * number of dependent variables
+     */
+    const size_t _m;
+    std::unique_ptr<BytecodeProgram<Base> > _zero;
+    std::unique_ptr<BytecodeProgram<Base> > _jacobian;
+    std::unique_ptr<BytecodeProgram<Base> > _hessian;
+    std::unique_ptr<BytecodeProgram<Base> > _sparseJacobian;
+    std::unique_ptr<BytecodeProgram<Base> > _sparseHessian;
+    /**
+     * Jacobian sparsity (only available after the first request)
+     */
+    std::vector<std::set<size_t> > _jacSparsity;
+    std::vector<size_t> _jacRows;
+    std::vector<size_t> _jacCols;
+    bool _jacSparsityReady;
+    /**
+     * Hessian sparsity (only available after the first request)
+     */
+    std::vector<std::set<size_t> > _hessSparsity;
+    std::vector<size_t> _hessRows;
+    std::vector<size_t> _hessCols;
+    bool _hessSparsityReady;
+    /**
+     * the independent variables followed by the multipliers
+     */
+    std::vector<Base> _xw;
+    /**
+     * the values of sparse Jacobians or Hessians
+     */
+    std::vector<Base> _compressed;
+    const std::vector<std::string> _atomicNames;
+public:
+
+    /**
+     * Creates a new model evaluated through bytecode.
+     *
+     * @param fun The taped model. It must only be deleted after this
+     *            object and it must not be used while this model is being
+     *            evaluated.
+     * @param name The model name
+     */
+    inline BytecodeGenericModel(ADFun<CGBase>& fun,
+                                std::string name) :
+        _fun(&fun),
+        _name(std::move(name)),
+        _n(fun.Domain()),
+        _m(fun.Range()),
+        _jacSparsityReady(false),
+        _hessSparsityReady(false) {
+    }
+
+    BytecodeGenericModel(const BytecodeGenericModel&) = delete;
+    BytecodeGenericModel& operator=(const BytecodeGenericModel&) = delete;
+
+    inline virtual ~BytecodeGenericModel() = default;
+
+    const std::string& getName() const override {
+        return _name;
+    }
+
+    size_t Domain() const override {
+        return _n;
+    }
+
+    size_t Range() const override {
+        return _m;
+    }
+
+    const std::vector<std::string>& getAtomicFunctionNames() override {
+        return _atomicNames;
+    }
+
+    bool addAtomicFunction(atomic_base<Base>& atomic) override {
+        return false;
+    }
+
+    bool addExternalModel(GenericModel<Base>& atomic) override {
+        return false;
+    }
+
+    /***********************************************************************
+     *                        Sparsity
+     **********************************************************************/
+
+    bool isJacobianSparsityAvailable() override {
+        return true;
+    }
+
+    std::vector<std::set<size_t> > JacobianSparsitySet() override {
+        prepareJacobianSparsity();
+        return _jacSparsity;
+    }
+
+    std::vector<bool> JacobianSparsityBool() override {
+        prepareJacobianSparsity();
+        return toBoolSparsity(_jacSparsity, _n);
+    }
+
+    void JacobianSparsity(std::vector<size_t>& equations,
+                          std::vector<size_t>& variables) override {
+        prepareJacobianSparsity();
+        equations = _jacRows;
+        variables = _jacCols;
+    }
+
+    bool isHessianSparsityAvailable() override {
+        return true;
+    }
+
+    std::vector<std::set<size_t> > HessianSparsitySet() override {
+        prepareHessianSparsity();
+        return _hessSparsity;
+    }
+
+    std::vector<bool> HessianSparsityBool() override {
+        prepareHessianSparsity();
+        return toBoolSparsity(_hessSparsity, _n);
+    }
+
+    void HessianSparsity(std::vector<size_t>& rows,
+                         std::vector<size_t>& cols) override {
+        prepareHessianSparsity();
+        rows = _hessRows;
+        cols = _hessCols;
+    }
+
+    bool isEquationHessianSparsityAvailable() override {
+        return true;
+    }
+
+    std::vector<std::set<size_t> > HessianSparsitySet(size_t i) override {
+        CPPADCG_ASSERT_KNOWN(i < _m, "Invalid equation index")
+        return hessianSparsitySet<std::vector<std::set<size_t> >, CGBase>(*_fun, i);
+    }
+
+    std::vector<bool> HessianSparsityBool(size_t i) override {
+        return toBoolSparsity(HessianSparsitySet(i), _n);
+    }
+
+    void HessianSparsity(size_t i,
+                         std::vector<size_t>& rows,
+                         std::vector<size_t>& cols) override {
+        generateSparsityIndexes(HessianSparsitySet(i), rows, cols);
+    }
+
+    /***********************************************************************
+     *                        Forward zero
+     **********************************************************************/
+
+    bool isForwardZeroAvailable() override {
+        return true;
+    }
+
+    void ForwardZero(ArrayView<const Base> x,
+                     ArrayView<Base> dep) override {
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(dep.size() == _m, "Invalid dependent array size")
+
+        if (_zero == nullptr) {
+            CodeHandler<Base> handler;
+            std::vector<CGBase> indVars(_n);
+            handler.makeVariables(indVars);
+
+            std::vector<CGBase> y = _fun->Forward(0, indVars);
+
+            _zero.reset(new BytecodeProgram<Base>(handler, y));
+        }
+
+        _zero->evaluate(x, dep);
+    }
+
+    void ForwardZero(const std::vector<const Base*>& x,
+                     ArrayView<Base> dep) override {
+        CPPADCG_ASSERT_KNOWN(x.size() == 1, "The number of independent variable arrays is higher than 1")
+
+        ForwardZero(ArrayView<const Base>(x[0], _n), dep);
+    }
+
+    void ForwardZero(const CppAD::vector<bool>& vx,
+                     CppAD::vector<bool>& vy,
+                     ArrayView<const Base> tx,
+                     ArrayView<Base> ty) override {
+        ForwardZero(tx, ty);
+
+        if (vx.size() > 0) {
+            CPPADCG_ASSERT_KNOWN(vx.size() >= _n, "Invalid vx size")
+            CPPADCG_ASSERT_KNOWN(vy.size() >= _m, "Invalid vy size")
+            prepareJacobianSparsity();
+            for (size_t i = 0; i < _m; i++) {
+                for (size_t j : _jacSparsity[i]) {
+                    if (vx[j]) {
+                        vy[i] = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    /***********************************************************************
+     *                        Dense Jacobian and Hessian
+     **********************************************************************/
+
+    bool isJacobianAvailable() override {
+        return true;
+    }
+
+    void Jacobian(ArrayView<const Base> x,
+                  ArrayView<Base> jac) override {
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(jac.size() == _m * _n, "Invalid Jacobian array size")
+
+        if (_jacobian == nullptr) {
+            CodeHandler<Base> handler;
+            std::vector<CGBase> indVars(_n);
+            handler.makeVariables(indVars);
+
+            std::vector<CGBase> j = _fun->Jacobian(indVars);
+
+            _jacobian.reset(new BytecodeProgram<Base>(handler, j));
+        }
+
+        _jacobian->evaluate(x, jac);
+    }
+
+    bool isHessianAvailable() override {
+        return true;
+    }
+
+    void Hessian(ArrayView<const Base> x,
+                 ArrayView<const Base> w,
+                 ArrayView<Base> hess) override {
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size")
+        CPPADCG_ASSERT_KNOWN(hess.size() == _n * _n, "Invalid Hessian size")
+
+        if (_hessian == nullptr) {
+            CodeHandler<Base> handler;
+            std::vector<CGBase> indVars(_n);
+            handler.makeVariables(indVars);
+            std::vector<CGBase> wVars(_m);
+            handler.makeVariables(wVars);
+
+            std::vector<CGBase> h = _fun->Hessian(indVars, wVars);
+
+            // make use of the symmetry of the Hessian in order to reduce operations
+            for (size_t i = 0; i < _n; i++) {
+                for (size_t j = 0; j < i; j++) {
+                    h[i * _n + j] = h[j * _n + i];
+                }
+            }
+
+            _hessian.reset(new BytecodeProgram<Base>(handler, h));
+        }
+
+        _hessian->evaluate(joinXW(x, w), hess);
+    }
+
+    /***********************************************************************
+     *                        Sparse Jacobian
+     **********************************************************************/
+
+    bool isSparseJacobianAvailable() override {
+        return true;
+    }
+
+    void SparseJacobian(ArrayView<const Base> x,
+                        ArrayView<Base> jac) override {
+        CPPADCG_ASSERT_KNOWN(jac.size() == _m * _n, "Invalid Jacobian size")
+
+        evalSparseJacobian(x);
+
+        std::fill(jac.begin(), jac.end(), Base(0));
+        for (size_t e = 0; e < _compressed.size(); e++) {
+            jac[_jacRows[e] * _n + _jacCols[e]] = _compressed[e];
+        }
+    }
+
+    void SparseJacobian(const std::vector<Base>& x,
+                        std::vector<Base>& jac,
+                        std::vector<size_t>& row,
+                        std::vector<size_t>& col) override {
+        evalSparseJacobian(ArrayView<const Base>(x));
+        jac = _compressed;
+        row = _jacRows;
+        col = _jacCols;
+    }
+
+    void SparseJacobian(ArrayView<const Base> x,
+                        ArrayView<Base> jac,
+                        size_t const** row,
+                        size_t const** col) override {
+        evalSparseJacobian(x);
+        CPPADCG_ASSERT_KNOWN(jac.size() == _compressed.size(), "Invalid Jacobian size")
+        std::copy(_compressed.begin(), _compressed.end(), jac.begin());
+        *row = _jacRows.data();
+        *col = _jacCols.data();
+    }
+
+    void SparseJacobian(const std::vector<const Base*>& x,
+                        ArrayView<Base> jac,
+                        size_t const** row,
+                        size_t const** col) override {
+        CPPADCG_ASSERT_KNOWN(x.size() == 1, "The number of independent variable arrays is higher than 1")
+        SparseJacobian(ArrayView<const Base>(x[0], _n), jac, row, col);
+    }
+
+    /***********************************************************************
+     *                        Sparse Hessian
+     **********************************************************************/
+
+    bool isSparseHessianAvailable() override {
+        return true;
+    }
+
+    void SparseHessian(ArrayView<const Base> x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess) override {
+        CPPADCG_ASSERT_KNOWN(hess.size() == _n * _n, "Invalid Hessian size")
+
+        evalSparseHessian(x, w);
+
+        std::fill(hess.begin(), hess.end(), Base(0));
+        for (size_t e = 0; e < _compressed.size(); e++) {
+            hess[_hessRows[e] * _n + _hessCols[e]] = _compressed[e];
+        }
+    }
+
+    void SparseHessian(const std::vector<Base>& x,
+                       const std::vector<Base>& w,
+                       std::vector<Base>& hess,
+                       std::vector<size_t>& row,
+                       std::vector<size_t>& col) override {
+        evalSparseHessian(ArrayView<const Base>(x), ArrayView<const Base>(w));
+        hess = _compressed;
+        row = _hessRows;
+        col = _hessCols;
+    }
+
+    void SparseHessian(ArrayView<const Base> x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess,
+                       size_t const** row,
+                       size_t const** col) override {
+        evalSparseHessian(x, w);
+        CPPADCG_ASSERT_KNOWN(hess.size() == _compressed.size(), "Invalid Hessian size")
+        std::copy(_compressed.begin(), _compressed.end(), hess.begin());
+        *row = _hessRows.data();
+        *col = _hessCols.data();
+    }
+
+    void SparseHessian(const std::vector<const Base*>& x,
+                       ArrayView<const Base> w,
+                       ArrayView<Base> hess,
+                       size_t const** row,
+                       size_t const** col) override {
+        CPPADCG_ASSERT_KNOWN(x.size() == 1, "The number of independent variable arrays is higher than 1")
+        SparseHessian(ArrayView<const Base>(x[0], _n), w, hess, row, col);
+    }
+
+    /***********************************************************************
+     *                   Directional derivatives (not available)
+     **********************************************************************/
+
+    bool isForwardOneAvailable() override {
+        return false;
+    }
+
+    void ForwardOne(ArrayView<const Base> tx,
+                    ArrayView<Base> ty) override {
+        throw CGException("First-order forward mode is not available in bytecode models");
+    }
+
+    bool isSparseForwardOneAvailable() override {
+        return false;
+    }
+
+    void ForwardOne(ArrayView<const Base> x,
+                    size_t tx1Nnz, const size_t idx[], const Base tx1[],
+                    ArrayView<Base> ty1) override {
+        throw CGException("First-order forward mode is not available in bytecode models");
+    }
+
+    bool isReverseOneAvailable() override {
+        return false;
+    }
+
+    bool isSparseReverseOneAvailable() override {
+        return false;
+    }
+
+    void ReverseOne(ArrayView<const Base> tx,
+                    ArrayView<const Base> ty,
+                    ArrayView<Base> px,
+                    ArrayView<const Base> py) override {
+        throw CGException("First-order reverse mode is not available in bytecode models");
+    }
+
+    void ReverseOne(ArrayView<const Base> x,
+                    ArrayView<Base> px,
+                    size_t pyNnz, const size_t idx[], const Base py[]) override {
+        throw CGException("First-order reverse mode is not available in bytecode models");
+    }
+
+    bool isReverseTwoAvailable() override {
+        return false;
+    }
+
+    bool isSparseReverseTwoAvailable() override {
+        return false;
+    }
+
+    void ReverseTwo(ArrayView<const Base> tx,
+                    ArrayView<const Base> ty,
+                    ArrayView<Base> px,
+                    ArrayView<const Base> py) override {
+        throw CGException("Second-order reverse mode is not available in bytecode models");
+    }
+
+    void ReverseTwo(ArrayView<const Base> x,
+                    size_t tx1Nnz, const size_t idx[], const Base tx1[],
+                    ArrayView<Base> px2,
+                    ArrayView<const Base> py2) override {
+        throw CGException("Second-order reverse mode is not available in bytecode models");
+    }
+
+protected:
+
+    inline void prepareJacobianSparsity() {
+        if (_jacSparsityReady)
+            return;
+
+        _jacSparsity = jacobianSparsitySet<std::vector<std::set<size_t> >, CGBase>(*_fun);
+        generateSparsityIndexes(_jacSparsity, _jacRows, _jacCols);
+        _jacSparsityReady = true;
+    }
+
+    inline void prepareHessianSparsity() {
+        if (_hessSparsityReady)
+            return;
+
+        _hessSparsity = hessianSparsitySet<std::vector<std::set<size_t> >, CGBase>(*_fun);
+        generateSparsityIndexes(_hessSparsity, _hessRows, _hessCols);
+        _hessSparsityReady = true;
+    }
+
+    inline void evalSparseJacobian(ArrayView<const Base> x) {
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
+
+        if (_sparseJacobian == nullptr) {
+            prepareJacobianSparsity();
+
+            CodeHandler<Base> handler;
+            std::vector<CGBase> indVars(_n);
+            handler.makeVariables(indVars);
+
+            std::vector<CGBase> jac(_jacRows.size());
+            CppAD::sparse_jacobian_work work;
+            if (_n <= _m) {
+                _fun->SparseJacobianForward(indVars, _jacSparsity, _jacRows, _jacCols, jac, work);
+            } else {
+                _fun->SparseJacobianReverse(indVars, _jacSparsity, _jacRows, _jacCols, jac, work);
+            }
+
+            _sparseJacobian.reset(new BytecodeProgram<Base>(handler, jac));
+        }
+
+        _compressed.resize(_jacRows.size());
+        _sparseJacobian->evaluate(x, _compressed);
+    }
+
+    inline void evalSparseHessian(ArrayView<const Base> x,
+                                  ArrayView<const Base> w) {
+        CPPADCG_ASSERT_KNOWN(x.size() == _n, "Invalid independent array size")
+        CPPADCG_ASSERT_KNOWN(w.size() == _m, "Invalid multiplier array size")
+
+        if (_sparseHessian == nullptr) {
+            prepareHessianSparsity();
+
+            CodeHandler<Base> handler;
+            std::vector<CGBase> indVars(_n);
+            handler.makeVariables(indVars);
+            std::vector<CGBase> wVars(_m);
+            handler.makeVariables(wVars);
+
+            std::vector<CGBase> hess(_hessRows.size());
+            CppAD::sparse_hessian_work work;
+            _fun->SparseHessian(indVars, wVars, _hessSparsity, _hessRows, _hessCols, hess, work);
+
+            _sparseHessian.reset(new BytecodeProgram<Base>(handler, hess));
+        }
+
+        _compressed.resize(_hessRows.size());
+        _sparseHessian->evaluate(joinXW(x, w), _compressed);
+    }
+
+    inline ArrayView<const Base> joinXW(ArrayView<const Base> x,
+                                        ArrayView<const Base> w) {
+        _xw.resize(_n + _m);
+        std::copy(x.begin(), x.end(), _xw.begin());
+        std::copy(w.begin(), w.end(), _xw.begin() + _n);
+        return ArrayView<const Base>(_xw);
+    }
+
+    static inline std::vector<bool> toBoolSparsity(const std::vector<std::set<size_t> >& sparsity,
+                                                   size_t n) {
+        std::vector<bool> s(sparsity.size() * n, false);
+        for (size_t i = 0; i < sparsity.size(); i++) {
+            for (size_t j : sparsity[i]) {
+                s[i * n + j] = true;
+            }
+        }
+        return s;
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -54,9 +54,6 @@ public:
     inline virtual void create(const std::string& library,
                                const std::set<std::string>& objectFiles,
                                JobTimer* timer = nullptr) {
-        // backup output format so that it can be restored
-        OStreamConfigRestore coutb(std::cout);
-
         std::vector<std::string> args;
         args.push_back("rcs");
         args.insert(args.end(), _flags.begin(), _flags.end());
@@ -66,6 +63,8 @@ public:
         if (timer != nullptr) {
             timer->startingJob("'" + library + "'", JobTimer::ASSEMBLE_STATIC_LIBRARY);
         } else if (_verbose) {
+            // backup output format so that it can be restored
+            OStreamConfigRestore coutb(std::cout);
             std::cout << "building library '" << library << "'" << std::endl;
         }
 
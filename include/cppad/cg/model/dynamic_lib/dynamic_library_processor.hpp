@@ -127,23 +127,116 @@ public:
         // backup output format so that it can be restored
         OStreamConfigRestore coutb(std::cout);
 
+        return buildDynamicLibrary(compiler, loadLib);
+    }
+
+    /**
+     * Compiles all models and generates a static library.
+     * 
+     * @param compiler The compiler used to compile the sources
+     * @param ar The archiver used to assemble the compiled source into a
+     *           static library
+     * @param posIndepCode Whether or not to compile the source 
+     *                     with position independent code (static libraries 
+     *                     typically do not use this feature)
+     */
+
+    void createStaticLibrary(CCompiler <Base>& compiler,
+                             Archiver& ar,
+                             bool posIndepCode) {
+        // backup output format so that it can be restored
+        OStreamConfigRestore coutb(std::cout);
+
+        buildStaticLibrary(compiler, ar, posIndepCode);
+    }
+
+    /**
+     * Compiles all models and generates a dynamic library in a background
+     * thread.
+     * Progress is reported to the JobListeners registered in the
+     * ModelLibraryCSourceGen and the task can be cancelled through
+     * ModelLibraryCSourceGen::requestCancel() (the future will then hold
+     * a CGException).
+     * This processor, the compiler, the library source generator and its
+     * models must not be used or deleted until the future is ready.
+     * The background thread has its own CppAD thread number (see
+     * CppADThreadManager), therefore other tapes can be used while the
+     * library is created.
+     * Unlike createDynamicLibrary(), the format of std::cout is not saved
+     * and restored since the caller can be using it.
+     *
+     * @param compiler The compiler used to compile the sources and create
+     *                 the dynamic library
+     * @param loadLib Whether or not to load the dynamic library
+     * @return A future for the dynamic library (nullptr if loadLib is false)
+     */
+    std::future<std::unique_ptr<DynamicLib<Base>>> createDynamicLibraryAsync(CCompiler<Base>& compiler,
+                                                                             bool loadLib = true) {
+        return this->runAsync([this, &compiler, loadLib]() {
+            return this->buildDynamicLibrary(compiler, loadLib);
+        });
+    }
+
+    /**
+     * Compiles all models and generates a static library in a background
+     * thread.
+     * Progress is reported to the JobListeners registered in the
+     * ModelLibraryCSourceGen and the task can be cancelled through
+     * ModelLibraryCSourceGen::requestCancel().
+     * This processor, the compiler, the archiver, the library source
+     * generator and its models must not be used or deleted until the
+     * future is ready.
+     * Unlike createStaticLibrary(), the format of std::cout is not saved
+     * and restored since the caller can be using it.
+     *
+     * @param compiler The compiler used to compile the sources
+     * @param ar The archiver used to assemble the compiled source into a
+     *           static library
+     * @param posIndepCode Whether or not to compile the source
+     *                     with position independent code
+     * @return A future which becomes ready when the library is created
+     */
+    std::future<void> createStaticLibraryAsync(CCompiler<Base>& compiler,
+                                               Archiver& ar,
+                                               bool posIndepCode) {
+        return this->runAsync([this, &compiler, &ar, posIndepCode]() {
+            this->buildStaticLibrary(compiler, ar, posIndepCode);
+        });
+    }
+
+protected:
+
+    /**
+     * Compiles all models and generates a dynamic library without
+     * changing the format of std::cout (it can be called by a background
+     * thread).
+     */
+    std::unique_ptr<DynamicLib<Base>> buildDynamicLibrary(CCompiler<Base>& compiler,
+                                                          bool loadLib) {
         this->modelLibraryHelper_->startingJob("", JobTimer::DYNAMIC_MODEL_LIBRARY);
 
         const std::map<std::string, ModelCSourceGen < Base>*>&models = this->modelLibraryHelper_->getModels();
         try {
-            for (const auto& p : models) {
-                const std::map<std::string, std::string>& modelSources = this->getSources(*p.second);
+            if (this->streamSources_) {
+                // each file is compiled as soon as it is generated
+                CompilerSourceSink<Base> sink(compiler, true, this->modelLibraryHelper_);
+                this->modelLibraryHelper_->generateSources(sink);
 
-                this->modelLibraryHelper_->startingJob("", JobTimer::COMPILING_FOR_MODEL);
-                compiler.compileSources(modelSources, true, this->modelLibraryHelper_);
-                this->modelLibraryHelper_->finishedJob();
-            }
+            } else {
+                for (const auto& p : models) {
+                    const std::map<std::string, std::string>& modelSources = this->getSources(*p.second);
+
+                    this->modelLibraryHelper_->startingJob("", JobTimer::COMPILING_FOR_MODEL);
+                    compiler.compileSources(modelSources, true, this->modelLibraryHelper_);
+                    this->modelLibraryHelper_->finishedJob();
+                }
 
-            const std::map<std::string, std::string>& sources = this->getLibrarySources();
-            compiler.compileSources(sources, true, this->modelLibraryHelper_);
+                const std::map<std::string, std::string>& sources = this->getLibrarySources();
+                compiler.compileSources(sources, true, this->modelLibraryHelper_);
 
-            const std::map<std::string, std::string>& customSource = this->modelLibraryHelper_->getCustomSources();
-            compiler.compileSources(customSource, true, this->modelLibraryHelper_);
+                const std::map<std::string, std::string>& customSource = this->modelLibraryHelper_->getCustomSources();
+                compiler.compileSources(customSource, true, this->modelLibraryHelper_);
+            }
 
             std::string libname = _libraryName;
             if (_customLibExtension != nullptr)
@@ -168,39 +261,36 @@ public:
     }
 
     /**
-     * Compiles all models and generates a static library.
-     * 
-     * @param compiler The compiler used to compile the sources
-     * @param ar The archiver used to assemble the compiled source into a
-     *           static library
-     * @param posIndepCode Whether or not to compile the source 
-     *                     with position independent code (static libraries 
-     *                     typically do not use this feature)
+     * Compiles all models and generates a static library without changing
+     * the format of std::cout (it can be called by a background thread).
      */
-
-    void createStaticLibrary(CCompiler <Base>& compiler,
-                             Archiver& ar,
-                             bool posIndepCode) {
-        // backup output format so that it can be restored
-        OStreamConfigRestore coutb(std::cout);
-
+    void buildStaticLibrary(CCompiler<Base>& compiler,
+                            Archiver& ar,
+                            bool posIndepCode) {
         this->modelLibraryHelper_->startingJob("", JobTimer::STATIC_MODEL_LIBRARY);
 
         const std::map<std::string, ModelCSourceGen<Base>*>& models = this->modelLibraryHelper_->getModels();
         try {
-            for (const auto& p : models) {
-                const std::map<std::string, std::string>& modelSources = this->getSources(*p.second);
+            if (this->streamSources_) {
+                // each file is compiled as soon as it is generated
+                CompilerSourceSink<Base> sink(compiler, posIndepCode, this->modelLibraryHelper_);
+                this->modelLibraryHelper_->generateSources(sink);
 
-                this->modelLibraryHelper_->startingJob("", JobTimer::COMPILING_FOR_MODEL);
-                compiler.compileSources(modelSources, posIndepCode, this->modelLibraryHelper_);
-                this->modelLibraryHelper_->finishedJob();
-            }
+            } else {
+                for (const auto& p : models) {
+                    const std::map<std::string, std::string>& modelSources = this->getSources(*p.second);
+
+                    this->modelLibraryHelper_->startingJob("", JobTimer::COMPILING_FOR_MODEL);
+                    compiler.compileSources(modelSources, posIndepCode, this->modelLibraryHelper_);
+                    this->modelLibraryHelper_->finishedJob();
+                }
 
-            const std::map<std::string, std::string>& sources = this->getLibrarySources();
-            compiler.compileSources(sources, posIndepCode, this->modelLibraryHelper_);
+                const std::map<std::string, std::string>& sources = this->getLibrarySources();
+                compiler.compileSources(sources, posIndepCode, this->modelLibraryHelper_);
 
-            const std::map<std::string, std::string>& customSource = this->modelLibraryHelper_->getCustomSources();
-            compiler.compileSources(customSource, posIndepCode, this->modelLibraryHelper_);
+                const std::map<std::string, std::string>& customSource = this->modelLibraryHelper_->getCustomSources();
+                compiler.compileSources(customSource, posIndepCode, this->modelLibraryHelper_);
+            }
 
             std::string libname = _libraryName;
             if (_customLibExtension != nullptr)
@@ -218,9 +308,6 @@ public:
         this->modelLibraryHelper_->finishedJob();
     }
 
-
-protected:
-
     virtual std::unique_ptr<DynamicLib<Base>> loadDynamicLibrary();
 
 };
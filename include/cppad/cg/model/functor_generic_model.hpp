@@ -91,6 +91,14 @@ protected:
             unsigned long * nnz);
     void (*_atomicFunctions)(const char*** names,
             unsigned long * n);
+    // workspace size for each worker and the number of workers
+    void (*_workspaceSize)(unsigned long* size,
+            unsigned long* workers);
+    // workspace provided by the user
+    void* _userWorkspace;
+    size_t _userWorkspaceSize;
+    // workspace allocated internally (when not provided by the user)
+    std::vector<char> _workspace;
 
 public:
 
@@ -291,6 +299,25 @@ public:
         return _m;
     }
 
+    size_t getWorkspaceSize() override {
+        CPPADCG_ASSERT_KNOWN(_isLibraryReady, ERROR_LIBRARY_NOT_READY)
+        if (_workspaceSize == nullptr)
+            return 0;
+
+        unsigned long size, workers;
+        (*_workspaceSize)(&size, &workers);
+        return size * workers;
+    }
+
+    void setWorkspace(void* workspace,
+                      size_t size) override {
+        CPPADCG_ASSERT_KNOWN(reinterpret_cast<std::uintptr_t>(workspace) % LanguageC<Base>::WORKSPACE_ALIGNMENT == 0,
+                             "The workspace must be aligned to 64 bytes")
+        _userWorkspace = workspace;
+        _userWorkspaceSize = workspace != nullptr ? size : 0;
+        std::vector<char>().swap(_workspace); // release the internal workspace
+    }
+
     bool isForwardZeroAvailable() override {
         return _zero != nullptr;
     }
@@ -309,6 +336,7 @@ public:
         _in[0] = x.data();
         _out[0] = dep.data();
 
+        prepareWorkspace();
         (*_zero)(&_in[0], &_out[0], _atomicFuncArg);
     }
 
@@ -322,6 +350,7 @@ public:
 
         _out[0] = dep.data();
 
+        prepareWorkspace();
         (*_zero)(&x[0], &_out[0], _atomicFuncArg);
     }
 
@@ -340,6 +369,7 @@ public:
         _in[0] = tx.data();
         _out[0] = ty.data();
 
+        prepareWorkspace();
         (*_zero)(&_in[0], &_out[0], _atomicFuncArg);
 
         if (vx.size() > 0) {
@@ -376,6 +406,7 @@ public:
         _in[0] = x.data();
         _out[0] = jac.data();
 
+        prepareWorkspace();
         (*_jacobian)(&_in[0], &_out[0], _atomicFuncArg);
     }
 
@@ -400,6 +431,7 @@ public:
         _inHess[1] = w.data();
         _out[0] = hess.data();
 
+        prepareWorkspace();
         (*_hessian)(&_inHess[0], &_out[0], _atomicFuncArg);
     }
 
@@ -417,6 +449,7 @@ public:
         CPPADCG_ASSERT_KNOWN(ty.size() >= (k + 1) * _m, "Invalid ty size")
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
 
+        prepareWorkspace();
         int ret = (*_forwardOne)(tx.data(), ty.data(), _atomicFuncArg);
 
         CPPADCG_ASSERT_KNOWN(ret == 0, "First-order forward mode failed.") // generic failure
@@ -454,6 +487,7 @@ public:
             (*_forwardOneSparsity)(j, &pos, &nnz);
 
             _inHess[1] = &tx1[ej];
+            prepareWorkspace();
             int ret = (*_sparseForwardOne)(j, &_inHess[0], &_out[0], _atomicFuncArg);
 
             CPPADCG_ASSERT_KNOWN(ret == 0, "First-order forward mode failed.") // generic failure
@@ -483,6 +517,7 @@ public:
         CPPADCG_ASSERT_KNOWN(py.size() >= k1 * _m, "Invalid py size")
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
 
+        prepareWorkspace();
         int ret = (*_reverseOne)(tx.data(), ty.data(), px.data(), py.data(), _atomicFuncArg);
 
         CPPADCG_ASSERT_KNOWN(ret == 0, "First-order reverse mode failed.")
@@ -520,6 +555,7 @@ public:
             (*_reverseOneSparsity)(i, &pos, &nnz);
 
             _inHess[1] = &py[ei];
+            prepareWorkspace();
             int ret = (*_sparseReverseOne)(i, &_inHess[0], &_out[0], _atomicFuncArg);
 
             CPPADCG_ASSERT_KNOWN(ret == 0, "First-order reverse mode failed.")
@@ -550,6 +586,7 @@ public:
         CPPADCG_ASSERT_KNOWN(py.size() >= k1 * _m, "Invalid py size")
         CPPADCG_ASSERT_KNOWN(_missingAtomicFunctions == 0, "Some atomic functions used by the compiled model have not been specified yet")
 
+        prepareWorkspace();
         int ret = (*_reverseTwo)(tx.data(), ty.data(), px.data(), py.data(), _atomicFuncArg);
 
         CPPADCG_ASSERT_KNOWN(ret != 1, "Second-order reverse mode failed: py[2*i] (i=0...m) must be zero.")
@@ -592,6 +629,7 @@ public:
             (*_reverseTwoSparsity)(j, &pos, &nnz);
 
             in[1] = &tx1[ej];
+            prepareWorkspace();
             int ret = (*_sparseReverseTwo)(j, &in[0], &_out[0], _atomicFuncArg);
 
             CPPADCG_ASSERT_KNOWN(ret == 0, "Second-order reverse mode failed.") // generic failure
@@ -629,6 +667,7 @@ public:
             _in[0] = x.data();
             _out[0] = &compressed[0];
 
+            prepareWorkspace();
             (*_sparseJacobian)(&_in[0], &_out[0], _atomicFuncArg);
         }
 
@@ -662,6 +701,7 @@ public:
             _in[0] = &x[0];
             _out[0] = &jac[0];
 
+            prepareWorkspace();
             (*_sparseJacobian)(&_in[0], &_out[0], _atomicFuncArg);
             std::copy(drow, drow + nnz, row.begin());
             std::copy(dcol, dcol + nnz, col.begin());
@@ -691,6 +731,7 @@ public:
             _in[0] = x.data();
             _out[0] = jac.data();
 
+            prepareWorkspace();
             (*_sparseJacobian)(&_in[0], &_out[0], _atomicFuncArg);
         }
     }
@@ -715,6 +756,7 @@ public:
         if (nnz > 0) {
             _out[0] = jac.data();
 
+            prepareWorkspace();
             (*_sparseJacobian)(&x[0], &_out[0], _atomicFuncArg);
         }
     }
@@ -747,6 +789,7 @@ public:
             _inHess[1] = w.data();
             _out[0] = &compressed[0];
 
+            prepareWorkspace();
             (*_sparseHessian)(&_inHess[0], &_out[0], _atomicFuncArg);
         }
 
@@ -786,6 +829,7 @@ public:
             _inHess[1] = &w[0];
             _out[0] = &hess[0];
 
+            prepareWorkspace();
             (*_sparseHessian)(&_inHess[0], &_out[0], _atomicFuncArg);
         }
     }
@@ -815,6 +859,7 @@ public:
             _inHess[1] = w.data();
             _out[0] = hess.data();
 
+            prepareWorkspace();
             (*_sparseHessian)(&_inHess[0], &_out[0], _atomicFuncArg);
         }
     }
@@ -842,6 +887,7 @@ public:
             _inHess.back() = w.data(); // the index might not be 1
             _out[0] = hess.data();
 
+            prepareWorkspace();
             (*_sparseHessian)(&_inHess[0], &_out[0], _atomicFuncArg);
         }
     }
@@ -877,7 +923,10 @@ protected:
         _jacobianSparsity(nullptr),
         _hessianSparsity(nullptr),
         _hessianSparsity2(nullptr),
-        _atomicFunctions(nullptr) {
+        _atomicFunctions(nullptr),
+        _workspaceSize(nullptr),
+        _userWorkspace(nullptr),
+        _userWorkspaceSize(0) {
 
     }
 
@@ -943,6 +992,7 @@ protected:
         _hessianSparsity = reinterpret_cast<decltype(_hessianSparsity)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_HESSIAN_SPARSITY, false));
         _hessianSparsity2 = reinterpret_cast<decltype(_hessianSparsity2)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_HESSIAN_SPARSITY2, false));
         _atomicFunctions = reinterpret_cast<decltype(_atomicFunctions)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_ATOMIC_FUNC_NAMES, true));
+        _workspaceSize = reinterpret_cast<decltype(_workspaceSize)>(loadFunction(_name + "_" + ModelCSourceGen<Base>::FUNCTION_WORKSPACE_SIZE, false));
 
         CPPADCG_ASSERT_KNOWN((_sparseForwardOne == nullptr) == (_forwardOneSparsity == nullptr), "Missing functions in the dynamic library")
         CPPADCG_ASSERT_KNOWN((_sparseForwardOne == nullptr) == (_forwardOne == nullptr), "Missing functions in the dynamic library")
@@ -1032,6 +1082,30 @@ protected:
         _jacobianSparsity = nullptr;
         _hessianSparsity = nullptr;
         _hessianSparsity2 = nullptr;
+        _workspaceSize = nullptr;
+    }
+
+    /**
+     * Provides the workspace to the compiled functions (if they use one)
+     */
+    inline void prepareWorkspace() {
+        if (_workspaceSize == nullptr)
+            return;
+
+        size_t size = getWorkspaceSize();
+
+        if (_userWorkspace != nullptr) {
+            CPPADCG_ASSERT_KNOWN(size <= _userWorkspaceSize, "The workspace is too small for the compiled model")
+            _atomicFuncArg.workspace = _userWorkspace;
+            return;
+        }
+
+        const size_t alignment = LanguageC<Base>::WORKSPACE_ALIGNMENT;
+        if (_workspace.size() < size + alignment) {
+            _workspace.resize(size + alignment);
+        }
+        auto address = reinterpret_cast<std::uintptr_t>(_workspace.data());
+        _atomicFuncArg.workspace = _workspace.data() + (alignment - address % alignment) % alignment;
     }
 
 private:
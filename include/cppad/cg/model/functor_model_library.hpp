@@ -42,6 +42,17 @@ protected:
     float (*_getThreadPoolGuidedMaxWork)();
     void (*_setThreadPoolNumberOfTimeMeas)(unsigned int n);
     unsigned int (*_getThreadPoolNumberOfTimeMeas)();
+    int (*_setThreadPoolExecutor)(const ThreadPoolExecutor*);
+    void (*_setThreadPoolTimeReference)(int r);
+    int (*_getThreadPoolTimeReference)();
+    void (*_setThreadPoolEwmaAlpha)(float a);
+    float (*_getThreadPoolEwmaAlpha)();
+    void (*_setThreadPoolRebalancePeriod)(unsigned int n);
+    unsigned int (*_getThreadPoolRebalancePeriod)();
+    float (*_getThreadPoolLastImbalance)();
+    float (*_getThreadPoolAverageImbalance)();
+    unsigned int (*_getThreadPoolNumberOfImbalanceMeas)();
+    void (*_resetThreadPoolImbalance)();
 public:
 
     std::set<std::string> getModelNames() override {
@@ -166,6 +177,83 @@ public:
         return 0;
     }
 
+    bool setThreadPoolExecutor(const ThreadPoolExecutor* executor) override {
+        if (_setThreadPoolExecutor == nullptr) {
+            return false;
+        }
+
+        if ((*_setThreadPoolExecutor)(executor) != 0) {
+            throw CGException("Invalid thread pool executor: all callbacks must be defined");
+        }
+        return true;
+    }
+
+    void setThreadPoolTimeReference(ThreadPoolTimeReference r) override {
+        if (_setThreadPoolTimeReference != nullptr) {
+            (*_setThreadPoolTimeReference)(int(r));
+        }
+    }
+
+    ThreadPoolTimeReference getThreadPoolTimeReference() const override {
+        if (_getThreadPoolTimeReference != nullptr) {
+            return ThreadPoolTimeReference((*_getThreadPoolTimeReference)());
+        }
+        return ThreadPoolTimeReference::MINIMUM;
+    }
+
+    void setThreadPoolEwmaAlpha(float alpha) override {
+        if (_setThreadPoolEwmaAlpha != nullptr) {
+            (*_setThreadPoolEwmaAlpha)(alpha);
+        }
+    }
+
+    float getThreadPoolEwmaAlpha() const override {
+        if (_getThreadPoolEwmaAlpha != nullptr) {
+            return (*_getThreadPoolEwmaAlpha)();
+        }
+        return 0;
+    }
+
+    void setThreadPoolRebalancePeriod(unsigned int n) override {
+        if (_setThreadPoolRebalancePeriod != nullptr) {
+            (*_setThreadPoolRebalancePeriod)(n);
+        }
+    }
+
+    unsigned int getThreadPoolRebalancePeriod() const override {
+        if (_getThreadPoolRebalancePeriod != nullptr) {
+            return (*_getThreadPoolRebalancePeriod)();
+        }
+        return 0;
+    }
+
+    float getThreadPoolLastImbalance() const override {
+        if (_getThreadPoolLastImbalance != nullptr) {
+            return (*_getThreadPoolLastImbalance)();
+        }
+        return 0;
+    }
+
+    float getThreadPoolAverageImbalance() const override {
+        if (_getThreadPoolAverageImbalance != nullptr) {
+            return (*_getThreadPoolAverageImbalance)();
+        }
+        return 0;
+    }
+
+    unsigned int getThreadPoolNumberOfImbalanceMeas() const override {
+        if (_getThreadPoolNumberOfImbalanceMeas != nullptr) {
+            return (*_getThreadPoolNumberOfImbalanceMeas)();
+        }
+        return 0;
+    }
+
+    void resetThreadPoolImbalance() override {
+        if (_resetThreadPoolImbalance != nullptr) {
+            (*_resetThreadPoolImbalance)();
+        }
+    }
+
     inline virtual ~FunctorModelLibrary() = default;
 
 protected:
@@ -183,7 +271,18 @@ protected:
             _setThreadPoolGuidedMaxWork(nullptr),
             _getThreadPoolGuidedMaxWork(nullptr),
             _setThreadPoolNumberOfTimeMeas(nullptr),
-            _getThreadPoolNumberOfTimeMeas(nullptr) {
+            _getThreadPoolNumberOfTimeMeas(nullptr),
+            _setThreadPoolExecutor(nullptr),
+            _setThreadPoolTimeReference(nullptr),
+            _getThreadPoolTimeReference(nullptr),
+            _setThreadPoolEwmaAlpha(nullptr),
+            _getThreadPoolEwmaAlpha(nullptr),
+            _setThreadPoolRebalancePeriod(nullptr),
+            _getThreadPoolRebalancePeriod(nullptr),
+            _getThreadPoolLastImbalance(nullptr),
+            _getThreadPoolAverageImbalance(nullptr),
+            _getThreadPoolNumberOfImbalanceMeas(nullptr),
+            _resetThreadPoolImbalance(nullptr) {
     }
 
     inline void validate() {
@@ -233,6 +332,17 @@ protected:
         _getThreadPoolGuidedMaxWork = reinterpret_cast<decltype(_getThreadPoolGuidedMaxWork)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLGUIDEDMAXGROUPWORK, false));
         _setThreadPoolNumberOfTimeMeas = reinterpret_cast<decltype(_setThreadPoolNumberOfTimeMeas)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLNUMBEROFTIMEMEAS, false));
         _getThreadPoolNumberOfTimeMeas = reinterpret_cast<decltype(_getThreadPoolNumberOfTimeMeas)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLNUMBEROFTIMEMEAS, false));
+        _setThreadPoolExecutor = reinterpret_cast<decltype(_setThreadPoolExecutor)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLEXECUTOR, false));
+        _setThreadPoolTimeReference = reinterpret_cast<decltype(_setThreadPoolTimeReference)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLTIMEREFERENCE, false));
+        _getThreadPoolTimeReference = reinterpret_cast<decltype(_getThreadPoolTimeReference)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLTIMEREFERENCE, false));
+        _setThreadPoolEwmaAlpha = reinterpret_cast<decltype(_setThreadPoolEwmaAlpha)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLEWMAALPHA, false));
+        _getThreadPoolEwmaAlpha = reinterpret_cast<decltype(_getThreadPoolEwmaAlpha)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLEWMAALPHA, false));
+        _setThreadPoolRebalancePeriod = reinterpret_cast<decltype(_setThreadPoolRebalancePeriod)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLREBALANCEPERIOD, false));
+        _getThreadPoolRebalancePeriod = reinterpret_cast<decltype(_getThreadPoolRebalancePeriod)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLREBALANCEPERIOD, false));
+        _getThreadPoolLastImbalance = reinterpret_cast<decltype(_getThreadPoolLastImbalance)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLLASTIMBALANCE, false));
+        _getThreadPoolAverageImbalance = reinterpret_cast<decltype(_getThreadPoolAverageImbalance)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLAVERAGEIMBALANCE, false));
+        _getThreadPoolNumberOfImbalanceMeas = reinterpret_cast<decltype(_getThreadPoolNumberOfImbalanceMeas)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLNUMBEROFIMBALANCEMEAS, false));
+        _resetThreadPoolImbalance = reinterpret_cast<decltype(_resetThreadPoolImbalance)> (this->loadFunction(ModelLibraryCSourceGen<Base>::FUNCTION_RESETTHREADPOOLIMBALANCE, false));
 
         if(_setThreads != nullptr) {
             (*_setThreads)(std::thread::hardware_concurrency());
@@ -745,6 +745,36 @@ public:
                                size_t const** row,
                                size_t const** col) = 0;
 
+    /**
+     * Provides the number of bytes of the workspace used by the compiled
+     * model for its temporary arrays
+     * (see ModelCSourceGen::setTemporaryWorkspace()).
+     * It can change with the number of threads used by the multithreaded
+     * functions since each thread uses its own part of the workspace.
+     *
+     * @return the workspace size in bytes (zero if no workspace is required)
+     */
+    virtual size_t getWorkspaceSize() {
+        return 0;
+    }
+
+    /**
+     * Defines the workspace used by the compiled model for its temporary
+     * arrays. If no workspace is provided, one is allocated internally when
+     * required.
+     * It is ignored by models which do not require a workspace.
+     *
+     * @param workspace The workspace memory which must be aligned to 64
+     *                  bytes (nullptr to use an internal workspace).
+     *                  It must not be released or used by other models while
+     *                  it is used by this model.
+     * @param size The number of bytes of the workspace (at least
+     *             getWorkspaceSize())
+     */
+    virtual void setWorkspace(void* workspace,
+                              size_t size) {
+    }
+
     /**
      * Provides a wrapper for this compiled model allowing it to be used as
      * an atomic function. The model must not be deleted while the atomic
@@ -192,6 +192,36 @@ public:
         return lib;
     }
 
+    /**
+     * Creates a model library in a background thread.
+     * Progress is reported to the JobListeners registered in the
+     * ModelLibraryCSourceGen and the task can be cancelled through
+     * ModelLibraryCSourceGen::requestCancel().
+     * This processor must not be used or deleted until the future is ready.
+     *
+     * @return a future for the model library
+     */
+    std::future<std::unique_ptr<LlvmModelLibrary<Base>>> createAsync() {
+        return this->runAsync([this]() {
+            return this->create();
+        });
+    }
+
+    /**
+     * Creates a LLVM model library in a background thread using an
+     * external Clang compiler to generate the bitcode.
+     * This processor and the compiler must not be used or deleted until
+     * the future is ready.
+     *
+     * @param clang  the external compiler
+     * @return a future for the model library
+     */
+    std::future<std::unique_ptr<LlvmModelLibrary<Base>>> createAsync(ClangCompiler<Base>& clang) {
+        return this->runAsync([this, &clang]() {
+            return this->create(clang);
+        });
+    }
+
 protected:
 
     virtual void createLlvmModules(const std::map<std::string, std::string>& sources) {
@@ -60,6 +60,7 @@ public:
     static const std::string FUNCTION_REVERSE_TWO_SPARSITY;
     static const std::string FUNCTION_INFO;
     static const std::string FUNCTION_ATOMIC_FUNC_NAMES;
+    static const std::string FUNCTION_WORKSPACE_SIZE;
 protected:
     static const std::string CONST;
 
@@ -149,6 +150,12 @@ protected:
      * loop models
      */
     std::set<LoopModel<Base>*> _loopTapes;
+    /**
+     * whether or not _funNoLoops and _loopTapes are deleted by this object
+     * (they are shared with the workers used to generate source code in
+     * parallel)
+     */
+    bool _ownsLoopModels;
     /**
      * the name of the model
      */
@@ -161,6 +168,44 @@ protected:
      * the maximum precision used to print values
      */
     size_t _parameterPrecision;
+    /**
+     * whether or not to print values with the fewest digits which preserve
+     * their exact value
+     */
+    bool _roundTripParameters;
+    /**
+     * whether or not to save the constant values of each source file in a
+     * static array
+     */
+    bool _constantPool;
+    /**
+     * whether or not to generate vectorization hints for loops
+     */
+    bool _loopVectorization;
+    /**
+     * whether or not to simplify the operation graphs before generating
+     * source code
+     */
+    bool _simplifyOperations;
+    /**
+     * whether or not to replace mathematical functions with cheaper
+     * equivalent forms
+     */
+    bool _mathLowering;
+    /**
+     * how multiply-add operations are written in the generated source code
+     */
+    FusedMultiplyAdd _fusedMultiplyAdd;
+    /**
+     * whether or not to use approximate implementations of exp, log, pow,
+     * and tanh
+     */
+    bool _approximateMath;
+    /**
+     * whether or not the temporary arrays of the generated functions are
+     * placed in a workspace provided by the caller
+     */
+    bool _temporaryWorkspace;
     /**
      * Typical values of the independent vector
      */
@@ -171,6 +216,12 @@ protected:
      * model library (experimental).
      */
     bool _multiThreading;
+    /**
+     * The number of groups of elements used to evaluate the sparse Jacobian
+     * and the sparse Hessian in parallel (partitioned multithreading is not
+     * used if lower than 2)
+     */
+    size_t _multiThreadingPartitions;
     /// generate source code for the zero order model evaluation
     bool _zero;
     bool _zeroEvaluated;
@@ -226,6 +277,10 @@ protected:
      * Maps each atomic function ID to information regarding how the atomic function is used
      */
     std::map<size_t, AtomicUseInfo<Base> >* _atomicsInfo;
+    /**
+     * The largest workspace (in bytes) required by a generated function
+     */
+    size_t _workspaceSize;
     /**
      * A string cache for code generation
      */
@@ -238,10 +293,40 @@ protected:
      * the maximum number of operations per variable assignment
      */
     size_t _maxOperationsPerAssignment;
+    /**
+     * whether or not to split the generated functions using a cost model
+     * instead of the maximum number of assignments per function
+     */
+    bool _automaticFunctionSplitting;
+    /**
+     * the cost model used by the automatic function splitting
+     */
+    typename LanguageC<Base>::FunctionSplitCostModel _splitCost;
+    /**
+     * the functions chosen by the automatic function splitting
+     * (function name -> operations in each function)
+     */
+    std::map<std::string, std::vector<typename LanguageC<Base>::FunctionChunk> > _functionPartitions;
+    /**
+     * the groups used by the partitioned multithreading
+     * (function name -> operations used by all the dependents and the
+     * operations evaluated by each group)
+     */
+    std::map<std::string, std::pair<size_t, std::vector<size_t> > > _dependentPartitions;
+    /**
+     * The maximum number of threads used to generate the source code of
+     * independent functions
+     */
+    size_t _generationThreads;
     /**
      *
      */
     std::vector<std::set<size_t> > _relatedDepCandidates;
+    /**
+     * Whether or not to determine the related dependent candidates from
+     * the structure of the expressions when none are provided
+     */
+    bool _autoRelatedDependents;
     /**
      * Maps the column groups of each loop model to the set of columns
      * (loop->group->{columns->{compressed forward 1 position} })
@@ -280,6 +365,20 @@ protected:
      * Generated source code (maps file names to content)
      */
     std::map<std::string, std::string> _sources;
+    /**
+     * Receives the source files while they are generated (when defined the
+     * files are not kept in _sources)
+     */
+    SourceSink* _sink;
+    /**
+     * Used to pass source files to the sink from several generation threads
+     */
+    std::mutex* _sinkMutex;
+    /**
+     * Whether or not the generated source files were passed to a sink
+     * (and are no longer available)
+     */
+    bool _sourcesStreamed;
 public:
 
     /**
@@ -293,10 +392,20 @@ public:
                     std::string model) :
         _fun(fun),
         _funNoLoops(nullptr),
+        _ownsLoopModels(true),
         _name(std::move(model)),
         _baseTypeName(ModelCSourceGen<Base>::baseTypeName()),
         _parameterPrecision(std::numeric_limits<Base>::digits10),
+        _roundTripParameters(false),
+        _constantPool(false),
+        _loopVectorization(false),
+        _simplifyOperations(false),
+        _mathLowering(false),
+        _fusedMultiplyAdd(FusedMultiplyAdd::Compiler),
+        _approximateMath(false),
+        _temporaryWorkspace(false),
         _multiThreading(true),
+        _multiThreadingPartitions(0),
         _zero(true),
         _zeroEvaluated(false),
         _jacobian(false),
@@ -311,9 +420,16 @@ public:
         _sparseHessianReusesRev2(true),
         _jacMode(JacobianADMode::Automatic),
         _atomicsInfo(nullptr),
+        _workspaceSize(0),
         _maxAssignPerFunc(20000),
         _maxOperationsPerAssignment(1000),
-        _jobTimer(nullptr) {
+        _automaticFunctionSplitting(false),
+        _generationThreads(1),
+        _autoRelatedDependents(false),
+        _jobTimer(nullptr),
+        _sink(nullptr),
+        _sinkMutex(nullptr),
+        _sourcesStreamed(false) {
 
         CPPADCG_ASSERT_KNOWN(!_name.empty(), "Model name cannot be empty");
         CPPADCG_ASSERT_KNOWN((_name[0] >= 'a' && _name[0] <= 'z') ||
@@ -332,6 +448,80 @@ public:
     ModelCSourceGen(const ModelCSourceGen&) = delete;
     ModelCSourceGen& operator=(const ModelCSourceGen&) = delete;
 
+protected:
+
+    /**
+     * Creates a copy of the settings of another source generator which is
+     * used to generate source code in a different thread.
+     *
+     * The loop models are shared with the original object (they are not
+     * deleted by the new object).
+     *
+     * @param orig The original source generator
+     * @param fun A copy of the taped model for the exclusive use of the new
+     *            object
+     */
+    ModelCSourceGen(const ModelCSourceGen& orig,
+                    ADFun<CppAD::cg::CG<Base> >& fun) :
+        _fun(fun),
+        _funNoLoops(orig._funNoLoops),
+        _loopTapes(orig._loopTapes),
+        _ownsLoopModels(false),
+        _name(orig._name),
+        _baseTypeName(orig._baseTypeName),
+        _parameterPrecision(orig._parameterPrecision),
+        _roundTripParameters(orig._roundTripParameters),
+        _constantPool(orig._constantPool),
+        _loopVectorization(orig._loopVectorization),
+        _simplifyOperations(orig._simplifyOperations),
+        _mathLowering(orig._mathLowering),
+        _fusedMultiplyAdd(orig._fusedMultiplyAdd),
+        _approximateMath(orig._approximateMath),
+        _temporaryWorkspace(orig._temporaryWorkspace),
+        _x(orig._x),
+        _multiThreading(orig._multiThreading),
+        _multiThreadingPartitions(orig._multiThreadingPartitions),
+        _zero(orig._zero),
+        _zeroEvaluated(orig._zeroEvaluated),
+        _jacobian(orig._jacobian),
+        _hessian(orig._hessian),
+        _sparseJacobian(orig._sparseJacobian),
+        _sparseHessian(orig._sparseHessian),
+        _hessianByEquation(orig._hessianByEquation),
+        _forwardOne(orig._forwardOne),
+        _reverseOne(orig._reverseOne),
+        _reverseTwo(orig._reverseTwo),
+        _sparseJacobianReusesOne(orig._sparseJacobianReusesOne),
+        _sparseHessianReusesRev2(orig._sparseHessianReusesRev2),
+        _jacMode(orig._jacMode),
+        _custom_jac(orig._custom_jac),
+        _jacSparsity(orig._jacSparsity),
+        _custom_hess(orig._custom_hess),
+        _hessSparsity(orig._hessSparsity),
+        _hessSparsities(orig._hessSparsities),
+        _atomicFunctions(orig._atomicFunctions),
+        _atomicsInfo(nullptr),
+        _workspaceSize(0),
+        _maxAssignPerFunc(orig._maxAssignPerFunc),
+        _maxOperationsPerAssignment(orig._maxOperationsPerAssignment),
+        _automaticFunctionSplitting(orig._automaticFunctionSplitting),
+        _splitCost(orig._splitCost),
+        _generationThreads(1),
+        _autoRelatedDependents(orig._autoRelatedDependents),
+        _loopFor1Groups(orig._loopFor1Groups),
+        _nonLoopFor1Elements(orig._nonLoopFor1Elements),
+        _loopRev1Groups(orig._loopRev1Groups),
+        _nonLoopRev1Elements(orig._nonLoopRev1Elements),
+        _loopRev2Groups(orig._loopRev2Groups),
+        _nonLoopRev2Elements(orig._nonLoopRev2Elements),
+        _jobTimer(nullptr),
+        _sink(orig._sink),
+        _sinkMutex(orig._sinkMutex),
+        _sourcesStreamed(false) {
+    }
+
+public:
+
     /**
      * Provides the model name which should be a valid C function name.
      *
@@ -341,6 +531,70 @@ public:
         return _name;
     }
 
+    /**
+     * Source code generation by a thread with its own CppAD thread number
+     * (e.g. in the background) while this object exists.
+     *
+     * The taped model is replaced by a copy created by the current thread
+     * and the loop models which already exist use copies created by the
+     * current thread (see ThreadLocalTapes).
+     * The loop models created in the meantime are deleted at the end since
+     * their memory belongs to the current thread.
+     * CppAD memory allocated by the current thread is therefore returned
+     * by this thread and the original tape is not modified.
+     * The model must not be used by other threads while this object
+     * exists.
+     */
+    class ThreadTape {
+    private:
+        ModelCSourceGen& gen_;
+        /**
+         * the original taped model while this object exists
+         */
+        std::unique_ptr<ADFun<CGBase> > fun_;
+        /**
+         * whether or not the loop models were created before this object
+         */
+        const bool loopModels_;
+    public:
+
+        inline explicit ThreadTape(ModelCSourceGen& gen) :
+            gen_(gen),
+            fun_(new ADFun<CGBase>()),
+            loopModels_(gen._funNoLoops != nullptr || !gen._loopTapes.empty()) {
+            *fun_ = gen_._fun;
+            gen_._fun.swap(*fun_);
+
+            if (loopModels_) {
+                if (gen_._funNoLoops != nullptr)
+                    gen_._funNoLoops->enableThreadTapes();
+                for (LoopModel<Base>* l : gen_._loopTapes)
+                    l->enableThreadTapes();
+            }
+        }
+
+        ThreadTape(const ThreadTape&) = delete;
+        ThreadTape& operator=(const ThreadTape&) = delete;
+
+        inline ~ThreadTape() {
+            gen_._fun.swap(*fun_);
+            fun_.reset();
+
+            if (loopModels_) {
+                if (gen_._funNoLoops != nullptr) {
+                    gen_._funNoLoops->releaseThreadTape();
+                    gen_._funNoLoops->disableThreadTapes();
+                }
+                for (LoopModel<Base>* l : gen_._loopTapes) {
+                    l->releaseThreadTape();
+                    l->disableThreadTapes();
+                }
+            } else {
+                gen_.deleteLoopModels();
+            }
+        }
+    };
+
     /**
      * Defines typical values for the independent variable vector. These
      * values can be useful when there is a need to call atomic functions,
@@ -367,6 +621,29 @@ public:
         return _relatedDepCandidates;
     }
 
+    /**
+     * Whether or not the groups of related dependents used to detect loops
+     * are determined automatically when they are not provided with
+     * setRelatedDependents().
+     */
+    inline bool isAutomaticRelatedDependents() const {
+        return _autoRelatedDependents;
+    }
+
+    /**
+     * Defines whether or not the groups of related dependents used to
+     * detect loops are determined automatically when they are not provided
+     * with setRelatedDependents().
+     * Dependents are grouped by a structural hash of their expressions
+     * which ignores the independent variables that are used
+     * (see DependentStructureHasher).
+     *
+     * @param autoRelated true to search for related dependents
+     */
+    inline void setAutomaticRelatedDependents(bool autoRelated) {
+        _autoRelatedDependents = autoRelated;
+    }
+
     /**
      * Provides the maximum precision used to print constant values in the
      * generated source code
@@ -387,15 +664,204 @@ public:
         _parameterPrecision = p;
     }
 
+    /**
+     * Whether or not constant values are printed with the fewest digits
+     * which are converted back to exactly the same value
+     * (see LanguageC::setRoundTripParameters()).
+     *
+     * @return true if the parameter precision is determined for each value
+     */
+    inline bool isRoundTripParameters() const {
+        return _roundTripParameters;
+    }
+
+    /**
+     * Defines whether or not constant values are printed with the fewest
+     * digits which are converted back to exactly the same value instead of
+     * using the parameter precision (see LanguageC::setRoundTripParameters()).
+     *
+     * @param roundTrip whether or not to print the shortest round-trip
+     *                  representation of constant values
+     */
+    inline void setRoundTripParameters(bool roundTrip) {
+        _roundTripParameters = roundTrip;
+    }
+
+    /**
+     * Whether or not the constant values of each source file are saved in
+     * a static array (see LanguageC::setConstantPool()).
+     *
+     * @return true if a constant pool is used
+     */
+    inline bool isConstantPool() const {
+        return _constantPool;
+    }
+
+    /**
+     * Defines whether or not the constant values of each source file are
+     * saved in a static array and referenced by index instead of being
+     * repeated in the expressions (see LanguageC::setConstantPool()).
+     *
+     * @param pool whether or not to use a constant pool
+     */
+    inline void setConstantPool(bool pool) {
+        _constantPool = pool;
+    }
+
+    /**
+     * Whether or not vectorization hints are generated for the loops
+     * created by the pattern detection (see LanguageC::setLoopVectorization()).
+     *
+     * @return true if vectorization hints are generated
+     */
+    inline bool isLoopVectorization() const {
+        return _loopVectorization;
+    }
+
+    /**
+     * Defines whether or not to generate vectorization hints for the loops
+     * created by the pattern detection (see LanguageC::setLoopVectorization()).
+     * The generated code should be compiled with -fopenmp-simd (or -fopenmp).
+     *
+     * @param vectorize whether or not to generate vectorization hints
+     */
+    inline void setLoopVectorization(bool vectorize) {
+        _loopVectorization = vectorize;
+    }
+
+    /**
+     * Whether or not the operation graphs are simplified before generating
+     * source code (see CodeHandler::setSimplifyOperations()).
+     *
+     * @return true if the operation graphs are simplified
+     */
+    inline bool isSimplifyOperations() const {
+        return _simplifyOperations;
+    }
+
+    /**
+     * Defines whether or not to simplify the operation graphs before
+     * generating source code: constant folding, removal of algebraic
+     * identities, and merging of equivalent operations
+     * (see CodeHandler::setSimplifyOperations()).
+     *
+     * @param simplify whether or not to simplify the operation graphs
+     */
+    inline void setSimplifyOperations(bool simplify) {
+        _simplifyOperations = simplify;
+    }
+
+    /**
+     * Whether or not some mathematical functions are replaced by cheaper
+     * equivalent forms (see LanguageC::setMathLowering()).
+     *
+     * @return true if the mathematical functions are lowered
+     */
+    inline bool isMathLowering() const {
+        return _mathLowering;
+    }
+
+    /**
+     * Defines whether or not to replace some mathematical functions by
+     * cheaper equivalent forms: pow() with small integer and half integer
+     * exponents, sin/cos pairs, and cosh/tanh/pow which can reuse exp, sinh,
+     * or log of the same argument (see LanguageC::setMathLowering()).
+     *
+     * @param lowering whether or not to lower mathematical functions
+     */
+    inline void setMathLowering(bool lowering) {
+        _mathLowering = lowering;
+    }
+
+    /**
+     * Provides how multiply-add operations are written in the generated
+     * source code (see LanguageC::setFusedMultiplyAdd()).
+     *
+     * @return the fused multiply-add mode
+     */
+    inline FusedMultiplyAdd getFusedMultiplyAdd() const {
+        return _fusedMultiplyAdd;
+    }
+
+    /**
+     * Defines how multiply-add operations are written in the generated
+     * source code (see LanguageC::setFusedMultiplyAdd()).
+     * FusedMultiplyAdd::Deterministic provides the same results regardless
+     * of the compiler flags.
+     *
+     * @param fma the fused multiply-add mode
+     */
+    inline void setFusedMultiplyAdd(FusedMultiplyAdd fma) {
+        _fusedMultiplyAdd = fma;
+    }
+
+    /**
+     * Whether or not exp(), log(), pow(), and tanh() are evaluated by
+     * approximate implementations (see LanguageC::setApproximateMath()).
+     *
+     * @return true if the approximate implementations are used
+     */
+    inline bool isApproximateMath() const {
+        return _approximateMath;
+    }
+
+    /**
+     * Defines whether or not exp(), log(), pow(), and tanh() are evaluated
+     * by approximate implementations with bounded relative errors
+     * (see LanguageC::setApproximateMath()).
+     * Useful for residuals evaluated in the inner iterations of solvers.
+     * The approximate implementations are only available for double.
+     *
+     * @param approximate whether or not to use the approximate implementations
+     * @throws CGException if Base is not double
+     */
+    inline void setApproximateMath(bool approximate) {
+        if (approximate && !std::is_same<Base, double>::value)
+            throw CGException("Approximate math functions are only available for double");
+        _approximateMath = approximate;
+    }
+
+    /**
+     * Whether or not the temporary arrays of the generated functions are
+     * placed in a workspace provided by the caller instead of the stack
+     * (see LanguageC::setTemporaryWorkspace()).
+     *
+     * @return true if the temporary arrays are placed in a workspace
+     */
+    inline bool isTemporaryWorkspace() const {
+        return _temporaryWorkspace;
+    }
+
+    /**
+     * Defines whether or not the temporary arrays of the generated functions
+     * are placed in a workspace provided by the caller instead of the stack
+     * (see LanguageC::setTemporaryWorkspace()).
+     * Large models can otherwise require very large thread stacks.
+     * The compiled model allocates the workspace unless one is provided
+     * with GenericModel::setWorkspace().
+     * Each worker of the multithreaded sparse Jacobian and sparse Hessian
+     * uses its own part of the workspace.
+     *
+     * @param workspace whether or not to use a workspace for the temporary
+     *                  arrays
+     */
+    inline void setTemporaryWorkspace(bool workspace) {
+        _temporaryWorkspace = workspace;
+    }
+
     /**
      * Returns whether or not multithreading directives can be generated to
      * parallelize the sparse Jacobian and sparse Hessian evaluation.
      * Multithreaded code is only generated if requested by the model library.
-     * For the sparse Jacobian, the _sparseJacobianReusesOne must be enabled,
-     * at least one of _forwardOne and _reverseOne must be enabled, and loop
-     * detection must be disabled.
+     * For the sparse Jacobian, the _sparseJacobianReusesOne must be enabled
+     * and at least one of _forwardOne and _reverseOne must be enabled.
      * For the sparse Hessian, the _sparseHessianReusesRev2 and _reverseTwo
-     * must be enabled and loop detection must be disabled.
+     * must be enabled.
+     * Alternatively, the elements can be split into groups with
+     * setMultiThreadingPartitions().
+     * When loops are detected, each row/column of the Jacobian or Hessian
+     * (including the contributions from all loop iterations) is evaluated
+     * as an independent job.
      *
      * @return whether or not multithreading can be used for this model
      */
@@ -407,11 +873,12 @@ public:
      * Defines whether or not multithreading directives can be generated to
      * parallelize the sparse Jacobian and sparse Hessian evaluation.
      * Multithreaded code is only generated if requested by the model library.
-     * For the sparse Jacobian, the _sparseJacobianReusesOne must be enabled,
-     * at least one of _forwardOne and _reverseOne must be enabled, and loop
-     * detection must be disabled.
+     * For the sparse Jacobian, the _sparseJacobianReusesOne must be enabled
+     * and at least one of _forwardOne and _reverseOne must be enabled.
      * For the sparse Hessian, the _sparseHessianReusesRev2 and _reverseTwo
-     * must be enabled and loop detection must be disabled.
+     * must be enabled.
+     * Alternatively, the elements can be split into groups with
+     * setMultiThreadingPartitions().
      *
      * @param multiThreading whether or not multithreading can be used for this
      *                       model
@@ -420,12 +887,47 @@ public:
         _multiThreading = multiThreading;
     }
 
+    /**
+     * Provides the number of groups of elements used to evaluate the sparse
+     * Jacobian and the sparse Hessian in parallel.
+     *
+     * @return the number of groups (partitioned multithreading is not used
+     *         if lower than 2)
+     */
+    inline size_t getMultiThreadingPartitions() const {
+        return _multiThreadingPartitions;
+    }
+
+    /**
+     * Defines the number of groups of elements used to evaluate the sparse
+     * Jacobian and the sparse Hessian in parallel.
+     * The elements are split into groups with a similar number of
+     * operations which share as few operations with the other groups as
+     * possible and a function is created for each group.
+     * Unlike the multithreaded functions which reuse the forward/reverse
+     * one and reverse two functions, the operations shared by the elements
+     * of a group are only evaluated once.
+     * This option is only used when multithreading is enabled and requested
+     * by the model library and when no loops are detected; it takes
+     * precedence over _sparseJacobianReusesOne and _sparseHessianReusesRev2.
+     * Typically, it should be the number of threads used to evaluate the
+     * model.
+     *
+     * @param partitions the number of groups (partitioned multithreading is
+     *                   not used if lower than 2)
+     */
+    inline void setMultiThreadingPartitions(size_t partitions) {
+        _multiThreadingPartitions = partitions;
+    }
+
     inline bool isJacobianMultiThreadingEnabled() const {
-        return _multiThreading && _loopTapes.empty() && _sparseJacobian && _sparseJacobianReusesOne && (_forwardOne || _reverseOne);
+        return _multiThreading && _sparseJacobian &&
+               ((_sparseJacobianReusesOne && (_forwardOne || _reverseOne)) || (_multiThreadingPartitions > 1 && _loopTapes.empty()));
     }
 
     inline bool isHessianMultiThreadingEnabled() const {
-        return _multiThreading && _loopTapes.empty() && _sparseHessian && _sparseHessianReusesRev2 && _reverseTwo;
+        return _multiThreading && _sparseHessian &&
+               ((_sparseHessianReusesRev2 && _reverseTwo) || (_multiThreadingPartitions > 1 && _loopTapes.empty()));
     }
 
     /**
@@ -896,13 +1398,82 @@ public:
         _maxOperationsPerAssignment = maxOperationsPerAssignment;
     }
 
+    inline bool isAutomaticFunctionSplitting() const {
+        return _automaticFunctionSplitting;
+    }
+
+    /**
+     * Defines whether or not the generated functions are split into several
+     * functions/files using a cost model (see setFunctionSplitCostModel())
+     * instead of the maximum number of assignments per function.
+     * The cost model balances the estimated compilation time and memory of
+     * each function against the runtime cost of calling more functions
+     * (see LanguageC::setAutomaticFunctionSplitting()).
+     *
+     * @param automatic whether or not to use the cost model
+     */
+    inline void setAutomaticFunctionSplitting(bool automatic) {
+        _automaticFunctionSplitting = automatic;
+    }
+
+    inline const typename LanguageC<Base>::FunctionSplitCostModel& getFunctionSplitCostModel() const {
+        return _splitCost;
+    }
+
+    /**
+     * Defines the cost model used by the automatic function splitting.
+     */
+    inline void setFunctionSplitCostModel(const typename LanguageC<Base>::FunctionSplitCostModel& cost) {
+        _splitCost = cost;
+    }
+
+    /**
+     * Provides the functions chosen by the automatic function splitting
+     * during source code generation.
+     *
+     * @return maps the name of each split function to the operations in
+     *         each of its parts
+     */
+    inline const std::map<std::string, std::vector<typename LanguageC<Base>::FunctionChunk> >& getFunctionPartitions() const {
+        return _functionPartitions;
+    }
+
+    /**
+     * The maximum number of threads used to generate the source code of
+     * independent functions.
+     *
+     * @return The maximum number of threads used for source code generation
+     */
+    inline size_t getGenerationThreads() const {
+        return _generationThreads;
+    }
+
+    /**
+     * Defines the maximum number of threads used to generate the source code
+     * of independent functions (e.g. the function for each direction of the
+     * forward and reverse modes).
+     * Each thread uses its own copy of the taped model and its own
+     * CodeHandler, and the generated files are merged by name.
+     * For models with loops, the source code for each direction (e.g.
+     * forward one, reverse one, reverse two) is generated by a different
+     * thread and the loop models are shared using a copy of their tapes
+     * for each thread.
+     * Source code is only generated in parallel for models without atomic
+     * functions, and when CppAD has not been configured
+     * for multiple threads by the user (CppAD is configured by
+     * CppADThreadManager and it is in parallel mode while the threads run).
+     *
+     * @param nThreads The maximum number of threads (one for a sequential
+     *                 generation)
+     */
+    inline void setGenerationThreads(size_t nThreads) {
+        _generationThreads = nThreads;
+    }
+
     inline virtual ~ModelCSourceGen() {
-        delete _funNoLoops;
         delete _atomicsInfo;
 
-        for (LoopModel<Base>* it : _loopTapes) {
-            delete it;
-        }
+        deleteLoopModels();
     }
 
 public:
@@ -928,14 +1499,145 @@ protected:
     virtual void generateSources(MultiThreadingType multiThreadingType,
                                  JobTimer* timer = nullptr);
 
+    /**
+     * Generates the source code and passes each file to a sink as soon as
+     * it is created so that the files are not kept in memory.
+     * If the source code was previously generated, a copy of the existing
+     * files is passed to the sink instead.
+     *
+     * @param sink receives the source files
+     * @param multiThreadingType the multithreading type used in the library
+     * @param timer used to report the progress (optional)
+     */
+    virtual void generateSources(SourceSink& sink,
+                                 MultiThreadingType multiThreadingType,
+                                 JobTimer* timer = nullptr);
+
+    /**
+     * Passes the source files generated so far to the sink (if there is
+     * one) and releases them.
+     */
+    inline void flushSources();
+
     virtual void generateLoops();
 
     virtual void generateInfoSource();
 
     virtual void generateAtomicFuncNames();
 
+    virtual void generateWorkspaceSizeSource(MultiThreadingType multiThreadingType);
+
+    /**
+     * Applies the options of this model which affect how the source code
+     * of each function is written (function splitting, parameter
+     * precision, math lowering, ...).
+     *
+     * @param langC the language object used to generate a function
+     */
+    inline void configureLanguage(LanguageC<Base>& langC) {
+        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
+        langC.setAutomaticFunctionSplitting(_automaticFunctionSplitting);
+        langC.setFunctionSplitCostModel(_splitCost);
+        langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
+        langC.setParameterPrecision(_parameterPrecision);
+        langC.setRoundTripParameters(_roundTripParameters);
+        langC.setConstantPool(_constantPool);
+        langC.setMathLowering(_mathLowering);
+        langC.setFusedMultiplyAdd(_fusedMultiplyAdd);
+        langC.setApproximateMath(_approximateMath);
+        langC.setTemporaryWorkspace(_temporaryWorkspace);
+        langC.setLoopVectorization(_loopVectorization);
+    }
+
+    /**
+     * Keeps track of the largest workspace required by the generated
+     * functions.
+     *
+     * @param langC the language object used to generate a function
+     */
+    inline void updateWorkspaceSize(const LanguageC<Base>& langC) {
+        _workspaceSize = std::max(_workspaceSize, langC.getWorkspaceSize());
+    }
+
+    /**
+     * Saves the functions chosen by the automatic function splitting for
+     * the last function generated by a language.
+     */
+    inline void updateFunctionPartition(const LanguageC<Base>& langC);
+
+    /**
+     * Reports the functions chosen by the automatic function splitting
+     * (verbose mode only).
+     */
+    virtual void printFunctionPartitions();
+
+    /**
+     * Reports the groups used by the partitioned multithreading
+     * (verbose mode only).
+     */
+    virtual void printDependentPartitions();
+
     virtual bool isAtomicsUsed();
 
+    /**
+     * Deletes the loop models (if they belong to this object).
+     */
+    inline void deleteLoopModels() {
+        if (!_ownsLoopModels)
+            return;
+
+        delete _funNoLoops;
+        _funNoLoops = nullptr;
+        for (LoopModel<Base>* it : _loopTapes) {
+            delete it;
+        }
+        _loopTapes.clear();
+    }
+
+    /***********************************************************************
+     * parallel source generation
+     **********************************************************************/
+
+    using GenerationTask = std::function<void(ModelCSourceGen<Base>&)>;
+
+    /**
+     * Whether or not independent functions can be generated by several
+     * threads.
+     */
+    virtual bool isParallelGenerationPossible();
+
+    /**
+     * Creates a copy of this object to generate source code in another
+     * thread.
+     * Subclasses which change the generated source code should override
+     * this method.
+     *
+     * @param fun A copy of the taped model for the exclusive use of the worker
+     * @return the new source generator or null if it is not possible to use
+     *         a different object to generate source code
+     */
+    virtual ModelCSourceGen<Base>* createGenerationWorker(ADFun<CGBase>& fun);
+
+    /**
+     * Executes independent source generation tasks.
+     * The tasks can be executed by several threads (each with its own copy
+     * of this object) and the generated sources are merged into the sources
+     * of this object.
+     *
+     * @param tasks The source generation tasks
+     */
+    virtual void runGenerationTasks(const std::vector<GenerationTask>& tasks);
+
+    /**
+     * Splits the directions of a directional function (forward one, reverse
+     * one, or reverse two) into groups which can be generated independently.
+     *
+     * @param elements The elements for each direction
+     * @return the groups of directions (a single group for a sequential
+     *         source generation)
+     */
+    virtual std::vector<std::map<size_t, std::vector<size_t> > > splitDirections(const std::map<size_t, std::vector<size_t> >& elements);
+
     virtual const std::map<size_t, AtomicUseInfo<Base> >& getAtomicsInfo();
 
     /***********************************************************************
@@ -958,7 +1660,8 @@ protected:
 
     virtual void generateSparseJacobianSource(MultiThreadingType multiThreadingType);
 
-    virtual void generateSparseJacobianSource(bool forward);
+    virtual void generateSparseJacobianSource(bool forward,
+                                              MultiThreadingType multiThreadingType);
 
     virtual void generateSparseJacobianForRevSource(bool forward,
                                                     MultiThreadingType multiThreadingType);
@@ -1031,7 +1734,36 @@ protected:
                                                                  const std::string& keyName,
                                                                  const std::map<size_t, std::set<size_t> >& nonLoopElements,
                                                                  const std::map<LoopModel<Base>*, std::map<size_t, std::map<size_t, std::set<size_t> > > >& loopGroups,
-                                                                 void (*generateLocalFunctionName)(std::ostringstream& cache, const std::string& modelName, const LoopModel<Base>& loop, size_t g));
+                                                                 void (*generateLocalFunctionName)(std::ostringstream& cache, const std::string& modelName, const LoopModel<Base>& loop, size_t g),
+                                                                 MultiThreadingType multiThreadingType);
+
+    /**
+     * Generates a multithreaded driver for the sparse Jacobian or the sparse
+     * Hessian of a model with loops.
+     * Each row/column is a job which uses the global forward/reverse mode
+     * function (which includes the contributions from equations in loops)
+     * to determine its elements, therefore different jobs never write to
+     * the same element.
+     *
+     * @param functionName the name of the generated function
+     * @param matrixInfo the elements of each row/column
+     * @param localFunction the name of the global forward/reverse mode
+     *                      function which receives the row/column index
+     * @param suffix the suffix used for the job functions
+     * @param resultName the name of the output array
+     * @param inLocalSize the number of input arrays of the local function
+     * @param nnz the number of elements in the output array
+     * @param multiThreadingType the multithreading framework
+     * @return the source code
+     */
+    virtual std::string generateSparseForRevWithLoopsMultiThreadSource(const std::string& functionName,
+                                                                       const std::map<size_t, CompressedVectorInfo>& matrixInfo,
+                                                                       const std::string& localFunction,
+                                                                       const std::string& suffix,
+                                                                       const std::string& resultName,
+                                                                       size_t inLocalSize,
+                                                                       size_t nnz,
+                                                                       MultiThreadingType multiThreadingType);
 
     inline virtual void generateFunctionNameLoopFor1(std::ostringstream& cache,
                                                      const LoopModel<Base>& loop,
@@ -1059,7 +1791,7 @@ protected:
 
     virtual void generateSparseHessianSource(MultiThreadingType multiThreadingType);
 
-    virtual void generateSparseHessianSourceDirectly();
+    virtual void generateSparseHessianSourceDirectly(MultiThreadingType multiThreadingType);
 
     virtual void generateSparseHessianSourceFromRev2(MultiThreadingType multiThreadingType);
 
@@ -1123,7 +1855,8 @@ protected:
                                               bool useSymmetry);
 
     inline virtual void generateSparseHessianWithLoopsSourceFromRev2(const std::map<size_t, CompressedVectorInfo>& hessInfo,
-                                                                     size_t maxCompressedSize);
+                                                                     size_t maxCompressedSize,
+                                                                     MultiThreadingType multiThreadingType);
 
     inline virtual void generateFunctionNameLoopRev2(std::ostringstream& cache,
                                                      const LoopModel<Base>& loop,
@@ -1277,16 +2010,28 @@ protected:
      **********************************************************************/
 
     /**
-     *
+     * Prints the declarations required to submit jobs to the PThreads pool
+     * (or to a host executor, which uses the same API with a different
+     * prefix).
      */
     static void printFileStartPThreads(std::ostringstream& cache,
-                                       const std::string& baseTypeName);
+                                       const std::string& baseTypeName,
+                                       bool workspace = false,
+                                       MultiThreadingType multiThreadingType = MultiThreadingType::PTHREADS);
 
     static void printFunctionStartPThreads(std::ostringstream& cache,
-                                           size_t size);
+                                           size_t size,
+                                           MultiThreadingType multiThreadingType = MultiThreadingType::PTHREADS);
 
     static void printFunctionEndPThreads(std::ostringstream& cache,
-                                         size_t size);
+                                         size_t size,
+                                         MultiThreadingType multiThreadingType = MultiThreadingType::PTHREADS);
+
+    /**
+     * Provides the prefix of the C functions used to run jobs with the
+     * PThreads pool or with a host executor.
+     */
+    static const char* threadPoolPrefix(MultiThreadingType multiThreadingType);
 
     static void printFileStartOpenMP(std::ostringstream& cache);
 
@@ -1299,6 +2044,52 @@ protected:
     static void printLoopEndOpenMP(std::ostringstream& cache,
                                    size_t size);
 
+    /**
+     * Prints a function which provides the part of the workspace used by
+     * each worker of a multithreaded function.
+     */
+    void printWorkerWorkspaceFunction(std::ostringstream& cache) const;
+
+    static void printWorkerWorkspaceOpenMP(std::ostringstream& cache,
+                                           const std::string& atomicArgName);
+
+    /**
+     * Whether or not the sparse Jacobian/Hessian should be evaluated by
+     * several functions with groups of elements (partitioned
+     * multithreading).
+     */
+    inline bool isPartitionedMultiThreading(MultiThreadingType multiThreadingType) const {
+        return _multiThreading && _multiThreadingPartitions > 1 &&
+               multiThreadingType != MultiThreadingType::NONE && _loopTapes.empty();
+    }
+
+    /**
+     * Generates one function for each group of elements of the sparse
+     * Jacobian/Hessian, which share as few operations as possible, and a
+     * function which evaluates these groups in parallel.
+     *
+     * @param handler the code handler which owns the dependents
+     * @param dependents the elements of the sparse Jacobian/Hessian
+     * @param functionName the name of the parallel function
+     * @param nameGen the variable name generator for the complete
+     *                Jacobian/Hessian
+     * @param hessian whether or not the dependents are the elements of a
+     *                Hessian (the multipliers are an additional input)
+     * @param jobName the name of the job (used to report timings)
+     * @param multiThreadingType the multithreading framework
+     */
+    virtual void generatePartitionedSource(CodeHandler<Base>& handler,
+                                           std::vector<CGBase>& dependents,
+                                           const std::string& functionName,
+                                           VariableNameGenerator<Base>& nameGen,
+                                           bool hessian,
+                                           const std::string& jobName,
+                                           MultiThreadingType multiThreadingType);
+
+    virtual std::string generatePartitionedMultiThreadSource(const std::string& functionName,
+                                                             const std::vector<std::string>& partFunctions,
+                                                             MultiThreadingType multiThreadingType);
+
     /**
      *
      */
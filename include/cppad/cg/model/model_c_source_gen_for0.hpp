@@ -26,6 +26,7 @@ void ModelCSourceGen<Base>::generateZeroSource() {
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setSimplifyOperations(_simplifyOperations);
 
     std::vector<CGBase> indVars(_fun.Domain());
     handler.makeVariables(indVars);
@@ -49,15 +50,15 @@ void ModelCSourceGen<Base>::generateZeroSource() {
     finishedJob();
 
     LanguageC<Base> langC(_baseTypeName);
-    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
-    langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-    langC.setParameterPrecision(_parameterPrecision);
+    configureLanguage(langC);
     langC.setGenerateFunction(_name + "_" + FUNCTION_FORWAD_ZERO);
 
     std::ostringstream code;
     std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator());
 
     handler.generateCode(code, langC, dep, *nameGen, _atomicFunctions, jobName);
+    updateWorkspaceSize(langC);
+    updateFunctionPartition(langC);
 }
 
 
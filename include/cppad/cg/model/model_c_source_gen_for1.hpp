@@ -45,7 +45,13 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSources() {
     if (isAtomicsUsed()) {
         generateSparseForwardOneSourcesWithAtomics(elements);
     } else {
-        generateSparseForwardOneSourcesNoAtomics(elements);
+        std::vector<GenerationTask> tasks;
+        for (const auto& group : splitDirections(elements)) {
+            tasks.push_back([group](ModelCSourceGen<Base>& gen) {
+                gen.generateSparseForwardOneSourcesNoAtomics(group);
+            });
+        }
+        runGenerationTasks(tasks);
     }
 
     finishedJob();
@@ -84,6 +90,7 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesWithAtomics(const std
 
         CodeHandler<Base> handler;
         handler.setJobTimer(_jobTimer);
+        handler.setSimplifyOperations(_simplifyOperations);
 
         vector<CGBase> indVars(n);
         handler.makeVariables(indVars);
@@ -114,9 +121,7 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesWithAtomics(const std
         finishedJob();
 
         LanguageC<Base> langC(_baseTypeName);
-        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
-        langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-        langC.setParameterPrecision(_parameterPrecision);
+        configureLanguage(langC);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_FORWARD_ONE << "_indep" << j;
         langC.setGenerateFunction(_cache.str());
@@ -126,6 +131,9 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesWithAtomics(const std
         LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "dx", n);
 
         handler.generateCode(code, langC, dyCustom, nameGenHess, _atomicFunctions, subJobName);
+        updateWorkspaceSize(langC);
+        updateFunctionPartition(langC);
+        flushSources();
     }
 }
 
@@ -140,6 +148,7 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesNoAtomics(const std::
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setSimplifyOperations(_simplifyOperations);
 
     vector<CGBase> x(n);
     handler.makeVariables(x);
@@ -155,10 +164,21 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesNoAtomics(const std::
         dx.setValue(Base(1.0));
     }
 
-    vector<CGBase> jacFlat(_jacSparsity.rows.size());
+    // only the elements in the requested columns
+    std::vector<size_t> rows, cols;
+    rows.reserve(_jacSparsity.rows.size());
+    cols.reserve(_jacSparsity.cols.size());
+    for (size_t e = 0; e < _jacSparsity.rows.size(); e++) {
+        if (elements.find(_jacSparsity.cols[e]) != elements.end()) {
+            rows.push_back(_jacSparsity.rows[e]);
+            cols.push_back(_jacSparsity.cols[e]);
+        }
+    }
+
+    vector<CGBase> jacFlat(rows.size());
 
     CppAD::sparse_jacobian_work work; // temporary structure for CPPAD
-    _fun.SparseJacobianForward(x, _jacSparsity.sparsity, _jacSparsity.rows, _jacSparsity.cols, jacFlat, work);
+    _fun.SparseJacobianForward(x, _jacSparsity.sparsity, rows, cols, jacFlat, work);
 
     /**
      * organize results
@@ -179,9 +199,9 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesNoAtomics(const std::
         }
     }
 
-    for (size_t el = 0; el < _jacSparsity.rows.size(); el++) {
-        size_t i = _jacSparsity.rows[el];
-        size_t j = _jacSparsity.cols[el];
+    for (size_t el = 0; el < rows.size(); el++) {
+        size_t i = rows[el];
+        size_t j = cols[el];
         size_t e = positions[j].at(i);
 
         vector<CGBase>& column = jac[j];
@@ -201,9 +221,7 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesNoAtomics(const std::
         const std::string subJobName = _cache.str();
 
         LanguageC<Base> langC(_baseTypeName);
-        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
-        langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-        langC.setParameterPrecision(_parameterPrecision);
+        configureLanguage(langC);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_FORWARD_ONE << "_indep" << j;
         langC.setGenerateFunction(_cache.str());
@@ -213,6 +231,9 @@ void ModelCSourceGen<Base>::generateSparseForwardOneSourcesNoAtomics(const std::
         LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "dx", n);
 
         handler.generateCode(code, langC, dyCustom, nameGenHess, _atomicFunctions, subJobName);
+        updateWorkspaceSize(langC);
+        updateFunctionPartition(langC);
+        flushSources();
     }
 }
 
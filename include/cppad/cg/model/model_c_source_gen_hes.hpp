@@ -28,6 +28,7 @@ void ModelCSourceGen<Base>::generateHessianSource() {
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setSimplifyOperations(_simplifyOperations);
 
     size_t m = _fun.Range();
     size_t n = _fun.Domain();
@@ -63,9 +64,7 @@ void ModelCSourceGen<Base>::generateHessianSource() {
     finishedJob();
 
     LanguageC<Base> langC(_baseTypeName);
-    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
-    langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-    langC.setParameterPrecision(_parameterPrecision);
+    configureLanguage(langC);
     langC.setGenerateFunction(_name + "_" + FUNCTION_HESSIAN);
 
     std::ostringstream code;
@@ -73,6 +72,8 @@ void ModelCSourceGen<Base>::generateHessianSource() {
     LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), n);
 
     handler.generateCode(code, langC, hess, nameGenHess, _atomicFunctions, jobName);
+    updateWorkspaceSize(langC);
+    updateFunctionPartition(langC);
 }
 
 template<class Base>
@@ -82,15 +83,17 @@ void ModelCSourceGen<Base>::generateSparseHessianSource(MultiThreadingType multi
      */
     determineHessianSparsity();
 
-    if (_sparseHessianReusesRev2 && _reverseTwo) {
+    if (isPartitionedMultiThreading(multiThreadingType)) {
+        generateSparseHessianSourceDirectly(multiThreadingType);
+    } else if (_sparseHessianReusesRev2 && _reverseTwo) {
         generateSparseHessianSourceFromRev2(multiThreadingType);
     } else {
-        generateSparseHessianSourceDirectly();
+        generateSparseHessianSourceDirectly(MultiThreadingType::NONE);
     }
 }
 
 template<class Base>
-void ModelCSourceGen<Base>::generateSparseHessianSourceDirectly() {
+void ModelCSourceGen<Base>::generateSparseHessianSourceDirectly(MultiThreadingType multiThreadingType) {
     using std::vector;
 
     const std::string jobName = "sparse Hessian";
@@ -162,6 +165,7 @@ void ModelCSourceGen<Base>::generateSparseHessianSourceDirectly() {
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setSimplifyOperations(_simplifyOperations);
 
     // independent variables
     vector<CGBase> indVars(n);
@@ -210,17 +214,23 @@ void ModelCSourceGen<Base>::generateSparseHessianSourceDirectly() {
 
     finishedJob();
 
+    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("hess"));
+
+    if (isPartitionedMultiThreading(multiThreadingType)) {
+        generatePartitionedSource(handler, hess, _name + "_" + FUNCTION_SPARSE_HESSIAN, *nameGen, true, jobName, multiThreadingType);
+        return;
+    }
+
     LanguageC<Base> langC(_baseTypeName);
-    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
-    langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-    langC.setParameterPrecision(_parameterPrecision);
+    configureLanguage(langC);
     langC.setGenerateFunction(_name + "_" + FUNCTION_SPARSE_HESSIAN);
 
     std::ostringstream code;
-    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("hess"));
     LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), n);
 
     handler.generateCode(code, langC, hess, nameGenHess, _atomicFunctions, jobName);
+    updateWorkspaceSize(langC);
+    updateFunctionPartition(langC);
 }
 
 template<class Base>
@@ -285,7 +295,7 @@ void ModelCSourceGen<Base>::generateSparseHessianSourceFromRev2(MultiThreadingTy
         /**
          * with loops
          */
-        generateSparseHessianWithLoopsSourceFromRev2(hessInfo, maxCompressedSize);
+        generateSparseHessianWithLoopsSourceFromRev2(hessInfo, maxCompressedSize, multiThreadingType);
         return;
     }
 
@@ -435,6 +445,10 @@ std::string ModelCSourceGen<Base>::generateSparseHessianRev2MultiThreadSource(co
     _cache << "\n"
             "typedef void (*cppadcg_function_type) (" << argsDcl << ");\n";
 
+    if (_temporaryWorkspace) {
+        _cache << "\n";
+        printWorkerWorkspaceFunction(_cache);
+    }
 
     if (multiThreadingType == MultiThreadingType::OPENMP) {
         _cache << "\n";
@@ -445,9 +459,9 @@ std::string ModelCSourceGen<Base>::generateSparseHessianRev2MultiThreadSource(co
         /**
          * PThreads pool needs a function with a void pointer argument
          */
-        assert(multiThreadingType == MultiThreadingType::PTHREADS);
+        assert(multiThreadingType == MultiThreadingType::PTHREADS || multiThreadingType == MultiThreadingType::EXECUTOR);
 
-        printFileStartPThreads(_cache, _baseTypeName);
+        printFileStartPThreads(_cache, _baseTypeName, _temporaryWorkspace, multiThreadingType);
     }
 
     /**
@@ -487,15 +501,20 @@ std::string ModelCSourceGen<Base>::generateSparseHessianRev2MultiThreadSource(co
         printFunctionStartOpenMP(_cache, hessInfo.size());
         _cache << "\n";
         printLoopStartOpenMP(_cache, hessInfo.size());
+        if (_temporaryWorkspace) {
+            printWorkerWorkspaceOpenMP(_cache, langC.getArgumentAtomic());
+            langC.setArgumentAtomic(langC.getArgumentAtomic() + "Local");
+            argsLocal = langC.generateDefaultFunctionArguments();
+        }
         _cache << "      outLocal[0] = &hess[offset[i]];\n"
                 "      (*p[i])(" << argsLocal << ");\n";
         printLoopEndOpenMP(_cache, hessInfo.size());
         _cache << "\n";
 
     } else {
-        assert(multiThreadingType == MultiThreadingType::PTHREADS);
+        assert(multiThreadingType == MultiThreadingType::PTHREADS || multiThreadingType == MultiThreadingType::EXECUTOR);
 
-        printFunctionStartPThreads(_cache, hessInfo.size());
+        printFunctionStartPThreads(_cache, hessInfo.size(), multiThreadingType);
         _cache << "\n"
                 "   for(i = 0; i < " << hessInfo.size() << "; ++i) {\n"
                 "      args[i] = (ExecArgStruct*) malloc(sizeof(ExecArgStruct));\n"
@@ -505,7 +524,7 @@ std::string ModelCSourceGen<Base>::generateSparseHessianRev2MultiThreadSource(co
                 "      args[i]->atomicFun = " << langC .getArgumentAtomic() << ";\n"
                 "   }\n"
                 "\n";
-        printFunctionEndPThreads(_cache, hessInfo.size());
+        printFunctionEndPThreads(_cache, hessInfo.size(), multiThreadingType);
     }
 
     _cache << "\n"
@@ -77,6 +77,9 @@ const std::string ModelCSourceGen<Base>::FUNCTION_INFO = "info";
 template<class Base>
 const std::string ModelCSourceGen<Base>::FUNCTION_ATOMIC_FUNC_NAMES = "atomic_functions";
 
+template<class Base>
+const std::string ModelCSourceGen<Base>::FUNCTION_WORKSPACE_SIZE = "workspace_size";
+
 template<class Base>
 const std::string ModelCSourceGen<Base>::CONST = "const";
 
@@ -92,11 +95,61 @@ template<class Base>
 const std::map<std::string, std::string>& ModelCSourceGen<Base>::getSources(MultiThreadingType multiThreadingType,
                                                                             JobTimer* timer) {
     if (_sources.empty()) {
+        if (_sourcesStreamed) {
+            throw CGException("The sources of model '", _name, "' were already passed to a source sink");
+        }
         generateSources(multiThreadingType, timer);
     }
     return _sources;
 }
 
+template<class Base>
+void ModelCSourceGen<Base>::generateSources(SourceSink& sink,
+                                            MultiThreadingType multiThreadingType,
+                                            JobTimer* timer) {
+    if (_sourcesStreamed) {
+        throw CGException("The sources of model '", _name, "' were already passed to a source sink");
+    }
+
+    if (!_sources.empty()) {
+        // previously generated
+        for (const auto& it : _sources) {
+            std::string source = it.second;
+            sink.addSource(it.first, std::move(source));
+        }
+        return;
+    }
+
+    std::mutex sinkMutex;
+    _sink = &sink;
+    _sinkMutex = &sinkMutex;
+    _sourcesStreamed = true;
+
+    try {
+        generateSources(multiThreadingType, timer);
+        flushSources();
+    } catch (...) {
+        _sink = nullptr;
+        _sinkMutex = nullptr;
+        throw;
+    }
+
+    _sink = nullptr;
+    _sinkMutex = nullptr;
+}
+
+template<class Base>
+inline void ModelCSourceGen<Base>::flushSources() {
+    if (_sink == nullptr || _sources.empty())
+        return;
+
+    std::lock_guard<std::mutex> lock(*_sinkMutex);
+    for (auto& it : _sources) {
+        _sink->addSource(it.first, std::move(it.second));
+    }
+    _sources.clear();
+}
+
 template<class Base>
 void ModelCSourceGen<Base>::generateSources(MultiThreadingType multiThreadingType,
                                             JobTimer* timer) {
@@ -109,57 +162,124 @@ void ModelCSourceGen<Base>::generateSources(MultiThreadingType multiThreadingTyp
     if (_zero) {
         generateZeroSource();
         _zeroEvaluated = true;
+        flushSources();
     }
 
+    std::vector<GenerationTask> tasks;
+
     if (_jacobian) {
-        generateJacobianSource();
+        tasks.push_back([](ModelCSourceGen<Base>& gen) {
+            gen.generateJacobianSource();
+        });
     }
 
     if (_hessian) {
-        generateHessianSource();
+        tasks.push_back([](ModelCSourceGen<Base>& gen) {
+            gen.generateHessianSource();
+        });
     }
 
-    if (_forwardOne) {
-        generateSparseForwardOneSources();
-        generateForwardOneSources();
-    }
+    if (!_loopTapes.empty()) {
+        /**
+         * with loops (each direction is generated by a single task)
+         *
+         * A direction is not split by loop: every loop of a direction uses
+         * the temporaries and their derivatives obtained from the loop-free
+         * tape (zero order and Jacobian) in the same CodeHandler, and the
+         * function which calls the loop groups needs the groups of all
+         * loops. Splitting by loop would evaluate the loop-free tape once
+         * per loop.
+         */
+        if (_forwardOne) {
+            tasks.push_back([](ModelCSourceGen<Base>& gen) {
+                gen.generateSparseForwardOneSources();
+                gen.generateForwardOneSources();
+            });
+        }
 
-    if (_reverseOne) {
-        generateSparseReverseOneSources();
-        generateReverseOneSources();
-    }
+        if (_reverseOne) {
+            tasks.push_back([](ModelCSourceGen<Base>& gen) {
+                gen.generateSparseReverseOneSources();
+                gen.generateReverseOneSources();
+            });
+        }
+
+        if (_reverseTwo) {
+            tasks.push_back([](ModelCSourceGen<Base>& gen) {
+                gen.generateSparseReverseTwoSources();
+                gen.generateReverseTwoSources();
+            });
+        }
+
+        runGenerationTasks(tasks);
+
+    } else {
+        runGenerationTasks(tasks);
+
+        if (_forwardOne) {
+            generateSparseForwardOneSources();
+            generateForwardOneSources();
+        }
 
-    if (_reverseTwo) {
-        generateSparseReverseTwoSources();
-        generateReverseTwoSources();
+        if (_reverseOne) {
+            generateSparseReverseOneSources();
+            generateReverseOneSources();
+        }
+
+        if (_reverseTwo) {
+            generateSparseReverseTwoSources();
+            generateReverseTwoSources();
+        }
     }
 
+    tasks.clear();
+
     if (_sparseJacobian) {
-        generateSparseJacobianSource(multiThreadingType);
+        tasks.push_back([multiThreadingType](ModelCSourceGen<Base>& gen) {
+            gen.generateSparseJacobianSource(multiThreadingType);
+        });
     }
 
     if (_sparseHessian) {
-        generateSparseHessianSource(multiThreadingType);
+        tasks.push_back([multiThreadingType](ModelCSourceGen<Base>& gen) {
+            gen.generateSparseHessianSource(multiThreadingType);
+        });
     }
 
     if (_sparseJacobian || _forwardOne || _reverseOne) {
-        generateJacobianSparsitySource();
+        tasks.push_back([](ModelCSourceGen<Base>& gen) {
+            gen.generateJacobianSparsitySource();
+        });
     }
 
     if (_sparseHessian || _reverseTwo) {
-        generateHessianSparsitySource();
+        tasks.push_back([](ModelCSourceGen<Base>& gen) {
+            gen.generateHessianSparsitySource();
+        });
     }
 
+    runGenerationTasks(tasks);
+
     generateInfoSource();
 
     generateAtomicFuncNames();
 
+    if (_temporaryWorkspace) {
+        generateWorkspaceSizeSource(multiThreadingType);
+    }
+
+    flushSources();
+
+    // only printed here since the functions can be generated by several threads
+    printDependentPartitions();
+    printFunctionPartitions();
+
     finishedJob();
 }
 
 template<class Base>
 void ModelCSourceGen<Base>::generateLoops() {
-    if (_relatedDepCandidates.empty()) {
+    if (_relatedDepCandidates.empty() && !_autoRelatedDependents) {
         return; //nothing to do
     }
 
@@ -167,6 +287,7 @@ void ModelCSourceGen<Base>::generateLoops() {
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setSimplifyOperations(_simplifyOperations);
 
     std::vector<CGBase> xx(_fun.Domain());
     handler.makeVariables(xx);
@@ -178,7 +299,19 @@ void ModelCSourceGen<Base>::generateLoops() {
 
     std::vector<CGBase> yy = _fun.Forward(0, xx);
 
-    DependentPatternMatcher<Base> matcher(_relatedDepCandidates, yy, xx);
+    std::vector<std::set<size_t> > relatedDepCandidates;
+    const std::vector<std::set<size_t> >* related = &_relatedDepCandidates;
+    if (_relatedDepCandidates.empty()) {
+        relatedDepCandidates = DependentStructureHasher<Base>::findRelatedDependents(handler, yy);
+        related = &relatedDepCandidates;
+
+        if (relatedDepCandidates.empty()) {
+            finishedJob();
+            return; // no dependents with the same expression structure
+        }
+    }
+
+    DependentPatternMatcher<Base> matcher(*related, yy, xx);
     matcher.generateTapes(_funNoLoops, _loopTapes);
 
     finishedJob();
@@ -234,6 +367,39 @@ void ModelCSourceGen<Base>::generateAtomicFuncNames() {
     _sources[funcName + ".c"] = _cache.str();
 }
 
+template<class Base>
+void ModelCSourceGen<Base>::generateWorkspaceSizeSource(MultiThreadingType multiThreadingType) {
+    std::string funcName = _name + "_" + FUNCTION_WORKSPACE_SIZE;
+
+    // each worker of the multithreaded functions uses its own part of the workspace
+    bool multiThreaded = _multiThreading && (_sparseJacobian || _sparseHessian);
+
+    _cache.str("");
+    if (multiThreaded && multiThreadingType == MultiThreadingType::OPENMP) {
+        _cache << CPPADCG_OPENMP_H_FILE << "\n\n";
+    } else if (multiThreaded && multiThreadingType == MultiThreadingType::PTHREADS) {
+        _cache << CPPADCG_PTHREAD_POOL_H_FILE << "\n\n";
+    } else if (multiThreaded && multiThreadingType == MultiThreadingType::EXECUTOR) {
+        _cache << CPPADCG_EXECUTOR_H_FILE << "\n\n";
+    }
+    LanguageC<Base>::printFunctionDeclaration(_cache, "void", funcName, {"unsigned long* size",
+                                                                         "unsigned long* workers"});
+    _cache << " {\n"
+              "   *size = " << _workspaceSize << "; // bytes per worker\n";
+    if (multiThreaded && multiThreadingType == MultiThreadingType::OPENMP) {
+        _cache << "   *workers = cppadcg_openmp_get_threads();\n";
+    } else if (multiThreaded && multiThreadingType == MultiThreadingType::PTHREADS) {
+        _cache << "   *workers = cppadcg_thpool_get_workers();\n";
+    } else if (multiThreaded && multiThreadingType == MultiThreadingType::EXECUTOR) {
+        _cache << "   *workers = cppadcg_executor_get_workers();\n";
+    } else {
+        _cache << "   *workers = 1;\n";
+    }
+    _cache << "}\n\n";
+
+    _sources[funcName + ".c"] = _cache.str();
+}
+
 template<class Base>
 bool ModelCSourceGen<Base>::isAtomicsUsed() {
     if (_zeroEvaluated) {
@@ -252,6 +418,226 @@ const std::map<size_t, AtomicUseInfo<Base> >& ModelCSourceGen<Base>::getAtomicsI
     return *_atomicsInfo;
 }
 
+template<class Base>
+bool ModelCSourceGen<Base>::isParallelGenerationPossible() {
+    return _generationThreads > 1 &&
+            !isAtomicsUsed() &&
+            CppADThreadManager::isAvailable(); // not configured for multiple threads by someone else
+}
+
+template<class Base>
+ModelCSourceGen<Base>* ModelCSourceGen<Base>::createGenerationWorker(ADFun<CGBase>& fun) {
+    if (typeid(*this) != typeid(ModelCSourceGen<Base>)) {
+        return nullptr; // a subclass could generate different source code
+    }
+    return new ModelCSourceGen<Base>(*this, fun);
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::runGenerationTasks(const std::vector<GenerationTask>& tasks) {
+    size_t nThreads = std::min(_generationThreads, tasks.size());
+
+    size_t firstThread = 0; // the CppAD thread number of the first new thread
+
+    if (nThreads > 1 && isParallelGenerationPossible()) {
+        // the sparsities are determined only once (they are copied to the workers)
+        if (_sparseJacobian || _forwardOne || _reverseOne)
+            determineJacobianSparsity();
+        if (_sparseHessian || _reverseTwo)
+            determineHessianSparsity();
+
+        // the loop model sparsities are also determined only once (they are shared by the workers)
+        bool hessian = _hessian || _sparseHessian || _reverseTwo;
+        if (_funNoLoops != nullptr) {
+            _funNoLoops->evalJacobianSparsity();
+            if (hessian)
+                _funNoLoops->evalHessianSparsity();
+        }
+        for (LoopModel<Base>* l : _loopTapes) {
+            l->evalJacobianSparsity();
+            if (hessian)
+                l->evalHessianSparsity();
+        }
+
+        /**
+         * CppAD must be aware of the threads (memory is managed per thread)
+         * before any memory is allocated for them
+         */
+        firstThread = CppADThreadManager::reserve<Base>(nThreads - 1);
+    }
+
+    /**
+     * each worker has its own copy of the model which is created and
+     * deleted by the thread which uses it
+     * (the current thread is also used)
+     */
+    std::vector<std::unique_ptr<ADFun<CGBase> > > funs(nThreads);
+    std::vector<std::unique_ptr<ModelCSourceGen<Base> > > workers(nThreads);
+
+    /**
+     * the workers report their jobs to the listeners of the current job
+     * and are cancelled with it
+     */
+    std::mutex timerMutex;
+    std::vector<std::unique_ptr<JobTimer> > timers(nThreads);
+    if (_jobTimer != nullptr) {
+        for (size_t t = 0; t < nThreads; ++t) {
+            timers[t].reset(new JobTimer(*_jobTimer, timerMutex));
+        }
+    }
+
+    if (firstThread != 0) {
+        funs[0].reset(new ADFun<CGBase>());
+        *funs[0] = _fun;
+        workers[0].reset(createGenerationWorker(*funs[0]));
+        if (workers[0] == nullptr) {
+            funs[0].reset();
+            CppADThreadManager::release(firstThread, nThreads - 1);
+            firstThread = 0;
+        }
+    }
+
+    if (firstThread == 0) {
+        for (const auto& task : tasks) {
+            task(*this);
+            flushSources();
+        }
+        return;
+    }
+
+    /**
+     * the loop models are shared but each thread uses its own tapes
+     * (created by the thread which uses them)
+     */
+    if (_funNoLoops != nullptr)
+        _funNoLoops->enableThreadTapes();
+    for (LoopModel<Base>* l : _loopTapes)
+        l->enableThreadTapes();
+
+    std::atomic<size_t> next(0);
+    std::vector<std::exception_ptr> errors(nThreads);
+
+    auto work = [&](size_t t) {
+        if (t > 0)
+            CppADThreadManager::setThreadNumber(firstThread + t - 1);
+
+        try {
+            if (workers[t] == nullptr) {
+                funs[t].reset(new ADFun<CGBase>());
+                *funs[t] = _fun;
+                workers[t].reset(createGenerationWorker(*funs[t]));
+                CPPADCG_ASSERT_UNKNOWN(workers[t] != nullptr)
+            }
+            workers[t]->_jobTimer = timers[t].get();
+
+            for (size_t i = next++; i < tasks.size(); i = next++) {
+                if (timers[t] != nullptr)
+                    timers[t]->checkCancelRequest("generating source code for model '" + _name + "'");
+                tasks[i](*workers[t]);
+                workers[t]->flushSources();
+            }
+        } catch (...) {
+            errors[t] = std::current_exception();
+            next = tasks.size(); // stop the other threads
+        }
+
+        /**
+         * the tapes must be deleted by the thread which created them
+         * (the workers only keep the generated sources and are merged later)
+         */
+        if (_funNoLoops != nullptr)
+            _funNoLoops->releaseThreadTape();
+        for (LoopModel<Base>* l : _loopTapes)
+            l->releaseThreadTape();
+        funs[t].reset();
+
+        if (t > 0) {
+            CppADThreadManager::freeAvailable();
+            CppADThreadManager::setThreadNumber(0);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(nThreads - 1);
+    for (size_t t = 1; t < nThreads; ++t) {
+        threads.emplace_back(work, t);
+    }
+
+    work(0);
+
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    if (_funNoLoops != nullptr)
+        _funNoLoops->disableThreadTapes();
+    for (LoopModel<Base>* l : _loopTapes)
+        l->disableThreadTapes();
+
+    /**
+     * return CppAD to sequential mode
+     */
+    CppADThreadManager::release(firstThread, nThreads - 1);
+
+    /**
+     * merge the results (sources are sorted by file name)
+     */
+    for (const auto& worker : workers) {
+        if (worker == nullptr)
+            continue; // failed before it was created
+
+        for (auto& it : worker->_sources) {
+            _sources[it.first] = std::move(it.second);
+        }
+
+        _workspaceSize = std::max(_workspaceSize, worker->_workspaceSize);
+        _functionPartitions.insert(worker->_functionPartitions.begin(), worker->_functionPartitions.end());
+        _dependentPartitions.insert(worker->_dependentPartitions.begin(), worker->_dependentPartitions.end());
+
+        // information required by other functions for models with loops
+        _loopFor1Groups.insert(worker->_loopFor1Groups.begin(), worker->_loopFor1Groups.end());
+        _nonLoopFor1Elements.insert(worker->_nonLoopFor1Elements.begin(), worker->_nonLoopFor1Elements.end());
+        _loopRev1Groups.insert(worker->_loopRev1Groups.begin(), worker->_loopRev1Groups.end());
+        _nonLoopRev1Elements.insert(worker->_nonLoopRev1Elements.begin(), worker->_nonLoopRev1Elements.end());
+        _loopRev2Groups.insert(worker->_loopRev2Groups.begin(), worker->_loopRev2Groups.end());
+        _nonLoopRev2Elements.insert(worker->_nonLoopRev2Elements.begin(), worker->_nonLoopRev2Elements.end());
+    }
+
+    workers.clear();
+
+    if (_jobTimer != nullptr) {
+        // the jobs started by the current thread will not finish either
+        _jobTimer->checkCancelRequest("generating source code for model '" + _name + "'");
+    }
+
+    for (const auto& e : errors) {
+        if (e != nullptr) {
+            std::rethrow_exception(e);
+        }
+    }
+}
+
+template<class Base>
+std::vector<std::map<size_t, std::vector<size_t> > > ModelCSourceGen<Base>::splitDirections(const std::map<size_t, std::vector<size_t> >& elements) {
+    if (_generationThreads <= 1 || elements.size() <= 1 || !isParallelGenerationPossible()) {
+        return {elements};
+    }
+
+    // several groups per thread for a better load balance
+    size_t nGroups = std::min(elements.size(), 4 * _generationThreads);
+    size_t groupSize = (elements.size() + nGroups - 1) / nGroups;
+
+    std::vector<std::map<size_t, std::vector<size_t> > > groups;
+    for (const auto& it : elements) {
+        if (groups.empty() || groups.back().size() == groupSize) {
+            groups.emplace_back();
+        }
+        groups.back().insert(it);
+    }
+
+    return groups;
+}
+
 template<class Base>
 std::vector<typename ModelCSourceGen<Base>::Color> ModelCSourceGen<Base>::colorByRow(const std::set<size_t>& columns,
                                                                                      const SparsitySetType& sparsity) {
@@ -642,11 +1028,29 @@ inline std::vector<std::set<size_t> > ModelCSourceGen<Base>::determineOrderByRow
     return userLocationRow;
 }
 
+template<class Base>
+const char* ModelCSourceGen<Base>::threadPoolPrefix(MultiThreadingType multiThreadingType) {
+    if (multiThreadingType == MultiThreadingType::EXECUTOR) {
+        return "cppadcg_executor";
+    } else {
+        CPPADCG_ASSERT_UNKNOWN(multiThreadingType == MultiThreadingType::PTHREADS);
+        return "cppadcg_thpool";
+    }
+}
+
 template<class Base>
 void ModelCSourceGen<Base>::printFileStartPThreads(std::ostringstream& cache,
-                                                   const std::string& baseTypeName) {
+                                                   const std::string& baseTypeName,
+                                                   bool workspace,
+                                                   MultiThreadingType multiThreadingType) {
+    const char* prefix = threadPoolPrefix(multiThreadingType);
+
     cache << "\n";
-    cache << CPPADCG_PTHREAD_POOL_H_FILE << "\n";
+    if (multiThreadingType == MultiThreadingType::EXECUTOR) {
+        cache << CPPADCG_EXECUTOR_H_FILE << "\n";
+    } else {
+        cache << CPPADCG_PTHREAD_POOL_H_FILE << "\n";
+    }
     cache << "\n";
     cache << "typedef struct ExecArgStruct {\n"
             "   cppadcg_function_type func;\n"
@@ -656,14 +1060,20 @@ void ModelCSourceGen<Base>::printFileStartPThreads(std::ostringstream& cache,
             "} ExecArgStruct;\n"
             "\n"
             "static void exec_func(void* arg) {\n"
-            "   ExecArgStruct* eArg = (ExecArgStruct*) arg;\n"
-            "   (*eArg->func)(eArg->in, eArg->out, eArg->atomicFun);\n"
+            "   ExecArgStruct* eArg = (ExecArgStruct*) arg;\n";
+    if (workspace) {
+        cache << "   eArg->atomicFun.workspace = cppadcg_worker_workspace(eArg->atomicFun.workspace, " << prefix << "_get_worker_id());\n";
+    }
+    cache << "   (*eArg->func)(eArg->in, eArg->out, eArg->atomicFun);\n"
             "}\n";
 }
 
 template<class Base>
 void ModelCSourceGen<Base>::printFunctionStartPThreads(std::ostringstream& cache,
-                                                       size_t size) {
+                                                       size_t size,
+                                                       MultiThreadingType multiThreadingType) {
+    const char* prefix = threadPoolPrefix(multiThreadingType);
+
     auto repeatFill = [&](const std::string& txt){
         cache << "{";
         for (size_t i = 0; i < size; ++i) {
@@ -674,7 +1084,7 @@ void ModelCSourceGen<Base>::printFunctionStartPThreads(std::ostringstream& cache
     };
 
     cache << "   ExecArgStruct* args[" << size << "];\n";
-    cache << "   static cppadcg_thpool_function_type execute_functions[" << size << "] = ";
+    cache << "   static " << prefix << "_function_type execute_functions[" << size << "] = ";
     repeatFill("exec_func");
     cache << "\n";
     cache << "   static float ref_elapsed[" << size << "] = ";
@@ -692,30 +1102,48 @@ void ModelCSourceGen<Base>::printFunctionStartPThreads(std::ostringstream& cache
             "   static int job2Thread[" << size << "] = ";
     repeatFill("-1");
     cache << "\n"
-            "   static int last_elapsed_changed = 1;\n"
-            "   unsigned int nBench = cppadcg_thpool_get_n_time_meas();\n"
-            "   static unsigned int n_meas = 0;\n"
-            "   int do_benchmark = " << (size > 0 ? "(n_meas < nBench && !cppadcg_thpool_is_disabled())" : "0") << ";\n"
-            "   float* elapsed_p = do_benchmark ? elapsed : NULL;\n";
+            "   static unsigned int n_meas = 0;\n";
+    if (multiThreadingType == MultiThreadingType::PTHREADS) {
+        // the pool decides when to measure (it can keep measuring after the first n_time_meas calls)
+        cache << "   static int last_elapsed_changed = 1;\n"
+                "   static unsigned int n_calls = 0;\n"
+                "   int do_benchmark = " << (size > 0 ? std::string(prefix) + "_do_benchmark(n_meas, n_calls++)" : "0") << ";\n";
+    } else {
+        // the function can be called by several threads (only one measures the elapsed times at a time)
+        cache << "   static int benchmarking = 0;\n"
+                "   int do_benchmark = " << (size > 0 ? std::string(prefix) + "_start_benchmark(&benchmarking, &n_meas)" : "0") << ";\n";
+    }
+    cache << "   float* elapsed_p = do_benchmark ? elapsed : NULL;\n";
 }
 
 template<class Base>
 void ModelCSourceGen<Base>::printFunctionEndPThreads(std::ostringstream& cache,
-                                                     size_t size) {
-    cache << "   cppadcg_thpool_add_jobs(execute_functions, (void**) args, ref_elapsed, elapsed_p, order, job2Thread, " << size << ", last_elapsed_changed" << ");\n"
+                                                     size_t size,
+                                                     MultiThreadingType multiThreadingType) {
+    const char* prefix = threadPoolPrefix(multiThreadingType);
+    bool executor = multiThreadingType == MultiThreadingType::EXECUTOR;
+
+    cache << "   " << prefix << "_add_jobs(execute_functions, (void**) args, ref_elapsed, elapsed_p, order, job2Thread, " << size << ", " << (executor ? "0" : "last_elapsed_changed") << ");\n"
             "\n"
-            "   cppadcg_thpool_wait();\n"
+            "   " << prefix << "_wait();\n"
             "\n"
             "   for(i = 0; i < " << size << "; ++i) {\n"
             "      free(args[i]);\n"
             "   }\n"
-            "\n"
-            "   if(do_benchmark) {\n"
-            "      cppadcg_thpool_update_order(ref_elapsed, n_meas, elapsed, order, " << size << ");\n"
-            "      n_meas++;\n"
-            "   } else {\n"
-            "      last_elapsed_changed = 0;\n"
-            "   }\n";
+            "\n";
+    if (executor) {
+        cache << "   if(do_benchmark) {\n"
+                "      " << prefix << "_end_benchmark(&benchmarking, &n_meas, ref_elapsed, elapsed, order, " << size << ");\n"
+                "   }\n";
+    } else {
+        cache << "   if(do_benchmark) {\n"
+                "      " << prefix << "_update_order(ref_elapsed, n_meas, elapsed, order, " << size << ");\n"
+                "      n_meas++;\n"
+                "      last_elapsed_changed = 1;\n"
+                "   } else {\n"
+                "      last_elapsed_changed = 0;\n"
+                "   }\n";
+    }
 }
 
 template<class Base>
@@ -802,6 +1230,68 @@ void ModelCSourceGen<Base>::printLoopEndOpenMP(std::ostringstream& cache,
 
 }
 
+template<class Base>
+void ModelCSourceGen<Base>::printWorkerWorkspaceFunction(std::ostringstream& cache) const {
+    std::string sizeFunction = _name + "_" + FUNCTION_WORKSPACE_SIZE;
+
+    cache << "void " << sizeFunction << "(unsigned long* size, unsigned long* workers);\n"
+            "\n"
+            "static void* cppadcg_worker_workspace(void* workspace, unsigned long worker) {\n"
+            "   unsigned long size, workers;\n"
+            "   if(workspace == NULL)\n"
+            "      return NULL;\n"
+            "   " << sizeFunction << "(&size, &workers);\n"
+            "   return (char*) workspace + worker * size;\n"
+            "}\n";
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::printWorkerWorkspaceOpenMP(std::ostringstream& cache,
+                                                       const std::string& atomicArgName) {
+    cache << "      struct LangCAtomicFun " << atomicArgName << "Local = " << atomicArgName << ";\n"
+            "      " << atomicArgName << "Local.workspace = cppadcg_worker_workspace(" << atomicArgName << ".workspace, omp_get_thread_num());\n";
+}
+
+template<class Base>
+inline void ModelCSourceGen<Base>::updateFunctionPartition(const LanguageC<Base>& langC) {
+    const auto& partition = langC.getFunctionPartition();
+    if (partition.empty())
+        return;
+
+    _functionPartitions[langC.getGenerateFunction()] = partition;
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::printFunctionPartitions() {
+    if (_jobTimer == nullptr || !_jobTimer->isVerbose())
+        return;
+
+    for (const auto& it : _functionPartitions) {
+        std::ostringstream os;
+        os << "'" << it.first << "' functions: " << it.second.size() << "  operations:";
+        for (const auto& chunk : it.second) {
+            os << " " << chunk.operations;
+        }
+        _jobTimer->printMessage(os.str());
+    }
+}
+
+template<class Base>
+void ModelCSourceGen<Base>::printDependentPartitions() {
+    if (_jobTimer == nullptr || !_jobTimer->isVerbose())
+        return;
+
+    for (const auto& it : _dependentPartitions) {
+        std::ostringstream os;
+        os << "'" << it.first << "' groups: " << it.second.second.size() <<
+                "  operations: " << it.second.first << " ->";
+        for (size_t ops : it.second.second) {
+            os << " " << ops;
+        }
+        _jobTimer->printMessage(os.str());
+    }
+}
+
 template<class Base>
 void ModelCSourceGen<Base>::startingJob(const std::string& jobName,
                                         const JobType& type) {
@@ -28,6 +28,7 @@ void ModelCSourceGen<Base>::generateJacobianSource() {
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setSimplifyOperations(_simplifyOperations);
 
     vector<CGBase> indVars(_fun.Domain());
     handler.makeVariables(indVars);
@@ -52,15 +53,15 @@ void ModelCSourceGen<Base>::generateJacobianSource() {
     finishedJob();
 
     LanguageC<Base> langC(_baseTypeName);
-    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
-    langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-    langC.setParameterPrecision(_parameterPrecision);
+    configureLanguage(langC);
     langC.setGenerateFunction(_name + "_" + FUNCTION_JACOBIAN);
 
     std::ostringstream code;
     std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("jac"));
 
     handler.generateCode(code, langC, jac, *nameGen, _atomicFunctions, jobName);
+    updateWorkspaceSize(langC);
+    updateFunctionPartition(langC);
 }
 
 template<class Base>
@@ -88,17 +89,20 @@ void ModelCSourceGen<Base>::generateSparseJacobianSource(MultiThreadingType mult
     /**
      * call the appropriate method for source code generation
      */
-    if (_sparseJacobianReusesOne && _forwardOne && forwardMode) {
+    if (isPartitionedMultiThreading(multiThreadingType)) {
+        generateSparseJacobianSource(forwardMode, multiThreadingType);
+    } else if (_sparseJacobianReusesOne && _forwardOne && forwardMode) {
         generateSparseJacobianForRevSource(true, multiThreadingType);
     } else if (_sparseJacobianReusesOne && _reverseOne && !forwardMode) {
         generateSparseJacobianForRevSource(false, multiThreadingType);
     } else {
-        generateSparseJacobianSource(forwardMode);
+        generateSparseJacobianSource(forwardMode, MultiThreadingType::NONE);
     }
 }
 
 template<class Base>
-void ModelCSourceGen<Base>::generateSparseJacobianSource(bool forward) {
+void ModelCSourceGen<Base>::generateSparseJacobianSource(bool forward,
+                                                         MultiThreadingType multiThreadingType) {
     using std::vector;
 
     const std::string jobName = "sparse Jacobian";
@@ -110,6 +114,7 @@ void ModelCSourceGen<Base>::generateSparseJacobianSource(bool forward) {
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setSimplifyOperations(_simplifyOperations);
 
     vector<CGBase> indVars(n);
     handler.makeVariables(indVars);
@@ -135,16 +140,22 @@ void ModelCSourceGen<Base>::generateSparseJacobianSource(bool forward) {
 
     finishedJob();
 
+    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("jac"));
+
+    if (isPartitionedMultiThreading(multiThreadingType)) {
+        generatePartitionedSource(handler, jac, _name + "_" + FUNCTION_SPARSE_JACOBIAN, *nameGen, false, jobName, multiThreadingType);
+        return;
+    }
+
     LanguageC<Base> langC(_baseTypeName);
-    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
-    langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-    langC.setParameterPrecision(_parameterPrecision);
+    configureLanguage(langC);
     langC.setGenerateFunction(_name + "_" + FUNCTION_SPARSE_JACOBIAN);
 
     std::ostringstream code;
-    std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("jac"));
 
     handler.generateCode(code, langC, jac, *nameGen, _atomicFunctions, jobName);
+    updateWorkspaceSize(langC);
+    updateFunctionPartition(langC);
 }
 
 template<class Base>
@@ -226,12 +237,14 @@ void ModelCSourceGen<Base>::generateSparseJacobianForRevSource(bool forward,
             generateSparseJacobianWithLoopsSourceFromForRev(jacInfo, maxCompressedSize,
                                                             FUNCTION_SPARSE_FORWARD_ONE, "indep", "jcol",
                                                             _nonLoopFor1Elements, _loopFor1Groups,
-                                                            generateFunctionNameLoopFor1);
+                                                            generateFunctionNameLoopFor1,
+                                                            multiThreadingType);
         } else {
             generateSparseJacobianWithLoopsSourceFromForRev(jacInfo, maxCompressedSize,
                                                             FUNCTION_SPARSE_REVERSE_ONE, "dep", "jrow",
                                                             _nonLoopRev1Elements, _loopRev1Groups,
-                                                            generateFunctionNameLoopRev1);
+                                                            generateFunctionNameLoopRev1,
+                                                            multiThreadingType);
         }
         return;
     }
@@ -379,6 +392,11 @@ std::string ModelCSourceGen<Base>::generateSparseJacobianForRevMultiThreadSource
     _cache << "\n"
             "typedef void (*cppadcg_function_type) (" << argsDcl << ");\n";
 
+    if (_temporaryWorkspace) {
+        _cache << "\n";
+        printWorkerWorkspaceFunction(_cache);
+    }
+
     /**
      * PThreads pool needs a function with a void pointer argument
      */
@@ -388,9 +406,9 @@ std::string ModelCSourceGen<Base>::generateSparseJacobianForRevMultiThreadSource
         _cache << "\n";
 
     } else {
-        assert(multiThreadingType == MultiThreadingType::PTHREADS);
+        assert(multiThreadingType == MultiThreadingType::PTHREADS || multiThreadingType == MultiThreadingType::EXECUTOR);
 
-        printFileStartPThreads(_cache, _baseTypeName);
+        printFileStartPThreads(_cache, _baseTypeName, _temporaryWorkspace, multiThreadingType);
     }
 
     /**
@@ -430,15 +448,20 @@ std::string ModelCSourceGen<Base>::generateSparseJacobianForRevMultiThreadSource
         printFunctionStartOpenMP(_cache, jacInfo.size());
         _cache << "\n";
         printLoopStartOpenMP(_cache, jacInfo.size());
+        if (_temporaryWorkspace) {
+            printWorkerWorkspaceOpenMP(_cache, langC.getArgumentAtomic());
+            langC.setArgumentAtomic(langC.getArgumentAtomic() + "Local");
+            argsLocal = langC.generateDefaultFunctionArguments();
+        }
         _cache << "      outLocal[0] = &jac[offset[i]];\n"
                 "      (*p[i])(" << argsLocal << ");\n";
         printLoopEndOpenMP(_cache, jacInfo.size());
         _cache << "\n";
 
     } else {
-        assert(multiThreadingType == MultiThreadingType::PTHREADS);
+        assert(multiThreadingType == MultiThreadingType::PTHREADS || multiThreadingType == MultiThreadingType::EXECUTOR);
 
-        printFunctionStartPThreads(_cache, jacInfo.size());
+        printFunctionStartPThreads(_cache, jacInfo.size(), multiThreadingType);
         _cache << "\n"
                 "   for(i = 0; i < " << jacInfo.size() << "; ++i) {\n"
                 "      args[i] = (ExecArgStruct*) malloc(sizeof(ExecArgStruct));\n"
@@ -448,7 +471,7 @@ std::string ModelCSourceGen<Base>::generateSparseJacobianForRevMultiThreadSource
                 "      args[i]->atomicFun = " << langC.getArgumentAtomic() << ";\n"
                 "   }\n"
                 "\n";
-        printFunctionEndPThreads(_cache, jacInfo.size());
+        printFunctionEndPThreads(_cache, jacInfo.size(), multiThreadingType);
     }
 
     _cache << "\n"
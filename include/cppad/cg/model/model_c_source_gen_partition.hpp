@@ -0,0 +1,182 @@
+#ifndef CPPAD_CG_MODEL_C_SOURCE_GEN_PARTITION_INCLUDED
+#define CPPAD_CG_MODEL_C_SOURCE_GEN_PARTITION_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+template<class Base>
+void ModelCSourceGen<Base>::generatePartitionedSource(CodeHandler<Base>& handler,
+                                                      std::vector<CGBase>& dependents,
+                                                      const std::string& functionName,
+                                                      VariableNameGenerator<Base>& nameGen,
+                                                      bool hessian,
+                                                      const std::string& jobName,
+                                                      MultiThreadingType multiThreadingType) {
+    using Node = OperationNode<Base>;
+
+    size_t n = _fun.Domain();
+
+    ArrayView<CGBase> depView(dependents);
+
+    /**
+     * the groups are determined with the simplified graph which is only
+     * simplified once (not for each group)
+     */
+    if (handler.isSimplifyOperations()) {
+        GraphSimplifier<Base>::simplify(handler, depView);
+        handler.setSimplifyOperations(false);
+    }
+
+    DependentPartitioner<Base> partitioner(handler);
+    std::vector<std::vector<size_t> > groups = partitioner.partition(depView, _multiThreadingPartitions);
+
+    // reported after all the functions are generated (see printDependentPartitions())
+    _dependentPartitions[functionName] = std::make_pair(partitioner.getTotalOperations(), partitioner.getGroupOperations());
+
+    std::vector<std::string> partFunctions(groups.size());
+
+    for (size_t g = 0; g < groups.size(); ++g) {
+        const std::vector<size_t>& locations = groups[g];
+        partFunctions[g] = functionName + "_part" + std::to_string(g);
+
+        std::vector<CGBase> partDep(locations.size());
+        for (size_t e = 0; e < locations.size(); ++e) {
+            partDep[e] = dependents[locations[e]];
+        }
+
+        // the names from the previous group must not be reused
+        for (Node* node : handler.getManagedNodes()) {
+            if (node->getOperationType() != CGOpCode::Inv)
+                node->clearName();
+        }
+
+        LanguageC<Base> langC(_baseTypeName);
+        configureLanguage(langC);
+        langC.setGenerateFunction(partFunctions[g]);
+
+        std::ostringstream code;
+        LangCDependentSubsetVarNameGenerator<Base> nameGenPart(&nameGen, locations);
+        std::unique_ptr<VariableNameGenerator<Base> > nameGenHess;
+        VariableNameGenerator<Base>* nameGenUsed = &nameGenPart;
+        if (hessian) {
+            nameGenHess.reset(new LangCDefaultHessianVarNameGenerator<Base>(&nameGenPart, n));
+            nameGenUsed = nameGenHess.get();
+        }
+
+        handler.generateCode(code, langC, partDep, *nameGenUsed, _atomicFunctions, jobName + " (group " + std::to_string(g) + ")");
+        updateWorkspaceSize(langC);
+        updateFunctionPartition(langC);
+    }
+
+    _sources[functionName + ".c"] = generatePartitionedMultiThreadSource(functionName, partFunctions, multiThreadingType);
+    _cache.str("");
+}
+
+template<class Base>
+std::string ModelCSourceGen<Base>::generatePartitionedMultiThreadSource(const std::string& functionName,
+                                                                        const std::vector<std::string>& partFunctions,
+                                                                        MultiThreadingType multiThreadingType) {
+    LanguageC<Base> langC(_baseTypeName);
+    std::string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
+    size_t size = partFunctions.size();
+
+    _cache.str("");
+    _cache << "#include <stdlib.h>\n"
+            "\n"
+           << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+    for (const std::string& f : partFunctions) {
+        _cache << "void " << f << "(" << argsDcl << ");\n";
+    }
+
+    _cache << "\n"
+            "typedef void (*cppadcg_function_type) (" << argsDcl << ");\n";
+
+    if (_temporaryWorkspace) {
+        _cache << "\n";
+        printWorkerWorkspaceFunction(_cache);
+    }
+
+    if (multiThreadingType == MultiThreadingType::OPENMP) {
+        _cache << "\n";
+        printFileStartOpenMP(_cache);
+        _cache << "\n";
+
+    } else {
+        assert(multiThreadingType == MultiThreadingType::PTHREADS || multiThreadingType == MultiThreadingType::EXECUTOR);
+
+        printFileStartPThreads(_cache, _baseTypeName, _temporaryWorkspace, multiThreadingType);
+    }
+
+    /**
+     * each group writes its elements directly into the output array
+     */
+    _cache << "\n"
+            "void " << functionName << "(" << argsDcl << ") {\n"
+            "   static const cppadcg_function_type p[" << size << "] = {";
+    for (size_t g = 0; g < size; ++g) {
+        if (g != 0) _cache << ", ";
+        _cache << partFunctions[g];
+    }
+    _cache << "};\n"
+            "   long i;\n";
+
+    if (multiThreadingType == MultiThreadingType::OPENMP) {
+        std::string outName = langC.getArgumentOut();
+        langC.setArgumentOut("outLocal");
+        std::string argsLocal = langC.generateDefaultFunctionArguments();
+
+        _cache << "   " << _baseTypeName << " * outLocal[1];\n";
+        printFunctionStartOpenMP(_cache, size);
+        _cache << "\n";
+        printLoopStartOpenMP(_cache, size);
+        if (_temporaryWorkspace) {
+            printWorkerWorkspaceOpenMP(_cache, langC.getArgumentAtomic());
+            langC.setArgumentAtomic(langC.getArgumentAtomic() + "Local");
+            argsLocal = langC.generateDefaultFunctionArguments();
+        }
+        _cache << "      outLocal[0] = " << outName << "[0];\n"
+                "      (*p[i])(" << argsLocal << ");\n";
+        printLoopEndOpenMP(_cache, size);
+        _cache << "\n";
+
+    } else {
+        assert(multiThreadingType == MultiThreadingType::PTHREADS || multiThreadingType == MultiThreadingType::EXECUTOR);
+
+        _cache << "\n";
+        printFunctionStartPThreads(_cache, size, multiThreadingType);
+        _cache << "\n"
+                "   for(i = 0; i < " << size << "; ++i) {\n"
+                "      args[i] = (ExecArgStruct*) malloc(sizeof(ExecArgStruct));\n"
+                "      args[i]->func = p[i];\n"
+                "      args[i]->in = " << langC.getArgumentIn() << ";\n"
+                "      args[i]->out[0] = " << langC.getArgumentOut() << "[0];\n"
+                "      args[i]->atomicFun = " << langC.getArgumentAtomic() << ";\n"
+                "   }\n"
+                "\n";
+        printFunctionEndPThreads(_cache, size, multiThreadingType);
+    }
+
+    _cache << "\n"
+            "}\n";
+
+    return _cache.str();
+}
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -45,7 +45,13 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSources() {
     if (isAtomicsUsed()) {
         generateSparseReverseOneSourcesWithAtomics(elements);
     } else {
-        generateSparseReverseOneSourcesNoAtomics(elements);
+        std::vector<GenerationTask> tasks;
+        for (const auto& group : splitDirections(elements)) {
+            tasks.push_back([group](ModelCSourceGen<Base>& gen) {
+                gen.generateSparseReverseOneSourcesNoAtomics(group);
+            });
+        }
+        runGenerationTasks(tasks);
     }
 
     finishedJob();
@@ -88,6 +94,7 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesWithAtomics(const std
 
         CodeHandler<Base> handler;
         handler.setJobTimer(_jobTimer);
+        handler.setSimplifyOperations(_simplifyOperations);
 
         vector<CGBase> indVars(_fun.Domain());
         handler.makeVariables(indVars);
@@ -119,9 +126,7 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesWithAtomics(const std
         finishedJob();
 
         LanguageC<Base> langC(_baseTypeName);
-        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
-        langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-        langC.setParameterPrecision(_parameterPrecision);
+        configureLanguage(langC);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_ONE << "_dep" << i;
         langC.setGenerateFunction(_cache.str());
@@ -131,6 +136,9 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesWithAtomics(const std
         LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "py", n);
 
         handler.generateCode(code, langC, dwCustom, nameGenHess, _atomicFunctions, subJobName);
+        updateWorkspaceSize(langC);
+        updateFunctionPartition(langC);
+        flushSources();
     }
 }
 
@@ -146,6 +154,7 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesNoAtomics(const std::
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setSimplifyOperations(_simplifyOperations);
 
     vector<CGBase> x(n);
     handler.makeVariables(x);
@@ -161,10 +170,21 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesNoAtomics(const std::
         py.setValue(Base(1.0));
     }
 
-    vector<CGBase> jacFlat(_jacSparsity.rows.size());
+    // only the elements in the requested rows
+    std::vector<size_t> rows, cols;
+    rows.reserve(_jacSparsity.rows.size());
+    cols.reserve(_jacSparsity.cols.size());
+    for (size_t e = 0; e < _jacSparsity.rows.size(); e++) {
+        if (elements.find(_jacSparsity.rows[e]) != elements.end()) {
+            rows.push_back(_jacSparsity.rows[e]);
+            cols.push_back(_jacSparsity.cols[e]);
+        }
+    }
+
+    vector<CGBase> jacFlat(rows.size());
 
     CppAD::sparse_jacobian_work work; // temporary structure for CPPAD
-    _fun.SparseJacobianReverse(x, _jacSparsity.sparsity, _jacSparsity.rows, _jacSparsity.cols, jacFlat, work);
+    _fun.SparseJacobianReverse(x, _jacSparsity.sparsity, rows, cols, jacFlat, work);
 
     /**
      * organize results
@@ -185,9 +205,9 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesNoAtomics(const std::
         }
     }
 
-    for (size_t el = 0; el < _jacSparsity.rows.size(); el++) {
-        size_t i = _jacSparsity.rows[el];
-        size_t j = _jacSparsity.cols[el];
+    for (size_t el = 0; el < rows.size(); el++) {
+        size_t i = rows[el];
+        size_t j = cols[el];
         size_t e = positions[i].at(j);
 
         vector<CGBase>& row = jac[i];
@@ -207,9 +227,7 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesNoAtomics(const std::
         const std::string subJobName = _cache.str();
 
         LanguageC<Base> langC(_baseTypeName);
-        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
-        langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-        langC.setParameterPrecision(_parameterPrecision);
+        configureLanguage(langC);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_ONE << "_dep" << i;
         langC.setGenerateFunction(_cache.str());
@@ -219,6 +237,9 @@ void ModelCSourceGen<Base>::generateSparseReverseOneSourcesNoAtomics(const std::
         LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "py", n);
 
         handler.generateCode(code, langC, dwCustom, nameGenHess, _atomicFunctions, subJobName);
+        updateWorkspaceSize(langC);
+        updateFunctionPartition(langC);
+        flushSources();
     }
 }
 
@@ -51,7 +51,21 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSources() {
         if (isAtomicsUsed()) {
             generateSparseReverseTwoSourcesWithAtomics(elements);
         } else {
-            generateSparseReverseTwoSourcesNoAtomics(elements, evalRows, evalCols);
+            std::vector<GenerationTask> tasks;
+            for (const auto& group : splitDirections(elements)) {
+                std::vector<size_t> groupRows, groupCols;
+                for (size_t e = 0; e < evalRows.size(); e++) {
+                    if (group.find(evalRows[e]) != group.end()) {
+                        groupRows.push_back(evalRows[e]);
+                        groupCols.push_back(evalCols[e]);
+                    }
+                }
+
+                tasks.push_back([group, groupRows, groupCols](ModelCSourceGen<Base>& gen) {
+                    gen.generateSparseReverseTwoSourcesNoAtomics(group, groupRows, groupCols);
+                });
+            }
+            runGenerationTasks(tasks);
         }
 
         finishedJob();
@@ -88,6 +102,7 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesWithAtomics(const std
 
         CodeHandler<Base> handler;
         handler.setJobTimer(_jobTimer);
+        handler.setSimplifyOperations(_simplifyOperations);
 
         vector<CGBase> tx0(n);
         handler.makeVariables(tx0);
@@ -127,9 +142,7 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesWithAtomics(const std
         finishedJob();
 
         LanguageC<Base> langC(_baseTypeName);
-        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
-        langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-        langC.setParameterPrecision(_parameterPrecision);
+        configureLanguage(langC);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_TWO << "_indep" << j;
         langC.setGenerateFunction(_cache.str());
@@ -139,6 +152,9 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesWithAtomics(const std
         LangCDefaultReverse2VarNameGenerator<Base> nameGenRev2(nameGen.get(), n, 1);
 
         handler.generateCode(code, langC, pxCustom, nameGenRev2, _atomicFunctions, subJobName);
+        updateWorkspaceSize(langC);
+        updateFunctionPartition(langC);
+        flushSources();
     }
 }
 
@@ -167,6 +183,7 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesNoAtomics(const std::
     // we can use a new handler to reduce memory usage
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setSimplifyOperations(_simplifyOperations);
 
     vector<CGBase> tx0(n);
     handler.makeVariables(tx0);
@@ -230,9 +247,7 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesNoAtomics(const std::
         }
 
         LanguageC<Base> langC(_baseTypeName);
-        langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
-        langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-        langC.setParameterPrecision(_parameterPrecision);
+        configureLanguage(langC);
         _cache.str("");
         _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_TWO << "_indep" << j;
         langC.setGenerateFunction(_cache.str());
@@ -242,6 +257,9 @@ void ModelCSourceGen<Base>::generateSparseReverseTwoSourcesNoAtomics(const std::
         LangCDefaultReverse2VarNameGenerator<Base> nameGenRev2(nameGen.get(), n, 1);
 
         handler.generateCode(code, langC, pxCustom, nameGenRev2, _atomicFunctions, subJobName);
+        updateWorkspaceSize(langC);
+        updateFunctionPartition(langC);
+        flushSources();
     }
 }
 
@@ -134,6 +134,102 @@ public:
      */
     virtual unsigned int getThreadPoolNumberOfTimeMeas() const = 0;
 
+    /**
+     * Defines how the time measurements of each task are combined to
+     * schedule the work across threads.
+     * With ThreadPoolTimeReference::EWMA, the tasks are measured again
+     * periodically (see setThreadPoolRebalancePeriod()) and the order of the
+     * tasks adapts to changes in their cost.
+     * This value is only used by the models if they were compiled with
+     * MultiThreadingType::PTHREADS.
+     *
+     * @param r the time reference
+     */
+    virtual void setThreadPoolTimeReference(ThreadPoolTimeReference r) = 0;
+
+    /**
+     * Provides how the time measurements of each task are combined to
+     * schedule the work across threads.
+     *
+     * @return the time reference
+     */
+    virtual ThreadPoolTimeReference getThreadPoolTimeReference() const = 0;
+
+    /**
+     * Defines the weight of new time measurements in the moving average
+     * of the cost of each task (ThreadPoolTimeReference::EWMA only).
+     *
+     * @param alpha a value in ]0, 1]
+     */
+    virtual void setThreadPoolEwmaAlpha(float alpha) = 0;
+
+    /**
+     * Provides the weight of new time measurements in the moving average
+     * of the cost of each task (ThreadPoolTimeReference::EWMA only).
+     */
+    virtual float getThreadPoolEwmaAlpha() const = 0;
+
+    /**
+     * Defines the number of multithreaded evaluations between time
+     * measurements after the initial ones
+     * (ThreadPoolTimeReference::EWMA only).
+     *
+     * @param n the number of evaluations (0 to stop measuring)
+     */
+    virtual void setThreadPoolRebalancePeriod(unsigned int n) = 0;
+
+    /**
+     * Provides the number of multithreaded evaluations between time
+     * measurements after the initial ones
+     * (ThreadPoolTimeReference::EWMA only).
+     */
+    virtual unsigned int getThreadPoolRebalancePeriod() const = 0;
+
+    /**
+     * Provides the imbalance between threads in the last multithreaded
+     * evaluation: the busy time of the busiest thread divided by the
+     * average busy time of the threads minus one.
+     *
+     * @return the imbalance (0 if it was never measured)
+     */
+    virtual float getThreadPoolLastImbalance() const = 0;
+
+    /**
+     * Provides the average imbalance between threads in the measured
+     * multithreaded evaluations (see getThreadPoolLastImbalance()).
+     *
+     * @return the average imbalance (0 if it was never measured)
+     */
+    virtual float getThreadPoolAverageImbalance() const = 0;
+
+    /**
+     * Provides the number of multithreaded evaluations used to determine
+     * the average imbalance between threads.
+     */
+    virtual unsigned int getThreadPoolNumberOfImbalanceMeas() const = 0;
+
+    /**
+     * Discards the imbalance measurements.
+     */
+    virtual void resetThreadPoolImbalance() = 0;
+
+    /**
+     * Defines the executor used to run the jobs of multithreaded model
+     * evaluations (sparse Jacobians and sparse Hessians) instead of
+     * threads created by the library.
+     * This is only used by libraries created with
+     * MultiThreadingType::EXECUTOR.
+     * The callback table is copied but the executor data must remain valid
+     * until the executor is replaced or the library is closed.
+     * It should not be changed while the models are being evaluated.
+     *
+     * @param executor the executor callbacks or nullptr to evaluate the
+     *                 jobs sequentially
+     * @return true if the library uses executors, false otherwise
+     * @throws CGException if the executor is not valid
+     */
+    virtual bool setThreadPoolExecutor(const ThreadPoolExecutor* executor) = 0;
+
     inline virtual ~ModelLibrary() = default;
 
 };
@@ -42,6 +42,17 @@ public:
     static const std::string FUNCTION_GETTHREADPOOLGUIDEDMAXGROUPWORK;
     static const std::string FUNCTION_SETTHREADPOOLNUMBEROFTIMEMEAS;
     static const std::string FUNCTION_GETTHREADPOOLNUMBEROFTIMEMEAS;
+    static const std::string FUNCTION_SETTHREADPOOLEXECUTOR;
+    static const std::string FUNCTION_SETTHREADPOOLTIMEREFERENCE;
+    static const std::string FUNCTION_GETTHREADPOOLTIMEREFERENCE;
+    static const std::string FUNCTION_SETTHREADPOOLEWMAALPHA;
+    static const std::string FUNCTION_GETTHREADPOOLEWMAALPHA;
+    static const std::string FUNCTION_SETTHREADPOOLREBALANCEPERIOD;
+    static const std::string FUNCTION_GETTHREADPOOLREBALANCEPERIOD;
+    static const std::string FUNCTION_GETTHREADPOOLLASTIMBALANCE;
+    static const std::string FUNCTION_GETTHREADPOOLAVERAGEIMBALANCE;
+    static const std::string FUNCTION_GETTHREADPOOLNUMBEROFIMBALANCEMEAS;
+    static const std::string FUNCTION_RESETTHREADPOOLIMBALANCE;
     static const unsigned long API_VERSION;
 protected:
     static const std::string CONST;
@@ -160,6 +171,8 @@ public:
 
     /**
      * Saves the generated C source code into several files.
+     * The model source files are saved as soon as they are generated (see
+     * generateSources(SourceSink&)).
      * 
      * @param sourcesFolder A directory path where the files should be
      *                      created (any existing files with the same names
@@ -167,6 +180,18 @@ public:
      */
     void saveSources(const std::string& sourcesFolder);
 
+    /**
+     * Generates the source code of all models, the library sources, and
+     * the custom sources, and passes each file to a sink.
+     * The model source files are passed to the sink as soon as they are
+     * created and they are not kept in memory, unless they were already
+     * generated before (e.g. by a model library processor).
+     * Models whose sources were streamed cannot be processed again.
+     *
+     * @param sink receives the source files
+     */
+    virtual void generateSources(SourceSink& sink);
+
     /**
      * Provides the sources for the model library level.
      * These sources include, for instance, functions to retrieve the list of
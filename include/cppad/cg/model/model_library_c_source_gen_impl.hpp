@@ -21,7 +21,7 @@ namespace CppAD {
 namespace cg {
 
 template<class Base>
-const unsigned long ModelLibraryCSourceGen<Base>::API_VERSION = 7;
+const unsigned long ModelLibraryCSourceGen<Base>::API_VERSION = 8;
 
 template<class Base>
 const std::string ModelLibraryCSourceGen<Base>::FUNCTION_VERSION = "cppad_cg_version";
@@ -68,25 +68,68 @@ const std::string ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLNUMBEROFTI
 template<class Base>
 const std::string ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLNUMBEROFTIMEMEAS = "cppad_cg_thpool_get_number_of_time_meas";
 
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLEXECUTOR = "cppad_cg_thpool_set_executor";
+
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLTIMEREFERENCE = "cppad_cg_thpool_set_time_meas_ref";
+
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLTIMEREFERENCE = "cppad_cg_thpool_get_time_meas_ref";
+
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLEWMAALPHA = "cppad_cg_thpool_set_ewma_alpha";
+
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLEWMAALPHA = "cppad_cg_thpool_get_ewma_alpha";
+
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_SETTHREADPOOLREBALANCEPERIOD = "cppad_cg_thpool_set_rebalance_period";
+
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLREBALANCEPERIOD = "cppad_cg_thpool_get_rebalance_period";
+
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLLASTIMBALANCE = "cppad_cg_thpool_get_last_imbalance";
+
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLAVERAGEIMBALANCE = "cppad_cg_thpool_get_avg_imbalance";
+
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_GETTHREADPOOLNUMBEROFIMBALANCEMEAS = "cppad_cg_thpool_get_n_imbalance_meas";
+
+template<class Base>
+const std::string ModelLibraryCSourceGen<Base>::FUNCTION_RESETTHREADPOOLIMBALANCE = "cppad_cg_thpool_reset_imbalance";
+
 template<class Base>
 const std::string ModelLibraryCSourceGen<Base>::CONST = "const";
 
 template<class Base>
 void ModelLibraryCSourceGen<Base>::saveSources(const std::string& sourcesFolder) {
+    // creates the folder if it does not exist
+    FileSourceSink sink(sourcesFolder);
 
-    // create the folder if it does not exist
-    system::createFolder(sourcesFolder);
+    generateSources(sink);
+}
 
-    // save/generate model sources
+template<class Base>
+void ModelLibraryCSourceGen<Base>::generateSources(SourceSink& sink) {
+    // generate model sources
     for (const auto& it : _models) {
-        saveSources(sourcesFolder, it.second->getSources());
+        it.second->generateSources(sink, _multiThreading, this);
     }
 
-    // save/generate library sources
-    saveSources(sourcesFolder, getLibrarySources());
+    // library sources
+    for (const auto& it : getLibrarySources()) {
+        std::string source = it.second;
+        sink.addSource(it.first, std::move(source));
+    }
 
-    // save custom user sources
-    saveSources(sourcesFolder, getCustomSources());
+    // custom user sources
+    for (const auto& it : getCustomSources()) {
+        std::string source = it.second;
+        sink.addSource(it.first, std::move(source));
+    }
 }
 
 template<class Base>
@@ -125,6 +168,9 @@ const std::map<std::string, std::string>& ModelLibraryCSourceGen<Base>::getLibra
 
                 } else if (_multiThreading == MultiThreadingType::OPENMP) {
                     _libSources["thread_pool.c"] = CPPADCG_OPENMP_C_FILE;
+
+                } else if (_multiThreading == MultiThreadingType::EXECUTOR) {
+                    _libSources["thread_pool.c"] = CPPADCG_EXECUTOR_C_FILE;
                 }
             }
         }
@@ -255,6 +301,46 @@ void ModelLibraryCSourceGen<Base>::generateThreadPoolSources(std::map<std::strin
         _cache << "   return cppadcg_thpool_get_n_time_meas();\n";
         _cache << "}\n\n";
 
+        _cache << "void " << FUNCTION_SETTHREADPOOLTIMEREFERENCE << "(enum ElapsedTimeReference r) {\n";
+        _cache << "   cppadcg_thpool_set_time_meas_ref(r);\n";
+        _cache << "}\n\n";
+
+        _cache << "enum ElapsedTimeReference " << FUNCTION_GETTHREADPOOLTIMEREFERENCE << "() {\n";
+        _cache << "   return cppadcg_thpool_get_time_meas_ref();\n";
+        _cache << "}\n\n";
+
+        _cache << "void " << FUNCTION_SETTHREADPOOLEWMAALPHA << "(float a) {\n";
+        _cache << "   cppadcg_thpool_set_ewma_alpha(a);\n";
+        _cache << "}\n\n";
+
+        _cache << "float " << FUNCTION_GETTHREADPOOLEWMAALPHA << "() {\n";
+        _cache << "   return cppadcg_thpool_get_ewma_alpha();\n";
+        _cache << "}\n\n";
+
+        _cache << "void " << FUNCTION_SETTHREADPOOLREBALANCEPERIOD << "(unsigned int n) {\n";
+        _cache << "   cppadcg_thpool_set_rebalance_period(n);\n";
+        _cache << "}\n\n";
+
+        _cache << "unsigned int " << FUNCTION_GETTHREADPOOLREBALANCEPERIOD << "() {\n";
+        _cache << "   return cppadcg_thpool_get_rebalance_period();\n";
+        _cache << "}\n\n";
+
+        _cache << "float " << FUNCTION_GETTHREADPOOLLASTIMBALANCE << "() {\n";
+        _cache << "   return cppadcg_thpool_get_last_imbalance();\n";
+        _cache << "}\n\n";
+
+        _cache << "float " << FUNCTION_GETTHREADPOOLAVERAGEIMBALANCE << "() {\n";
+        _cache << "   return cppadcg_thpool_get_avg_imbalance();\n";
+        _cache << "}\n\n";
+
+        _cache << "unsigned int " << FUNCTION_GETTHREADPOOLNUMBEROFIMBALANCEMEAS << "() {\n";
+        _cache << "   return cppadcg_thpool_get_n_imbalance_meas();\n";
+        _cache << "}\n\n";
+
+        _cache << "void " << FUNCTION_RESETTHREADPOOLIMBALANCE << "() {\n";
+        _cache << "   cppadcg_thpool_reset_imbalance();\n";
+        _cache << "}\n\n";
+
         sources["thread_pool_access.c"] = _cache.str();
 
     } else if(usingMultiThreading && _multiThreading == MultiThreadingType::OPENMP) {
@@ -310,6 +396,63 @@ void ModelLibraryCSourceGen<Base>::generateThreadPoolSources(std::map<std::strin
 
         sources["thread_pool_access.c"] = _cache.str();
 
+    } else if(usingMultiThreading && _multiThreading == MultiThreadingType::EXECUTOR) {
+        _cache.str("");
+        _cache << CPPADCG_EXECUTOR_H_FILE << "\n\n";
+
+        _cache << "int " << FUNCTION_SETTHREADPOOLEXECUTOR << "(const CppADCGExecutor* executor) {\n";
+        _cache << "   return cppadcg_executor_set(executor);\n";
+        _cache << "}\n\n";
+
+        _cache << "void " << FUNCTION_SETTHREADPOOLDISABLED << "(int disabled) {\n";
+        _cache << "   cppadcg_executor_set_disabled(disabled);\n";
+        _cache << "}\n\n";
+
+        _cache << "int " << FUNCTION_ISTHREADPOOLDISABLED << "() {\n";
+        _cache << "   return cppadcg_executor_is_disabled();\n";
+        _cache << "}\n\n";
+
+        _cache << "void " << FUNCTION_SETTHREADS << "(unsigned int n) {\n";
+        _cache << "   cppadcg_executor_set_threads(n);\n";
+        _cache << "}\n\n";
+
+        _cache << "unsigned int " << FUNCTION_GETTHREADS << "() {\n";
+        _cache << "   return cppadcg_executor_get_threads();\n";
+        _cache << "}\n\n";
+
+        _cache << "void " << FUNCTION_SETTHREADSCHEDULERSTRAT << "(enum ScheduleStrategy s) {\n";
+        _cache << "   cppadcg_executor_set_scheduler_strategy(s);\n";
+        _cache << "}\n\n";
+
+        _cache << "enum ScheduleStrategy " << FUNCTION_GETTHREADSCHEDULERSTRAT << "() {\n";
+        _cache << "   return cppadcg_executor_get_scheduler_strategy();\n";
+        _cache << "}\n\n";
+
+        _cache << "void " << FUNCTION_SETTHREADPOOLVERBOSE << "(int v) {\n";
+        _cache << "   cppadcg_executor_set_verbose(v);\n";
+        _cache << "}\n\n";
+
+        _cache << "int " << FUNCTION_ISTHREADPOOLVERBOSE << "() {\n";
+        _cache << "   return cppadcg_executor_is_verbose();\n";
+        _cache << "}\n\n";
+
+        _cache << "void " << FUNCTION_SETTHREADPOOLGUIDEDMAXGROUPWORK << "(float v) {\n";
+        _cache << "}\n\n";
+
+        _cache << "float " << FUNCTION_GETTHREADPOOLGUIDEDMAXGROUPWORK << "() {\n";
+        _cache << "   return 1.0;\n";
+        _cache << "}\n\n";
+
+        _cache << "void " << FUNCTION_SETTHREADPOOLNUMBEROFTIMEMEAS << "(unsigned int n) {\n";
+        _cache << "   cppadcg_executor_set_n_time_meas(n);\n";
+        _cache << "}\n\n";
+
+        _cache << "unsigned int " << FUNCTION_GETTHREADPOOLNUMBEROFTIMEMEAS << "() {\n";
+        _cache << "   return cppadcg_executor_get_n_time_meas();\n";
+        _cache << "}\n\n";
+
+        sources["thread_pool_access.c"] = _cache.str();
+
     } else {
         _cache.str("");
         _cache << "enum ScheduleStrategy {SCHED_STATIC = 1, SCHED_DYNAMIC = 2, SCHED_GUIDED = 3};\n"
@@ -28,14 +28,42 @@ template<class Base>
 class ModelLibraryProcessor {
 protected:
     ModelLibraryCSourceGen<Base>* modelLibraryHelper_;
+    /**
+     * whether or not the model source files are processed as soon as they
+     * are generated
+     */
+    bool streamSources_;
 public:
 
     inline explicit ModelLibraryProcessor(ModelLibraryCSourceGen<Base>& modelLibraryHelper) :
-        modelLibraryHelper_(&modelLibraryHelper) {
+        modelLibraryHelper_(&modelLibraryHelper),
+        streamSources_(false) {
     }
 
     inline virtual ~ModelLibraryProcessor() = default;
 
+    /**
+     * Whether or not the model source files are processed (e.g. saved or
+     * compiled) as soon as each one is generated.
+     */
+    inline bool isStreamSources() const {
+        return streamSources_;
+    }
+
+    /**
+     * Defines whether or not the model source files are processed (e.g.
+     * saved or compiled) as soon as each one is generated instead of
+     * keeping the sources of a complete model in memory.
+     * This reduces the memory required for very large models, however the
+     * streamed sources are discarded and the models cannot be processed
+     * again (by this or any other processor).
+     *
+     * @param stream whether or not to stream the model sources
+     */
+    inline void setStreamSources(bool stream) {
+        streamSources_ = stream;
+    }
+
 protected:
 
     inline const std::map<std::string, std::string>& getLibrarySources() {
@@ -46,6 +74,102 @@ protected:
         return model.getSources(modelLibraryHelper_->getMultiThreading(), modelLibraryHelper_);
     }
 
+    /**
+     * Executes a task in a background thread with its own CppAD thread
+     * number so that the calling thread can continue to use CppAD.
+     * The background thread uses copies of the model tapes which it
+     * creates and deletes itself (see ModelCSourceGen::ThreadTape).
+     * The thread number is released (and CppAD placed back in sequential
+     * mode) by the thread which calls get() or wait() on the returned
+     * future, or which destroys it.
+     * The returned future is deferred, therefore wait_for() and
+     * wait_until() do not wait for the background thread.
+     * If CppAD was configured for multiple threads by someone else, the
+     * new thread uses the CppAD thread number 0 and the calling thread
+     * must not use CppAD until the task finishes.
+     *
+     * @param task the task to execute
+     * @return a future for the result of the task
+     */
+    template<class Task>
+    inline std::future<typename std::result_of<Task()>::type> runAsync(Task task) {
+        using Result = typename std::result_of<Task()>::type;
+
+        size_t thread = CppADThreadManager::reserve<Base>(1);
+        if (thread == 0) {
+            return std::async(std::launch::async, task);
+        }
+
+        std::vector<ModelCSourceGen<Base>*> models;
+        for (const auto& it : modelLibraryHelper_->getModels()) {
+            models.push_back(it.second);
+        }
+
+        std::future<Result> future;
+        try {
+            future = std::async(std::launch::async, [task, thread, models]() -> Result {
+                CppADThreadManager::ThreadScope scope(thread);
+
+                // deleted before the thread returns its CppAD memory
+                std::vector<std::unique_ptr<typename ModelCSourceGen<Base>::ThreadTape> > tapes;
+                for (ModelCSourceGen<Base>* m : models) {
+                    tapes.emplace_back(new typename ModelCSourceGen<Base>::ThreadTape(*m));
+                }
+
+                return task();
+            });
+        } catch (...) {
+            CppADThreadManager::release(thread, 1);
+            throw;
+        }
+
+        return std::async(std::launch::deferred, [](AsyncThread<Result> t) -> Result {
+            return t.get();
+        }, AsyncThread<Result>(std::move(future), thread));
+    }
+
+private:
+
+    /**
+     * The result of a task executed by runAsync() which releases the
+     * CppAD thread number used by the task when it is destroyed
+     * (by the thread which requests the result).
+     */
+    template<class Result>
+    class AsyncThread {
+    private:
+        std::future<Result> future_;
+        size_t thread_;
+    public:
+
+        inline AsyncThread(std::future<Result>&& future,
+                           size_t thread) :
+            future_(std::move(future)),
+            thread_(thread) {
+        }
+
+        inline AsyncThread(AsyncThread&& other) :
+            future_(std::move(other.future_)),
+            thread_(other.thread_) {
+            other.thread_ = 0;
+        }
+
+        AsyncThread(const AsyncThread&) = delete;
+        AsyncThread& operator=(const AsyncThread&) = delete;
+
+        inline Result get() {
+            return future_.get();
+        }
+
+        inline ~AsyncThread() {
+            if (thread_ != 0) {
+                if (future_.valid())
+                    future_.wait(); // the thread number is still in use
+                CppADThreadManager::release(thread_, 1);
+            }
+        }
+    };
+
 };
 
 } // END cg namespace
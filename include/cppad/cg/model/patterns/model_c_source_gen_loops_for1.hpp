@@ -32,6 +32,7 @@ void ModelCSourceGen<Base>::prepareSparseForwardOneWithLoops(const std::map<size
     
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setSimplifyOperations(_simplifyOperations);
     handler.setZeroDependents(false);
 
     auto& indexJcolDcl = *handler.makeIndexDclrNode("jcol");
@@ -346,7 +347,7 @@ void ModelCSourceGen<Base>::prepareSparseForwardOneWithLoops(const std::map<size
 
             LanguageC<Base> langC(_baseTypeName);
             langC.setFunctionIndexArgument(indexJcolDcl);
-            langC.setParameterPrecision(_parameterPrecision);
+            configureLanguage(langC);
 
             _cache.str("");
             std::ostringstream code;
@@ -371,15 +372,18 @@ void ModelCSourceGen<Base>::prepareSparseForwardOneWithLoops(const std::map<size
             _cache << "#include <stdlib.h>\n"
                     "#include <math.h>\n"
                     "\n"
+                    << langC.generateFilePreamble()
                     << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n"
                     "\n"
-                    "void " << functionName << "(" << argsDcl << ") {\n";
+                    << langC.generateConstantPoolDeclaration()
+                    << "void " << functionName << "(" << argsDcl << ") {\n";
             nameGenHess.customFunctionVariableDeclarations(_cache);
             _cache << langC.generateIndependentVariableDeclaration() << "\n";
             _cache << langC.generateDependentVariableDeclaration() << "\n";
             _cache << langC.generateTemporaryVariableDeclaration(false, false,
                                                                  handler.getExternalFuncMaxForwardOrder(),
                                                                  handler.getExternalFuncMaxReverseOrder()) << "\n";
+            updateWorkspaceSize(langC);
             nameGenHess.prepareCustomFunctionVariables(_cache);
 
             // code inside the loop
@@ -389,6 +393,7 @@ void ModelCSourceGen<Base>::prepareSparseForwardOneWithLoops(const std::map<size
             _cache << "}\n\n";
 
             _sources[functionName + ".c"] = _cache.str();
+            flushSources();
             _cache.str("");
 
             /**
@@ -429,8 +434,7 @@ void ModelCSourceGen<Base>::createForwardOneWithLoopsNL(CodeHandler<Base>& handl
     const std::string jobName = _cache.str();
 
     LanguageC<Base> langC(_baseTypeName);
-    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
-    langC.setParameterPrecision(_parameterPrecision);
+    configureLanguage(langC);
     _cache.str("");
     _cache << _name << "_" << FUNCTION_SPARSE_FORWARD_ONE << "_noloop_indep" << j;
     langC.setGenerateFunction(_cache.str());
@@ -440,6 +444,8 @@ void ModelCSourceGen<Base>::createForwardOneWithLoopsNL(CodeHandler<Base>& handl
     LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "dx", n);
 
     handler.generateCode(code, langC, jacCol, nameGenHess, _atomicFunctions, jobName);
+    updateWorkspaceSize(langC);
+    updateFunctionPartition(langC);
 
     handler.resetNodes();
 }
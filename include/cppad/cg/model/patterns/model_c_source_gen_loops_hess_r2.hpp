@@ -20,7 +20,8 @@ namespace cg {
 
 template<class Base>
 void ModelCSourceGen<Base>::generateSparseHessianWithLoopsSourceFromRev2(const std::map<size_t, CompressedVectorInfo>& hessInfo,
-                                                                         size_t maxCompressedSize) {
+                                                                         size_t maxCompressedSize,
+                                                                         MultiThreadingType multiThreadingType) {
     using namespace std;
     using namespace CppAD::cg::loops;
 
@@ -37,6 +38,15 @@ void ModelCSourceGen<Base>::generateSparseHessianWithLoopsSourceFromRev2(const s
     string suffix = "indep";
     string nlRev2Suffix = "noloop_" + suffix;
 
+    if (_multiThreading && multiThreadingType != MultiThreadingType::NONE) {
+        _sources[model_function + ".c"] = generateSparseForRevWithLoopsMultiThreadSource(model_function, hessInfo,
+                                                                                         functionRev2, suffix, "hess",
+                                                                                         3, _hessSparsity.rows.size(),
+                                                                                         multiThreadingType);
+        finishedJob();
+        return;
+    }
+
     _cache.str("");
     _cache << "#include <stdlib.h>\n"
             << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n\n";
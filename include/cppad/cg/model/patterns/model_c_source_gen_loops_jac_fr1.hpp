@@ -26,7 +26,8 @@ void ModelCSourceGen<Base>::generateSparseJacobianWithLoopsSourceFromForRev(cons
                                                                             const std::string& keyName,
                                                                             const std::map<size_t, std::set<size_t> >& nonLoopElements,
                                                                             const std::map<LoopModel<Base>*, std::map<size_t, std::map<size_t, std::set<size_t> > > >& loopGroups,
-                                                                            void (*generateLocalFunctionName)(std::ostringstream& cache, const std::string& modelName, const LoopModel<Base>& loop, size_t g)) {
+                                                                            void (*generateLocalFunctionName)(std::ostringstream& cache, const std::string& modelName, const LoopModel<Base>& loop, size_t g),
+                                                                            MultiThreadingType multiThreadingType) {
     using namespace std;
     using namespace CppAD::cg::loops;
 
@@ -40,6 +41,16 @@ void ModelCSourceGen<Base>::generateSparseJacobianWithLoopsSourceFromForRev(cons
 
     string model_function = _name + "_" + FUNCTION_SPARSE_JACOBIAN;
     string localFunction = _name + "_" + localFunctionTypeName;
+
+    if (_multiThreading && multiThreadingType != MultiThreadingType::NONE) {
+        _sources[model_function + ".c"] = generateSparseForRevWithLoopsMultiThreadSource(model_function, jacInfo,
+                                                                                         localFunction, suffix, "jac",
+                                                                                         2, _jacSparsity.rows.size(),
+                                                                                         multiThreadingType);
+        finishedJob();
+        return;
+    }
+
     string nlSuffix = "noloop_" + suffix;
 
     _cache.str("");
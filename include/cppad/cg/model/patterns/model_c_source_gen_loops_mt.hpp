@@ -0,0 +1,175 @@
+#ifndef CPPAD_CG_MODEL_C_SOURCE_GEN_LOOPS_MT_INCLUDED
+#define CPPAD_CG_MODEL_C_SOURCE_GEN_LOOPS_MT_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+template<class Base>
+std::string ModelCSourceGen<Base>::generateSparseForRevWithLoopsMultiThreadSource(const std::string& functionName,
+                                                                                  const std::map<size_t, CompressedVectorInfo>& matrixInfo,
+                                                                                  const std::string& localFunction,
+                                                                                  const std::string& suffix,
+                                                                                  const std::string& resultName,
+                                                                                  size_t inLocalSize,
+                                                                                  size_t nnz,
+                                                                                  MultiThreadingType multiThreadingType) {
+    CPPADCG_ASSERT_UNKNOWN(_multiThreading);
+    CPPADCG_ASSERT_UNKNOWN(multiThreadingType != MultiThreadingType::NONE);
+    CPPADCG_ASSERT_UNKNOWN(inLocalSize >= 2);
+
+    LanguageC<Base> langC(_baseTypeName);
+    std::string argsDcl = langC.generateDefaultFunctionArgumentsDcl();
+    std::vector<std::string> argsDcl2 = langC.generateDefaultFunctionArgumentsDcl2();
+
+    langC.setArgumentIn("inLocal");
+    langC.setArgumentOut("outLocal");
+    std::string argsLocal = langC.generateDefaultFunctionArguments();
+
+    _cache.str("");
+    _cache << "#include <stdlib.h>\n"
+           << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n\n";
+    LanguageC<Base>::printFunctionDeclaration(_cache, "int", localFunction, {"unsigned long pos"}, argsDcl2);
+    _cache << ";\n"
+              "\n";
+
+    /**
+     * Create a function for each row/column which determines all the
+     * contributions (with and without loops) to its elements
+     */
+    for (const auto& it : matrixInfo) {
+        size_t index = it.first;
+        const std::vector<std::set<size_t> >& location = it.second.locations;
+        size_t compressedSize = it.second.indexes.size();
+        CPPADCG_ASSERT_UNKNOWN(compressedSize == location.size());
+
+        std::string jobName = functionName + "_" + suffix + std::to_string(index);
+        _cache << "static ";
+        LanguageC<Base>::printFunctionDeclaration(_cache, "void", jobName, argsDcl2);
+        _cache << " {\n"
+                  "   " << _baseTypeName << " const * inLocal[" << inLocalSize << "];\n"
+                  "   " << _baseTypeName << " inLocal1 = 1;\n"
+                  "   " << _baseTypeName << " * outLocal[1];\n"
+                  "   " << _baseTypeName << " compressed[" << compressedSize << "];\n"
+                  "   " << _baseTypeName << " * " << resultName << " = out[0];\n"
+                  "   unsigned long e;\n"
+                  "\n"
+                  "   inLocal[0] = in[0];\n"
+                  "   inLocal[1] = &inLocal1;\n";
+        for (size_t j = 2; j < inLocalSize; j++)
+            _cache << "   inLocal[" << j << "] = in[" << (j - 1) << "];\n";
+        _cache << "   outLocal[0] = compressed;\n"
+                  "\n"
+                  "   for(e = 0; e < " << compressedSize << "; e++) compressed[e] = 0;\n"
+                  "   " << localFunction << "(" << index << ", " << argsLocal << ");\n"
+                  "\n";
+        for (size_t e = 0; e < location.size(); e++) {
+            if (location[e].empty())
+                continue;
+            _cache << "   ";
+            for (size_t itl : location[e]) {
+                _cache << resultName << "[" << itl << "] = ";
+            }
+            _cache << "compressed[" << e << "];\n";
+        }
+        _cache << "}\n"
+                  "\n";
+    }
+
+    _cache << "typedef void (*cppadcg_function_type) (" << argsDcl << ");\n";
+
+    if (_temporaryWorkspace) {
+        _cache << "\n";
+        printWorkerWorkspaceFunction(_cache);
+    }
+
+    if (multiThreadingType == MultiThreadingType::OPENMP) {
+        _cache << "\n";
+        printFileStartOpenMP(_cache);
+        _cache << "\n";
+
+    } else {
+        /**
+         * PThreads pool needs a function with a void pointer argument
+         */
+        assert(multiThreadingType == MultiThreadingType::PTHREADS || multiThreadingType == MultiThreadingType::EXECUTOR);
+
+        printFileStartPThreads(_cache, _baseTypeName, _temporaryWorkspace, multiThreadingType);
+    }
+
+    /**
+     * the Jacobian/Hessian function
+     * (all jobs write to the complete output array but never to the same element)
+     */
+    size_t nJobs = matrixInfo.size();
+
+    _cache << "\n"
+              "void " << functionName << "(" << argsDcl << ") {\n"
+              "   static const cppadcg_function_type p[" << nJobs << "] = {";
+    for (const auto& it : matrixInfo) {
+        if (it.first != matrixInfo.begin()->first) _cache << ", ";
+        _cache << functionName << "_" << suffix << it.first;
+    }
+    _cache << "};\n"
+              "   " << _baseTypeName << " * outLocal[1];\n"
+              "   " << _baseTypeName << " * " << resultName << " = out[0];\n"
+              "   long i;\n"
+              "\n"
+              "   for(i = 0; i < " << nnz << "; ++i) " << resultName << "[i] = 0;\n";
+
+    langC.setArgumentIn("in");
+
+    if (multiThreadingType == MultiThreadingType::OPENMP) {
+        printFunctionStartOpenMP(_cache, nJobs);
+        _cache << "\n";
+        printLoopStartOpenMP(_cache, nJobs);
+        if (_temporaryWorkspace) {
+            printWorkerWorkspaceOpenMP(_cache, langC.getArgumentAtomic());
+            langC.setArgumentAtomic(langC.getArgumentAtomic() + "Local");
+        }
+        _cache << "      outLocal[0] = " << resultName << ";\n"
+                  "      (*p[i])(" << langC.generateDefaultFunctionArguments() << ");\n";
+        printLoopEndOpenMP(_cache, nJobs);
+        _cache << "\n";
+
+    } else {
+        assert(multiThreadingType == MultiThreadingType::PTHREADS || multiThreadingType == MultiThreadingType::EXECUTOR);
+
+        printFunctionStartPThreads(_cache, nJobs, multiThreadingType);
+        _cache << "\n"
+                  "   for(i = 0; i < " << nJobs << "; ++i) {\n"
+                  "      args[i] = (ExecArgStruct*) malloc(sizeof(ExecArgStruct));\n"
+                  "      args[i]->func = p[i];\n"
+                  "      args[i]->in = in;\n"
+                  "      args[i]->out[0] = " << resultName << ";\n"
+                  "      args[i]->atomicFun = " << langC.getArgumentAtomic() << ";\n"
+                  "   }\n"
+                  "\n";
+        printFunctionEndPThreads(_cache, nJobs, multiThreadingType);
+    }
+
+    _cache << "\n"
+              "}\n";
+
+    std::string source = _cache.str();
+    _cache.str("");
+    return source;
+}
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -38,6 +38,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseOneWithLoops(const std::map<size
 
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setSimplifyOperations(_simplifyOperations);
     handler.setZeroDependents(false);
 
     auto& indexJrowDcl = *handler.makeIndexDclrNode("jrow");
@@ -281,7 +282,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseOneWithLoops(const std::map<size
              */
             LanguageC<Base> langC(_baseTypeName);
             langC.setFunctionIndexArgument(indexJrowDcl);
-            langC.setParameterPrecision(_parameterPrecision);
+            configureLanguage(langC);
 
             _cache.str("");
             std::ostringstream code;
@@ -306,15 +307,18 @@ void ModelCSourceGen<Base>::prepareSparseReverseOneWithLoops(const std::map<size
             _cache << "#include <stdlib.h>\n"
                     "#include <math.h>\n"
                     "\n"
+                    << langC.generateFilePreamble()
                     << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n"
                     "\n"
-                    "void " << functionName << "(" << argsDcl << ") {\n";
+                    << langC.generateConstantPoolDeclaration()
+                    << "void " << functionName << "(" << argsDcl << ") {\n";
             nameGenHess.customFunctionVariableDeclarations(_cache);
             _cache << langC.generateIndependentVariableDeclaration() << "\n";
             _cache << langC.generateDependentVariableDeclaration() << "\n";
             _cache << langC.generateTemporaryVariableDeclaration(false, false,
                                                                  handler.getExternalFuncMaxForwardOrder(),
                                                                  handler.getExternalFuncMaxReverseOrder()) << "\n";
+            updateWorkspaceSize(langC);
             nameGenHess.prepareCustomFunctionVariables(_cache);
 
             // code inside the loop
@@ -324,6 +328,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseOneWithLoops(const std::map<size
             _cache << "}\n\n";
 
             _sources[functionName + ".c"] = _cache.str();
+            flushSources();
             _cache.str("");
 
             /**
@@ -364,8 +369,7 @@ void ModelCSourceGen<Base>::createReverseOneWithLoopsNL(CodeHandler<Base>& handl
     const std::string jobName = _cache.str();
 
     LanguageC<Base> langC(_baseTypeName);
-    langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
-    langC.setParameterPrecision(_parameterPrecision);
+    configureLanguage(langC);
     _cache.str("");
     _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_ONE << "_noloop_dep" << i;
     langC.setGenerateFunction(_cache.str());
@@ -375,6 +379,8 @@ void ModelCSourceGen<Base>::createReverseOneWithLoopsNL(CodeHandler<Base>& handl
     LangCDefaultHessianVarNameGenerator<Base> nameGenHess(nameGen.get(), "dy", n);
 
     handler.generateCode(code, langC, jacRow, nameGenHess, _atomicFunctions, jobName);
+    updateWorkspaceSize(langC);
+    updateFunctionPartition(langC);
 
     handler.resetNodes();
 }
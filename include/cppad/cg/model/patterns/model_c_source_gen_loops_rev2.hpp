@@ -68,6 +68,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
     
     CodeHandler<Base> handler;
     handler.setJobTimer(_jobTimer);
+    handler.setSimplifyOperations(_simplifyOperations);
     handler.setZeroDependents(false);
     
     auto& indexJrowDcl = *handler.makeIndexDclrNode("jrow");
@@ -382,7 +383,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
 
             LanguageC<Base> langC(_baseTypeName);
             langC.setFunctionIndexArgument(indexJrowDcl);
-            langC.setParameterPrecision(_parameterPrecision);
+            configureLanguage(langC);
 
             std::ostringstream code;
             std::unique_ptr<VariableNameGenerator<Base> > nameGen(createVariableNameGenerator("px"));
@@ -406,15 +407,18 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
             _cache << "#include <stdlib.h>\n"
                     "#include <math.h>\n"
                     "\n"
+                    << langC.generateFilePreamble()
                     << LanguageC<Base>::ATOMICFUN_STRUCT_DEFINITION << "\n"
                     "\n"
-                    "void " << functionName << "(" << argsDcl << ") {\n";
+                    << langC.generateConstantPoolDeclaration()
+                    << "void " << functionName << "(" << argsDcl << ") {\n";
             nameGenRev2.customFunctionVariableDeclarations(_cache);
             _cache << langC.generateIndependentVariableDeclaration() << "\n";
             _cache << langC.generateDependentVariableDeclaration() << "\n";
             _cache << langC.generateTemporaryVariableDeclaration(false, false,
                                                                  handler.getExternalFuncMaxForwardOrder(),
                                                                  handler.getExternalFuncMaxReverseOrder()) << "\n";
+            updateWorkspaceSize(langC);
             nameGenRev2.prepareCustomFunctionVariables(_cache);
 
             // code inside the loop
@@ -424,6 +428,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
             _cache << "}\n\n";
 
             _sources[functionName + ".c"] = _cache.str();
+            flushSources();
             _cache.str("");
 
             /**
@@ -523,9 +528,7 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
                 }
 
                 LanguageC<Base> langC(_baseTypeName);
-                langC.setMaxAssignmentsPerFunction(_maxAssignPerFunc, &_sources);
-                langC.setMaxOperationsPerAssignment(_maxOperationsPerAssignment);
-                langC.setParameterPrecision(_parameterPrecision);
+                configureLanguage(langC);
                 _cache.str("");
                 _cache << _name << "_" << FUNCTION_SPARSE_REVERSE_TWO << "_noloop_indep" << j;
                 string functionName = _cache.str();
@@ -536,6 +539,9 @@ void ModelCSourceGen<Base>::prepareSparseReverseTwoWithLoops(const std::map<size
                 LangCDefaultReverse2VarNameGenerator<Base> nameGenRev2(nameGen.get(), n, 1);
 
                 handlerNL.generateCode(code, langC, pxCustom, nameGenRev2, _atomicFunctions, subJobName);
+                updateWorkspaceSize(langC);
+                updateFunctionPartition(langC);
+                flushSources();
             }
 
             finishedJob();
@@ -40,34 +40,17 @@ public:
     }
 
     inline void saveSourcesTo(const std::string& sourcesFolder) {
+        FileSourceSink sink(sourcesFolder);
 
-        auto saveFile = [&](const std::string& filename, const std::string& source){
-            std::ofstream sourceFile;
-            std::string file = system::createPath(sourcesFolder, filename);
-            sourceFile.open(file.c_str());
-            sourceFile << source;
-            sourceFile.close();
-        };
-
-        system::createFolder(sourcesFolder);
-
-        const std::map<std::string, ModelCSourceGen<Base>*>& models = this->modelLibraryHelper_->getModels();
-
-        for (const auto& itm : models) {
-            const std::map<std::string, std::string>& sources = this->getSources(*itm.second);
-
-            for (const auto& it : sources) {
-                saveFile(it.first, it.second);
+        if (!this->streamSources_) {
+            // keep the model sources in memory so that they can be used later
+            const std::map<std::string, ModelCSourceGen<Base>*>& models = this->modelLibraryHelper_->getModels();
+            for (const auto& itm : models) {
+                this->getSources(*itm.second);
             }
         }
 
-        for (const auto& it : this->modelLibraryHelper_->getLibrarySources()) {
-            saveFile(it.first, it.second);
-        }
-
-        for (const auto& it : this->modelLibraryHelper_->getCustomSources()) {
-            saveFile(it.first, it.second);
-        }
+        this->modelLibraryHelper_->generateSources(sink);
     }
 
     inline static void saveLibrarySourcesTo(ModelLibraryCSourceGen<Base>& modelLibraryHelper,
@@ -0,0 +1,127 @@
+#ifndef CPPAD_CG_SOURCE_SINK_INCLUDED
+#define CPPAD_CG_SOURCE_SINK_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Receives generated source files as soon as they are created so that
+ * they do not have to be kept in memory until the whole model library is
+ * generated.
+ *
+ * Sinks are never called concurrently by the source generators.
+ *
+ * @author Joao Leal
+ */
+class SourceSink {
+public:
+
+    inline virtual ~SourceSink() = default;
+
+    /**
+     * Processes a new source file.
+     *
+     * @param filename the name of the source file
+     * @param source the source code (it can be moved away)
+     */
+    virtual void addSource(const std::string& filename,
+                           std::string&& source) = 0;
+};
+
+/**
+ * Saves each source file to a folder as soon as it is generated.
+ *
+ * @author Joao Leal
+ */
+class FileSourceSink : public SourceSink {
+protected:
+    /**
+     * the folder where the files are created
+     */
+    std::string _folder;
+public:
+
+    /**
+     * @param folder A directory path where the files should be created (it is
+     *               created if it does not exist and any existing files with
+     *               the same names will be overridden).
+     */
+    inline explicit FileSourceSink(std::string folder) :
+            _folder(std::move(folder)) {
+        system::createFolder(_folder);
+    }
+
+    inline const std::string& getFolder() const {
+        return _folder;
+    }
+
+    void addSource(const std::string& filename,
+                   std::string&& source) override {
+        std::string file = system::createPath(_folder, filename);
+
+        std::ofstream sourceFile;
+        sourceFile.open(file.c_str());
+        sourceFile << source;
+        sourceFile.close();
+
+        if (sourceFile.fail())
+            throw CGException("Failed to save the source file '", file, "'");
+    }
+};
+
+/**
+ * Compiles each source file as soon as it is generated.
+ * The compiled object files are kept by the compiler until a library is
+ * created (or the compiler is cleaned up).
+ *
+ * @author Joao Leal
+ */
+template<class Base>
+class CompilerSourceSink : public SourceSink {
+protected:
+    CCompiler<Base>* _compiler;
+    bool _posIndepCode;
+    JobTimer* _timer;
+public:
+
+    /**
+     * @param compiler The compiler used to compile the sources
+     * @param posIndepCode Whether or not to compile the sources with
+     *                     position independent code
+     * @param timer Used to report the compilation progress (optional)
+     */
+    inline CompilerSourceSink(CCompiler<Base>& compiler,
+                              bool posIndepCode,
+                              JobTimer* timer = nullptr) :
+            _compiler(&compiler),
+            _posIndepCode(posIndepCode),
+            _timer(timer) {
+    }
+
+    void addSource(const std::string& filename,
+                   std::string&& source) override {
+        std::map<std::string, std::string> sources;
+        sources[filename] = std::move(source);
+
+        _compiler->compileSources(sources, _posIndepCode, _timer);
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,480 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+/**
+ * Runs the jobs of multithreaded model functions using an executor
+ * provided by the host application (e.g. a task scheduler) instead of
+ * a thread pool owned by the model library.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+
+enum ScheduleStrategy {SCHED_STATIC = 1,
+                       SCHED_DYNAMIC = 2,
+                       SCHED_GUIDED = 3
+                       };
+
+enum ElapsedTimeReference {ELAPSED_TIME_AVG,
+                           ELAPSED_TIME_MIN};
+
+typedef void (*cppadcg_executor_function_type)(void*);
+
+typedef struct CppADCGExecutorJob {
+    cppadcg_executor_function_type function;
+    void* arg;
+} CppADCGExecutorJob;
+
+typedef struct CppADCGExecutor {
+    void* data;
+    void* (*submit)(void* data, const CppADCGExecutorJob jobs[], int nJobs);
+    void (*wait)(void* data, void* batch);
+    int (*get_workers)(void* data);
+    int (*get_worker_id)(void* data);
+} CppADCGExecutor;
+
+/* ========================== STRUCTURES ============================ */
+
+/* Job */
+typedef struct ExecutorJob {
+    cppadcg_executor_function_type function; /* function pointer                     */
+    void* arg;                               /* function's argument                  */
+    float* elapsed;                          /* the current elapsed time             */
+    int worker;                              /* the worker which ran it (verbose only) */
+    struct timespec startTime;               /* initial time (verbose only)          */
+    struct timespec endTime;                 /* final time (verbose only)            */
+} ExecutorJob;
+
+/* Batch of jobs submitted by a single call to a model function */
+typedef struct ExecutorBatch {
+    struct ExecutorBatch* prev;              /* the batch submitted before (same thread) */
+    CppADCGExecutor executor;                /* the executor used to run the jobs    */
+    ExecutorJob* jobs;                       /* jobs (ordered as provided)           */
+    CppADCGExecutorJob* submitted;           /* jobs (ordered by expected cost)      */
+    void* handle;                            /* the handle provided by the executor  */
+    int size;                                /* number of jobs                       */
+} ExecutorBatch;
+
+static CppADCGExecutor cppadcg_executor;
+static int cppadcg_executor_defined = 0; // false
+static int cppadcg_executor_disabled = 0; // false
+static int cppadcg_executor_verbose = 0; // false
+static enum ElapsedTimeReference cppadcg_executor_time_update = ELAPSED_TIME_MIN;
+static unsigned int cppadcg_executor_time_meas = 10; // default number of time measurements
+static enum ScheduleStrategy cppadcg_executor_strategy = SCHED_DYNAMIC;
+
+/* batches which are still running (model functions can be called from several threads) */
+static __thread ExecutorBatch* cppadcg_executor_batches = NULL;
+
+/* protects the job order and time measurements of the model functions (shared by all calling threads) */
+static pthread_mutex_t cppadcg_executor_order_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void executor_update_order(float refElapsed[],
+                                  unsigned int nTimeMeas,
+                                  const float elapsed[],
+                                  int order[],
+                                  int nJobs);
+
+/* ============================ TIME ============================== */
+
+static float get_thread_time(struct timespec* cputime,
+                             int* info) {
+    *info = clock_gettime(CLOCK_THREAD_CPUTIME_ID, cputime);
+    if(*info == 0) {
+        return cputime->tv_sec + cputime->tv_nsec * 1e-9f;
+    } else {
+        fprintf(stderr, "failed clock_gettime()\n");
+        return 0;
+    }
+}
+
+static void get_monotonic_time2(struct timespec* time) {
+    int info;
+    info = clock_gettime(CLOCK_MONOTONIC, time);
+    if(info != 0) {
+        time->tv_sec = 0;
+        time->tv_nsec = 0;
+        fprintf(stderr, "failed clock_gettime()\n");
+    }
+}
+
+static void timespec_diff(struct timespec* end,
+                          struct timespec* start,
+                          struct timespec* result) {
+    if ((end->tv_nsec - start->tv_nsec) < 0) {
+        result->tv_sec = end->tv_sec - start->tv_sec - 1;
+        result->tv_nsec = end->tv_nsec - start->tv_nsec + 1000000000;
+    } else {
+        result->tv_sec = end->tv_sec - start->tv_sec;
+        result->tv_nsec = end->tv_nsec - start->tv_nsec;
+    }
+}
+
+/* ============================ JOBS ============================== */
+
+int cppadcg_executor_get_worker_id();
+
+static void executor_run_job(void* arg) {
+    ExecutorJob* job = (ExecutorJob*) arg;
+    struct timespec cputime;
+    float elapsed = 0;
+    int info = 0;
+
+    if (cppadcg_executor_verbose) {
+        job->worker = cppadcg_executor_get_worker_id();
+        get_monotonic_time2(&job->startTime);
+    }
+
+    if (job->elapsed != NULL) {
+        elapsed = -get_thread_time(&cputime, &info);
+    }
+
+    (*job->function)(job->arg);
+
+    if (job->elapsed != NULL && info == 0) {
+        elapsed += get_thread_time(&cputime, &info);
+        if (info == 0) {
+            (*job->elapsed) = elapsed;
+        }
+    }
+
+    if (cppadcg_executor_verbose) {
+        get_monotonic_time2(&job->endTime);
+    }
+}
+
+/* ========================== PUBLIC API ============================ */
+
+int cppadcg_executor_set(const CppADCGExecutor* executor) {
+    if (executor == NULL) {
+        cppadcg_executor_defined = 0;
+        return 0;
+    }
+
+    if (executor->submit == NULL || executor->wait == NULL ||
+        executor->get_workers == NULL || executor->get_worker_id == NULL) {
+        fprintf(stderr, "cppadcg_executor_set(): all the executor callbacks must be provided\n");
+        return -1;
+    }
+
+    cppadcg_executor = *executor;
+    cppadcg_executor_defined = 1;
+    return 0;
+}
+
+int cppadcg_executor_is_defined() {
+    return cppadcg_executor_defined;
+}
+
+void cppadcg_executor_set_threads(int n) {
+    // the number of threads is controlled by the executor
+    (void) n;
+}
+
+int cppadcg_executor_get_workers() {
+    int n = 1;
+    if (cppadcg_executor_defined) {
+        n = (*cppadcg_executor.get_workers)(cppadcg_executor.data);
+    }
+    return n > 0 ? n : 1;
+}
+
+int cppadcg_executor_get_threads() {
+    return cppadcg_executor_get_workers();
+}
+
+int cppadcg_executor_get_worker_id() {
+    if (cppadcg_executor_defined && !cppadcg_executor_disabled) {
+        return (*cppadcg_executor.get_worker_id)(cppadcg_executor.data);
+    }
+    return 0;
+}
+
+void cppadcg_executor_set_scheduler_strategy(enum ScheduleStrategy s) {
+    // not used (the executor decides how the jobs are scheduled)
+    cppadcg_executor_strategy = s;
+}
+
+enum ScheduleStrategy cppadcg_executor_get_scheduler_strategy() {
+    return cppadcg_executor_strategy;
+}
+
+unsigned int cppadcg_executor_get_n_time_meas() {
+    return cppadcg_executor_time_meas;
+}
+
+void cppadcg_executor_set_n_time_meas(unsigned int n) {
+    cppadcg_executor_time_meas = n;
+}
+
+enum ElapsedTimeReference cppadcg_executor_get_time_meas_ref() {
+    return cppadcg_executor_time_update;
+}
+
+void cppadcg_executor_set_time_meas_ref(enum ElapsedTimeReference r) {
+    cppadcg_executor_time_update = r;
+}
+
+void cppadcg_executor_set_verbose(int v) {
+    cppadcg_executor_verbose = v;
+}
+
+int cppadcg_executor_is_verbose() {
+    return cppadcg_executor_verbose;
+}
+
+void cppadcg_executor_set_disabled(int disabled) {
+    cppadcg_executor_disabled = disabled;
+}
+
+int cppadcg_executor_is_disabled() {
+    return cppadcg_executor_disabled;
+}
+
+void cppadcg_executor_add_jobs(cppadcg_executor_function_type functions[],
+                               void* args[],
+                               const float refElapsed[],
+                               float elapsed[],
+                               const int order[],
+                               int job2Thread[],
+                               int nJobs,
+                               int lastElapsedChanged) {
+    ExecutorBatch* batch;
+    int i, pos;
+
+    /**
+     * same arguments as cppadcg_thpool_add_jobs() so that the generated
+     * code can use either thread pool, but the executor decides how the
+     * jobs are distributed by its workers
+     */
+    (void) refElapsed;
+    (void) job2Thread;
+    (void) lastElapsedChanged;
+
+    batch = (ExecutorBatch*) malloc(sizeof(ExecutorBatch));
+    if (batch != NULL) {
+        batch->jobs = (ExecutorJob*) malloc(nJobs * sizeof(ExecutorJob));
+        batch->submitted = (CppADCGExecutorJob*) malloc(nJobs * sizeof(CppADCGExecutorJob));
+        if (batch->jobs == NULL || batch->submitted == NULL) {
+            free(batch->jobs);
+            free(batch->submitted);
+            free(batch);
+            batch = NULL;
+        }
+    }
+
+    if (batch == NULL) {
+        fprintf(stderr, "cppadcg_executor_add_jobs(): failed to allocate memory\n");
+        // executor not used
+        for (i = 0; i < nJobs; ++i) {
+            (*functions[i])(args[i]);
+        }
+        return;
+    }
+
+    batch->executor = cppadcg_executor;
+    batch->handle = NULL;
+    batch->size = nJobs;
+
+    for (i = 0; i < nJobs; ++i) {
+        ExecutorJob* job = &batch->jobs[i];
+        job->function = functions[i];
+        job->arg = args[i];
+        job->elapsed = elapsed != NULL ? &elapsed[i] : NULL;
+        job->worker = 0;
+
+        batch->submitted[i].function = executor_run_job;
+        batch->submitted[i].arg = NULL;
+    }
+
+    /**
+     * the jobs expected to take longer are submitted first
+     * (the order can be updated by other threads and it is only used if it
+     *  is a permutation)
+     */
+    if (order != NULL) {
+        pthread_mutex_lock(&cppadcg_executor_order_mutex);
+        for (i = 0; i < nJobs; ++i) {
+            pos = order[i];
+            if (pos < 0 || pos >= nJobs || batch->submitted[pos].arg != NULL) {
+                break;
+            }
+            batch->submitted[pos].arg = &batch->jobs[i];
+        }
+        pthread_mutex_unlock(&cppadcg_executor_order_mutex);
+    } else {
+        i = 0;
+    }
+
+    if (i != nJobs) {
+        for (i = 0; i < nJobs; ++i) {
+            batch->submitted[i].arg = &batch->jobs[i];
+        }
+    }
+
+    batch->prev = cppadcg_executor_batches;
+    cppadcg_executor_batches = batch;
+
+    if (cppadcg_executor_defined && !cppadcg_executor_disabled && nJobs > 0) {
+        batch->handle = (*batch->executor.submit)(batch->executor.data, batch->submitted, nJobs);
+        return;
+    }
+
+    // executor not used
+    batch->handle = NULL;
+    for (i = 0; i < nJobs; ++i) {
+        executor_run_job(batch->submitted[i].arg);
+    }
+}
+
+void cppadcg_executor_wait() {
+    ExecutorBatch* batch = cppadcg_executor_batches;
+    struct timespec diffTime;
+    int i;
+
+    if (batch == NULL)
+        return;
+
+    if (batch->handle != NULL) {
+        (*batch->executor.wait)(batch->executor.data, batch->handle);
+    }
+
+    cppadcg_executor_batches = batch->prev;
+
+    if (cppadcg_executor_verbose) {
+        for (i = 0; i < batch->size; ++i) {
+            ExecutorJob* job = &batch->jobs[i];
+            timespec_diff(&job->endTime, &job->startTime, &diffTime);
+            fprintf(stdout, "## Worker %i, Job %i, started at %ld.%.9ld, ended at %ld.%.9ld, elapsed %ld.%.9ld\n",
+                    job->worker, i, job->startTime.tv_sec, job->startTime.tv_nsec,
+                    job->endTime.tv_sec, job->endTime.tv_nsec, diffTime.tv_sec, diffTime.tv_nsec);
+        }
+    }
+
+    free(batch->jobs);
+    free(batch->submitted);
+    free(batch);
+}
+
+typedef struct pair_double_int {
+    float val;
+    int index;
+} pair_double_int;
+
+static int comparePair(const void* a, const void* b) {
+    if (((pair_double_int*) a)->val < ((pair_double_int*) b)->val)
+        return -1;
+    if (((pair_double_int*) a)->val == ((pair_double_int*) b)->val)
+        return 0;
+    return 1;
+}
+
+int cppadcg_executor_start_benchmark(int* benchmarking,
+                                     const unsigned int* nTimeMeas) {
+    int start;
+
+    if (cppadcg_executor_disabled)
+        return 0;
+
+    // only one calling thread measures the elapsed times of a model function at a time
+    pthread_mutex_lock(&cppadcg_executor_order_mutex);
+    start = !(*benchmarking) && *nTimeMeas < cppadcg_executor_time_meas;
+    if (start)
+        *benchmarking = 1;
+    pthread_mutex_unlock(&cppadcg_executor_order_mutex);
+
+    return start;
+}
+
+void cppadcg_executor_end_benchmark(int* benchmarking,
+                                    unsigned int* nTimeMeas,
+                                    float refElapsed[],
+                                    const float elapsed[],
+                                    int order[],
+                                    int nJobs) {
+    pthread_mutex_lock(&cppadcg_executor_order_mutex);
+    executor_update_order(refElapsed, *nTimeMeas, elapsed, order, nJobs);
+    (*nTimeMeas)++;
+    *benchmarking = 0;
+    pthread_mutex_unlock(&cppadcg_executor_order_mutex);
+}
+
+void cppadcg_executor_update_order(float refElapsed[],
+                                   unsigned int nTimeMeas,
+                                   const float elapsed[],
+                                   int order[],
+                                   int nJobs) {
+    pthread_mutex_lock(&cppadcg_executor_order_mutex);
+    executor_update_order(refElapsed, nTimeMeas, elapsed, order, nJobs);
+    pthread_mutex_unlock(&cppadcg_executor_order_mutex);
+}
+
+static void executor_update_order(float refElapsed[],
+                                  unsigned int nTimeMeas,
+                                  const float elapsed[],
+                                  int order[],
+                                  int nJobs) {
+    if(nJobs == 0 || refElapsed == NULL || elapsed == NULL || order == NULL)
+        return;
+
+    struct pair_double_int elapsedOrder[nJobs];
+    int i;
+    int nonZero = 0; // false
+
+    for(i = 0; i < nJobs; ++i) {
+        if(elapsed[i] != 0) {
+            nonZero = 1;
+            break;
+        }
+    }
+
+    if (!nonZero) {
+        if (cppadcg_executor_verbose) {
+            fprintf(stdout, "order not updated: all times are zero\n");
+        }
+        return;
+    }
+
+    if(cppadcg_executor_time_update == ELAPSED_TIME_AVG) {
+        for (i = 0; i < nJobs; ++i) {
+            refElapsed[i] = (refElapsed[i] * nTimeMeas + elapsed[i]) / (nTimeMeas + 1);
+            elapsedOrder[i].val = refElapsed[i];
+            elapsedOrder[i].index = i;
+        }
+    } else {
+        // cppadcg_executor_time_update == ELAPSED_TIME_MIN
+        for (i = 0; i < nJobs; ++i) {
+            if(nTimeMeas == 0 || elapsed[i] < refElapsed[i]) {
+                refElapsed[i] = elapsed[i];
+            }
+            elapsedOrder[i].val = refElapsed[i];
+            elapsedOrder[i].index = i;
+        }
+    }
+
+    qsort(elapsedOrder, nJobs, sizeof(struct pair_double_int), comparePair);
+
+    for (i = 0; i < nJobs; ++i) {
+        order[elapsedOrder[i].index] = nJobs - i - 1; // descending order
+    }
+
+    if (cppadcg_executor_verbose) {
+        fprintf(stdout, "new order (%i values):\n", nTimeMeas + 1);
+        for (i = 0; i < nJobs; ++i) {
+            fprintf(stdout, " job id: %i   order: %i   time: %e s\n", i, order[i], refElapsed[i]);
+        }
+    }
+}
@@ -0,0 +1,150 @@
+#ifndef CPPADCG_EXECUTOR_H
+#define CPPADCG_EXECUTOR_H
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum ScheduleStrategy {SCHED_STATIC = 1,
+                       SCHED_DYNAMIC = 2,
+                       SCHED_GUIDED = 3
+                       };
+
+enum ElapsedTimeReference {ELAPSED_TIME_AVG,
+                           ELAPSED_TIME_MIN};
+
+typedef void (*cppadcg_executor_function_type)(void*);
+
+/**
+ * A job which must be executed by the host executor
+ */
+typedef struct CppADCGExecutorJob {
+    cppadcg_executor_function_type function;
+    void* arg;
+} CppADCGExecutorJob;
+
+/**
+ * Callbacks provided by the host application to run the jobs of
+ * multithreaded model functions
+ */
+typedef struct CppADCGExecutor {
+    /**
+     * host data passed to all callbacks
+     */
+    void* data;
+    /**
+     * Starts the execution of a batch of jobs (sorted by decreasing
+     * expected cost) and returns a handle for the batch.
+     * The jobs array remains valid until wait() returns.
+     */
+    void* (*submit)(void* data, const CppADCGExecutorJob jobs[], int nJobs);
+    /**
+     * Blocks until all the jobs in a batch have finished.
+     */
+    void (*wait)(void* data, void* batch);
+    /**
+     * The maximum number of workers which can run jobs simultaneously.
+     */
+    int (*get_workers)(void* data);
+    /**
+     * The identifier of the current worker (from 0 to get_workers() - 1).
+     */
+    int (*get_worker_id)(void* data);
+} CppADCGExecutor;
+
+
+int cppadcg_executor_set(const CppADCGExecutor* executor);
+
+int cppadcg_executor_is_defined();
+
+
+void cppadcg_executor_set_threads(int n);
+
+int cppadcg_executor_get_threads();
+
+int cppadcg_executor_get_workers();
+
+int cppadcg_executor_get_worker_id();
+
+
+void cppadcg_executor_set_scheduler_strategy(enum ScheduleStrategy s);
+
+enum ScheduleStrategy cppadcg_executor_get_scheduler_strategy();
+
+
+unsigned int cppadcg_executor_get_n_time_meas();
+
+void cppadcg_executor_set_n_time_meas(unsigned int n);
+
+
+enum ElapsedTimeReference cppadcg_executor_get_time_meas_ref();
+
+void cppadcg_executor_set_time_meas_ref(enum ElapsedTimeReference r);
+
+
+void cppadcg_executor_set_verbose(int v);
+
+int cppadcg_executor_is_verbose();
+
+
+void cppadcg_executor_set_disabled(int disabled);
+
+int cppadcg_executor_is_disabled();
+
+
+void cppadcg_executor_add_jobs(cppadcg_executor_function_type functions[],
+                               void* args[],
+                               const float refElapsed[],
+                               float elapsed[],
+                               const int order[],
+                               int job2Thread[],
+                               int nJobs,
+                               int lastElapsedChanged);
+
+void cppadcg_executor_wait();
+
+void cppadcg_executor_update_order(float refElapsed[],
+                                   unsigned int nTimeMeas,
+                                   const float elapsed[],
+                                   int order[],
+                                   int nJobs);
+
+/**
+ * Whether or not the calling thread should measure the elapsed time of the
+ * jobs of a model function (only one thread at a time).
+ * cppadcg_executor_end_benchmark() must be called afterwards if it returns
+ * true.
+ */
+int cppadcg_executor_start_benchmark(int* benchmarking,
+                                     const unsigned int* nTimeMeas);
+
+/**
+ * Updates the job order of a model function with the measured elapsed times
+ * and allows other threads to measure them.
+ */
+void cppadcg_executor_end_benchmark(int* benchmarking,
+                                    unsigned int* nTimeMeas,
+                                    float refElapsed[],
+                                    const float elapsed[],
+                                    int order[],
+                                    int nJobs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
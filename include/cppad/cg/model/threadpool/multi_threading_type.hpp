@@ -21,7 +21,8 @@ namespace cg {
 enum class MultiThreadingType {
     NONE, // no multithreading
     OPENMP, // using the OpenMP library (does not work on dynamically loaded model libraries)
-    PTHREADS // using the PThreads library
+    PTHREADS, // using the PThreads library
+    EXECUTOR // using an executor provided by the application (see ModelLibrary::setThreadPoolExecutor())
 };
 
 }
@@ -21,6 +21,7 @@
 #include <unistd.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <pthread.h>
 #include <errno.h>
 #include <time.h>
@@ -38,7 +39,8 @@ enum ScheduleStrategy {SCHED_STATIC = 1,
                        };
 
 enum ElapsedTimeReference {ELAPSED_TIME_AVG,
-                           ELAPSED_TIME_MIN};
+                           ELAPSED_TIME_MIN,
+                           ELAPSED_TIME_EWMA};
 
 typedef struct ThPool ThPool;
 typedef void (* thpool_function_type)(void*);
@@ -51,8 +53,18 @@ static enum ElapsedTimeReference cppadcg_pool_time_update = ELAPSED_TIME_MIN;
 static unsigned int cppadcg_pool_time_meas = 10; // default number of time measurements
 static float cppadcg_pool_guided_maxgroupwork = 0.75;
 
+static float cppadcg_pool_spin_time = 50e-6f; // time spent by idle workers waiting for new jobs before sleeping (s)
+static float cppadcg_pool_ewma_alpha = 0.2f; // weight of new time measurements (ELAPSED_TIME_EWMA only)
+static unsigned int cppadcg_pool_rebalance_period = 32; // calls between time measurements after the initial ones (ELAPSED_TIME_EWMA only)
+
+static float cppadcg_pool_last_imbalance = 0; // imbalance between threads in the last call
+static double cppadcg_pool_imbalance_sum = 0; // sum of the imbalance of all measured calls
+static unsigned int cppadcg_pool_n_imbalance = 0; // number of calls used in cppadcg_pool_imbalance_sum
+
 static enum ScheduleStrategy schedule_strategy = SCHED_DYNAMIC;
 
+static __thread int cppadcg_pool_worker_id = 0; // id of the pool thread (zero for other threads)
+
 /* ==================== INTERNAL HIGH LEVEL API  ====================== */
 
 static ThPool* thpool_init(int num_threads);
@@ -78,17 +90,9 @@ static void thpool_wait(ThPool*);
 static void thpool_destroy(ThPool*);
 
 /* ========================== STRUCTURES ============================ */
-/* Binary semaphore */
-typedef struct BSem {
-    pthread_mutex_t mutex;
-    pthread_cond_t   cond;
-    int v;
-} BSem;
-
 
 /* Job */
 typedef struct Job {
-    struct Job*  prev;                   /* pointer to previous job              */
     thpool_function_type function;       /* function pointer                     */
     void*  arg;                          /* function's argument                  */
     const float* avgElapsed;             /* the last measurement of elapsed time */
@@ -100,9 +104,10 @@ typedef struct Job {
 
 /* Work group */
 typedef struct WorkGroup {
-    struct WorkGroup*  prev;             /* pointer to previous WorkGroup  */
+    struct WorkGroup*  prev;             /* pointer to previous WorkGroup (verbose only) */
     struct Job* jobs;                    /* jobs                           */
     int size;                            /* number of jobs                 */
+    int capacity;                        /* allocated number of jobs       */
     struct timespec startTime;           /* initial time (verbose only)    */
     struct timespec endTime;             /* final time (verbose only)      */
 } WorkGroup;
@@ -110,13 +115,21 @@ typedef struct WorkGroup {
 /* Job queue */
 typedef struct JobQueue {
     pthread_mutex_t rwmutex;             /* used for queue r/w access */
-    Job  *front;                         /* pointer to front of queue */
-    Job  *rear;                          /* pointer to rear  of queue */
-    WorkGroup* group_front;              /* previously created work groups (SCHED_STATIC scheduling only)*/
-    BSem *has_jobs;                      /* flag as binary semaphore  */
+    Job* jobs;                           /* ring of jobs (reused between calls) */
+    int capacity;                        /* size of the ring          */
+    int front;                           /* index of the front of the queue */
     int   len;                           /* number of jobs in queue   */
+    WorkGroup* static_groups;            /* work groups waiting for a thread (SCHED_STATIC scheduling only) */
+    int n_static_groups;                 /* number of work groups waiting for a thread */
+    int static_capacity;                 /* allocated number of static work groups */
     float total_time;                    /* total expected time to complete the work */
     float highest_expected_return;       /* the time when the last running thread is expected to request new work */
+    volatile unsigned int published;     /* incremented every time new jobs are added */
+    volatile int pending;                /* jobs added but not yet completed */
+    volatile int num_threads_sleeping;   /* threads waiting on has_jobs */
+    volatile int num_waiting;            /* threads waiting on threads_all_idle */
+    pthread_mutex_t sleep_mutex;         /* used by sleeping threads  */
+    pthread_cond_t has_jobs;             /* signals new jobs to sleeping threads */
 } JobQueue;
 
 
@@ -125,7 +138,9 @@ typedef struct Thread {
     int id;                              /* friendly id                          */
     pthread_t pthread;                   /* pointer to actual thread             */
     struct ThPool* thpool;               /* access to ThPool                     */
+    WorkGroup work;                      /* the jobs being executed (reused)     */
     WorkGroup* processed_groups;         /* processed work groups (verbose only) */
+    double busy;                         /* time spent executing jobs since the last wait (s) */
 } Thread;
 
 
@@ -134,11 +149,11 @@ typedef struct ThPool {
     Thread** threads;                    /* pointer to threads        */
     int num_threads;                     /* total number of threads   */
     volatile int num_threads_alive;      /* threads currently alive   */
-    volatile int num_threads_working;    /* threads currently working */
     pthread_mutex_t thcount_lock;        /* used for thread count etc */
     pthread_cond_t threads_all_idle;     /* signal to thpool_wait     */
     JobQueue* jobqueue;                  /* pointer to the job queue  */
     volatile int threads_keepalive;
+    float spin_time;                     /* time spent spinning before sleeping (s) */
 } ThPool;
 
 /* ========================== PUBLIC API ============================ */
@@ -151,6 +166,17 @@ int cppadcg_thpool_get_threads() {
     return cppadcg_pool_n_threads;
 }
 
+int cppadcg_thpool_get_workers() {
+    int n = cppadcg_pool_n_threads;
+    if (cppadcg_pool != NULL && cppadcg_pool->num_threads > n)
+        n = cppadcg_pool->num_threads; // the pool is not resized
+    return n > 0 ? n : 1;
+}
+
+int cppadcg_thpool_get_worker_id() {
+    return cppadcg_pool_worker_id;
+}
+
 void cppadcg_thpool_set_scheduler_strategy(enum ScheduleStrategy s) {
     if(cppadcg_pool != NULL) {
         pthread_mutex_lock(&cppadcg_pool->jobqueue->rwmutex);
@@ -227,10 +253,58 @@ void cppadcg_thpool_set_time_meas_ref(enum ElapsedTimeReference r) {
     cppadcg_pool_time_update = r;
 }
 
+float cppadcg_thpool_get_ewma_alpha() {
+    return cppadcg_pool_ewma_alpha;
+}
+
+void cppadcg_thpool_set_ewma_alpha(float a) {
+    if (a > 0 && a <= 1)
+        cppadcg_pool_ewma_alpha = a;
+}
+
+unsigned int cppadcg_thpool_get_rebalance_period() {
+    return cppadcg_pool_rebalance_period;
+}
+
+void cppadcg_thpool_set_rebalance_period(unsigned int n) {
+    cppadcg_pool_rebalance_period = n;
+}
+
+float cppadcg_thpool_get_last_imbalance() {
+    return cppadcg_pool_last_imbalance;
+}
+
+float cppadcg_thpool_get_avg_imbalance() {
+    if (cppadcg_pool_n_imbalance == 0)
+        return 0;
+    return (float) (cppadcg_pool_imbalance_sum / cppadcg_pool_n_imbalance);
+}
+
+unsigned int cppadcg_thpool_get_n_imbalance_meas() {
+    return cppadcg_pool_n_imbalance;
+}
+
+void cppadcg_thpool_reset_imbalance() {
+    cppadcg_pool_last_imbalance = 0;
+    cppadcg_pool_imbalance_sum = 0;
+    cppadcg_pool_n_imbalance = 0;
+}
+
 int cppadcg_thpool_is_verbose() {
     return cppadcg_pool_verbose;
 }
 
+void cppadcg_thpool_set_spin_time(float t) {
+    cppadcg_pool_spin_time = t;
+    if (cppadcg_pool != NULL && sysconf(_SC_NPROCESSORS_ONLN) > cppadcg_pool->num_threads) {
+        cppadcg_pool->spin_time = t;
+    }
+}
+
+float cppadcg_thpool_get_spin_time() {
+    return cppadcg_pool_spin_time;
+}
+
 void cppadcg_thpool_prepare() {
     if(cppadcg_pool == NULL) {
         cppadcg_pool = thpool_init(cppadcg_pool_n_threads);
@@ -282,6 +356,18 @@ void cppadcg_thpool_wait() {
     }
 }
 
+int cppadcg_thpool_do_benchmark(unsigned int nMeas,
+                                unsigned int nCalls) {
+    if (cppadcg_pool_disabled)
+        return 0;
+    if (nMeas < cppadcg_pool_time_meas)
+        return 1;
+    // keep measuring (and rebalancing) periodically
+    return cppadcg_pool_time_update == ELAPSED_TIME_EWMA &&
+           cppadcg_pool_rebalance_period > 0 &&
+           nCalls % cppadcg_pool_rebalance_period == 0;
+}
+
 typedef struct pair_double_int {
     float val;
     int index;
@@ -327,6 +413,16 @@ void cppadcg_thpool_update_order(float refElapsed[],
             elapsedOrder[i].val = refElapsed[i];
             elapsedOrder[i].index = i;
         }
+    } else if(cppadcg_pool_time_update == ELAPSED_TIME_EWMA) {
+        // the first measurements are averaged so that the estimate does not depend too much on the first ones
+        float alpha = 1.0f / (nTimeMeas + 1);
+        if (alpha < cppadcg_pool_ewma_alpha)
+            alpha = cppadcg_pool_ewma_alpha;
+        for (i = 0; i < nJobs; ++i) {
+            refElapsed[i] += alpha * (elapsed[i] - refElapsed[i]);
+            elapsedOrder[i].val = refElapsed[i];
+            elapsedOrder[i].index = i;
+        }
     } else {
         // cppadcg_pool_time_update == ELAPSED_TIME_MIN
         for (i = 0; i < nJobs; ++i) {
@@ -363,38 +459,114 @@ void cppadcg_thpool_shutdown() {
 /* ========================== PROTOTYPES ============================ */
 
 static void thpool_cleanup(ThPool* thpool);
+static void thpool_update_imbalance(ThPool* thpool);
+static void thpool_wake_all(ThPool* thpool);
+static void thpool_job_done(ThPool* thpool,
+                            int nJobs);
 
 static int  thread_init(ThPool* thpool,
                         Thread** thread,
                         int id);
 static void* thread_do(Thread* thread);
+static void  thread_wait_jobs(Thread* thread,
+                              unsigned int* seen);
 static void  thread_destroy(Thread* thread);
 
 static int   jobqueue_init(ThPool* thpool);
 static void  jobqueue_clear(ThPool* thpool);
-static void  jobqueue_push(JobQueue* queue,
-                           Job* newjob_p);
-static void jobqueue_multipush(JobQueue* queue,
-                               Job* newjob[],
-                               int nJobs);
+static int   jobqueue_reserve(JobQueue* queue,
+                              int nJobs);
+static Job*  jobqueue_push_internal(JobQueue* queue);
+static void  jobqueue_publish(ThPool* thpool,
+                              int nJobs);
 static int jobqueue_push_static_jobs(ThPool* thpool,
-                                     Job* newjobs[],
+                                     thpool_function_type functions[],
+                                     void* args[],
                                      const float avgElapsed[],
+                                     float elapsed[],
+                                     const int order[],
                                      int jobs2thread[],
                                      int nJobs,
                                      int lastElapsedChanged);
-static WorkGroup* jobqueue_pull(ThPool* thpool, int id);
+static WorkGroup* jobqueue_pull(ThPool* thpool,
+                                Thread* thread);
 static void  jobqueue_destroy(ThPool* thpool);
 
-static void  bsem_init(BSem *bsem, int value);
-static void  bsem_reset(BSem *bsem);
-static void  bsem_post(BSem *bsem);
-static void  bsem_post_all(BSem *bsem);
-static void  bsem_wait(BSem *bsem);
+static int   workgroup_reserve(WorkGroup* group,
+                               int size);
+
+#if defined(__x86_64__) || defined(__i386__)
+#define cpu_relax() __builtin_ia32_pause()
+#elif defined(__aarch64__)
+#define cpu_relax() __asm__ __volatile__("yield" ::: "memory")
+#else
+#define cpu_relax() do {} while (0)
+#endif
 
 
 /* ============================ TIME ============================== */
 
+#if defined(__x86_64__) || defined(__i386__)
+#define CPPADCG_POOL_CYCLE_COUNTER
+static inline unsigned long long read_cycle_counter() {
+    return __builtin_ia32_rdtsc();
+}
+#elif defined(__aarch64__)
+#define CPPADCG_POOL_CYCLE_COUNTER
+static inline unsigned long long read_cycle_counter() {
+    unsigned long long v;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+}
+#endif
+
+static double cppadcg_pool_cycle_period = 0; // seconds per tick of the cycle counter (zero if not available)
+
+static void calibrate_cycle_counter() {
+#if defined(CPPADCG_POOL_CYCLE_COUNTER)
+    if (cppadcg_pool_cycle_period > 0)
+        return;
+#if defined(__aarch64__)
+    unsigned long long freq;
+    __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(freq));
+    if (freq > 0)
+        cppadcg_pool_cycle_period = 1.0 / freq;
+#else
+    // assumes an invariant time stamp counter (it does not depend on the CPU frequency)
+    struct timespec start, end;
+    unsigned long long c0, c1;
+    double dt;
+    if (clock_gettime(CLOCK_MONOTONIC, &start) != 0)
+        return;
+    c0 = read_cycle_counter();
+    do {
+        if (clock_gettime(CLOCK_MONOTONIC, &end) != 0)
+            return;
+        dt = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) * 1e-9;
+    } while (dt < 1e-3);
+    c1 = read_cycle_counter();
+    if (c1 > c0)
+        cppadcg_pool_cycle_period = dt / (c1 - c0);
+#endif
+#endif
+}
+
+/**
+ * A cheap wall clock time (s) used to measure jobs continuously.
+ * It uses the cycle counter when available and the monotonic clock
+ * otherwise.
+ */
+static double get_fast_time() {
+#if defined(CPPADCG_POOL_CYCLE_COUNTER)
+    if (cppadcg_pool_cycle_period > 0)
+        return read_cycle_counter() * cppadcg_pool_cycle_period;
+#endif
+    struct timespec time;
+    if (clock_gettime(CLOCK_MONOTONIC, &time) != 0)
+        return 0;
+    return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
 static float get_thread_time(struct timespec* cputime,
                              int* info) {
     *info = clock_gettime(CLOCK_THREAD_CPUTIME_ID, cputime);
@@ -481,8 +653,11 @@ struct ThPool* thpool_init(int num_threads) {
     }
     thpool->num_threads = num_threads;
     thpool->num_threads_alive = 0;
-    thpool->num_threads_working = 0;
     thpool->threads_keepalive = 1;
+    /* spinning only helps when the waiting threads do not compete for the same cores */
+    thpool->spin_time = sysconf(_SC_NPROCESSORS_ONLN) > num_threads ? cppadcg_pool_spin_time : 0;
+
+    calibrate_cycle_counter();
 
     /* Initialize the job queue */
     if (jobqueue_init(thpool) == -1) {
@@ -548,26 +723,41 @@ static int thpool_add_job(ThPool* thpool,
                           void* arg,
                           const float* avgElapsed,
                           float* elapsed) {
+    JobQueue* queue = thpool->jobqueue;
     Job* newjob;
 
-    newjob = (struct Job*) malloc(sizeof(struct Job));
-    if (newjob == NULL) {
+    pthread_mutex_lock(&queue->rwmutex);
+
+    if (jobqueue_reserve(queue, 1) != 0) {
+        pthread_mutex_unlock(&queue->rwmutex);
         fprintf(stderr, "thpool_add_job(): Could not allocate memory for new job\n");
         return -1;
     }
 
     /* add function and argument */
+    newjob = jobqueue_push_internal(queue);
     newjob->function = function;
     newjob->arg = arg;
     newjob->avgElapsed = avgElapsed;
     newjob->elapsed = elapsed;
+    newjob->id = 0;
+    if (avgElapsed != NULL) {
+        queue->total_time += *avgElapsed;
+    }
+
+    jobqueue_publish(thpool, 1);
 
-    /* add job to queue */
-    jobqueue_push(thpool->jobqueue, newjob);
+    pthread_mutex_unlock(&queue->rwmutex);
 
     return 0;
 }
 
+/**
+ * Adds all the jobs to the queue at once (a single lock and a single
+ * wake-up of the sleeping threads).
+ * The jobs are placed in the queue according to order (the position of
+ * each job) and they are copied into a ring which is reused between calls.
+ */
 static int thpool_add_jobs(ThPool* thpool,
                            thpool_function_type functions[],
                            void* args[],
@@ -577,94 +767,99 @@ static int thpool_add_jobs(ThPool* thpool,
                            int job2Thread[],
                            int nJobs,
                            int lastElapsedChanged) {
-    Job* newjobs[nJobs];
+    JobQueue* queue = thpool->jobqueue;
+    Job* newjob;
     int i;
     int j;
 
-    for (i = 0; i < nJobs; ++i) {
-        newjobs[i] = (Job*) malloc(sizeof(Job));
-        if (newjobs[i] == NULL) {
-            fprintf(stderr, "thpool_add_jobs(): Could not allocate memory for new jobs\n");
-            return -1;
-        }
+    if (schedule_strategy == SCHED_STATIC && avgElapsed != NULL && order != NULL && nJobs > 0 && avgElapsed[0] > 0) {
+        return jobqueue_push_static_jobs(thpool, functions, args, avgElapsed, elapsed, order, job2Thread, nJobs, lastElapsedChanged);
+    }
+
+    pthread_mutex_lock(&queue->rwmutex);
+
+    if (jobqueue_reserve(queue, nJobs) != 0) {
+        pthread_mutex_unlock(&queue->rwmutex);
+        fprintf(stderr, "thpool_add_jobs(): Could not allocate memory for new jobs\n");
+        return -1;
+    }
+
+    /* the position in the ring of the first new job */
+    int first = queue->front + queue->len;
+
+    for (j = 0; j < nJobs; ++j) {
+        i = order != NULL ? order[j] : j;
+        newjob = &queue->jobs[(first + i) % queue->capacity];
 
-        j = order != NULL ? order[i] : i;
         /* add function and argument */
-        newjobs[i]->function = functions[j];
-        newjobs[i]->arg = args[j];
-        newjobs[i]->id = i;
-        if (avgElapsed != NULL)
-            newjobs[i]->avgElapsed = &avgElapsed[j];
-        else
-            newjobs[i]->avgElapsed = NULL;
+        newjob->function = functions[j];
+        newjob->arg = args[j];
+        newjob->id = j;
+        if (avgElapsed != NULL) {
+            newjob->avgElapsed = &avgElapsed[j];
+            queue->total_time += avgElapsed[j];
+        } else {
+            newjob->avgElapsed = NULL;
+        }
 
         if (elapsed != NULL)
-            newjobs[i]->elapsed = &elapsed[j];
+            newjob->elapsed = &elapsed[j];
         else
-            newjobs[i]->elapsed = NULL;
+            newjob->elapsed = NULL;
     }
+    queue->len += nJobs;
 
-    /* add jobs to queue */
-    if (schedule_strategy == SCHED_STATIC && avgElapsed != NULL && order != NULL && nJobs > 0 && avgElapsed[0] > 0) {
-        return jobqueue_push_static_jobs(thpool, newjobs, avgElapsed, job2Thread, nJobs, lastElapsedChanged);
-    } else {
-        jobqueue_multipush(thpool->jobqueue, newjobs, nJobs);
-        return 0;
-    }
+    jobqueue_publish(thpool, nJobs);
+
+    pthread_mutex_unlock(&queue->rwmutex);
+
+    return 0;
 }
 
 /**
  * Split work among the threads evenly considering the elapsed time of each job.
  */
 static int jobqueue_push_static_jobs(ThPool* thpool,
-                                     Job* newjobs[],
+                                     thpool_function_type functions[],
+                                     void* args[],
                                      const float avgElapsed[],
+                                     float elapsed[],
+                                     const int order[],
                                      int jobs2thread[],
                                      int nJobs,
                                      int lastElapsedChanged) {
     float total_duration, target_duration, next_duration, best_duration;
-    int i, j, iBest;
+    int i, j, p, iBest;
     int added;
     int num_threads = thpool->num_threads;
-    int* n_jobs;
-    float* durations = NULL;
-    WorkGroup** groups;
+    int nGroups;
+    JobQueue* queue = thpool->jobqueue;
     WorkGroup* group;
+    Job* job;
 
     if(nJobs < num_threads)
         num_threads = nJobs;
 
-    n_jobs = (int*) malloc(num_threads * sizeof(int));
-    if (n_jobs == NULL) {
-        fprintf(stderr, "jobqueue_push_static_jobs(): Could not allocate memory\n");
-        return -1;
-    }
-
-    groups = (WorkGroup**) malloc(num_threads * sizeof(WorkGroup*));
-    if (groups == NULL) {
-        fprintf(stderr, "jobqueue_push_static_jobs(): Could not allocate memory\n");
-        free(n_jobs);
-        return -1;
-    }
+    int n_jobs[num_threads];
+    float durations[num_threads];
+    int byPosition[nJobs]; // jobs sorted by decreasing duration
+    int computed = 0; // false
 
     for (i = 0; i < num_threads; ++i) {
         n_jobs[i] = 0;
     }
 
-    total_duration = 0;
-    for (i = 0; i < nJobs; ++i) {
-        total_duration += avgElapsed[i];
+    for (j = 0; j < nJobs; ++j) {
+        byPosition[order[j]] = j;
     }
 
+    total_duration = 0;
+    for (j = 0; j < nJobs; ++j) {
+        total_duration += avgElapsed[j];
+    }
 
-    if (nJobs > 0 && (lastElapsedChanged || jobs2thread[0] < 0)) {
-        durations = (float*) malloc(num_threads * sizeof(float));
-        if (durations == NULL) {
-            fprintf(stderr, "jobqueue_push_static_jobs(): Could not allocate memory\n");
-            free(n_jobs);
-            free(groups);
-            return -1;
-        }
+    if (lastElapsedChanged || jobs2thread[0] < 0) {
+        computed = 1;
 
         for(i = 0; i < num_threads; ++i) {
             durations[i] = 0;
@@ -673,7 +868,8 @@ static int jobqueue_push_static_jobs(ThPool* thpool,
         // decide in which work group to place each job
         target_duration = total_duration / num_threads;
 
-        for (j = 0; j < nJobs; ++j) {
+        for (p = 0; p < nJobs; ++p) {
+            j = byPosition[p];
             added = 0;
             for (i = 0; i < num_threads; ++i) {
                 next_duration = durations[i] + avgElapsed[j];
@@ -711,56 +907,62 @@ static int jobqueue_push_static_jobs(ThPool* thpool,
     }
 
     /**
-     * create the work groups
+     * add to the queue (work groups are reused between calls)
      */
-    for (i = 0; i < num_threads; ++i) {
-        group = (WorkGroup*) malloc(sizeof(WorkGroup));
-        group->size = 0;
-        group->jobs = (Job*) malloc(n_jobs[i] * sizeof(Job));
-        groups[i] = group;
+    pthread_mutex_lock(&queue->rwmutex);
+
+    nGroups = queue->n_static_groups + num_threads;
+    if (nGroups > queue->static_capacity) {
+        group = (WorkGroup*) realloc(queue->static_groups, nGroups * sizeof(WorkGroup));
+        if (group == NULL) {
+            pthread_mutex_unlock(&queue->rwmutex);
+            fprintf(stderr, "jobqueue_push_static_jobs(): Could not allocate memory\n");
+            return -1;
+        }
+        memset(&group[queue->static_capacity], 0, (nGroups - queue->static_capacity) * sizeof(WorkGroup));
+        queue->static_groups = group;
+        queue->static_capacity = nGroups;
     }
-    for (i = 0; i < num_threads - 1; ++i) {
-        groups[i]->prev = groups[i + 1];
+
+    group = &queue->static_groups[queue->n_static_groups];
+    for (i = 0; i < num_threads; ++i) {
+        group[i].size = 0;
+        if (workgroup_reserve(&group[i], n_jobs[i]) != 0) {
+            pthread_mutex_unlock(&queue->rwmutex);
+            fprintf(stderr, "jobqueue_push_static_jobs(): Could not allocate memory\n");
+            return -1;
+        }
     }
-    groups[num_threads - 1]->prev = NULL;
 
     // place jobs on the work groups
-    for (j = 0; j < nJobs; ++j) {
+    for (p = 0; p < nJobs; ++p) {
+        j = byPosition[p];
         i = jobs2thread[j];
-        group = groups[i];
-        group->jobs[group->size] = *newjobs[j]; // copy
-        group->size++;
-        free(newjobs[j]);
+        job = &group[i].jobs[group[i].size++];
+        job->function = functions[j];
+        job->arg = args[j];
+        job->avgElapsed = &avgElapsed[j];
+        job->elapsed = elapsed != NULL ? &elapsed[j] : NULL;
+        job->id = j;
     }
 
     if (cppadcg_pool_verbose) {
-        if (durations != NULL) {
+        if (computed) {
             for (i = 0; i < num_threads; ++i) {
-                fprintf(stdout, "jobqueue_push_static_jobs(): work group %i with %i jobs for %e s\n", i, groups[i]->size, durations[i]);
+                fprintf(stdout, "jobqueue_push_static_jobs(): work group %i with %i jobs for %e s\n", i, group[i].size, durations[i]);
             }
         } else {
             for (i = 0; i < num_threads; ++i) {
-                fprintf(stdout, "jobqueue_push_static_jobs(): work group %i with %i jobs\n", i, groups[i]->size);
+                fprintf(stdout, "jobqueue_push_static_jobs(): work group %i with %i jobs\n", i, group[i].size);
             }
         }
     }
 
-    /**
-     * add to the queue
-     */
-    pthread_mutex_lock(&thpool->jobqueue->rwmutex);
-
-    groups[num_threads - 1]->prev = thpool->jobqueue->group_front;
-    thpool->jobqueue->group_front = groups[0];
-
-    bsem_post_all(thpool->jobqueue->has_jobs);
+    queue->n_static_groups = nGroups;
 
-    pthread_mutex_unlock(&thpool->jobqueue->rwmutex);
+    jobqueue_publish(thpool, nJobs);
 
-    // clean up
-    free(durations);
-    free(n_jobs);
-    free(groups);
+    pthread_mutex_unlock(&queue->rwmutex);
 
     return 0;
 }
@@ -772,11 +974,8 @@ static int jobqueue_push_static_jobs(ThPool* thpool,
  * Once the queue is empty and all work has completed, the calling thread
  * (probably the main program) will continue.
  *
- * Smart polling is used in wait. The polling is initially 0 - meaning that
- * there is virtually no polling at all. If after 1 seconds the threads
- * haven't finished, the polling interval starts growing exponentially
- * untill it reaches max_secs seconds. Then it jumps down to a maximum polling
- * interval assuming that heavy processing is being used in the threadpool.
+ * The calling thread spins for a short time (small batches usually end
+ * within a few microseconds) before sleeping until the last job ends.
  *
  * @example
  *
@@ -792,17 +991,105 @@ static int jobqueue_push_static_jobs(ThPool* thpool,
  * @param threadpool     the threadpool to wait for
  */
 static void thpool_wait(ThPool* thpool) {
-    pthread_mutex_lock(&thpool->thcount_lock);
-    while (thpool->jobqueue->len || thpool->jobqueue->group_front || thpool->num_threads_working) {  //// PROBLEM HERE!!!! len is not locked!!!!
-        pthread_cond_wait(&thpool->threads_all_idle, &thpool->thcount_lock);
+    JobQueue* queue = thpool->jobqueue;
+    struct timespec start, now;
+    struct timespec diffTime;
+    int i;
+
+    if (thpool->spin_time > 0 && __atomic_load_n(&queue->pending, __ATOMIC_ACQUIRE) > 0) {
+        get_monotonic_time2(&start);
+        for (i = 1; __atomic_load_n(&queue->pending, __ATOMIC_ACQUIRE) > 0; ++i) {
+            cpu_relax();
+            if ((i & 255) == 0) {
+                get_monotonic_time2(&now);
+                timespec_diff(&now, &start, &diffTime);
+                if (diffTime.tv_sec + diffTime.tv_nsec * 1e-9f > thpool->spin_time)
+                    break;
+            }
+        }
     }
-    thpool->jobqueue->total_time = 0;
-    thpool->jobqueue->highest_expected_return = 0;
-    pthread_mutex_unlock(&thpool->thcount_lock);
+
+    if (__atomic_load_n(&queue->pending, __ATOMIC_ACQUIRE) > 0) {
+        pthread_mutex_lock(&thpool->thcount_lock);
+        __atomic_add_fetch(&queue->num_waiting, 1, __ATOMIC_SEQ_CST);
+        while (__atomic_load_n(&queue->pending, __ATOMIC_SEQ_CST) > 0) {
+            pthread_cond_wait(&thpool->threads_all_idle, &thpool->thcount_lock);
+        }
+        __atomic_sub_fetch(&queue->num_waiting, 1, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&thpool->thcount_lock);
+    }
+
+    pthread_mutex_lock(&queue->rwmutex);
+    queue->total_time = 0;
+    queue->highest_expected_return = 0;
+    pthread_mutex_unlock(&queue->rwmutex);
+
+    thpool_update_imbalance(thpool);
 
     thpool_cleanup(thpool);
 }
 
+/**
+ * Determines how unevenly the work of the last call was distributed among
+ * the threads: the busiest thread time divided by the average thread time,
+ * minus one (zero when all threads were busy for the same time).
+ *
+ * Notice: it must only be called when all jobs have completed.
+ */
+static void thpool_update_imbalance(ThPool* thpool) {
+    double max = 0;
+    double total = 0;
+    int i;
+
+    for (i = 0; i < thpool->num_threads; ++i) {
+        Thread* thread = thpool->threads[i];
+        total += thread->busy;
+        if (thread->busy > max)
+            max = thread->busy;
+        thread->busy = 0;
+    }
+
+    if (total <= 0)
+        return; // no jobs
+
+    cppadcg_pool_last_imbalance = (float) (max * thpool->num_threads / total - 1);
+    cppadcg_pool_imbalance_sum += cppadcg_pool_last_imbalance;
+    cppadcg_pool_n_imbalance++;
+
+    if (cppadcg_pool_verbose) {
+        fprintf(stdout, "thpool_wait(): busiest thread %e s, imbalance %f\n", max, cppadcg_pool_last_imbalance);
+    }
+}
+
+/**
+ * Called by the worker threads after completing jobs.
+ * The last job wakes up any thread sleeping in thpool_wait().
+ */
+static void thpool_job_done(ThPool* thpool,
+                            int nJobs) {
+    JobQueue* queue = thpool->jobqueue;
+
+    if (__atomic_sub_fetch(&queue->pending, nJobs, __ATOMIC_SEQ_CST) == 0 &&
+        __atomic_load_n(&queue->num_waiting, __ATOMIC_SEQ_CST) > 0) {
+        pthread_mutex_lock(&thpool->thcount_lock);
+        pthread_cond_broadcast(&thpool->threads_all_idle);
+        pthread_mutex_unlock(&thpool->thcount_lock);
+    }
+}
+
+/**
+ * Wakes up all the threads waiting for new jobs.
+ */
+static void thpool_wake_all(ThPool* thpool) {
+    JobQueue* queue = thpool->jobqueue;
+
+    __atomic_add_fetch(&queue->published, 1, __ATOMIC_SEQ_CST);
+
+    pthread_mutex_lock(&queue->sleep_mutex);
+    pthread_cond_broadcast(&queue->has_jobs);
+    pthread_mutex_unlock(&queue->sleep_mutex);
+}
+
 
 /**
  * Called to clean-up after waiting for a thread pool to end the current work.
@@ -891,14 +1178,14 @@ static void thpool_destroy(ThPool* thpool) {
     double tpassed = 0.0;
     time(&start);
     while (tpassed < TIMEOUT && thpool->num_threads_alive) {
-        bsem_post_all(thpool->jobqueue->has_jobs);
+        thpool_wake_all(thpool);
         time(&end);
         tpassed = difftime(end, start);
     }
 
     /* Poll remaining threads */
     while (thpool->num_threads_alive) {
-        bsem_post_all(thpool->jobqueue->has_jobs);
+        thpool_wake_all(thpool);
         sleep(1);
     }
 
@@ -945,6 +1232,8 @@ static int thread_init(ThPool* thpool,
     (*thread)->thpool = thpool;
     (*thread)->id = id;
     (*thread)->processed_groups = NULL;
+    (*thread)->busy = 0;
+    memset(&(*thread)->work, 0, sizeof(WorkGroup));
 
     pthread_create(&(*thread)->pthread, NULL, (void*) thread_do, (*thread));
     pthread_detach((*thread)->pthread);
@@ -961,13 +1250,16 @@ static int thread_init(ThPool* thpool,
 */
 static void* thread_do(Thread* thread) {
     float elapsed;
+    double start, groupStart;
     int info;
+    int fast_timing;
     struct timespec cputime;
-    JobQueue* queue;
     WorkGroup* workGroup;
+    WorkGroup* processed;
     Job* job;
     thpool_function_type func_buff;
     void* arg_buff;
+    unsigned int seen;
     int i;
 
     /* Set thread name for profiling and debugging */
@@ -983,33 +1275,26 @@ static void* thread_do(Thread* thread) {
     fprintf(stderr, "thread_do(): pthread_setname_np is not supported on this system");
 #endif
 
+    cppadcg_pool_worker_id = thread->id;
+
     /* Assure all threads have been created before starting serving */
     ThPool* thpool = thread->thpool;
 
+    /* Jobs added before this point are found by the first pull */
+    seen = __atomic_load_n(&thpool->jobqueue->published, __ATOMIC_ACQUIRE);
+
     /* Mark thread as alive (initialized) */
     pthread_mutex_lock(&thpool->thcount_lock);
     thpool->num_threads_alive += 1;
     pthread_mutex_unlock(&thpool->thcount_lock);
 
-    queue = thpool->jobqueue;
-
     while (thpool->threads_keepalive) {
 
-        bsem_wait(queue->has_jobs);
-
-        if (!thpool->threads_keepalive) {
-            break;
-        }
-
-        pthread_mutex_lock(&thpool->thcount_lock);
-        thpool->num_threads_working++;
-        pthread_mutex_unlock(&thpool->thcount_lock);
-
         while (thpool->threads_keepalive) {
             /* Read job from queue and execute it */
-            pthread_mutex_lock(&queue->rwmutex);
-            workGroup = jobqueue_pull(thpool, thread->id);
-            pthread_mutex_unlock(&queue->rwmutex);
+            pthread_mutex_lock(&thpool->jobqueue->rwmutex);
+            workGroup = jobqueue_pull(thpool, thread);
+            pthread_mutex_unlock(&thpool->jobqueue->rwmutex);
 
             if (workGroup == NULL)
                 break;
@@ -1018,6 +1303,9 @@ static void* thread_do(Thread* thread) {
                 get_monotonic_time2(&workGroup->startTime);
             }
 
+            fast_timing = cppadcg_pool_time_update == ELAPSED_TIME_EWMA;
+            groupStart = get_fast_time();
+
             for (i = 0; i < workGroup->size; ++i) {
                 job = &workGroup->jobs[i];
 
@@ -1027,7 +1315,12 @@ static void* thread_do(Thread* thread) {
 
                 int do_benchmark = job->elapsed != NULL;
                 if (do_benchmark) {
-                    elapsed = -get_thread_time(&cputime, &info);
+                    if (fast_timing) {
+                        start = get_fast_time();
+                        info = 0;
+                    } else {
+                        elapsed = -get_thread_time(&cputime, &info);
+                    }
                 }
 
                 /* Execute the job */
@@ -1036,9 +1329,13 @@ static void* thread_do(Thread* thread) {
                 func_buff(arg_buff);
 
                 if (do_benchmark && info == 0) {
-                    elapsed += get_thread_time(&cputime, &info);
-                    if (info == 0) {
-                        (*job->elapsed) = elapsed;
+                    if (fast_timing) {
+                        (*job->elapsed) = (float) (get_fast_time() - start);
+                    } else {
+                        elapsed += get_thread_time(&cputime, &info);
+                        if (info == 0) {
+                            (*job->elapsed) = elapsed;
+                        }
                     }
                 }
 
@@ -1047,27 +1344,31 @@ static void* thread_do(Thread* thread) {
                 }
             }
 
+            thread->busy += get_fast_time() - groupStart;
+
             if (cppadcg_pool_verbose) {
                 get_monotonic_time2(&workGroup->endTime);
 
-                if (thread->processed_groups == NULL) {
-                    thread->processed_groups = workGroup;
-                } else {
-                    workGroup->prev = thread->processed_groups;
-                    thread->processed_groups = workGroup;
+                /* keep a copy (the work group is reused) */
+                processed = (WorkGroup*) malloc(sizeof(WorkGroup));
+                if (processed != NULL) {
+                    *processed = *workGroup;
+                    processed->capacity = workGroup->size;
+                    processed->jobs = (Job*) malloc(workGroup->size * sizeof(Job));
+                    if (processed->jobs != NULL) {
+                        memcpy(processed->jobs, workGroup->jobs, workGroup->size * sizeof(Job));
+                        processed->prev = thread->processed_groups;
+                        thread->processed_groups = processed;
+                    } else {
+                        free(processed);
+                    }
                 }
-            } else {
-                free(workGroup->jobs);
-                free(workGroup);
             }
-        }
 
-        pthread_mutex_lock(&thpool->thcount_lock);
-        thpool->num_threads_working--;
-        if (!thpool->num_threads_working) {
-            pthread_cond_signal(&thpool->threads_all_idle);
+            thpool_job_done(thpool, workGroup->size);
         }
-        pthread_mutex_unlock(&thpool->thcount_lock);
+
+        thread_wait_jobs(thread, &seen);
     }
 
     pthread_mutex_lock(&thpool->thcount_lock);
@@ -1077,9 +1378,55 @@ static void* thread_do(Thread* thread) {
     return NULL;
 }
 
+/**
+ * Waits until new jobs are added to the queue (or the pool is destroyed).
+ * The thread spins for up to spin_time seconds, so that the
+ * jobs from consecutive calls do not require a system call to wake it up,
+ * and then it sleeps.
+ *
+ * @param thread the current thread
+ * @param seen the last value of the published counter which was processed
+ */
+static void thread_wait_jobs(Thread* thread,
+                             unsigned int* seen) {
+    ThPool* thpool = thread->thpool;
+    JobQueue* queue = thpool->jobqueue;
+    struct timespec start, now;
+    struct timespec diffTime;
+    int i;
+
+    if (thpool->spin_time > 0) {
+        get_monotonic_time2(&start);
+        for (i = 1; ; ++i) {
+            if (__atomic_load_n(&queue->published, __ATOMIC_ACQUIRE) != *seen || !thpool->threads_keepalive) {
+                *seen = __atomic_load_n(&queue->published, __ATOMIC_ACQUIRE);
+                return;
+            }
+            cpu_relax();
+            if ((i & 255) == 0) {
+                get_monotonic_time2(&now);
+                timespec_diff(&now, &start, &diffTime);
+                if (diffTime.tv_sec + diffTime.tv_nsec * 1e-9f > thpool->spin_time)
+                    break;
+            }
+        }
+    }
+
+    pthread_mutex_lock(&queue->sleep_mutex);
+    __atomic_add_fetch(&queue->num_threads_sleeping, 1, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&queue->published, __ATOMIC_SEQ_CST) == *seen && thpool->threads_keepalive) {
+        pthread_cond_wait(&queue->has_jobs, &queue->sleep_mutex);
+    }
+    __atomic_sub_fetch(&queue->num_threads_sleeping, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&queue->sleep_mutex);
+
+    *seen = __atomic_load_n(&queue->published, __ATOMIC_ACQUIRE);
+}
+
 
 /* Frees a thread  */
 static void thread_destroy(Thread* thread) {
+    free(thread->work.jobs);
     free(thread);
 }
 
@@ -1096,181 +1443,202 @@ static int jobqueue_init(ThPool* thpool) {
     }
     thpool->jobqueue = queue;
     queue->len = 0;
-    queue->front = NULL;
-    queue->rear = NULL;
-    queue->group_front = NULL;
+    queue->front = 0;
+    queue->capacity = 0;
+    queue->jobs = NULL;
+    queue->static_groups = NULL;
+    queue->n_static_groups = 0;
+    queue->static_capacity = 0;
     queue->total_time = 0;
     queue->highest_expected_return = 0;
+    queue->published = 0;
+    queue->pending = 0;
+    queue->num_threads_sleeping = 0;
+    queue->num_waiting = 0;
 
-    queue->has_jobs = (BSem*) malloc(sizeof(BSem));
-    if (queue->has_jobs == NULL) {
+    pthread_mutex_init(&(queue->rwmutex), NULL);
+    pthread_mutex_init(&(queue->sleep_mutex), NULL);
+    pthread_cond_init(&(queue->has_jobs), NULL);
+
+    if (jobqueue_reserve(queue, 64) != 0) {
         return -1;
     }
 
-    pthread_mutex_init(&(queue->rwmutex), NULL);
-    bsem_init(queue->has_jobs, 0);
-
     return 0;
 }
 
 
 /* Clear the queue */
 static void jobqueue_clear(ThPool* thpool) {
-    WorkGroup* group;
-    int size;
-
-    do {
-        group = jobqueue_pull(thpool, -1);
-        if (group == NULL) {
-            size = 0;
-        } else {
-            size = group->size;
-            free(group->jobs);
-            free(group);
-        }
-    } while (size > 0);
+    JobQueue* queue = thpool->jobqueue;
 
-    thpool->jobqueue->front = NULL;
-    thpool->jobqueue->rear = NULL;
-    bsem_reset(thpool->jobqueue->has_jobs);
-    thpool->jobqueue->len = 0;
-    thpool->jobqueue->group_front = NULL;
-    thpool->jobqueue->total_time = 0;
-    thpool->jobqueue->highest_expected_return = 0;
+    queue->front = 0;
+    queue->len = 0;
+    queue->n_static_groups = 0;
+    queue->pending = 0;
+    queue->total_time = 0;
+    queue->highest_expected_return = 0;
 }
 
 
 /**
- * Add (allocated) job to queue without locks (internal function)
+ * Makes sure there is enough space in the ring for nJobs additional jobs.
+ *
+ * Notice: Caller MUST hold a mutex
  */
-static void jobqueue_push_internal(JobQueue* queue,
-                                   Job* newjob) {
-    newjob->prev = NULL;
-
-    switch (queue->len) {
+static int jobqueue_reserve(JobQueue* queue,
+                            int nJobs) {
+    Job* jobs;
+    int capacity;
+    int i;
 
-        case 0:  /* if no jobs in queue */
-            queue->front = newjob;
-            queue->rear = newjob;
-            break;
+    if (queue->len + nJobs <= queue->capacity)
+        return 0;
 
-        default: /* if jobs in queue */
-            queue->rear->prev = newjob;
-            queue->rear = newjob;
+    capacity = queue->capacity > 0 ? 2 * queue->capacity : 64;
+    while (capacity < queue->len + nJobs) {
+        capacity *= 2;
+    }
 
+    jobs = (Job*) malloc(capacity * sizeof(Job));
+    if (jobs == NULL) {
+        return -1;
     }
-    if(newjob->avgElapsed != NULL) {
-        queue->total_time += *newjob->avgElapsed;
+
+    // jobs are never referenced by the threads outside the queue lock
+    for (i = 0; i < queue->len; ++i) {
+        jobs[i] = queue->jobs[(queue->front + i) % queue->capacity];
     }
-    queue->len++;
-}
 
-/**
- * Add (allocated) job to queue
- */
-static void jobqueue_push(JobQueue* queue,
-                          Job* newjob) {
-    pthread_mutex_lock(&queue->rwmutex);
+    free(queue->jobs);
+    queue->jobs = jobs;
+    queue->capacity = capacity;
+    queue->front = 0;
 
-    jobqueue_push_internal(queue, newjob);
+    return 0;
+}
 
-    bsem_post(queue->has_jobs);
 
-    pthread_mutex_unlock(&queue->rwmutex);
+/**
+ * Adds a job to the end of the queue and returns it so that it can be
+ * defined (the ring must have enough space).
+ *
+ * Notice: Caller MUST hold a mutex
+ */
+static Job* jobqueue_push_internal(JobQueue* queue) {
+    Job* job = &queue->jobs[(queue->front + queue->len) % queue->capacity];
+    queue->len++;
+    return job;
 }
 
 
 /**
- * Add (allocated) multiple jobs to queue
+ * Makes the new jobs visible to the threads and wakes up the ones which
+ * are sleeping (threads which are still spinning do not need a signal).
+ *
+ * Notice: Caller MUST hold the queue mutex
  */
-static void jobqueue_multipush(JobQueue* queue,
-                               Job* newjob[],
-                               int nJobs) {
-    int i;
+static void jobqueue_publish(ThPool* thpool,
+                             int nJobs) {
+    JobQueue* queue = thpool->jobqueue;
 
-    pthread_mutex_lock(&queue->rwmutex);
+    __atomic_add_fetch(&queue->pending, nJobs, __ATOMIC_SEQ_CST);
+    __atomic_add_fetch(&queue->published, 1, __ATOMIC_SEQ_CST);
 
-    for(i = 0; i < nJobs; ++i) {
-        jobqueue_push_internal(queue, newjob[i]);
+    if (__atomic_load_n(&queue->num_threads_sleeping, __ATOMIC_SEQ_CST) > 0) {
+        pthread_mutex_lock(&queue->sleep_mutex);
+        pthread_cond_broadcast(&queue->has_jobs);
+        pthread_mutex_unlock(&queue->sleep_mutex);
     }
+}
 
-    bsem_post_all(queue->has_jobs);
 
-    pthread_mutex_unlock(&queue->rwmutex);
+/**
+ * Removes the job at the front of the queue (the queue cannot be empty).
+ */
+static Job* jobqueue_extract_single(JobQueue* queue) {
+    Job* job = &queue->jobs[queue->front];
+
+    queue->front = (queue->front + 1) % queue->capacity;
+    queue->len--;
+    if (queue->len == 0) {
+        queue->front = 0;
+        queue->total_time = 0;
+        queue->highest_expected_return = 0;
+    } else if (job->avgElapsed != NULL) {
+        queue->total_time -= *job->avgElapsed;
+    }
+    return job;
 }
 
-static Job* jobqueue_extract_single(JobQueue* queue) {
-    Job* job = queue->front;
+/**
+ * Makes sure a work group can hold a given number of jobs.
+ */
+static int workgroup_reserve(WorkGroup* group,
+                             int size) {
+    Job* jobs;
+    int capacity;
 
-    switch (queue->len) {
-        case 0:  /* if no jobs in queue */
-            return NULL;
+    if (size <= group->capacity)
+        return 0;
 
-        case 1:  /* if one job in queue */
-            queue->front = NULL;
-            queue->rear = NULL;
-            queue->len = 0;
-            queue->total_time = 0;
-            queue->highest_expected_return = 0;
-            return job;
-
-        default: /* if >1 jobs in queue */
-            queue->front = job->prev;
-            queue->len--;
-            if(job->avgElapsed != NULL) {
-                queue->total_time -= *job->avgElapsed;
-            }
-            return job;
-    }
-}
+    capacity = group->capacity > 0 ? 2 * group->capacity : 16;
+    if (capacity < size)
+        capacity = size;
 
-static void jobqueue_extract_single_group(JobQueue* queue,
-                                          WorkGroup* group) {
-    Job* job = jobqueue_extract_single(queue);
-    if(job != NULL) {
-        group->size = 1;
-        group->jobs = (Job*) malloc(sizeof(Job));
-        group->jobs[0] = *job; // copy
-        free(job);
-    } else {
-        group->size = 0;
-        group->jobs = NULL;
+    jobs = (Job*) realloc(group->jobs, capacity * sizeof(Job));
+    if (jobs == NULL) {
+        return -1;
     }
+    group->jobs = jobs;
+    group->capacity = capacity;
+
+    return 0;
 }
 
 /**
- * Get jobs from the queue(removes them from the queue)
+ * Get jobs from the queue(removes them from the queue).
+ * The jobs are placed in the work group of the thread, which is reused.
  *
  * Notice: Caller MUST hold a mutex
  */
 static WorkGroup* jobqueue_pull(ThPool* thpool,
-                                int id) {
+                                Thread* thread) {
 
-    WorkGroup* group;
+    WorkGroup* group = &thread->work;
+    WorkGroup* pending;
+    WorkGroup aux;
     Job* job;
     float current_time;
     float duration, duration_next, min_duration, target_duration;
     struct timespec timeAux;
     int info;
     int i;
+    int id = thread->id;
     JobQueue* queue = thpool->jobqueue;
 
-    if (schedule_strategy == SCHED_STATIC && queue->group_front != NULL) {
-        // STATIC
-        group = queue->group_front;
+    group->prev = NULL;
+
+    if (queue->n_static_groups > 0) {
+        // STATIC (exchange the buffers of the work groups)
+        queue->n_static_groups--;
+        pending = &queue->static_groups[queue->n_static_groups];
 
-        queue->group_front = group->prev;
-        group->prev = NULL;
+        aux = *group;
+        group->jobs = pending->jobs;
+        group->capacity = pending->capacity;
+        group->size = pending->size;
+        pending->jobs = aux.jobs;
+        pending->capacity = aux.capacity;
+        pending->size = 0;
 
     } else if (queue->len == 0) {
         // nothing to do
         group = NULL;
 
-    } else if (schedule_strategy == SCHED_DYNAMIC || queue->len == 1 || queue->total_time <= 0) {
+    } else if (schedule_strategy != SCHED_GUIDED || queue->len == 1 || queue->total_time <= 0 ||
+               workgroup_reserve(group, 2) != 0) {
         // SCHED_DYNAMIC
-        group = (WorkGroup*) malloc(sizeof(WorkGroup));
-        group->prev = NULL;
-
         if (cppadcg_pool_verbose) {
             if (schedule_strategy == SCHED_GUIDED) {
                 if (queue->len == 1)
@@ -1278,36 +1646,34 @@ static WorkGroup* jobqueue_pull(ThPool* thpool,
                 else if (queue->total_time <= 0)
                     fprintf(stdout, "jobqueue_pull(): Thread %i using single-job instead of multi-job (no timing information)\n", id);
             } else if (schedule_strategy == SCHED_STATIC && queue->len >= 1) {
-                if (queue->total_time >= 0) {
-                    // this should not happen but just in case the user messed up
-                    fprintf(stderr, "jobqueue_pull(): Thread %i given a work group with 1 job\n", id);
-                } else {
-                    fprintf(stdout, "jobqueue_pull(): Thread %i given a work group with 1 job\n", id);
-                }
+                fprintf(stdout, "jobqueue_pull(): Thread %i given a work group with 1 job\n", id);
             }
         }
 
-        jobqueue_extract_single_group(thpool->jobqueue, group);
+        if (workgroup_reserve(group, 1) != 0) {
+            fprintf(stderr, "jobqueue_pull(): Could not allocate memory\n");
+            return NULL;
+        }
+        group->jobs[0] = *jobqueue_extract_single(queue); // copy
+        group->size = 1;
+
     } else { // schedule_strategy == SCHED_GUIDED
         // SCHED_GUIDED
-        group = (WorkGroup*) malloc(sizeof(WorkGroup));
-        group->prev = NULL;
-
-        job = queue->front;
+        job = &queue->jobs[queue->front];
 
         if (job->avgElapsed == NULL) {
             if (cppadcg_pool_verbose) {
                 fprintf(stderr, "jobqueue_pull(): Thread %i using single job instead of multi-job (No timing information for current job)\n", id);
             }
             // cannot use this strategy (something went wrong!)
-            jobqueue_extract_single_group(thpool->jobqueue, group);
+            group->jobs[0] = *jobqueue_extract_single(queue); // copy
+            group->size = 1;
 
         } else {
             // there are at least 2 jobs in the queue
             group->size = 1;
             duration = *job->avgElapsed;
             duration_next = duration;
-            job = job->prev;
             target_duration = queue->total_time * cppadcg_pool_guided_maxgroupwork / thpool->num_threads; // always positive
             current_time = get_monotonic_time(&timeAux, &info);
 
@@ -1318,7 +1684,8 @@ static WorkGroup* jobqueue_pull(ThPool* thpool,
                 }
             }
 
-            do {
+            for (i = 1; i < queue->len; ++i) {
+                job = &queue->jobs[(queue->front + i) % queue->capacity];
                 if (job->avgElapsed == NULL) {
                     break;
                 }
@@ -1329,18 +1696,18 @@ static WorkGroup* jobqueue_pull(ThPool* thpool,
                 } else {
                     break;
                 }
-                job = job->prev;
-            } while (job != queue->front);
+            }
+
+            if (workgroup_reserve(group, group->size) != 0) {
+                group->size = group->capacity; // use the available space
+            }
 
             if (cppadcg_pool_verbose) {
                 fprintf(stdout, "jobqueue_pull(): Thread %i given a work group with %i jobs for %e s (target: %e s)\n", id, group->size, duration, target_duration);
             }
 
-            group->jobs = (Job*) malloc(group->size * sizeof(Job));
             for (i = 0; i < group->size; ++i) {
-                job = jobqueue_extract_single(thpool->jobqueue);
-                group->jobs[i] = *job; // copy
-                free(job);
+                group->jobs[i] = *jobqueue_extract_single(queue); // copy
             }
 
             duration_next = current_time + duration; // the time when the current work is expected to end
@@ -1349,10 +1716,6 @@ static WorkGroup* jobqueue_pull(ThPool* thpool,
         }
 
     }
-    /* more than one job in queue -> post it */
-    if (queue->len > 0 || queue->group_front != NULL) {
-        bsem_post(queue->has_jobs);
-    }
 
     return group;
 }
@@ -1360,59 +1723,14 @@ static WorkGroup* jobqueue_pull(ThPool* thpool,
 
 /* Free all queue resources back to the system */
 static void jobqueue_destroy(ThPool* thpool) {
-    jobqueue_clear(thpool);
-    free(thpool->jobqueue->has_jobs);
-}
-
-
-
-
-
-/* ======================== SYNCHRONISATION ========================= */
-
-
-/* Init semaphore to 1 or 0 */
-static void bsem_init(BSem* bsem, int value) {
-    if (value < 0 || value > 1) {
-        fprintf(stderr, "bsem_init(): Binary semaphore can take only values 1 or 0");
-        exit(1);
-    }
-    pthread_mutex_init(&(bsem->mutex), NULL);
-    pthread_cond_init(&(bsem->cond), NULL);
-    bsem->v = value;
-}
-
-
-/* Reset semaphore to 0 */
-static void bsem_reset(BSem* bsem) {
-    bsem_init(bsem, 0);
-}
-
-
-/* Post to at least one thread */
-static void bsem_post(BSem* bsem) {
-    pthread_mutex_lock(&bsem->mutex);
-    bsem->v = 1;
-    pthread_cond_signal(&bsem->cond);
-    pthread_mutex_unlock(&bsem->mutex);
-}
-
-
-/* Post to all threads */
-static void bsem_post_all(BSem* bsem) {
-    pthread_mutex_lock(&bsem->mutex);
-    bsem->v = 1;
-    pthread_cond_broadcast(&bsem->cond);
-    pthread_mutex_unlock(&bsem->mutex);
-}
+    JobQueue* queue = thpool->jobqueue;
+    int i;
 
+    jobqueue_clear(thpool);
 
-/* Wait on semaphore until semaphore has value 0 */
-static void bsem_wait(BSem* bsem) {
-    pthread_mutex_lock(&bsem->mutex);
-    while (bsem->v != 1) {
-        pthread_cond_wait(&bsem->cond, &bsem->mutex);
+    for (i = 0; i < queue->static_capacity; ++i) {
+        free(queue->static_groups[i].jobs);
     }
-    bsem->v = 0;
-    pthread_mutex_unlock(&bsem->mutex);
+    free(queue->static_groups);
+    free(queue->jobs);
 }
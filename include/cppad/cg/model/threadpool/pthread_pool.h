@@ -25,7 +25,8 @@ enum ScheduleStrategy {SCHED_STATIC = 1,
                        };
 
 enum ElapsedTimeReference {ELAPSED_TIME_AVG,
-                           ELAPSED_TIME_MIN};
+                           ELAPSED_TIME_MIN,
+                           ELAPSED_TIME_EWMA};
 
 typedef void (*cppadcg_thpool_function_type)(void*);
 
@@ -34,6 +35,10 @@ void cppadcg_thpool_set_threads(int n);
 
 int cppadcg_thpool_get_threads();
 
+int cppadcg_thpool_get_workers();
+
+int cppadcg_thpool_get_worker_id();
+
 
 void cppadcg_thpool_set_scheduler_strategy(enum ScheduleStrategy s);
 
@@ -55,11 +60,35 @@ enum ElapsedTimeReference cppadcg_thpool_get_time_meas_ref();
 void cppadcg_thpool_set_time_meas_ref(enum ElapsedTimeReference r);
 
 
+float cppadcg_thpool_get_ewma_alpha();
+
+void cppadcg_thpool_set_ewma_alpha(float a);
+
+
+unsigned int cppadcg_thpool_get_rebalance_period();
+
+void cppadcg_thpool_set_rebalance_period(unsigned int n);
+
+
+float cppadcg_thpool_get_last_imbalance();
+
+float cppadcg_thpool_get_avg_imbalance();
+
+unsigned int cppadcg_thpool_get_n_imbalance_meas();
+
+void cppadcg_thpool_reset_imbalance();
+
+
 void cppadcg_thpool_set_verbose(int v);
 
 int cppadcg_thpool_is_verbose();
 
 
+void cppadcg_thpool_set_spin_time(float t);
+
+float cppadcg_thpool_get_spin_time();
+
+
 void cppadcg_thpool_set_disabled(int disabled);
 
 int cppadcg_thpool_is_disabled();
@@ -83,6 +112,9 @@ void cppadcg_thpool_add_jobs(cppadcg_thpool_function_type functions[],
 
 void cppadcg_thpool_wait();
 
+int cppadcg_thpool_do_benchmark(unsigned int nMeas,
+                                unsigned int nCalls);
+
 void cppadcg_thpool_update_order(float refElapsed[],
                                  unsigned int nTimeMeas,
                                  const float elapsed[],
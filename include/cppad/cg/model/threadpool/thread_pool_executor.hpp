@@ -0,0 +1,77 @@
+#ifndef CPPAD_CG_THREAD_POOL_EXECUTOR_INCLUDED
+#define CPPAD_CG_THREAD_POOL_EXECUTOR_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A job of a multithreaded model function which must be executed by a
+ * ThreadPoolExecutor.
+ * It has the same layout as the CppADCGExecutorJob structure used by the
+ * generated code.
+ */
+struct ThreadPoolExecutorJob {
+    void (*function)(void*);
+    void* arg;
+};
+
+/**
+ * Callbacks used by the models in libraries created with
+ * MultiThreadingType::EXECUTOR to run the jobs of multithreaded functions
+ * (sparse Jacobians and sparse Hessians) in a task scheduler owned by the
+ * host application.
+ * It has the same layout as the CppADCGExecutor structure used by the
+ * generated code.
+ *
+ * The callbacks can be called concurrently if the models are evaluated by
+ * several threads.
+ */
+struct ThreadPoolExecutor {
+    /**
+     * Host data provided to all callbacks
+     */
+    void* data;
+    /**
+     * Starts the execution of a batch of jobs and returns a handle to
+     * the batch.
+     * The jobs are sorted by decreasing expected duration (based on
+     * previous evaluations) and they can be executed in any order by any
+     * thread.
+     * The jobs array remains valid until wait() returns.
+     */
+    void* (*submit)(void* data, const ThreadPoolExecutorJob jobs[], int nJobs);
+    /**
+     * Blocks until all the jobs of a batch have finished.
+     */
+    void (*wait)(void* data, void* batch);
+    /**
+     * Provides the maximum number of threads which can execute jobs
+     * simultaneously (used to split the temporary workspace).
+     */
+    int (*get_workers)(void* data);
+    /**
+     * Provides the index of the thread executing a job, which must be
+     * lower than get_workers() and unique among the threads currently
+     * executing jobs.
+     */
+    int (*get_worker_id)(void* data);
+};
+
+}
+}
+
+#endif
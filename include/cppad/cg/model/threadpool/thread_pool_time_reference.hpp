@@ -0,0 +1,34 @@
+#ifndef CPPAD_CG_THREAD_POOL_TIME_REFERENCE_INCLUDED
+#define CPPAD_CG_THREAD_POOL_TIME_REFERENCE_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * How the time measurements of each job are combined to schedule the jobs
+ * of the thread pool
+ */
+enum class ThreadPoolTimeReference {
+    AVERAGE = 0, // the average of the first measurements
+    MINIMUM = 1, // the minimum of the first measurements
+    EWMA = 2 // an exponentially weighted moving average updated periodically
+};
+
+}
+}
+
+#endif
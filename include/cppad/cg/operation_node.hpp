@@ -163,6 +163,17 @@ public:
             name_.reset(new std::string(name));
     }
 
+    /**
+     * Defines a new variable name for this node
+     * @param name a variable name (moved)
+     */
+    inline void setName(std::string&& name) {
+        if (name_ != nullptr)
+            *name_ = std::move(name);
+        else
+            name_.reset(new std::string(std::move(name)));
+    }
+
     /**
      * Clears any name assigned to this node.
      */
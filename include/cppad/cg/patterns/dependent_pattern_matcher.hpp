@@ -791,37 +791,69 @@ private:
         varColor.adjustSize();
         varColor.fill(0);
 
+        /**
+         * Dependents can only have the same pattern if they have the same
+         * structural hash, therefore they are only compared with other
+         * dependents in the same bucket
+         */
+        DependentStructureHasher<Base> hasher(*handler_);
+        std::vector<bool> used(dependents_.size(), false);
+        std::unordered_map<size_t, size_t> hash2Bucket;
+        std::vector<std::vector<size_t> > buckets;
+        std::vector<std::pair<size_t, size_t> > bucketPos; // bucket index and position in the bucket
+
         size_t rSize = relatedDepCandidates_.size();
         for (size_t r = 0; r < rSize; r++) {
             const std::set<size_t>& candidates = relatedDepCandidates_[r];
-            std::set<size_t> used;
+
+            hash2Bucket.clear();
+            buckets.clear();
+            bucketPos.clear();
+            bucketPos.reserve(candidates.size());
+
+            for (size_t iDep : candidates) {
+                size_t h = hasher.hash(dependents_[iDep]);
+                auto itb = hash2Bucket.find(h);
+                size_t b;
+                if (itb == hash2Bucket.end()) {
+                    b = buckets.size();
+                    hash2Bucket[h] = b;
+                    buckets.emplace_back();
+                } else {
+                    b = itb->second;
+                }
+                bucketPos.emplace_back(b, buckets[b].size());
+                buckets[b].push_back(iDep);
+            }
 
             eqCurr_ = nullptr;
 
-            std::set<size_t>::const_iterator itRef;
-            for (itRef = candidates.begin(); itRef != candidates.end(); ++itRef) {
+            size_t pos = 0;
+            for (auto itRef = candidates.begin(); itRef != candidates.end(); ++itRef, ++pos) {
                 size_t iDepRef = *itRef;
 
                 // check if it has already been used
-                if (used.find(iDepRef) != used.end()) {
+                if (used[iDepRef]) {
                     continue;
                 }
 
-                if (eqCurr_ == nullptr || !used.empty()) {
-                    eqCurr_ = new EquationPattern<Base>(dependents_[iDepRef], iDepRef);
-                    equations_.push_back(eqCurr_);
+                const std::vector<size_t>& bucket = buckets[bucketPos[pos].first];
+                if (bucket.size() == 1) {
+                    continue; // nothing else with the same structure
                 }
 
-                auto it = itRef;
-                for (++it; it != candidates.end(); ++it) {
-                    size_t iDep = *it;
+                eqCurr_ = new EquationPattern<Base>(dependents_[iDepRef], iDepRef);
+                equations_.push_back(eqCurr_);
+
+                for (size_t k = bucketPos[pos].second + 1; k < bucket.size(); ++k) {
+                    size_t iDep = bucket[k];
                     // check if it has already been used
-                    if (used.find(iDep) != used.end()) {
+                    if (used[iDep]) {
                         continue;
                     }
 
                     if (eqCurr_->testAdd(iDep, dependents_[iDep], color_, varColor)) {
-                        used.insert(iDep);
+                        used[iDep] = true;
                     }
                 }
 
@@ -832,6 +864,10 @@ private:
                     equations_.pop_back();
                 }
             }
+
+            for (size_t iDep : candidates) {
+                used[iDep] = false;
+            }
         }
 
         /**
@@ -0,0 +1,255 @@
+#ifndef CPPAD_CG_DEPENDENT_STRUCTURE_HASHER_INCLUDED
+#define CPPAD_CG_DEPENDENT_STRUCTURE_HASHER_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Determines a structural hash for the expression of each dependent
+ * variable which ignores the independent variables used by the expression.
+ *
+ * Two dependents which would be considered to have the same expression
+ * pattern by an EquationPattern always have the same hash (the same
+ * operation types, operation information, parameter values, and
+ * arguments, where any independent variable matches any other independent
+ * variable).
+ * The opposite is not always true, therefore the hash can only be used to
+ * determine groups of candidates.
+ *
+ * The hash of each node is computed only once and without recursion so
+ * that it can be used for models with a very large number of equations.
+ */
+template<class Base>
+class DependentStructureHasher {
+public:
+    using CGBase = CG<Base>;
+private:
+    CodeHandler<Base>& handler_;
+    /**
+     * the hash of each node (only valid if the node was visited)
+     */
+    std::vector<size_t> hash_;
+    /**
+     * whether or not the hash of a node has been computed
+     */
+    std::vector<bool> visited_;
+    /**
+     * the nodes whose hash is still being computed
+     */
+    std::vector<std::pair<OperationNode<Base>*, size_t> > stack_;
+public:
+
+    inline explicit DependentStructureHasher(CodeHandler<Base>& handler) :
+        handler_(handler) {
+    }
+
+    /**
+     * Determines the structural hash of the expression of a dependent
+     * variable.
+     *
+     * @param dependent a dependent variable which must belong to the code
+     *                  handler used by this object
+     * @return the hash value
+     */
+    inline size_t hash(const CGBase& dependent) {
+        if (dependent.isParameter()) {
+            return combine(PARAMETER_HASH, hashValue(dependent.getValue()));
+        }
+
+        OperationNode<Base>* node = dependent.getOperationNode();
+        CPPADCG_ASSERT_KNOWN(dependent.getCodeHandler() == &handler_, "Only one code handler allowed")
+
+        if (node->getOperationType() == CGOpCode::Inv) {
+            // the pattern matcher uses an alias (same hash as an alias node to an independent)
+            size_t h = combine(size_t(CGOpCode::Alias), 0); // no information
+            h = combine(h, 1); // one argument
+            return combine(h, INDEPENDENT_HASH);
+        }
+
+        return hash(*node);
+    }
+
+    /**
+     * Creates groups of dependent variables which have the same structural
+     * hash and, therefore, might have the same expression pattern.
+     * These groups can be used as the related dependent candidates for the
+     * DependentPatternMatcher.
+     *
+     * Only groups with more than one element are returned and dependents
+     * which are parameters are ignored.
+     * The groups are sorted by their lowest dependent index.
+     *
+     * @param dependents the dependent variables
+     * @return groups of dependent indexes which might share the same
+     *         expression pattern
+     */
+    inline std::vector<std::set<size_t> > findRelatedDependents(const std::vector<CGBase>& dependents) {
+        std::unordered_map<size_t, size_t> hash2Group;
+        hash2Group.reserve(dependents.size());
+
+        std::vector<std::vector<size_t> > groups;
+
+        for (size_t i = 0; i < dependents.size(); ++i) {
+            if (dependents[i].isParameter())
+                continue;
+
+            size_t h = hash(dependents[i]);
+            auto it = hash2Group.find(h);
+            if (it == hash2Group.end()) {
+                hash2Group[h] = groups.size();
+                groups.emplace_back(1, i);
+            } else {
+                groups[it->second].push_back(i);
+            }
+        }
+
+        std::vector<std::set<size_t> > related;
+        for (const auto& g : groups) {
+            if (g.size() > 1)
+                related.emplace_back(g.begin(), g.end()); // indexes already sorted
+        }
+
+        return related;
+    }
+
+    /**
+     * Creates groups of dependent variables which might have the same
+     * expression pattern (see findRelatedDependents()).
+     *
+     * @param dependents the dependent variables
+     * @return groups of dependent indexes which might share the same
+     *         expression pattern
+     */
+    static inline std::vector<std::set<size_t> > findRelatedDependents(CodeHandler<Base>& handler,
+                                                                        const std::vector<CGBase>& dependents) {
+        DependentStructureHasher<Base> hasher(handler);
+        return hasher.findRelatedDependents(dependents);
+    }
+
+private:
+    static const size_t PARAMETER_HASH = 0x51ed2705;
+    static const size_t INDEPENDENT_HASH = 0x2545f491;
+
+    inline size_t hash(OperationNode<Base>& root) {
+        const size_t n = handler_.getManagedNodesCount();
+        if (hash_.size() < n) {
+            hash_.resize(n);
+            visited_.resize(n, false);
+        }
+
+        OperationNode<Base>* start = resolveAlias(root);
+        if (isVisited(*start))
+            return hash_[start->getHandlerPosition()];
+
+        stack_.clear();
+        stack_.emplace_back(start, 0);
+
+        while (!stack_.empty()) {
+            OperationNode<Base>* node = stack_.back().first;
+            size_t& a = stack_.back().second;
+            const std::vector<Argument<Base> >& args = node->getArguments();
+
+            // visit the arguments first
+            bool pushed = false;
+            for (; a < args.size(); ++a) {
+                OperationNode<Base>* arg = args[a].getOperation();
+                if (arg == nullptr || arg->getOperationType() == CGOpCode::Inv)
+                    continue;
+                arg = resolveAlias(*arg);
+                if (!isVisited(*arg)) {
+                    ++a;
+                    stack_.emplace_back(arg, 0);
+                    pushed = true;
+                    break;
+                }
+            }
+            if (pushed)
+                continue;
+
+            stack_.pop_back();
+
+            size_t h = size_t(node->getOperationType());
+
+            const std::vector<size_t>& info = node->getInfo();
+            h = combine(h, info.size());
+            for (size_t e : info)
+                h = combine(h, e);
+
+            h = combine(h, args.size());
+            for (const Argument<Base>& arg : args) {
+                OperationNode<Base>* argOp = arg.getOperation();
+                if (argOp == nullptr) {
+                    h = combine(h, combine(PARAMETER_HASH, hashValue(*arg.getParameter())));
+                } else if (argOp->getOperationType() == CGOpCode::Inv) {
+                    h = combine(h, INDEPENDENT_HASH);
+                } else {
+                    h = combine(h, hash_[resolveAlias(*argOp)->getHandlerPosition()]);
+                }
+            }
+
+            size_t p = node->getHandlerPosition();
+            hash_[p] = h;
+            visited_[p] = true;
+        }
+
+        return hash_[start->getHandlerPosition()];
+    }
+
+    inline bool isVisited(const OperationNode<Base>& node) const {
+        size_t p = node.getHandlerPosition();
+        CPPADCG_ASSERT_KNOWN(p < visited_.size(), "this node is not managed by the code handler")
+        return visited_[p];
+    }
+
+    /**
+     * Aliases are ignored by the pattern matcher unless they point to an
+     * independent variable.
+     */
+    static inline OperationNode<Base>* resolveAlias(OperationNode<Base>& node) {
+        OperationNode<Base>* n = &node;
+        while (n->getOperationType() == CGOpCode::Alias) {
+            CPPADCG_ASSERT_KNOWN(n->getArguments().size() == 1, "Invalid number of arguments for alias")
+            OperationNode<Base>* a = n->getArguments()[0].getOperation();
+            if (a == nullptr || a->getOperationType() == CGOpCode::Inv)
+                break;
+            n = a;
+        }
+        return n;
+    }
+
+    static inline size_t combine(size_t seed, size_t value) {
+        return seed ^ (value + size_t(0x9e3779b97f4a7c15ull) + (seed << 6) + (seed >> 2));
+    }
+
+    template<class T = Base>
+    static inline typename std::enable_if<std::is_arithmetic<T>::value, size_t>::type hashValue(const T& value) {
+        if (value == T(0))
+            return 0; // the same for +0 and -0
+        return std::hash<T>()(value);
+    }
+
+    template<class T = Base>
+    static inline typename std::enable_if<!std::is_arithmetic<T>::value, size_t>::type hashValue(const T&) {
+        return 0; // parameters will be compared by the pattern matcher
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
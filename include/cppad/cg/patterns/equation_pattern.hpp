@@ -84,11 +84,26 @@ public:
      */
     std::map<const OperationNode<Base>*, std::set<size_t> > constOperationIndependents;
 
+private:
+    /**
+     * A change to indexedOpIndep performed while comparing a dependent
+     * with the reference (used to undo it if the dependent does not match)
+     */
+    struct IndependentChange {
+        const OperationNode<Base>* operation;
+        size_t argumentIndex;
+        bool newOperation;
+        bool newReference;
+    };
 private:
     CodeHandler<Base>* const handler_;
     size_t currDep_;
     size_t minColor_;
     size_t cmpColor_;
+    /**
+     * changes to indexedOpIndep by the current comparison
+     */
+    std::vector<IndependentChange> indepChanges_;
 public:
 
     explicit EquationPattern(const CG<Base>& ref,
@@ -107,9 +122,11 @@ public:
                  const CG<Base>& dep2,
                  size_t& minColor,
                  CodeHandlerVector<Base, size_t>& varColor) {
-        IndexedIndependent<Base> independentsBackup = indexedOpIndep;
-        std::map<const OperationNode<Base>*, std::set<size_t> > constOperationIndependentsBackup = constOperationIndependents;
-        std::map<size_t, std::map<const OperationNode<Base>*, OperationNode<Base>*> > operation2ReferenceBackup = operationEO2Reference;
+        /**
+         * only the changes are recorded (copying all the data would make
+         * the cost of adding dependents quadratic)
+         */
+        indepChanges_.clear();
 
         currDep_ = iDep2;
         minColor_ = minColor;
@@ -125,9 +142,24 @@ public:
             return true; // matches the reference pattern
         } else {
             // restore
-            indexedOpIndep.op2Arguments.swap(independentsBackup.op2Arguments);
-            constOperationIndependents.swap(constOperationIndependentsBackup);
-            operationEO2Reference.swap(operation2ReferenceBackup);
+            for (auto it = indepChanges_.rbegin(); it != indepChanges_.rend(); ++it) {
+                auto itOp = indexedOpIndep.op2Arguments.find(it->operation);
+                CPPADCG_ASSERT_UNKNOWN(itOp != indexedOpIndep.op2Arguments.end())
+                if (it->newOperation) {
+                    indexedOpIndep.op2Arguments.erase(itOp);
+                } else {
+                    std::map<size_t, const OperationNode<Base>*>& dep2Indeps = itOp->second.arg2Independents[it->argumentIndex];
+                    dep2Indeps.erase(iDep2);
+                    if (it->newReference)
+                        dep2Indeps.erase(depRefIndex);
+                }
+            }
+            indepChanges_.clear();
+
+            operationEO2Reference.erase(iDep2);
+            if (dependents.size() == 1) {
+                operationEO2Reference.erase(depRefIndex); // only added while testing the first dependent
+            }
 
             return false; // cannot be added
         }
@@ -380,14 +412,18 @@ private:
             }
         }
 
+        bool newOperation = indexedOpIndep.op2Arguments.find(parentOp) == indexedOpIndep.op2Arguments.end();
         OperationIndexedIndependents<Base>& opIndexedIndep = indexedOpIndep.op2Arguments[parentOp];
         opIndexedIndep.arg2Independents.resize(parentOp != nullptr ? parentOp->getArguments().size() : 1);
 
         std::map<size_t, const OperationNode<Base>*>& dep2Indeps = opIndexedIndep.arg2Independents[argIndex];
-        if (dep2Indeps.empty())
+        bool newReference = dep2Indeps.empty();
+        if (newReference)
             dep2Indeps[depRefIndex] = argRefOp;
         dep2Indeps[currDep_] = arg2Op;
 
+        indepChanges_.push_back(IndependentChange{parentOp, argIndex, newOperation, newReference});
+
         return true; // same pattern
     }
 
@@ -0,0 +1,253 @@
+#ifndef CPPAD_CG_AFFINE_ND_INDEX_PATTERN_INCLUDED
+#define CPPAD_CG_AFFINE_ND_INDEX_PATTERN_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * An affine pattern over the points of a N-dimensional grid which are
+ * enumerated by a single strided index (e.g. the iteration index of a loop
+ * over all the elements of a tensor):
+ *
+ * i = (x - xOffset) / dx
+ * y = b + sum_k ((i / stride_k) % extent_k) * dy_k
+ *
+ * where stride_k is the product of the extents of the inner dimensions.
+ * The outermost dimension is not bounded (extent = 0).
+ */
+class AffineNDIndexPattern : public IndexPattern {
+protected:
+    long xOffset_;
+    long dx_;
+    /**
+     * the number of consecutive values of i with the same grid coordinate
+     * in each dimension (innermost dimension first)
+     */
+    std::vector<size_t> strides_;
+    /**
+     * the number of points in each dimension (zero for the outermost)
+     */
+    std::vector<size_t> extents_;
+    /**
+     * the slope in each dimension
+     */
+    std::vector<long> dy_;
+    // constant term
+    long b_;
+public:
+
+    inline AffineNDIndexPattern(long xOffset,
+                                long dx,
+                                const std::vector<size_t>& strides,
+                                const std::vector<size_t>& extents,
+                                const std::vector<long>& dy,
+                                long b) :
+        xOffset_(xOffset),
+        dx_(dx),
+        strides_(strides),
+        extents_(extents),
+        dy_(dy),
+        b_(b) {
+        CPPADCG_ASSERT_UNKNOWN(dx_ > 0)
+        CPPADCG_ASSERT_UNKNOWN(!strides_.empty())
+        CPPADCG_ASSERT_UNKNOWN(strides_.size() == extents_.size())
+        CPPADCG_ASSERT_UNKNOWN(strides_.size() == dy_.size())
+    }
+
+    inline virtual ~AffineNDIndexPattern() = default;
+
+    inline long getXOffset() const {
+        return xOffset_;
+    }
+
+    inline long getStrideDx() const {
+        return dx_;
+    }
+
+    /**
+     * @return the number of dimensions of the grid
+     */
+    inline size_t getDimensions() const {
+        return strides_.size();
+    }
+
+    inline const std::vector<size_t>& getStrides() const {
+        return strides_;
+    }
+
+    inline const std::vector<size_t>& getExtents() const {
+        return extents_;
+    }
+
+    inline const std::vector<long>& getSlopes() const {
+        return dy_;
+    }
+
+    inline long getConstantTerm() const {
+        return b_;
+    }
+
+    inline IndexPatternType getType() const override {
+        return IndexPatternType::AffineND;
+    }
+
+    inline void getSubIndexes(std::set<IndexPattern*>& indexes) const override {
+        // nothing to add
+    }
+
+    inline long evaluate(long x) const {
+        long i = (x - xOffset_) / dx_;
+        long y = b_;
+        for (size_t k = 0; k < strides_.size(); ++k) {
+            long d = i / long(strides_[k]);
+            if (extents_[k] != 0)
+                d %= long(extents_[k]);
+            y += d * dy_[k];
+        }
+        return y;
+    }
+
+    /***********************************************************************
+     *                        static methods
+     **********************************************************************/
+
+    /**
+     * Attempts to describe y = f(x) for consecutive values of x (starting
+     * at zero) as an affine function of the coordinates of a N-dimensional
+     * grid.
+     *
+     * @param x2y maps the independents to the dependents (x2y[x] = y)
+     * @param maxDims the maximum number of dimensions
+     * @return the generated index pattern (must be deleted by user) or
+     *         null if the points do not fit the pattern
+     */
+    template<class VectorSizeT>
+    static inline AffineNDIndexPattern* detectAffineND(const VectorSizeT& x2y,
+                                                       size_t maxDims = 4) {
+        std::vector<long> values(x2y.size());
+        for (size_t x = 0; x < values.size(); ++x)
+            values[x] = long(x2y[x]);
+
+        return detectAffineND(values, 0, 1, maxDims);
+    }
+
+    /**
+     * Attempts to describe y = f(x) as an affine function of the
+     * coordinates of a N-dimensional grid.
+     * The values of x must be equally spaced.
+     *
+     * @param x2y maps the independents to the dependents (x,y)
+     * @param maxDims the maximum number of dimensions
+     * @return the generated index pattern (must be deleted by user) or
+     *         null if the points do not fit the pattern
+     */
+    static inline AffineNDIndexPattern* detectAffineND(const std::map<size_t, size_t>& x2y,
+                                                       size_t maxDims = 4) {
+        if (x2y.size() < 2)
+            return nullptr;
+
+        auto it = x2y.begin();
+        long xOffset = long(it->first);
+        ++it;
+        long dx = long(it->first) - xOffset;
+
+        std::vector<long> values;
+        values.reserve(x2y.size());
+        long xExpected = xOffset;
+        for (const auto& p : x2y) {
+            if (long(p.first) != xExpected)
+                return nullptr; // not equally spaced
+            values.push_back(long(p.second));
+            xExpected += dx;
+        }
+
+        return detectAffineND(values, xOffset, dx, maxDims);
+    }
+
+private:
+
+    static inline AffineNDIndexPattern* detectAffineND(std::vector<long>& values,
+                                                       long xOffset,
+                                                       long dx,
+                                                       size_t maxDims) {
+        const size_t n = values.size();
+        if (n < 2)
+            return nullptr;
+
+        long b = values[0];
+        std::vector<size_t> strides;
+        std::vector<size_t> extents;
+        std::vector<long> dys;
+
+        size_t stride = 1;
+        while (values.size() > 1) {
+            size_t nv = values.size();
+            long dy = values[1] - values[0];
+
+            size_t extent = nv;
+            for (size_t k = 2; k < nv; ++k) {
+                if (values[k] - values[k - 1] != dy) {
+                    extent = k;
+                    break;
+                }
+            }
+
+            strides.push_back(stride);
+            extents.push_back(extent);
+            dys.push_back(dy);
+
+            if (extent == nv)
+                break; // linear in the outermost dimension
+
+            if (strides.size() == maxDims)
+                return nullptr; // too many dimensions
+
+            // all the blocks must have the same inner pattern
+            for (size_t k = 0; k < nv; ++k) {
+                size_t d = k % extent;
+                if (values[k] - values[k - d] != dy * long(d))
+                    return nullptr;
+            }
+
+            // continue with the first point of each block
+            size_t nOuter = (nv + extent - 1) / extent;
+            for (size_t j = 0; j < nOuter; ++j)
+                values[j] = values[j * extent];
+            values.resize(nOuter);
+
+            stride *= extent;
+        }
+
+        /**
+         * a single dimension is a linear pattern and the grid should only be
+         * used when it is much smaller than a table (which also avoids
+         * fitting a grid of extent 2 to random points)
+         */
+        if (strides.size() < 2 || n <= 4 * strides.size())
+            return nullptr;
+
+        extents.back() = 0; // no need to bound the outermost dimension
+
+        return new AffineNDIndexPattern(xOffset, dx, strides, extents, dys, b);
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -29,6 +29,11 @@ IndexPattern* IndexPattern::detect(const VectorSizeT& x2y) {
         return linearSections.begin()->second;
     } else if (!linearSections.empty()) {
         return new SectionedIndexPattern(linearSections);
+    }
+
+    IndexPattern* affine = AffineNDIndexPattern::detectAffineND(x2y);
+    if (affine != nullptr) {
+        return affine;
     } else {
         return new Random1DIndexPattern(x2y);
     }
@@ -45,6 +50,11 @@ IndexPattern* IndexPattern::detect(const std::map<size_t, size_t>& x2y) {
         return linearSections.begin()->second;
     } else if (!linearSections.empty()) {
         return new SectionedIndexPattern(linearSections);
+    }
+
+    IndexPattern* affine = AffineNDIndexPattern::detectAffineND(x2y);
+    if (affine != nullptr) {
+        return affine;
     } else {
         return new Random1DIndexPattern(x2y);
     }
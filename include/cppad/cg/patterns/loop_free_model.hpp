@@ -36,6 +36,11 @@ protected:
      * The tape
      */
     ADFun<CGB> * const fun_;
+    /**
+     * Copies of the tape for each CppAD thread number while generating
+     * source code in parallel
+     */
+    ThreadLocalTapes<Base> threadTapes_;
     /**
      * The dependent variables in this tape to their original indexes
      */
@@ -83,7 +88,30 @@ public:
     LoopFreeModel& operator=(const LoopFreeModel<Base>&) = delete;
 
     inline ADFun<CGB>& getTape() const {
-        return *fun_;
+        return threadTapes_.getTape(*fun_);
+    }
+
+    /**
+     * Allows the tape to be used by several threads at the same time
+     * (see ThreadLocalTapes::enable()).
+     */
+    inline void enableThreadTapes() {
+        threadTapes_.enable();
+    }
+
+    /**
+     * Deletes the copy of the tape created for the current thread
+     * (see ThreadLocalTapes::release()).
+     */
+    inline void releaseThreadTape() {
+        threadTapes_.release();
+    }
+
+    /**
+     * Stops using copies of the tape (see ThreadLocalTapes::disable()).
+     */
+    inline void disableThreadTapes() {
+        threadTapes_.disable();
     }
 
     inline size_t getTapeDependentCount() const {
@@ -317,7 +345,7 @@ public:
         }
 
         std::vector<map<size_t, CGB> > dyDx;
-        generateLoopForJacHes(*fun_, x, vwNoLoop, temps,
+        generateLoopForJacHes(getTape(), x, vwNoLoop, temps,
                               getJacobianSparsity(),
                               noLoopEvalJacSparsity,
                               dyDx,
@@ -376,7 +404,7 @@ public:
             // atomic functions which only provide half of the elements
             // (some values could be zeroed)
             work.color_method = "cppad.general";
-            fun_->SparseHessian(x, wNoLoop, hessTapeOrigEqSparsity_, row, col, hessNoLoop, work);
+            getTape().SparseHessian(x, wNoLoop, hessTapeOrigEqSparsity_, row, col, hessNoLoop, work);
 
             // save non-indexed hessian elements
             for (size_t el = 0; el < row.size(); el++) {
@@ -39,6 +39,11 @@ private:
      * The tape for a single loop iteration
      */
     ADFun<CGB>* const fun_;
+    /**
+     * Copies of the tape for each CppAD thread number while generating
+     * source code in parallel
+     */
+    ThreadLocalTapes<Base> threadTapes_;
     /**
      * Whether or not it calls atomic functions
      */
@@ -261,7 +266,30 @@ public:
      * @return the tape of the loop model
      */
     inline ADFun<CGB>& getTape() const {
-        return *fun_;
+        return threadTapes_.getTape(*fun_);
+    }
+
+    /**
+     * Allows the tape to be used by several threads at the same time
+     * (see ThreadLocalTapes::enable()).
+     */
+    inline void enableThreadTapes() {
+        threadTapes_.enable();
+    }
+
+    /**
+     * Deletes the copy of the tape created for the current thread
+     * (see ThreadLocalTapes::release()).
+     */
+    inline void releaseThreadTape() {
+        threadTapes_.release();
+    }
+
+    /**
+     * Stops using copies of the tape (see ThreadLocalTapes::disable()).
+     */
+    inline void disableThreadTapes() {
+        threadTapes_.disable();
     }
 
     /**
@@ -0,0 +1,124 @@
+#ifndef CPPAD_CG_THREAD_LOCAL_TAPES_INCLUDED
+#define CPPAD_CG_THREAD_LOCAL_TAPES_INCLUDED
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Copies of a tape for each CppAD thread number so that the tape can be
+ * used by several threads at the same time (e.g. to generate source code
+ * in parallel).
+ *
+ * CppAD memory is managed per thread, therefore each copy is created and
+ * deleted by the thread which uses it and the original tape is not used
+ * while the copies are enabled.
+ */
+template<class Base>
+class ThreadLocalTapes {
+public:
+    using CGB = CppAD::cg::CG<Base>;
+private:
+    /**
+     * the copies of the tape for each CppAD thread number
+     */
+    mutable std::vector<std::unique_ptr<ADFun<CGB> > > threadFuns_;
+    /**
+     * the number of calls to enable() without a call to disable()
+     * (each thread uses its own copy of the tape while it is positive)
+     */
+    size_t enabled_;
+public:
+
+    inline ThreadLocalTapes() :
+        enabled_(0) {
+    }
+
+    ThreadLocalTapes(const ThreadLocalTapes&) = delete;
+    ThreadLocalTapes& operator=(const ThreadLocalTapes&) = delete;
+
+    /**
+     * Whether or not each thread uses its own copy of the tape.
+     */
+    inline bool isEnabled() const {
+        return enabled_ > 0;
+    }
+
+    /**
+     * Provides the tape to be used by the current thread.
+     *
+     * @param fun the original tape
+     * @return the original tape if the copies are not enabled, otherwise
+     *         the copy for the current CppAD thread number (created by
+     *         the current thread the first time it is requested)
+     */
+    inline ADFun<CGB>& getTape(ADFun<CGB>& fun) const {
+        if (enabled_ == 0)
+            return fun;
+
+        size_t t = CppAD::thread_alloc::thread_num();
+        CPPADCG_ASSERT_UNKNOWN(t < threadFuns_.size())
+        std::unique_ptr<ADFun<CGB> >& f = threadFuns_[t];
+        if (f == nullptr) {
+            f.reset(new ADFun<CGB>());
+            *f = fun;
+        }
+        return *f;
+    }
+
+    /**
+     * Starts using a copy of the tape for each CppAD thread number.
+     * Must be called before the other threads start using the tape.
+     * Calls can be nested (e.g. by a background thread which also
+     * generates source code in parallel) and each one must be matched by
+     * a call to disable().
+     */
+    inline void enable() {
+        if (enabled_++ == 0)
+            threadFuns_.resize(CPPAD_MAX_NUM_THREADS);
+    }
+
+    /**
+     * Deletes the copy of the tape created for the current thread.
+     * Must be called by each thread which used getTape() after enable()
+     * (before it returns its CppAD memory).
+     */
+    inline void release() {
+        if (enabled_ > 0)
+            threadFuns_[CppAD::thread_alloc::thread_num()].reset();
+    }
+
+    /**
+     * Stops using copies of the tape when it matches the first call to
+     * enable().
+     * Must be called after the other threads have released their copies.
+     */
+    inline void disable() {
+        CPPADCG_ASSERT_UNKNOWN(enabled_ > 0)
+        if (--enabled_ > 0)
+            return;
+
+        CPPADCG_ASSERT_UNKNOWN(std::all_of(threadFuns_.begin(), threadFuns_.end(),
+                                           [](const std::unique_ptr<ADFun<CGB> >& f) { return f == nullptr; }))
+        threadFuns_.clear();
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+#endif
@@ -0,0 +1,120 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2019 Ciengis
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include <cppad/cg/cppadcg.hpp>
+#include "../../../../test/cppad/cg/models/distillation.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+using Base = double;
+using CGD = CG<Base>;
+using ADCGD = AD<CGD>;
+using duration = std::chrono::steady_clock::duration;
+
+/**
+ * Measures the time required to repeatedly evaluate the operation graph of
+ * the distillation model with the same evaluator.
+ */
+template<class Function>
+inline void measureEvaluation(const std::string& name,
+                              size_t nTimes,
+                              Function evaluate) {
+    using namespace std::chrono;
+
+    evaluate(); // the first evaluation allocates the evaluator memory
+
+    steady_clock::time_point start = steady_clock::now();
+    for (size_t i = 0; i < nTimes; ++i) {
+        evaluate();
+    }
+    duration dt = steady_clock::now() - start;
+
+    std::cout << name << ": "
+              << duration_cast<nanoseconds>(dt).count() / (1e3 * nTimes) << " us/evaluation"
+              << std::endl;
+}
+
+int main(int argc, char **argv) {
+    size_t nTimes = 1000;
+    if (argc > 1) {
+        std::istringstream is(argv[1]);
+        is >> nTimes;
+    }
+
+    const size_t nStage = 8;
+    const size_t n = nStage * 5 + (nStage - 1) + 1 + 4 + 4;
+
+    std::vector<Base> xb(n, 1.0);
+    size_t j = 0;
+    for (size_t i = 0; i < nStage; i++, j++) xb[j] = 12000 + 100 * i; // mWater
+    for (size_t i = 0; i < nStage; i++, j++) xb[j] = 12000 - 100 * i; // mEthanol
+    for (size_t i = 0; i < nStage; i++, j++) xb[j] = 360 + i * 2; // T
+    for (size_t i = 0; i < nStage; i++, j++) xb[j] = 0.3 + 0.05 * i; // yWater
+    for (size_t i = 0; i < nStage; i++, j++) xb[j] = 0.7 - 0.05 * i; // yEthanol
+    for (size_t i = 0; i < nStage - 1; i++, j++) xb[j] = 8 + 0.1 * i; // V
+    xb[j++] = 150e3; // Qc
+    xb[j++] = 250e3; // Qsteam
+    xb[j++] = 0.1; // Fdistillate
+    xb[j++] = 2.5; // reflux
+    xb[j++] = 4; // Frectifier
+    xb[j++] = 30; // feed
+    xb[j++] = 1.01325e5; // P
+    xb[j++] = 0.7; // xFWater
+    xb[j++] = 366; // Tfeed
+    assert(j == n);
+
+    /**
+     * create the operation graph
+     */
+    std::vector<ADCGD> ax(n);
+    for (size_t i = 0; i < n; i++)
+        ax[i] = xb[i];
+    CppAD::Independent(ax);
+    std::vector<ADCGD> ay = distillationFunc(ax);
+    ADFun<CGD> fun(ax, ay);
+
+    CodeHandler<Base> handler;
+    std::vector<CGD> x(n);
+    handler.makeVariables(x);
+    std::vector<CGD> y = fun.Forward(0, x);
+
+    std::cout << "operation nodes: " << handler.getManagedNodesCount() << std::endl;
+
+    /**
+     * evaluate with AD<double>
+     */
+    Evaluator<Base, Base> evalAD(handler);
+    std::vector<AD<Base>> xAD(xb.begin(), xb.end());
+    std::vector<AD<Base>> yAD(y.size());
+
+    measureEvaluation("Evaluator<double, double>", nTimes, [&]() {
+        evalAD.evaluate(xAD, yAD, y);
+    });
+
+    /**
+     * evaluate with CG<double> (clones the operation graph)
+     */
+    Evaluator<Base, Base, CGD> evalCG(handler);
+    std::vector<CGD> yCG(y.size());
+
+    measureEvaluation("Evaluator<double, double, CG<double>>", nTimes, [&]() {
+        CodeHandler<Base> handlerOut;
+        std::vector<CGD> xCG(n);
+        handlerOut.makeVariables(xCG);
+
+        evalCG.evaluate(xCG, yCG, y);
+    });
+}
@@ -0,0 +1,146 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include <dlfcn.h>
+#include <cppad/cg/cppadcg.hpp>
+#include <cppad/cg/lang/c/lang_c_default_var_name_gen.hpp>
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+using Base = double;
+using CGD = CG<Base>;
+
+/**
+ * Compiles a function which evaluates the model for several points
+ * (one independent and one dependent per point) in a loop.
+ */
+void* compileModel(CodeHandler<Base>& handler,
+                   std::vector<CGD>& y,
+                   bool approximate,
+                   const std::vector<std::string>& extraFlags,
+                   const std::string& library) {
+    LanguageC<Base> langC("double");
+    langC.setApproximateMath(approximate);
+    LangCDefaultVariableNameGenerator<Base> nameGen;
+
+    std::ostringstream code;
+    handler.generateCode(code, langC, y, nameGen);
+
+    std::string source = "#include <math.h>\n\n" +
+            langC.generateFilePreamble() +
+            "int approx_speed(const double* xs, double* ys, int n) {\n"
+            "   int i;\n"
+            "   for (i = 0; i < n; i++) {\n"
+            "      const double* x = xs + i;\n"
+            "      double* y = ys + i;\n" +
+            langC.generateTemporaryVariableDeclaration() +
+            code.str() +
+            "   }\n"
+            "   return 0;\n"
+            "}\n";
+
+    GccCompiler<Base> compiler;
+    std::vector<std::string> flags = compiler.getCompileFlags(); // copy
+    flags.emplace_back("-O3"); // vectorize loops with an unknown number of iterations
+    flags.insert(flags.end(), extraFlags.begin(), extraFlags.end());
+    compiler.setCompileFlags(flags);
+
+    try {
+        compiler.compileSources({{"approx_speed.c", source}}, true);
+        compiler.buildDynamic(library);
+    } catch (...) {
+        compiler.cleanup();
+        throw;
+    }
+    compiler.cleanup();
+
+    void* libHandle = dlopen(library.c_str(), RTLD_NOW);
+    if (libHandle == nullptr) {
+        throw CGException("Failed to dynamically load library '", library, "'");
+    }
+    return libHandle;
+}
+
+/**
+ * Compares the evaluation time of exp, log, pow, and tanh with the C math
+ * library and with the approximate implementations (in a vectorizable loop).
+ * Additional compiler flags (e.g. -march=native) can be provided after the
+ * number of evaluations.
+ */
+int main(int argc, char **argv) {
+    size_t nTimes = 2000;
+    if (argc > 1) {
+        std::istringstream is(argv[1]);
+        is >> nTimes;
+    }
+    std::vector<std::string> extraFlags;
+    for (int i = 2; i < argc; ++i) {
+        extraFlags.emplace_back(argv[i]);
+    }
+
+    const int n = 4096;
+
+    CodeHandler<Base> handler;
+    std::vector<CGD> x(1);
+    handler.makeVariables(x);
+
+    std::vector<CGD> y{exp(x[0]) * tanh(x[0]) + log(x[0]) + pow(x[0], 1.3)};
+
+    std::vector<double> xv(n);
+    for (int i = 0; i < n; ++i)
+        xv[i] = 0.01 + 5.0 * i / n;
+
+    std::vector<double> yLibm(n);
+    std::vector<double> yApprox(n);
+
+    for (bool approximate : {false, true}) {
+        std::vector<double>& yv = approximate ? yApprox : yLibm;
+
+        void* libHandle = compileModel(handler, y, approximate, extraFlags,
+                                       approximate ? "./approx_speed.so" : "./libm_speed.so");
+
+        int (*fn)(const double*, double*, int) = nullptr;
+        *(void **) (&fn) = dlsym(libHandle, "approx_speed");
+        if (fn == nullptr) {
+            std::cerr << "failed to load the function approx_speed" << std::endl;
+            dlclose(libHandle);
+            return 1;
+        }
+
+        (*fn)(&xv[0], &yv[0], n); // the first evaluation loads the code
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < nTimes; ++r) {
+            (*fn)(&xv[0], &yv[0], n);
+        }
+        auto end = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration<double, std::nano>(end - start).count() / double(nTimes * n);
+
+        dlclose(libHandle);
+
+        std::cout << (approximate ? "approximate:    " : "C math library: ")
+                  << elapsed << " ns/point" << std::endl;
+    }
+
+    for (int i = 0; i < n; ++i) {
+        if (!CppAD::NearEqual(yApprox[i], yLibm[i], 1e-10, 1e-10)) {
+            std::cerr << "different results for x = " << xv[i] << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
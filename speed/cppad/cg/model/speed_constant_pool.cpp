@@ -0,0 +1,132 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include <cppad/cg/cppadcg.hpp>
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+using Base = double;
+using CGD = CG<Base>;
+using ADCGD = AD<CGD>;
+
+/**
+ * A model where the same constants are used many times
+ */
+std::vector<ADCGD> constantModel(const std::vector<ADCGD>& x,
+                                 size_t m) {
+    const double c[] = {0.12345678901234566, 1.4142135623730951, 2.7182818284590451, 0.57721566490153287};
+    size_t n = x.size();
+
+    std::vector<ADCGD> y(m);
+    for (size_t i = 0; i < m; ++i) {
+        ADCGD a = x[i % n] * c[i % 4] + x[(i + 1) % n] * c[(i + 1) % 4];
+        y[i] = sin(a) * c[(i + 2) % 4] + a * a * c[(i + 3) % 4] - 3.0;
+    }
+    return y;
+}
+
+/**
+ * Counts the number of characters in the source files
+ */
+class SourceSizeSink : public SourceSink {
+public:
+    size_t size = 0;
+
+    void addSource(const std::string& filename,
+                   std::string&& source) override {
+        size += source.size();
+    }
+};
+
+/**
+ * Compares the source size, the compilation time, and the evaluation time
+ * with and without a constant pool.
+ */
+int main(int argc, char **argv) {
+    size_t nTimes = 1000;
+    if (argc > 1) {
+        std::istringstream is(argv[1]);
+        is >> nTimes;
+    }
+
+    const size_t n = 20;
+    const size_t m = 4000;
+
+    std::vector<double> xv(n);
+    for (size_t j = 0; j < n; ++j)
+        xv[j] = 0.1 * j;
+
+    std::vector<double> yRef;
+
+    for (bool pool : {false, true}) {
+        std::string name = pool ? "cpool_on" : "cpool_off";
+
+        std::vector<ADCGD> u(n);
+        for (size_t j = 0; j < n; j++)
+            u[j] = xv[j];
+        CppAD::Independent(u);
+        std::vector<ADCGD> v = constantModel(u, m);
+        ADFun<CGD> fun(u, v);
+
+        ModelCSourceGen<double> modelSourceGen(fun, name);
+        modelSourceGen.setCreateForwardZero(true);
+        modelSourceGen.setRoundTripParameters(true);
+        modelSourceGen.setConstantPool(pool);
+
+        ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+
+        SourceSizeSink sizeSink;
+        libSourceGen.generateSources(sizeSink);
+
+        GccCompiler<double> compiler;
+        DynamicModelLibraryProcessor<double> p(libSourceGen, "cppadcg_" + name);
+
+        auto start = std::chrono::steady_clock::now();
+        std::unique_ptr<DynamicLib<double>> dynamicLib = p.createDynamicLibrary(compiler);
+        auto end = std::chrono::steady_clock::now();
+        double compileTime = std::chrono::duration<double>(end - start).count();
+
+        std::unique_ptr<GenericModel<double>> model = dynamicLib->model(name);
+
+        std::vector<double> yv(m);
+        model->ForwardZero(xv, yv); // the first evaluation loads the code
+
+        start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < nTimes; ++r) {
+            model->ForwardZero(xv, yv);
+        }
+        end = std::chrono::steady_clock::now();
+        double evalTime = std::chrono::duration<double, std::micro>(end - start).count() / nTimes;
+
+        std::cout << (pool ? "constant pool:    " : "inline constants: ")
+                  << sizeSink.size << " characters, "
+                  << compileTime << " s compilation, "
+                  << evalTime << " us/evaluation" << std::endl;
+
+        if (yRef.empty()) {
+            yRef = yv;
+        } else {
+            for (size_t i = 0; i < m; ++i) {
+                if (!CppAD::NearEqual(yRef[i], yv[i], 1e-14, 1e-14)) {
+                    std::cerr << "different results for the dependent " << i << std::endl;
+                    return 1;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
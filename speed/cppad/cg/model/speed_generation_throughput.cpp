@@ -0,0 +1,73 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include <cppad/cg/cppadcg.hpp>
+#include <cppad/cg/lang/c/lang_c_default_var_name_gen.hpp>
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+using Base = double;
+using CGD = CG<Base>;
+
+/**
+ * Measures the source generation throughput for a model with many
+ * operations and constants.
+ */
+int main(int argc, char **argv) {
+    size_t nTimes = 5;
+    if (argc > 1) {
+        std::istringstream is(argv[1]);
+        is >> nTimes;
+    }
+
+    const size_t n = 200;
+    const size_t m = 20000;
+
+    CodeHandler<Base> handler;
+
+    std::vector<CGD> x(n);
+    handler.makeVariables(x);
+
+    std::vector<CGD> y(m);
+    for (size_t i = 0; i < m; ++i) {
+        CGD a = x[i % n] * (1.0 + 1e-3 * i) - x[(i + 7) % n] / (3.0 + i);
+        y[i] = sin(a) * 0.1 + cos(x[(i + 1) % n]) * (0.5 + 1e-5 * i);
+    }
+
+    for (bool roundTrip : {false, true}) {
+        size_t characters = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < nTimes; ++r) {
+            LanguageC<Base> langC("double");
+            langC.setRoundTripParameters(roundTrip);
+            LangCDefaultVariableNameGenerator<Base> nameGen;
+
+            std::ostringstream code;
+            handler.generateCode(code, langC, y, nameGen);
+            characters += code.str().size();
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        double seconds = std::chrono::duration<double>(end - start).count();
+
+        std::cout << (roundTrip ? "round-trip parameters: " : "default parameters:    ")
+                  << seconds / nTimes * 1e3 << " ms/model, "
+                  << characters / seconds / 1e6 << " MB/s" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,157 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include <dlfcn.h>
+#include <cppad/cg/cppadcg.hpp>
+#include <cppad/cg/lang/c/lang_c_default_var_name_gen.hpp>
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+using Base = double;
+using CGD = CG<Base>;
+
+/**
+ * A model where the default evaluation order keeps all sin(x[k])
+ * alive until the end (they are used by the last dependents)
+ */
+std::vector<CGD> model(std::vector<CGD>& x) {
+    size_t n = x.size();
+
+    std::vector<CGD> y(2 * n);
+    std::vector<CGD> t(n);
+    CGD s = x[0];
+    for (size_t k = 0; k < n; ++k) {
+        t[k] = sin(x[k]);
+        s = s + t[k];
+        y[k] = cos(s);
+    }
+    for (size_t k = 0; k < n; ++k) {
+        y[n + k] = t[k] * x[k];
+    }
+    return y;
+}
+
+/**
+ * Generates and compiles the source code for the model
+ *
+ * @return the number of temporary variables
+ */
+size_t compileModel(size_t n,
+                    bool schedule,
+                    const std::string& library) {
+    CodeHandler<Base> handler(10 + 4 * n);
+    handler.setScheduleOperations(schedule);
+
+    std::vector<CGD> x(n);
+    handler.makeVariables(x);
+    std::vector<CGD> y = model(x);
+
+    LanguageC<Base> langC("double");
+    LangCDefaultVariableNameGenerator<Base> nameGen;
+
+    std::ostringstream code;
+    handler.generateCode(code, langC, y, nameGen);
+
+    std::string source = "#include <math.h>\n\n"
+                         "void model(const double* x, double* y) {\n" +
+                         langC.generateTemporaryVariableDeclaration() +
+                         code.str() +
+                         "}\n";
+
+    GccCompiler<Base> compiler;
+    try {
+        compiler.compileSources({{"model.c", source}}, true);
+        compiler.buildDynamic(library);
+    } catch (...) {
+        compiler.cleanup();
+        throw;
+    }
+    compiler.cleanup();
+
+    return handler.getTemporaryVariableCount();
+}
+
+/**
+ * Evaluates a compiled model several times
+ *
+ * @return the average evaluation time (ns)
+ */
+double evaluate(const std::string& library,
+                const std::vector<double>& x,
+                std::vector<double>& y,
+                size_t nTimes) {
+    void* libHandle = dlopen(library.c_str(), RTLD_NOW);
+    if (libHandle == nullptr) {
+        throw CGException("Failed to dynamically load library '", library, "'");
+    }
+
+    void (*fn)(const double*, double*) = nullptr;
+    *(void **) (&fn) = dlsym(libHandle, "model");
+    if (fn == nullptr) {
+        dlclose(libHandle);
+        throw CGException("Failed to load the function 'model'");
+    }
+
+    (*fn)(&x[0], &y[0]); // the first evaluation loads the code
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < nTimes; ++r) {
+        (*fn)(&x[0], &y[0]);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    dlclose(libHandle);
+
+    return std::chrono::duration<double, std::nano>(end - start).count() / double(nTimes);
+}
+
+/**
+ * Compares the evaluation time of the generated code with and without
+ * operation scheduling.
+ */
+int main(int argc, char **argv) {
+    size_t nTimes = 2000;
+    if (argc > 1) {
+        std::istringstream is(argv[1]);
+        is >> nTimes;
+    }
+
+    const size_t n = 2000;
+
+    size_t tmpDefault = compileModel(n, false, "./schedule_speed_off.so");
+    size_t tmpScheduled = compileModel(n, true, "./schedule_speed_on.so");
+
+    std::vector<double> x(n);
+    for (size_t j = 0; j < n; ++j)
+        x[j] = 0.001 * j;
+
+    std::vector<double> yDefault(2 * n);
+    std::vector<double> yScheduled(2 * n);
+    double tDefault = evaluate("./schedule_speed_off.so", x, yDefault, nTimes);
+    double tScheduled = evaluate("./schedule_speed_on.so", x, yScheduled, nTimes);
+
+    std::cout << "default order:   " << tmpDefault << " temporaries, " << tDefault << " ns/evaluation\n"
+                 "scheduled order: " << tmpScheduled << " temporaries, " << tScheduled << " ns/evaluation" << std::endl;
+
+    for (size_t i = 0; i < 2 * n; ++i) {
+        if (!CppAD::NearEqual(yDefault[i], yScheduled[i], 1e-14, 1e-14)) {
+            std::cerr << "different results for the dependent " << i << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
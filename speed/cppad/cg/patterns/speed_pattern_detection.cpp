@@ -0,0 +1,110 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+
+#include <cppad/cg/cppadcg.hpp>
+#include "../../../../test/cppad/cg/models/plug_flow.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+using Base = double;
+using CGD = CG<Base>;
+using ADCGD = AD<CGD>;
+
+/**
+ * Measures the time required to detect the equation patterns and to create
+ * the loop models.
+ *
+ * @param fun the taped model
+ * @param relations the related dependent candidates (nullptr to determine
+ *                  them automatically)
+ */
+inline double measurePatternDetection(ADFun<CGD>& fun,
+                                      const std::vector<std::set<size_t> >* relations,
+                                      size_t& nRelated,
+                                      size_t& nLoops) {
+    using namespace std::chrono;
+
+    steady_clock::time_point start = steady_clock::now();
+
+    CodeHandler<Base> handler;
+    std::vector<CGD> x(fun.Domain());
+    handler.makeVariables(x);
+    std::vector<CGD> y = fun.Forward(0, x);
+
+    std::vector<std::set<size_t> > related;
+    if (relations != nullptr) {
+        related = *relations;
+    } else {
+        related = DependentStructureHasher<Base>::findRelatedDependents(handler, y);
+    }
+    nRelated = related.size();
+
+    DependentPatternMatcher<Base> matcher(related, y, x);
+
+    LoopFreeModel<Base>* nonLoopTape;
+    SmartSetPointer<LoopModel<Base> > loopTapes;
+    matcher.generateTapes(nonLoopTape, loopTapes.s);
+    delete nonLoopTape;
+
+    nLoops = loopTapes.size();
+
+    return duration_cast<duration<double> >(steady_clock::now() - start).count();
+}
+
+int main(int argc, char **argv) {
+    std::vector<size_t> sizes;
+    for (int i = 1; i < argc; ++i) {
+        std::istringstream is(argv[i]);
+        size_t nEls;
+        is >> nEls;
+        sizes.push_back(nEls);
+    }
+    if (sizes.empty()) {
+        sizes = {100, 200, 500, 1000, 2000, 5000, 10000};
+    }
+
+    std::cout << "# elements  equations  nodes  candidates[s]  loops  automatic[s]  groups  loops" << std::endl;
+
+    for (size_t nEls : sizes) {
+        std::vector<Base> xb = PlugFlowModel<Base>::getTypicalValues(nEls);
+        std::vector<std::set<size_t> > relations = PlugFlowModel<Base>::getRelatedCandidates(nEls);
+
+        std::vector<ADCGD> ax(xb.size());
+        for (size_t j = 0; j < xb.size(); j++)
+            ax[j] = xb[j];
+        CppAD::Independent(ax);
+        PlugFlowModel<CGD> model;
+        std::vector<ADCGD> ay = model.model2(ax, nEls);
+        ADFun<CGD> fun(ax, ay);
+
+        size_t nodes;
+        {
+            CodeHandler<Base> handler;
+            std::vector<CGD> x(fun.Domain());
+            handler.makeVariables(x);
+            fun.Forward(0, x);
+            nodes = handler.getManagedNodesCount();
+        }
+
+        size_t nRelated, nLoops, nGroups, nLoopsAuto;
+        double tCandidates = measurePatternDetection(fun, &relations, nRelated, nLoops);
+        double tAutomatic = measurePatternDetection(fun, nullptr, nGroups, nLoopsAuto);
+
+        std::cout << nEls << "  " << fun.Range() << "  " << nodes << "  "
+                  << tCandidates << "  " << nLoops << "  "
+                  << tAutomatic << "  " << nGroups << "  " << nLoopsAuto << std::endl;
+    }
+}
@@ -39,9 +39,19 @@ protected:
     MultiThreadingType _multithread;
     bool _multithreadDisabled;
     ThreadPoolScheduleStrategy _multithreadScheduler;
+    size_t _multithreadPartitions = 0;
     std::vector<Base> _xTape;
     std::vector<double> _xRun;
     size_t _maxAssignPerFunc = 100;
+    size_t _generationThreads = 1;
+    bool _mathLowering = false;
+    FusedMultiplyAdd _fusedMultiplyAdd = FusedMultiplyAdd::Compiler;
+    bool _temporaryWorkspace = false;
+    bool _streamSources = false;
+    bool _constantPool = false;
+    bool _automaticFunctionSplitting = false;
+    LanguageC<double>::FunctionSplitCostModel _functionSplitCost;
+    std::map<std::string, std::vector<LanguageC<double>::FunctionChunk> > _functionPartitions;
     double epsilonR = 1e-14;
     double epsilonA = 1e-14;
     std::vector<double> _xNorm;
@@ -53,6 +63,7 @@ protected:
     std::vector<size_t> _jacCol;
     std::vector<size_t> _hessRow;
     std::vector<size_t> _hessCol;
+    std::vector<std::set<size_t> > _relatedDepCandidates;
 public:
 
     explicit CppADCGDynamicTest(std::string testName,
@@ -124,6 +135,14 @@ public:
         modelSourceGen.setCreateReverseTwo(_reverseTwo);
         modelSourceGen.setMaxAssignmentsPerFunc(_maxAssignPerFunc);
         modelSourceGen.setMultiThreading(true);
+        modelSourceGen.setMultiThreadingPartitions(_multithreadPartitions);
+        modelSourceGen.setGenerationThreads(_generationThreads);
+        modelSourceGen.setMathLowering(_mathLowering);
+        modelSourceGen.setFusedMultiplyAdd(_fusedMultiplyAdd);
+        modelSourceGen.setTemporaryWorkspace(_temporaryWorkspace);
+        modelSourceGen.setConstantPool(_constantPool);
+        modelSourceGen.setAutomaticFunctionSplitting(_automaticFunctionSplitting);
+        modelSourceGen.setFunctionSplitCostModel(_functionSplitCost);
 
         if (!_jacRow.empty())
             modelSourceGen.setCustomSparseJacobianElements(_jacRow, _jacCol);
@@ -131,12 +150,17 @@ public:
         if (!_hessRow.empty())
             modelSourceGen.setCustomSparseHessianElements(_hessRow, _hessCol);
 
+        if (!_relatedDepCandidates.empty())
+            modelSourceGen.setRelatedDependents(_relatedDepCandidates);
+
         ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
         libSourceGen.setMultiThreading(_multithread);
 
-        SaveFilesModelLibraryProcessor<double>::saveLibrarySourcesTo(libSourceGen, "sources_" + _name + "_1");
+        if (!_streamSources) // streamed sources can only be used once
+            SaveFilesModelLibraryProcessor<double>::saveLibrarySourcesTo(libSourceGen, "sources_" + _name + "_1");
 
         DynamicModelLibraryProcessor<double> p(libSourceGen);
+        p.setStreamSources(_streamSources);
         GccCompiler<double> compiler;
         //compiler.setSaveToDiskFirst(true); // useful to detect problem
         prepareTestCompilerFlags(compiler);
@@ -149,11 +173,13 @@ public:
             // this is required because the OpenMP implementation in GCC causes a segmentation fault on dlclose
             p.getOptions()["dlOpenMode"] = std::to_string(RTLD_NOW | RTLD_NODELETE);
 #endif
-        } else if(libSourceGen.getMultiThreading() == MultiThreadingType::PTHREADS) {
+        } else if(libSourceGen.getMultiThreading() == MultiThreadingType::PTHREADS ||
+                  libSourceGen.getMultiThreading() == MultiThreadingType::EXECUTOR) {
             compiler.addCompileFlag("-pthread");
         }
 
         _dynamicLib = p.createDynamicLibrary(compiler);
+        _functionPartitions = modelSourceGen.getFunctionPartitions();
         _dynamicLib->setThreadPoolVerbose(this->verbose_);
         _dynamicLib->setThreadNumber(2);
         _dynamicLib->setThreadPoolDisabled(_multithreadDisabled);
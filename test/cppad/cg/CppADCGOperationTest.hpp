@@ -27,11 +27,18 @@ namespace CppAD {
 namespace cg {
 
 class CppADCGOperationTest : public CppADCGTest {
+protected:
+    /**
+     * whether or not to use the approximate implementations of exp, log,
+     * pow, and tanh in the generated code
+     */
+    bool approximateMath_;
 public:
 
     inline explicit CppADCGOperationTest(bool verbose = false,
                                          bool printValues = false) :
-        CppADCGTest(verbose, printValues) {
+        CppADCGTest(verbose, printValues),
+        approximateMath_(false) {
     }
 
     void TearDown() override {
@@ -118,13 +118,15 @@ std::vector<std::vector<double> > CppADCGOperationTest::run0(ADFun<CG<double> >&
     vector<CG<double> > dep = f.Forward(0, indVars);
 
     LanguageC<double> langC("double");
+    langC.setApproximateMath(approximateMath_);
     LangCDefaultVariableNameGenerator<double> nameGen;
 
     std::ostringstream code;
     handler.generateCode(code, langC, dep, nameGen);
 
     std::string spaces = "   ";
-    std::string source = "#include <math.h>\n\n"
+    std::string source = "#include <math.h>\n\n" +
+            langC.generateFilePreamble() +
             "int " + function + "(const double* x, double* y) {\n";
 
     // declare variables
@@ -240,13 +242,15 @@ std::vector<std::vector<double> > CppADCGOperationTest::runSparseJac(ADFun<CG<do
     vector<CG<double> > jacCG = f.SparseJacobian(indVars);
 
     LanguageC<double> langC("double");
+    langC.setApproximateMath(approximateMath_);
     LangCDefaultVariableNameGenerator<double> nameGen;
 
     std::ostringstream code;
     handler.generateCode(code, langC, jacCG, nameGen);
 
     std::string spaces = "   ";
-    std::string source = "#include <math.h>\n\n"
+    std::string source = "#include <math.h>\n\n" +
+            langC.generateFilePreamble() +
             "int " + functionJac + "(const double* x, double* y) {\n";
 
     // declare variables
@@ -0,0 +1,86 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+/**
+ * Two pairs of dependents which share one operation within each pair
+ */
+std::vector<CGD> partitionTestModel(std::vector<CGD>& x) {
+    CGD s = sin(x[0]);
+    CGD c = cos(x[2]);
+
+    std::vector<CGD> y(4);
+    y[0] = s * x[1];
+    y[1] = s + x[1];
+    y[2] = c * x[3];
+    y[3] = c - x[3];
+    return y;
+}
+
+}
+
+TEST_F(CppADCGTest, DependentPartitioner) {
+    CodeHandler<double> handler;
+
+    std::vector<CGD> x(4);
+    handler.makeVariables(x);
+
+    std::vector<CGD> y = partitionTestModel(x);
+
+    DependentPartitioner<double> partitioner(handler);
+    auto groups = partitioner.partition(y, 2);
+
+    ASSERT_EQ(2u, groups.size());
+    ASSERT_EQ(std::vector<size_t>({0, 1}), groups[0]);
+    ASSERT_EQ(std::vector<size_t>({2, 3}), groups[1]);
+
+    // no operation is evaluated twice
+    ASSERT_EQ(6u, partitioner.getTotalOperations());
+    ASSERT_EQ(6u, partitioner.getPartitionedOperations());
+    ASSERT_EQ(std::vector<size_t>({3, 3}), partitioner.getGroupOperations());
+}
+
+TEST_F(CppADCGTest, DependentPartitionerManyGroups) {
+    CodeHandler<double> handler;
+
+    std::vector<CGD> x(4);
+    handler.makeVariables(x);
+
+    std::vector<CGD> y = partitionTestModel(x);
+
+    DependentPartitioner<double> partitioner(handler);
+    auto groups = partitioner.partition(y, 8);
+
+    // empty groups are not returned and each dependent is in a single group
+    ASSERT_LE(groups.size(), y.size());
+    std::vector<size_t> count(y.size(), 0);
+    for (const auto& g : groups) {
+        ASSERT_FALSE(g.empty());
+        for (size_t i : g)
+            count[i]++;
+    }
+    ASSERT_EQ(std::vector<size_t>(y.size(), 1), count);
+
+    ASSERT_GE(partitioner.getPartitionedOperations(), partitioner.getTotalOperations());
+
+    groups = partitioner.partition(y, 1);
+    ASSERT_EQ(1u, groups.size());
+    ASSERT_EQ(6u, partitioner.getPartitionedOperations());
+}
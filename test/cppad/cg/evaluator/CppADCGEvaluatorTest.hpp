@@ -64,6 +64,20 @@ protected:
             }
         }
 
+        /**
+         * Test with bytecode
+         */
+        {
+            BytecodeProgram<Base> program(handlerOrig, yOrig);
+
+            std::vector<Base> yNew = program.evaluate(testValues);
+
+            ASSERT_EQ(yNew.size(), yOrig.size());
+            for (size_t i = 0; i < yOrig.size(); i++) {
+                ASSERT_EQ(yNew[i], yOrig[i].getValue());
+            }
+        }
+
         /**
          * Test with active variables from CG
          */
@@ -0,0 +1,99 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+template<class T>
+std::vector<T> bytecodeTestModel(const std::vector<T>& x) {
+    std::vector<T> y(3);
+    T a = x[0] * x[1] + 2.0;
+    y[0] = exp(a) / x[2];
+    y[1] = CondExpLt(x[0], x[1], sin(a), cos(a)) * x[2];
+    y[2] = pow(x[1], 3.0) - x[0] * x[0];
+    return y;
+}
+
+}
+
+TEST_F(CppADCGTest, BytecodeRegisterReuse) {
+    CodeHandler<double> handler;
+
+    std::vector<CGD> x(1);
+    handler.makeVariables(x);
+    x[0].setValue(0.5);
+
+    // long chain where each temporary is only used by the next operation
+    CGD v = x[0];
+    for (size_t i = 0; i < 100; i++) {
+        v = sin(v) + 1.0;
+    }
+    std::vector<CGD> y{v, CGD(3.0)};
+
+    BytecodeProgram<double> program(handler, y);
+
+    ASSERT_EQ(program.getInstructionCount(), 200u);
+    ASSERT_LE(program.getRegisterCount(), 2u);
+
+    std::vector<double> xv{0.5};
+    std::vector<double> yv = program.evaluate(xv);
+    ASSERT_EQ(yv[0], v.getValue());
+    ASSERT_EQ(yv[1], 3.0);
+
+    // a caller provided workspace
+    std::vector<double> slots;
+    std::vector<double> yv2(2);
+    program.evaluate(xv, yv2, slots);
+    ASSERT_EQ(yv2, yv);
+}
+
+TEST_F(CppADCGTest, BytecodeGenericModel) {
+    std::vector<double> xv{0.5, 1.5, 2.0};
+    std::vector<double> wv{1.0, 2.0, -1.0};
+
+    // CG tape
+    std::vector<ADCGD> ax(xv.size());
+    for (size_t j = 0; j < xv.size(); j++)
+        ax[j] = xv[j];
+    CppAD::Independent(ax);
+    std::vector<ADCGD> ay = bytecodeTestModel(ax);
+    ADFun<CGD> fun(ax, ay);
+
+    // reference values from CppAD
+    std::vector<AD<double> > adx(xv.begin(), xv.end());
+    CppAD::Independent(adx);
+    std::vector<AD<double> > ady = bytecodeTestModel(adx);
+    ADFun<double> funRef(adx, ady);
+
+    BytecodeGenericModel<double> bytecodeModel(fun, "model");
+    GenericModel<double>& model = bytecodeModel;
+
+    ASSERT_TRUE(compareValues(model.ForwardZero(xv), funRef.Forward(0, xv)));
+    ASSERT_TRUE(compareValues(model.Jacobian(xv), funRef.Jacobian(xv)));
+    ASSERT_TRUE(compareValues(model.SparseJacobian(xv), funRef.Jacobian(xv)));
+    ASSERT_TRUE(compareValues(model.Hessian(xv, wv), funRef.Hessian(xv, wv)));
+    ASSERT_TRUE(compareValues(model.SparseHessian(xv, wv), funRef.Hessian(xv, wv)));
+
+    // different values with the same programs
+    xv[0] = 3.0;
+    ASSERT_TRUE(compareValues(model.ForwardZero(xv), funRef.Forward(0, xv)));
+    ASSERT_TRUE(compareValues(model.SparseJacobian(xv), funRef.Jacobian(xv)));
+    ASSERT_TRUE(compareValues(model.SparseHessian(xv, wv), funRef.Hessian(xv, wv)));
+
+    ASSERT_FALSE(model.isForwardOneAvailable());
+}
@@ -0,0 +1,124 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+/**
+ * y[0] and y[2] share operations, y[1] and y[3] are independent
+ */
+std::vector<CGD> parallelTestModel(std::vector<CGD>& x) {
+    CGD a = sin(x[0]) * x[1];
+    std::vector<CGD> y(4);
+    y[0] = a + x[2];
+    y[1] = exp(x[3]) / x[4];
+    y[2] = a * a;
+    y[3] = x[4] - 2.0;
+    return y;
+}
+
+}
+
+TEST_F(CppADCGTest, ParallelEvaluatorCones) {
+    CodeHandler<double> handler;
+
+    std::vector<CGD> x(5);
+    handler.makeVariables(x);
+
+    std::vector<CGD> y = parallelTestModel(x);
+
+    ParallelEvaluator<double, double> evaluator(handler, 2);
+    std::vector<std::vector<size_t>> cones = evaluator.findIndependentCones(y);
+
+    std::vector<std::vector<size_t>> expected{{0, 2}, {1}, {3}};
+    ASSERT_EQ(cones, expected);
+}
+
+TEST_F(CppADCGTest, ParallelEvaluatorDouble) {
+    CodeHandler<double> handler;
+
+    std::vector<CGD> x(5);
+    handler.makeVariables(x);
+
+    std::vector<CGD> y = parallelTestModel(x);
+
+    std::vector<double> xv{0.5, 1.5, 2.0, -1.0, 3.0};
+
+    // reference values
+    for (size_t j = 0; j < x.size(); ++j)
+        x[j].setValue(xv[j]);
+    std::vector<CGD> yRef = parallelTestModel(x);
+
+    for (size_t nThreads : {1, 2, 4}) {
+        ParallelEvaluator<double, double> evaluator(handler, nThreads);
+        std::vector<double> yv = evaluator.evaluate(xv, y);
+
+        ASSERT_EQ(yv.size(), y.size());
+        for (size_t i = 0; i < y.size(); ++i) {
+            ASSERT_EQ(yv[i], yRef[i].getValue());
+        }
+    }
+}
+
+TEST_F(CppADCGTest, ParallelEvaluatorCG) {
+    CodeHandler<double> handler;
+
+    std::vector<CGD> x(5);
+    handler.makeVariables(x);
+
+    std::vector<CGD> y = parallelTestModel(x);
+
+    ParallelEvaluator<double, double, CGD> evaluator(handler, 2);
+    std::vector<std::vector<size_t>> cones = evaluator.findIndependentCones(y);
+
+    // a different code handler for each group
+    std::vector<std::unique_ptr<CodeHandler<double>>> handlers(cones.size());
+    std::vector<std::vector<CGD>> xNew(cones.size(), std::vector<CGD>(x.size()));
+    std::vector<ArrayView<const CGD>> indeps;
+    for (size_t c = 0; c < cones.size(); ++c) {
+        handlers[c].reset(new CodeHandler<double>());
+        handlers[c]->makeVariables(xNew[c]);
+        indeps.emplace_back(xNew[c]);
+    }
+
+    std::vector<CGD> yNew(y.size());
+    evaluator.evaluate(cones, indeps, yNew, y);
+
+    // reference values from the sequential evaluator
+    std::vector<double> xv{0.5, 1.5, 2.0, -1.0, 3.0};
+
+    Evaluator<double, double> evaluatorRef(handler);
+    std::vector<double> yRef = evaluatorRef.evaluate(xv, y);
+
+    for (size_t c = 0; c < cones.size(); ++c) {
+        std::vector<CGD> yCone;
+        for (size_t i : cones[c]) {
+            ASSERT_TRUE(yNew[i].getOperationNode() != nullptr);
+            ASSERT_EQ(yNew[i].getOperationNode()->getCodeHandler(), handlers[c].get());
+            yCone.push_back(yNew[i]);
+        }
+
+        Evaluator<double, double> evaluatorCone(*handlers[c]);
+        std::vector<double> yv = evaluatorCone.evaluate(xv, yCone);
+
+        ASSERT_EQ(yv.size(), cones[c].size());
+        for (size_t k = 0; k < cones[c].size(); ++k) {
+            ASSERT_EQ(yv[k], yRef[cones[c][k]]);
+        }
+    }
+}
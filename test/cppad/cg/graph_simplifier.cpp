@@ -0,0 +1,123 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace {
+
+/**
+ * Creates operations which would not be created by the arithmetic operators
+ * of CG (e.g. resulting from substitutions and derivatives)
+ */
+std::vector<CGD> simplificationTestModel(CodeHandler<double>& handler,
+                                         std::vector<CGD>& x) {
+    using Arg = Argument<double>;
+    Arg x0(*x[0].getOperationNode());
+    Arg x1(*x[1].getOperationNode());
+
+    auto* m1 = handler.makeNode(CGOpCode::Mul, {x0, Arg(1.0)}); // x0 * 1
+    auto* c = handler.makeNode(CGOpCode::Mul, {Arg(2.0), Arg(3.0)}); // 2 * 3
+    auto* p = handler.makeNode(CGOpCode::Pow, {x0, Arg(2.0)}); // pow(x0, 2)
+    auto* u1 = handler.makeNode(CGOpCode::UnMinus, x1);
+    auto* u2 = handler.makeNode(CGOpCode::UnMinus, Arg(*u1)); // -(-x1)
+
+    std::vector<CGD> y(4);
+    y[0] = CGD(*handler.makeNode(CGOpCode::Add, {Arg(*m1), Arg(*c)}));
+    y[1] = CGD(*handler.makeNode(CGOpCode::Add, {Arg(*p), Arg(*u2)}));
+    y[2] = CGD(*handler.makeNode(CGOpCode::Mul, {x0, x1}));
+    y[3] = CGD(*handler.makeNode(CGOpCode::Mul, {x1, x0})); // same as y[2]
+    return y;
+}
+
+}
+
+TEST_F(CppADCGTest, GraphSimplifier) {
+    CodeHandler<double> handler;
+
+    std::vector<CGD> x(2);
+    handler.makeVariables(x);
+
+    std::vector<CGD> y = simplificationTestModel(handler, x);
+
+    std::vector<double> xv{0.5, -1.5};
+
+    Evaluator<double, double> evaluator(handler);
+    std::vector<double> yRef = evaluator.evaluate(xv, y);
+
+    ArrayView<CGD> yv(y);
+    GraphSimplifier<double> simplifier(handler);
+    simplifier.simplify(yv);
+
+    ASSERT_EQ(9u, simplifier.getNodeCountBefore());
+    ASSERT_EQ(4u, simplifier.getNodeCountAfter());
+
+    // the simplified graph must provide the same values
+    Evaluator<double, double> evaluator2(handler);
+    std::vector<double> ySimp = evaluator2.evaluate(xv, y);
+    ASSERT_EQ(yRef.size(), ySimp.size());
+    for (size_t i = 0; i < yRef.size(); ++i) {
+        ASSERT_EQ(yRef[i], ySimp[i]);
+    }
+}
+
+TEST_F(CppADCGTest, GraphSimplifierGenerateCode) {
+    CodeHandler<double> handler;
+    handler.setSimplifyOperations(true);
+
+    std::vector<CGD> x(2);
+    handler.makeVariables(x);
+
+    std::vector<CGD> y = simplificationTestModel(handler, x);
+
+    LanguageC<double> langC("double");
+    LangCDefaultVariableNameGenerator<double> nameGen;
+
+    std::ostringstream code;
+    handler.generateCode(code, langC, y, nameGen);
+
+    ASSERT_EQ(9u, handler.getNodeCountBeforeSimplification());
+    ASSERT_EQ(4u, handler.getNodeCountAfterSimplification());
+    ASSERT_EQ(std::string::npos, code.str().find("pow("));
+}
+
+TEST_F(CppADCGTest, GraphSimplifierNonFinite) {
+    using Arg = Argument<double>;
+
+    CodeHandler<double> handler;
+
+    std::vector<CGD> x(2);
+    handler.makeVariables(x);
+
+    Arg x0(*x[0].getOperationNode());
+    Arg x1(*x[1].getOperationNode());
+
+    std::vector<CGD> y(2);
+    y[0] = CGD(*handler.makeNode(CGOpCode::Sub, {x0, x0})); // x0 - x0
+    y[1] = CGD(*handler.makeNode(CGOpCode::Div, {x1, x1})); // x1 / x1
+
+    ArrayView<CGD> yv(y);
+    GraphSimplifier<double> simplifier(handler);
+    simplifier.simplify(yv);
+
+    // these operations must not be replaced by constants
+    std::vector<double> xv{std::numeric_limits<double>::infinity(), 0.0};
+
+    Evaluator<double, double> evaluator(handler);
+    std::vector<double> ySimp = evaluator.evaluate(xv, y);
+    ASSERT_TRUE(std::isnan(ySimp[0]));
+    ASSERT_TRUE(std::isnan(ySimp[1]));
+}
@@ -0,0 +1,220 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+#include "gccCompilerFlags.hpp"
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGDynamicAsyncTest : public CppADCGTest {
+protected:
+    const std::string _modelName;
+    std::vector<double> x;
+    std::unique_ptr<ADFun<CGD>> _fun;
+    /**
+     * a function which is independent from the model (used by the caller
+     * while the library is created)
+     */
+    std::unique_ptr<ADFun<CGD>> _fun2;
+public:
+
+    inline CppADCGDynamicAsyncTest(bool verbose = false, bool printValues = false) :
+        CppADCGTest(verbose, printValues),
+        _modelName("model"),
+        x{0.5, 1.5} {
+    }
+
+    void SetUp() override {
+        _fun.reset(createFunction());
+        _fun2.reset(createFunction());
+    }
+
+    void TearDown() override {
+        _fun.reset(nullptr);
+        _fun2.reset(nullptr);
+    }
+
+    ADFun<CGD>* createFunction() {
+        std::vector<ADCGD> u(x.size());
+        for (size_t j = 0; j < x.size(); j++)
+            u[j] = x[j];
+
+        CppAD::Independent(u);
+
+        std::vector<ADCGD> y(2);
+        y[0] = cos(u[0]) * u[1];
+        y[1] = u[1] * u[1] + 2;
+
+        return new ADFun<CGD>(u, y);
+    }
+
+};
+
+/**
+ * Counts the number of started and finished jobs
+ */
+class CountingJobListener : public JobListener {
+public:
+    std::atomic<size_t> started{0};
+    std::atomic<size_t> ended{0};
+
+    void jobStarted(const std::vector<Job>& job) override {
+        started++;
+    }
+
+    void jobEndended(const std::vector<Job>& job,
+                     duration elapsed) override {
+        ended++;
+    }
+};
+
+/**
+ * Requests a cancellation when a nested job starts
+ */
+class CancellingJobListener : public JobListener {
+public:
+    JobTimer& timer;
+    bool cancelled;
+
+    explicit CancellingJobListener(JobTimer& t) :
+        timer(t),
+        cancelled(false) {
+    }
+
+    void jobStarted(const std::vector<Job>& job) override {
+        if (job.size() > 1 && !cancelled) {
+            timer.requestCancel();
+            cancelled = true;
+        }
+    }
+
+    void jobEndended(const std::vector<Job>& job,
+                     duration elapsed) override {
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGDynamicAsyncTest, DynamicLibrary) {
+    ModelCSourceGen<double> cgen(*_fun, _modelName);
+    cgen.setCreateSparseJacobian(true);
+
+    ModelLibraryCSourceGen<double> libcgen(cgen);
+    CountingJobListener listener;
+    libcgen.addListener(listener);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+
+    DynamicModelLibraryProcessor<double> p(libcgen, "cppadcg_async_lib");
+
+    std::future<std::unique_ptr<DynamicLib<double>>> future = p.createDynamicLibraryAsync(compiler);
+
+    // the caller can keep using CppAD (with other tapes) while the library is prepared
+    std::vector<CGD> xOrig(x.begin(), x.end());
+    std::vector<CGD> jacOrig = _fun2->SparseJacobian(xOrig);
+
+    std::unique_ptr<DynamicLib<double>> dynamicLib = future.get();
+    ASSERT_TRUE(dynamicLib != nullptr);
+
+    std::unique_ptr<GenericModel<double>> model = dynamicLib->model(_modelName);
+    std::vector<double> jacCG = model->SparseJacobian(x);
+
+    ASSERT_TRUE(compareValues(jacCG, jacOrig));
+
+    ASSERT_GT(listener.started, 0u);
+    ASSERT_EQ(listener.started, listener.ended);
+}
+
+TEST_F(CppADCGDynamicAsyncTest, DynamicLibraryTwice) {
+    ModelCSourceGen<double> cgen(*_fun, _modelName);
+    cgen.setCreateSparseJacobian(true);
+
+    ModelLibraryCSourceGen<double> libcgen(cgen);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+
+    std::vector<CGD> xOrig(x.begin(), x.end());
+    std::vector<CGD> jacOrig = _fun->SparseJacobian(xOrig);
+
+    for (size_t i = 0; i < 2; ++i) {
+        DynamicModelLibraryProcessor<double> p(libcgen, "cppadcg_async_twice_lib" + std::to_string(i));
+
+        auto future = p.createDynamicLibraryAsync(compiler);
+
+        // the caller keeps using CppAD while the library is prepared
+        std::vector<CGD> jac2 = _fun2->SparseJacobian(xOrig);
+        ASSERT_EQ(jacOrig.size(), jac2.size());
+
+        std::unique_ptr<DynamicLib<double>> dynamicLib = future.get();
+        ASSERT_TRUE(dynamicLib != nullptr);
+
+        // CppAD is back in sequential mode
+        ASSERT_EQ(1u, CppAD::thread_alloc::num_threads());
+        ASSERT_FALSE(CppAD::thread_alloc::in_parallel());
+
+        std::unique_ptr<GenericModel<double>> model = dynamicLib->model(_modelName);
+        std::vector<double> jacCG = model->SparseJacobian(x);
+        ASSERT_TRUE(compareValues(jacCG, jacOrig));
+
+        // the original tape is still owned by the calling thread
+        std::vector<CGD> jac = _fun->SparseJacobian(xOrig);
+        ASSERT_EQ(jacOrig.size(), jac.size());
+    }
+}
+
+TEST_F(CppADCGDynamicAsyncTest, Cancel) {
+    ModelCSourceGen<double> cgen(*_fun, _modelName);
+    cgen.setCreateSparseJacobian(true);
+
+    ModelLibraryCSourceGen<double> libcgen(cgen);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+
+    DynamicModelLibraryProcessor<double> p(libcgen, "cppadcg_async_cancel_lib");
+
+    libcgen.requestCancel();
+    auto future = p.createDynamicLibraryAsync(compiler);
+
+    ASSERT_THROW(future.get(), CGException);
+}
+
+TEST_F(CppADCGDynamicAsyncTest, CancelRunningJobs) {
+    ModelCSourceGen<double> cgen(*_fun, _modelName);
+    cgen.setCreateSparseJacobian(true);
+
+    ModelLibraryCSourceGen<double> libcgen(cgen);
+    CancellingJobListener listener(libcgen);
+    libcgen.addListener(listener);
+
+    GccCompiler<double> compiler;
+    prepareTestCompilerFlags(compiler);
+
+    DynamicModelLibraryProcessor<double> p(libcgen, "cppadcg_async_cancel_running_lib");
+
+    auto future = p.createDynamicLibraryAsync(compiler);
+
+    ASSERT_THROW(future.get(), CGException);
+    ASSERT_TRUE(listener.cancelled);
+
+    // the jobs which were running when the task was cancelled are discarded
+    ASSERT_EQ(0u, libcgen.getJobCount());
+}
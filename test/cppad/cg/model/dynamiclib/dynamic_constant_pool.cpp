@@ -0,0 +1,147 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGDynamicTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Constant values saved in a static array of each source file
+ */
+class CppADCGDynamicConstantPoolTest : public CppADCGDynamicTest {
+public:
+
+    explicit CppADCGDynamicConstantPoolTest(bool verbose = false, bool printValues = false) :
+            CppADCGDynamicTest("dynamic_constant_pool", verbose, printValues) {
+        // independent variables
+        _xTape = {1, 1, 1, 1, 1};
+        _xRun = {1.5, 0.5, 2.0, 1.2, 0.8};
+        _maxAssignPerFunc = 20;
+        _constantPool = true;
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& x) override {
+        return constantModel(x, 4);
+    }
+
+    /**
+     * A model where the same constants are used many times
+     */
+    static std::vector<ADCGD> constantModel(const std::vector<ADCGD>& x,
+                                            size_t m) {
+        const double c[] = {0.12345678901234566, 1.4142135623730951, 2.7182818284590451, 0.57721566490153287};
+        size_t n = x.size();
+
+        std::vector<ADCGD> y(m);
+        for (size_t i = 0; i < m; ++i) {
+            ADCGD a = x[i % n] * c[i % 4] + x[(i + 1) % n] * c[(i + 1) % 4];
+            y[i] = sin(a) * c[(i + 2) % 4] + a * a * c[(i + 3) % 4] - 3.0;
+        }
+        return y;
+    }
+
+    /**
+     * Counts the number of characters in the source files
+     */
+    class SourceSizeSink : public SourceSink {
+    public:
+        size_t size = 0;
+
+        void addSource(const std::string& filename,
+                       std::string&& source) override {
+            size += source.size();
+        }
+    };
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGDynamicConstantPoolTest, ForwardZero) {
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGDynamicConstantPoolTest, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGDynamicConstantPoolTest, Hessian) {
+    this->testHessian();
+}
+
+/**
+ * The constant pool produces smaller sources with the same results
+ */
+TEST_F(CppADCGDynamicConstantPoolTest, SameResults) {
+    const size_t n = 5;
+    const size_t m = 40;
+
+    std::vector<double> xv(n);
+    for (size_t j = 0; j < n; ++j)
+        xv[j] = 0.1 * j;
+
+    std::vector<double> yRef;
+    size_t sizeRef = 0;
+
+    for (bool pool : {false, true}) {
+        std::string name = pool ? "cpool_on" : "cpool_off";
+
+        std::vector<ADCGD> u(n);
+        for (size_t j = 0; j < n; j++)
+            u[j] = xv[j];
+        CppAD::Independent(u);
+        std::vector<ADCGD> v = constantModel(u, m);
+        ADFun<CGD> fun(u, v);
+
+        ModelCSourceGen<double> modelSourceGen(fun, name);
+        modelSourceGen.setCreateForwardZero(true);
+        modelSourceGen.setRoundTripParameters(true);
+        modelSourceGen.setConstantPool(pool);
+
+        ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+
+        SourceSizeSink sizeSink;
+        libSourceGen.generateSources(sizeSink);
+
+        GccCompiler<double> compiler;
+        prepareTestCompilerFlags(compiler);
+        DynamicModelLibraryProcessor<double> p(libSourceGen, "cppadcg_" + name);
+        std::unique_ptr<DynamicLib<double>> dynamicLib = p.createDynamicLibrary(compiler);
+
+        std::unique_ptr<GenericModel<double>> model = dynamicLib->model(name);
+        ASSERT_TRUE(model != nullptr);
+
+        std::vector<double> yv(m);
+        model->ForwardZero(xv, yv);
+
+        if (this->verbose_) {
+            std::cout << (pool ? "constant pool:    " : "inline constants: ")
+                      << sizeSink.size << " characters" << std::endl;
+        }
+
+        if (yRef.empty()) {
+            yRef = yv;
+            sizeRef = sizeSink.size;
+        } else {
+            ASSERT_LT(sizeSink.size, sizeRef);
+            for (size_t i = 0; i < m; ++i) {
+                ASSERT_TRUE(nearEqual(yRef[i], yv[i], 1e-14, 1e-14));
+            }
+        }
+    }
+}
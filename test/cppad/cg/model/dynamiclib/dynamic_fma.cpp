@@ -0,0 +1,72 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGDynamicTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Source code generation with explicit fused multiply-add operations
+ */
+class CppADCGDynamicFmaTest : public CppADCGDynamicTest {
+public:
+
+    explicit CppADCGDynamicFmaTest(bool verbose = false, bool printValues = false) :
+            CppADCGDynamicTest("dynamic_fma", verbose, printValues) {
+        // independent variables
+        _xTape = {1, 1, 1, 1};
+        _xRun = {1.5, 0.5, 2.0, 0.8};
+        _fusedMultiplyAdd = FusedMultiplyAdd::Deterministic;
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& x) override {
+        std::vector<ADCGD> y(3);
+
+        ADCGD r1 = 2.0 * x[0] * x[1];
+        ADCGD r2 = 0.5 * x[2] * x[2] * x[3];
+        y[0] = x[0] * x[3] - r1 + r2;
+        y[1] = r1 - r2 * x[1] + exp(x[2]) * x[0];
+        y[2] = x[1] * x[2] + x[3] * x[0] - 3.0 * r1 * r2;
+
+        return y;
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGDynamicFmaTest, ForwardZero) {
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGDynamicFmaTest, DenseJacobian) {
+    this->testDenseJacobian();
+}
+
+TEST_F(CppADCGDynamicFmaTest, DenseHessian) {
+    this->testDenseHessian();
+}
+
+TEST_F(CppADCGDynamicFmaTest, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGDynamicFmaTest, Hessian) {
+    this->testHessian();
+}
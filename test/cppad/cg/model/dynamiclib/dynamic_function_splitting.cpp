@@ -0,0 +1,84 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGDynamicTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Source code split into several functions using the cost model
+ */
+class CppADCGDynamicFunctionSplittingTest : public CppADCGDynamicTest {
+public:
+
+    explicit CppADCGDynamicFunctionSplittingTest(bool verbose = false, bool printValues = false) :
+            CppADCGDynamicTest("dynamic_function_splitting", verbose, printValues) {
+        // independent variables
+        _xTape = std::vector<double>(10, 1.0);
+        _xRun = {1.5, 0.5, 2.0, 1.2, 0.8, 0.3, 1.1, 0.7, 1.9, 0.4};
+        _automaticFunctionSplitting = true;
+        // small functions
+        _functionSplitCost.compileScale = 20;
+        _functionSplitCost.compileWeight = 1;
+        _functionSplitCost.callCost = 5;
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& x) override {
+        size_t n = x.size();
+        std::vector<ADCGD> y(n);
+
+        ADCGD s = x[0];
+        for (size_t i = 0; i < n; ++i) {
+            ADCGD t = sin(x[i]) * x[(i + 1) % n];
+            s = s * 0.5 + t;
+            y[i] = s + t * t;
+        }
+
+        return y;
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGDynamicFunctionSplittingTest, ForwardZero) {
+    bool split = false;
+    for (const auto& it : _functionPartitions) {
+        split |= it.second.size() > 1;
+    }
+    ASSERT_TRUE(split);
+
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGDynamicFunctionSplittingTest, DenseJacobian) {
+    this->testDenseJacobian();
+}
+
+TEST_F(CppADCGDynamicFunctionSplittingTest, DenseHessian) {
+    this->testDenseHessian();
+}
+
+TEST_F(CppADCGDynamicFunctionSplittingTest, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGDynamicFunctionSplittingTest, Hessian) {
+    this->testHessian();
+}
@@ -0,0 +1,107 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGDynamicTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Source code generation with cheaper forms of mathematical functions
+ */
+class CppADCGDynamicMathLoweringTest : public CppADCGDynamicTest {
+public:
+
+    explicit CppADCGDynamicMathLoweringTest(bool verbose = false, bool printValues = false) :
+            CppADCGDynamicTest("dynamic_math_lowering", verbose, printValues) {
+        // independent variables
+        _xTape = {1, 1, 1, 1};
+        _xRun = {1.5, 0.5, 1.2, 0.8};
+        _mathLowering = true;
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& x) override {
+        std::vector<ADCGD> y(5);
+
+        ADCGD a = x[0] * x[1];
+        ADCGD logT = log(x[2]);
+        y[0] = pow(x[0], 2.0) * pow(x[1], 3.0) + pow(x[2], 0.5) / pow(x[3], -1.5);
+        y[1] = sin(a) * x[2] + cos(a) * x[3];
+        y[2] = exp(x[3]) * (1 + cosh(x[3]));
+        y[3] = sinh(x[1]) + tanh(x[1]) * cosh(x[1]);
+        y[4] = pow(x[2], x[3]) * logT + pow(x[2], 1.7) + logT * x[0];
+
+        return y;
+    }
+
+};
+
+/**
+ * Lowering with arguments for which other forms overflow or are undefined
+ */
+class CppADCGDynamicMathLoweringLimitsTest : public CppADCGDynamicTest {
+public:
+
+    explicit CppADCGDynamicMathLoweringLimitsTest(bool verbose = false, bool printValues = false) :
+            CppADCGDynamicTest("dynamic_math_lowering_limits", verbose, printValues) {
+        // independent variables
+        _xTape = {400, -400, -2, 2};
+        _xRun = {400, -400, -2, 2};
+        _mathLowering = true;
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& x) override {
+        std::vector<ADCGD> y(3);
+
+        ADCGD logB = log(x[2]);
+        // sinh(x)^2 overflows
+        y[0] = 1e-170 * (sinh(x[0]) + tanh(x[0]) * cosh(x[0]));
+        y[1] = 1e-170 * (cosh(x[1]) + 1 / exp(x[1]));
+        // log(x[2]) is not used by the dependents for a negative base
+        y[2] = pow(x[2], x[3]) + CondExpLt(x[2], ADCGD(0), x[3], logB * logB);
+
+        return y;
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGDynamicMathLoweringTest, ForwardZero) {
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGDynamicMathLoweringTest, DenseJacobian) {
+    this->testDenseJacobian();
+}
+
+TEST_F(CppADCGDynamicMathLoweringTest, DenseHessian) {
+    this->testDenseHessian();
+}
+
+TEST_F(CppADCGDynamicMathLoweringTest, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGDynamicMathLoweringTest, Hessian) {
+    this->testHessian();
+}
+
+TEST_F(CppADCGDynamicMathLoweringLimitsTest, ForwardZero) {
+    this->testForwardZero();
+}
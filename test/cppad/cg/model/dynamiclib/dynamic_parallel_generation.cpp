@@ -0,0 +1,123 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGDynamicTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Keeps the generated sources in memory
+ */
+class MapSourceSink : public SourceSink {
+public:
+    std::map<std::string, std::string> sources;
+
+    void addSource(const std::string& filename,
+                   std::string&& source) override {
+        ASSERT_TRUE(sources.find(filename) == sources.end());
+        sources[filename] = std::move(source);
+    }
+};
+
+/**
+ * Source code generation of the model functions using several threads
+ */
+class CppADCGDynamicParallelGenTest : public CppADCGDynamicTest {
+public:
+
+    explicit CppADCGDynamicParallelGenTest(bool verbose = false, bool printValues = false) :
+            CppADCGDynamicTest("dynamic_parallel_generation", verbose, printValues) {
+        // independent variables
+        _xTape = {1, 1, 1, 1, 1};
+        _xRun = {1.5, 0.5, 2.0, 1.2, 0.8};
+        _maxAssignPerFunc = 20;
+        _generationThreads = 4;
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& x) override {
+        std::vector<ADCGD> y(4);
+
+        ADCGD a = x[0] * x[1];
+        y[0] = sin(a) + x[2] * x[2];
+        y[1] = exp(x[1]) / (1 + x[3] * x[3]);
+        y[2] = a * log(x[4]) - cos(x[2] * x[3]);
+        y[3] = x[4] * x[4] * x[4] + 2 * x[0];
+
+        return y;
+    }
+
+    /**
+     * Generates the sources of the model with a given number of threads
+     */
+    std::map<std::string, std::string> generateSources(size_t threads) {
+        ModelCSourceGen<double> modelSourceGen(*_fun, _name + "sources");
+        modelSourceGen.setCreateForwardZero(true);
+        modelSourceGen.setCreateJacobian(true);
+        modelSourceGen.setCreateHessian(true);
+        modelSourceGen.setCreateSparseJacobian(true);
+        modelSourceGen.setCreateSparseHessian(true);
+        modelSourceGen.setCreateForwardOne(true);
+        modelSourceGen.setCreateReverseOne(true);
+        modelSourceGen.setCreateReverseTwo(true);
+        modelSourceGen.setMaxAssignmentsPerFunc(_maxAssignPerFunc);
+        modelSourceGen.setGenerationThreads(threads);
+
+        ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+
+        MapSourceSink sink;
+        libSourceGen.generateSources(sink);
+        return sink.sources;
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGDynamicParallelGenTest, ForwardZero) {
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGDynamicParallelGenTest, DenseJacobian) {
+    this->testDenseJacobian();
+}
+
+TEST_F(CppADCGDynamicParallelGenTest, DenseHessian) {
+    this->testDenseHessian();
+}
+
+TEST_F(CppADCGDynamicParallelGenTest, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGDynamicParallelGenTest, Hessian) {
+    this->testHessian();
+}
+
+TEST_F(CppADCGDynamicParallelGenTest, DeterministicSources) {
+    std::map<std::string, std::string> sequential = generateSources(1);
+    std::map<std::string, std::string> parallel = generateSources(_generationThreads);
+
+    ASSERT_FALSE(sequential.empty());
+    ASSERT_EQ(sequential.size(), parallel.size());
+    for (const auto& it : sequential) {
+        auto itp = parallel.find(it.first);
+        ASSERT_TRUE(itp != parallel.end()) << it.first;
+        ASSERT_EQ(it.second, itp->second) << it.first;
+    }
+}
@@ -0,0 +1,96 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGDynamicTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Compilation of each source file as soon as it is generated
+ * (sources are not kept in memory)
+ */
+class CppADCGDynamicStreamSourcesTest : public CppADCGDynamicTest {
+public:
+
+    explicit CppADCGDynamicStreamSourcesTest(bool verbose = false, bool printValues = false) :
+            CppADCGDynamicTest("dynamic_stream_sources", verbose, printValues) {
+        // independent variables
+        _xTape = {1, 1, 1, 1, 1};
+        _xRun = {1.5, 0.5, 2.0, 1.2, 0.8};
+        _maxAssignPerFunc = 20;
+        _generationThreads = 4;
+        _forwardOne = true;
+        _reverseOne = true;
+        _reverseTwo = true;
+        _streamSources = true;
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& x) override {
+        std::vector<ADCGD> y(4);
+
+        ADCGD a = x[0] * x[1];
+        y[0] = sin(a) + x[2] * x[2];
+        y[1] = exp(x[1]) / (1 + x[3] * x[3]);
+        y[2] = a * log(x[4]) - cos(x[2] * x[3]);
+        y[3] = x[4] * x[4] * x[4] + 2 * x[0];
+
+        return y;
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGDynamicStreamSourcesTest, ForwardZero) {
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGDynamicStreamSourcesTest, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGDynamicStreamSourcesTest, Hessian) {
+    this->testHessian();
+}
+
+TEST_F(CppADCGDynamicStreamSourcesTest, SaveFiles) {
+    std::vector<ADCGD> u(_xTape.size());
+    for (size_t i = 0; i < u.size(); i++)
+        u[i] = _xTape[i];
+    CppAD::Independent(u);
+    std::vector<ADCGD> v = model(u);
+    ADFun<CGD> fun(u, v);
+
+    ModelCSourceGen<double> modelSourceGen(fun, "stream_save");
+    modelSourceGen.setCreateSparseJacobian(true);
+    modelSourceGen.setMaxAssignmentsPerFunc(_maxAssignPerFunc);
+    modelSourceGen.setGenerationThreads(_generationThreads);
+
+    ModelLibraryCSourceGen<double> libSourceGen(modelSourceGen);
+
+    SaveFilesModelLibraryProcessor<double> p(libSourceGen);
+    p.setStreamSources(true);
+    p.saveSourcesTo("sources_stream_save");
+
+    std::ifstream forwardZero("sources_stream_save/stream_save_forward_zero.c");
+    ASSERT_TRUE(forwardZero.good());
+
+    // the sources were not kept in memory
+    ASSERT_THROW(p.saveSourcesTo("sources_stream_save"), CGException);
+}
@@ -0,0 +1,101 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGDynamicTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Source code generation with the temporary arrays in a workspace provided
+ * by the caller
+ */
+class CppADCGDynamicWorkspaceTest : public CppADCGDynamicTest {
+public:
+
+    explicit CppADCGDynamicWorkspaceTest(bool verbose = false, bool printValues = false) :
+            CppADCGDynamicTest("dynamic_workspace", verbose, printValues) {
+        // independent variables
+        _xTape = {1, 1, 1, 1};
+        _xRun = {1.5, 0.5, 2.0, 0.8};
+        _maxAssignPerFunc = 5; // the temporary arrays are shared by several functions
+        _temporaryWorkspace = true;
+    }
+
+    std::vector<ADCGD> model(const std::vector<ADCGD>& x) override {
+        std::vector<ADCGD> y(4);
+
+        ADCGD r1 = 2.0 * x[0] * x[1];
+        ADCGD r2 = 0.5 * x[2] * x[2] * x[3];
+        y[0] = x[0] * x[3] - r1 + r2;
+        y[1] = r1 - r2 * x[1] + exp(x[2]) * x[0];
+        y[2] = x[1] * x[2] + x[3] * x[0] - 3.0 * r1 * r2;
+        y[3] = sin(r1) * cos(r2) + log(x[0] + x[3]) * y[2];
+
+        return y;
+    }
+
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+TEST_F(CppADCGDynamicWorkspaceTest, ForwardZero) {
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGDynamicWorkspaceTest, DenseJacobian) {
+    this->testDenseJacobian();
+}
+
+TEST_F(CppADCGDynamicWorkspaceTest, DenseHessian) {
+    this->testDenseHessian();
+}
+
+TEST_F(CppADCGDynamicWorkspaceTest, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGDynamicWorkspaceTest, Hessian) {
+    this->testHessian();
+}
+
+TEST_F(CppADCGDynamicWorkspaceTest, UserWorkspace) {
+    size_t size = _model->getWorkspaceSize();
+    ASSERT_GT(size, 0u);
+    ASSERT_EQ(0u, size % LanguageC<double>::WORKSPACE_ALIGNMENT);
+
+    std::vector<char> memory(size + 2 * LanguageC<double>::WORKSPACE_ALIGNMENT);
+    void* workspace = memory.data();
+    size_t space = memory.size();
+    ASSERT_TRUE(std::align(LanguageC<double>::WORKSPACE_ALIGNMENT, size, workspace, space) != nullptr);
+
+    ASSERT_THROW(_model->setWorkspace(static_cast<char*>(workspace) + 8, size), CGException);
+
+    _model->setWorkspace(workspace, size);
+    this->testForwardZero();
+    this->testJacobian();
+    this->testHessian();
+
+    // too small
+    _model->setWorkspace(workspace, size - LanguageC<double>::WORKSPACE_ALIGNMENT);
+    ASSERT_THROW(_model->ForwardZero(_xRun), CGException);
+
+    // back to an internal workspace
+    _model->setWorkspace(nullptr, 0);
+    this->testForwardZero();
+}
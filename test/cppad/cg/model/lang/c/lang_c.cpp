@@ -137,4 +137,224 @@ TEST_F(CppADCGTestLangC, maxOperationPerAssign1) {
     testNumberOfSources(2u,
                         1u,
                         11u);
-}
\ No newline at end of file
+}
+TEST_F(CppADCGTestLangC, mathLowering) {
+    CodeHandler<double> handler;
+
+    std::vector<CGD> x(3);
+    handler.makeVariables(x);
+
+    CGD a = x[0] * x[1];
+    CGD s = sin(a);
+    CGD c = cos(a);
+    CGD e = exp(x[2]);
+    CGD l = log(x[0]);
+
+    CGD h = cosh(x[1]);
+    CGD lh = log(h);
+
+    std::vector<CGD> y(6);
+    y[0] = s + c;
+    y[1] = s * c;
+    y[2] = pow(x[0], 3.0) / pow(x[1], -0.5);
+    y[3] = e + cosh(x[2]) * e;
+    y[4] = pow(x[0], x[2]) * l + l + a; // the base can be negative
+    y[5] = pow(h, x[2]) * lh + lh;
+
+    LanguageC<double> langC("double");
+    langC.setMathLowering(true);
+    LangCDefaultVariableNameGenerator<double> nameGen;
+
+    std::ostringstream code;
+    handler.generateCode(code, langC, y, nameGen);
+
+    if (this->verbose_) {
+        std::cout << code.str();
+    }
+
+    std::string src = code.str();
+    ASSERT_NE(std::string::npos, src.find("__builtin_sincos("));
+    ASSERT_NE(std::string::npos, src.find("(x[0] * x[0] * x[0])"));
+    ASSERT_NE(std::string::npos, src.find("(1 / sqrt(x[1]))"));
+    ASSERT_NE(std::string::npos, src.find("pow(x[0], x[2])"));
+    ASSERT_EQ(src.find("pow("), src.rfind("pow("));
+    ASSERT_EQ(std::string::npos, src.find("cosh(x[2])"));
+    ASSERT_EQ(std::string::npos, src.find("sqrt(1 +"));
+}
+
+TEST_F(CppADCGTestLangC, fusedMultiplyAdd) {
+    CodeHandler<double> handler;
+
+    std::vector<CGD> x(3);
+    handler.makeVariables(x);
+
+    std::vector<CGD> y(3);
+    y[0] = x[0] * x[1] + x[2];
+    y[1] = x[2] - x[0] * x[1];
+    y[2] = x[0] * x[2] - 2.0;
+
+    LanguageC<double> langC("double");
+    langC.setFusedMultiplyAdd(FusedMultiplyAdd::Deterministic);
+    langC.setGenerateFunction("fma_model");
+    LangCDefaultVariableNameGenerator<double> nameGen;
+
+    std::ostringstream code;
+    handler.generateCode(code, langC, y, nameGen);
+
+    if (this->verbose_) {
+        std::cout << code.str();
+    }
+
+    std::string src = code.str();
+    ASSERT_NE(std::string::npos, src.find("fma(x[0], x[1], x[2])"));
+    ASSERT_NE(std::string::npos, src.find("fma(-x[0], x[1], x[2])"));
+    ASSERT_NE(std::string::npos, src.find("fma(x[0], x[2], -2.)"));
+    ASSERT_NE(std::string::npos, src.find("fp-contract=off"));
+}
+
+TEST_F(CppADCGTestLangC, automaticFunctionSplitting) {
+    const size_t n = 200;
+
+    CodeHandler<double> handler;
+
+    std::vector<CGD> x(n);
+    handler.makeVariables(x);
+
+    std::vector<CGD> y(n);
+    CGD s = x[0];
+    for (size_t i = 0; i < n; ++i) {
+        CGD t = sin(x[i]) * x[(i + 1) % n];
+        s = s * 0.5 + t;
+        y[i] = s + t * t;
+    }
+
+    LanguageC<double> langC("double");
+    LanguageC<double>::FunctionSplitCostModel cost;
+    cost.compileScale = 100; // compilation cost per operation doubles for 100 operations
+    cost.compileWeight = 1;
+    cost.callCost = 10;
+    langC.setFunctionSplitCostModel(cost);
+    langC.setAutomaticFunctionSplitting(true);
+
+    std::map<std::string, std::string> sources;
+    langC.setMaxAssignmentsPerFunction(0, &sources);
+    langC.setGenerateFunction("auto_split");
+    LangCDefaultVariableNameGenerator<double> nameGen;
+
+    std::ostringstream code;
+    handler.generateCode(code, langC, y, nameGen);
+
+    if (this->verbose_) {
+        printSources(sources);
+    }
+
+    const auto& partition = langC.getFunctionPartition();
+    ASSERT_GT(partition.size(), 1u);
+    ASSERT_EQ(partition.size() + 1, sources.size()); // the wrapper function calls all the others
+
+    ASSERT_EQ(0u, partition.front().begin);
+    for (size_t c = 1; c < partition.size(); ++c) {
+        ASSERT_EQ(partition[c - 1].end, partition[c].begin);
+        ASSERT_GT(partition[c].operations, 0u);
+        ASSERT_LT(partition[c].operations, 1000u);
+    }
+    ASSERT_EQ(0u, partition.back().liveOut);
+
+    /**
+     * a very expensive function call should not split the code
+     */
+    CodeHandler<double> handler2;
+    std::vector<CGD> x2(n);
+    handler2.makeVariables(x2);
+    std::vector<CGD> y2(n);
+    for (size_t i = 0; i < n; ++i) {
+        y2[i] = sin(x2[i]) * x2[(i + 1) % n];
+    }
+
+    LanguageC<double> langC2("double");
+    cost.callCost = 1e9;
+    langC2.setFunctionSplitCostModel(cost);
+    langC2.setAutomaticFunctionSplitting(true);
+    sources.clear();
+    langC2.setMaxAssignmentsPerFunction(0, &sources);
+    langC2.setGenerateFunction("auto_split");
+    LangCDefaultVariableNameGenerator<double> nameGen2;
+
+    std::ostringstream code2;
+    handler2.generateCode(code2, langC2, y2, nameGen2);
+
+    ASSERT_EQ(1u, langC2.getFunctionPartition().size());
+    ASSERT_EQ(1u, sources.size());
+}
+
+TEST_F(CppADCGTestLangC, roundTripParameters) {
+    CodeHandler<double> handler;
+
+    std::vector<CGD> x(1);
+    handler.makeVariables(x);
+
+    std::vector<CGD> y(3);
+    y[0] = x[0] * (CGD(0.1) + CGD(0.2)); // 0.30000000000000004
+    y[1] = x[0] + 0.1;
+    y[2] = x[0] * 2.0;
+
+    auto generate = [&](bool roundTrip) {
+        LanguageC<double> langC("double");
+        langC.setRoundTripParameters(roundTrip);
+        LangCDefaultVariableNameGenerator<double> nameGen;
+
+        std::ostringstream code;
+        handler.generateCode(code, langC, y, nameGen);
+
+        if (this->verbose_) {
+            std::cout << code.str();
+        }
+        return code.str();
+    };
+
+    std::string src = generate(false);
+    ASSERT_EQ(std::string::npos, src.find("0.30000000000000004"));
+    ASSERT_NE(std::string::npos, src.find("0.3"));
+    ASSERT_NE(std::string::npos, src.find("0.1"));
+    ASSERT_NE(std::string::npos, src.find("2."));
+
+    src = generate(true);
+    ASSERT_NE(std::string::npos, src.find("0.30000000000000004"));
+    ASSERT_NE(std::string::npos, src.find("0.1;"));
+    ASSERT_EQ(std::string::npos, src.find("0.10000000000000001"));
+    ASSERT_NE(std::string::npos, src.find("2."));
+}
+
+TEST_F(CppADCGTestLangC, constantPool) {
+    CodeHandler<double> handler;
+
+    std::vector<CGD> x(3);
+    handler.makeVariables(x);
+
+    std::vector<CGD> y(3);
+    for (size_t i = 0; i < y.size(); ++i) {
+        y[i] = x[i] * 1.4142135623730951 + x[(i + 1) % 3] * 0.5 - 1.4142135623730951;
+    }
+
+    LanguageC<double> langC("double");
+    langC.setConstantPool(true);
+    langC.setRoundTripParameters(true);
+    langC.setGenerateFunction("pool_model");
+    LangCDefaultVariableNameGenerator<double> nameGen;
+
+    std::ostringstream code;
+    handler.generateCode(code, langC, y, nameGen);
+
+    if (this->verbose_) {
+        std::cout << code.str();
+    }
+
+    std::string src = code.str();
+    ASSERT_EQ(1u, langC.getConstantPool().size()); // 0.5 is shorter than a reference
+    ASSERT_NE(std::string::npos, src.find("static const double cst[1] = {"));
+    size_t first = src.find("1.4142135623730951");
+    ASSERT_NE(std::string::npos, first);
+    ASSERT_EQ(std::string::npos, src.find("1.4142135623730951", first + 1)); // only in the pool
+    ASSERT_NE(std::string::npos, src.find("cst[0]"));
+    ASSERT_NE(std::string::npos, src.find("0.5"));
+}
@@ -0,0 +1,186 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include <atomic>
+#include <thread>
+
+#include "ThreadPoolTest.hpp"
+
+using namespace CppAD::cg;
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * A simple executor which runs each batch of jobs in a few new threads
+ */
+class TestExecutor {
+public:
+    static const int WORKERS = 3;
+    std::atomic<int> submittedJobs{0};
+    std::atomic<int> batches{0};
+private:
+    static thread_local int workerId_;
+
+    struct Batch {
+        std::vector<std::thread> threads;
+    };
+public:
+
+    ThreadPoolExecutor callbacks() {
+        return ThreadPoolExecutor{this, &submit, &wait, &getWorkers, &getWorkerId};
+    }
+
+private:
+
+    static void* submit(void* data,
+                        const ThreadPoolExecutorJob jobs[],
+                        int nJobs) {
+        auto* executor = static_cast<TestExecutor*>(data);
+        executor->submittedJobs += nJobs;
+        executor->batches++;
+
+        auto* batch = new Batch();
+        int nThreads = std::min(nJobs, WORKERS);
+        for (int t = 0; t < nThreads; ++t) {
+            batch->threads.emplace_back([=]() {
+                workerId_ = t;
+                for (int j = t; j < nJobs; j += nThreads) {
+                    (*jobs[j].function)(jobs[j].arg);
+                }
+            });
+        }
+        return batch;
+    }
+
+    static void wait(void* data,
+                     void* handle) {
+        auto* batch = static_cast<Batch*>(handle);
+        for (auto& t : batch->threads) {
+            t.join();
+        }
+        delete batch;
+    }
+
+    static int getWorkers(void* data) {
+        return WORKERS;
+    }
+
+    static int getWorkerId(void* data) {
+        return workerId_;
+    }
+};
+
+thread_local int TestExecutor::workerId_ = 0;
+
+class CppADCGThreadPoolExecutorTest : public ThreadPoolTest {
+protected:
+    TestExecutor _executor;
+public:
+    explicit CppADCGThreadPoolExecutorTest() :
+            ThreadPoolTest(MultiThreadingType::EXECUTOR) {
+        this->_multithreadDisabled = false;
+        this->_temporaryWorkspace = true;
+    }
+
+    void SetUp() override {
+        ThreadPoolTest::SetUp();
+
+        ThreadPoolExecutor callbacks = _executor.callbacks();
+        ASSERT_TRUE(_dynamicLib->setThreadPoolExecutor(&callbacks));
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+TEST_F(CppADCGThreadPoolExecutorTest, ForwardZero) {
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGThreadPoolExecutorTest, Jacobian) {
+    this->testJacobian();
+
+    ASSERT_GT(_executor.batches.load(), 0);
+    ASSERT_GE(_executor.submittedJobs.load(), _executor.batches.load());
+}
+
+TEST_F(CppADCGThreadPoolExecutorTest, Hessian) {
+    this->testHessian();
+
+    ASSERT_GT(_executor.batches.load(), 0);
+}
+
+TEST_F(CppADCGThreadPoolExecutorTest, ConcurrentEvaluation) {
+    const size_t nThreads = 4;
+    const size_t nEvaluations = 25; // more than the number of time measurements
+
+    std::vector<double> jacRef = _model->SparseJacobian(_xRun);
+    std::vector<double> hessRef = _model->SparseHessian(_xRun, std::vector<double>(_model->Range(), 1.0));
+
+    // each thread uses its own model object
+    std::vector<std::unique_ptr<GenericModel<double>>> models(nThreads);
+    for (auto& m : models) {
+        m = _dynamicLib->model(_name + "dynamic");
+        ASSERT_TRUE(m != nullptr);
+    }
+
+    auto equal = [](const std::vector<double>& a, const std::vector<double>& b) {
+        if (a.size() != b.size())
+            return false;
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (!CppAD::NearEqual(a[i], b[i], 1e-10, 1e-10))
+                return false;
+        }
+        return true;
+    };
+
+    std::atomic<size_t> mismatches{0};
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < nThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            std::vector<double> w(models[t]->Range(), 1.0);
+            for (size_t e = 0; e < nEvaluations; ++e) {
+                if (!equal(models[t]->SparseJacobian(_xRun), jacRef))
+                    mismatches++;
+                if (!equal(models[t]->SparseHessian(_xRun, w), hessRef))
+                    mismatches++;
+            }
+        });
+    }
+
+    for (auto& th : threads) {
+        th.join();
+    }
+
+    ASSERT_EQ(0u, mismatches.load());
+    ASSERT_GE(_executor.batches.load(), int(2 * nThreads * nEvaluations));
+}
+
+TEST_F(CppADCGThreadPoolExecutorTest, NoExecutor) {
+    // the jobs are evaluated sequentially
+    ASSERT_TRUE(_dynamicLib->setThreadPoolExecutor(nullptr));
+
+    this->testJacobian();
+    this->testHessian();
+
+    ASSERT_EQ(_executor.batches.load(), 0);
+}
+
+TEST_F(CppADCGThreadPoolExecutorTest, InvalidExecutor) {
+    ThreadPoolExecutor callbacks = _executor.callbacks();
+    callbacks.wait = nullptr;
+
+    ASSERT_THROW(_dynamicLib->setThreadPoolExecutor(&callbacks), CGException);
+}
@@ -0,0 +1,68 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "ThreadPoolTest.hpp"
+
+using namespace CppAD::cg;
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * The sparse Jacobian and sparse Hessian are evaluated by groups of
+ * elements instead of the forward/reverse functions
+ */
+class CppADCGThreadPoolPartitionedTest : public ThreadPoolTest {
+public:
+    explicit CppADCGThreadPoolPartitionedTest() :
+            ThreadPoolTest(MultiThreadingType::PTHREADS) {
+        this->_multithreadDisabled = false;
+        this->_multithreadScheduler = ThreadPoolScheduleStrategy::STATIC;
+        this->_multithreadPartitions = 2;
+    }
+};
+
+class CppADCGThreadPoolPartitionedWorkspaceTest : public ThreadPoolTest {
+public:
+    explicit CppADCGThreadPoolPartitionedWorkspaceTest() :
+            ThreadPoolTest(MultiThreadingType::PTHREADS) {
+        this->_multithreadDisabled = false;
+        this->_multithreadScheduler = ThreadPoolScheduleStrategy::DYNAMIC;
+        this->_multithreadPartitions = 3;
+        this->_temporaryWorkspace = true;
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+TEST_F(CppADCGThreadPoolPartitionedTest, ForwardZero) {
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGThreadPoolPartitionedTest, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGThreadPoolPartitionedTest, Hessian) {
+    this->testHessian();
+}
+
+TEST_F(CppADCGThreadPoolPartitionedWorkspaceTest, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGThreadPoolPartitionedWorkspaceTest, Hessian) {
+    this->testHessian();
+}
@@ -158,3 +158,105 @@ TEST_F(CppADCGThreadPoolDynamicCustomTest, Jacobian) {
 TEST_F(CppADCGThreadPoolDynamicCustomTest, Hessian) {
     this->testHessian();
 }
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGThreadPoolLoopsTest : public ThreadPoolTest {
+public:
+    explicit CppADCGThreadPoolLoopsTest() :
+            ThreadPoolTest(MultiThreadingType::PTHREADS) {
+        this->_multithreadDisabled = false;
+        this->_multithreadScheduler = ThreadPoolScheduleStrategy::DYNAMIC;
+
+        // equations in loops
+        _relatedDepCandidates = {{0, 2, 4}, {1, 3, 5}};
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+TEST_F(CppADCGThreadPoolLoopsTest, ForwardZero) {
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGThreadPoolLoopsTest, Jacobian) {
+    this->testJacobian();
+}
+
+TEST_F(CppADCGThreadPoolLoopsTest, Hessian) {
+    this->testHessian();
+}
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGThreadPoolWorkspaceTest : public ThreadPoolTest {
+public:
+    explicit CppADCGThreadPoolWorkspaceTest() :
+            ThreadPoolTest(MultiThreadingType::PTHREADS) {
+        this->_multithreadDisabled = false;
+        this->_multithreadScheduler = ThreadPoolScheduleStrategy::DYNAMIC;
+        this->_temporaryWorkspace = true;
+
+        // equations in loops
+        _relatedDepCandidates = {{0, 2, 4}, {1, 3, 5}};
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+TEST_F(CppADCGThreadPoolWorkspaceTest, ForwardZero) {
+    this->testForwardZero();
+}
+
+TEST_F(CppADCGThreadPoolWorkspaceTest, Jacobian) {
+    // each thread uses its own part of the workspace
+    ASSERT_EQ(0u, _model->getWorkspaceSize() % _dynamicLib->getThreadNumber());
+
+    this->testJacobian();
+}
+
+TEST_F(CppADCGThreadPoolWorkspaceTest, Hessian) {
+    this->testHessian();
+}
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGThreadPoolEwmaTest : public ThreadPoolTest {
+public:
+    explicit CppADCGThreadPoolEwmaTest() :
+            ThreadPoolTest(MultiThreadingType::PTHREADS) {
+        this->_multithreadDisabled = false;
+        this->_multithreadScheduler = ThreadPoolScheduleStrategy::STATIC;
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+TEST_F(CppADCGThreadPoolEwmaTest, Jacobian) {
+    _dynamicLib->setThreadPoolTimeReference(ThreadPoolTimeReference::EWMA);
+    _dynamicLib->setThreadPoolEwmaAlpha(0.5);
+    _dynamicLib->setThreadPoolRebalancePeriod(2);
+    _dynamicLib->resetThreadPoolImbalance();
+
+    ASSERT_EQ(ThreadPoolTimeReference::EWMA, _dynamicLib->getThreadPoolTimeReference());
+    ASSERT_EQ(0.5f, _dynamicLib->getThreadPoolEwmaAlpha());
+    ASSERT_EQ(2u, _dynamicLib->getThreadPoolRebalancePeriod());
+    ASSERT_EQ(0u, _dynamicLib->getThreadPoolNumberOfImbalanceMeas());
+
+    // the job order is updated while the results are compared
+    size_t nTests = 10;
+    this->testSparseJacobianResults(nTests, *_model, *_fun, nullptr, _xRun, false, epsilonR, epsilonA);
+
+    ASSERT_GT(_dynamicLib->getThreadPoolNumberOfImbalanceMeas(), 0u);
+    ASSERT_GE(_dynamicLib->getThreadPoolLastImbalance(), 0.0f);
+    ASSERT_GE(_dynamicLib->getThreadPoolAverageImbalance(), 0.0f);
+
+    _dynamicLib->resetThreadPoolImbalance();
+    ASSERT_EQ(0u, _dynamicLib->getThreadPoolNumberOfImbalanceMeas());
+}
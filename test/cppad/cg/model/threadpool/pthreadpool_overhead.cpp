@@ -0,0 +1,119 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include <atomic>
+#include <chrono>
+#include <cppad/cg/model/threadpool/pthread_pool.h>
+#include "CppADCGTest.hpp"
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Measures the time spent by the thread pool to dispatch and wait for
+ * batches of (almost) empty jobs.
+ */
+class PThreadPoolOverheadTest : public CppADCGTest {
+protected:
+    static const int N_CALLS = 2000;
+    std::vector<std::atomic<int>> counters;
+public:
+
+    inline PThreadPoolOverheadTest() :
+            counters(64) {
+        cppadcg_thpool_set_verbose(0);
+        cppadcg_thpool_set_threads(2);
+        cppadcg_thpool_set_n_time_meas(5);
+    }
+
+    void TearDown() override {
+        cppadcg_thpool_shutdown();
+        cppadcg_thpool_set_spin_time(50e-6f);
+    }
+
+    /**
+     * @return the average time (in microseconds) of each call
+     */
+    double measure(int nJobs) {
+        std::vector<cppadcg_thpool_function_type> functions(nJobs, &count);
+        std::vector<void*> args(nJobs);
+        std::vector<float> avgElapsed(nJobs, 0);
+        std::vector<float> elapsed(nJobs, 0);
+        std::vector<int> order(nJobs);
+        std::vector<int> job2Thread(nJobs, -1);
+
+        for (int j = 0; j < nJobs; ++j) {
+            counters[j] = 0;
+            args[j] = &counters[j];
+            order[j] = j;
+        }
+
+        // warm-up (also defines the job order)
+        unsigned int nMeas = cppadcg_thpool_get_n_time_meas();
+        for (unsigned int i = 0; i < nMeas; ++i) {
+            cppadcg_thpool_add_jobs(functions.data(), args.data(), avgElapsed.data(), elapsed.data(), order.data(), job2Thread.data(), nJobs, 1);
+            cppadcg_thpool_wait();
+            cppadcg_thpool_update_order(avgElapsed.data(), i, elapsed.data(), order.data(), nJobs);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < N_CALLS; ++i) {
+            cppadcg_thpool_add_jobs(functions.data(), args.data(), avgElapsed.data(), nullptr, order.data(), job2Thread.data(), nJobs, 0);
+            cppadcg_thpool_wait();
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        for (int j = 0; j < nJobs; ++j) {
+            EXPECT_EQ(counters[j].load(), N_CALLS + (int) nMeas);
+        }
+
+        return std::chrono::duration<double, std::micro>(end - start).count() / N_CALLS;
+    }
+
+    void measureAll(ScheduleStrategy strategy) {
+        cppadcg_thpool_set_scheduler_strategy(strategy);
+
+        std::cout << "  jobs   spin (us/call)   no spin (us/call)" << std::endl;
+        for (int nJobs = 1; nJobs <= 64; nJobs *= 2) {
+            cppadcg_thpool_set_spin_time(50e-6f);
+            double spin = measure(nJobs);
+            cppadcg_thpool_set_spin_time(0);
+            double noSpin = measure(nJobs);
+
+            std::cout << std::setw(6) << nJobs << std::setw(17) << spin << std::setw(20) << noSpin << std::endl;
+        }
+    }
+
+private:
+    static void count(void* arg) {
+        (*static_cast<std::atomic<int>*>(arg))++;
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+using namespace CppAD::cg;
+
+TEST_F(PThreadPoolOverheadTest, Dynamic) {
+    measureAll(SCHED_DYNAMIC);
+}
+
+TEST_F(PThreadPoolOverheadTest, Guided) {
+    measureAll(SCHED_GUIDED);
+}
+
+TEST_F(PThreadPoolOverheadTest, Static) {
+    measureAll(SCHED_STATIC);
+}
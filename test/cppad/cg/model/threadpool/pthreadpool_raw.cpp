@@ -138,9 +138,9 @@ void pooldynamic_sparse_jacobian(double const* const* in, double* const* out, st
     static int order[6] = {0, 1, 2, 3, 4, 5};
     static int job2Thread[6] = {-1, -1, -1, -1, -1, -1};
     static int lastElapsedChanged = 1;
-    unsigned int nBench = cppadcg_thpool_get_n_time_meas();
     static unsigned int meas = 0;
-    int do_benchmark = (meas < nBench && !cppadcg_thpool_is_disabled());
+    static unsigned int calls = 0;
+    int do_benchmark = cppadcg_thpool_do_benchmark(meas, calls++);
     float* elapsed_p = do_benchmark ? elapsed : NULL;
 
     for (i = 0; i < 6; ++i) {
@@ -162,6 +162,7 @@ void pooldynamic_sparse_jacobian(double const* const* in, double* const* out, st
     if (do_benchmark) {
         cppadcg_thpool_update_order(avgElapsed, meas, elapsed, order, 6);
         meas++;
+        lastElapsedChanged = 1;
     } else {
         lastElapsedChanged = 0;
     }
@@ -213,6 +214,8 @@ public:
 
     virtual void TearDown() override {
         cppadcg_thpool_shutdown();
+        cppadcg_thpool_set_time_meas_ref(ELAPSED_TIME_MIN);
+        cppadcg_thpool_reset_imbalance();
     }
 };
 
@@ -251,4 +254,26 @@ TEST_F(PThreadPoolTest, StaticJac) {
     pooldynamic_sparse_jacobian(in.data(), out.data(), atomicFun); // reuse previous work group schedule
 
     ASSERT_TRUE(compareValues(jac, out0));
-}
\ No newline at end of file
+}
+
+TEST_F(PThreadPoolTest, EwmaStaticJac) {
+    cppadcg_thpool_set_scheduler_strategy(SCHED_STATIC);
+    cppadcg_thpool_set_time_meas_ref(ELAPSED_TIME_EWMA);
+    cppadcg_thpool_set_rebalance_period(2);
+
+    ASSERT_TRUE(cppadcg_thpool_do_benchmark(0, 0));
+    ASSERT_TRUE(cppadcg_thpool_do_benchmark(cppadcg_thpool_get_n_time_meas(), 4)); // periodic measurement
+    ASSERT_FALSE(cppadcg_thpool_do_benchmark(cppadcg_thpool_get_n_time_meas(), 5));
+
+    for (int i = 0; i < 10; ++i) {
+        pooldynamic_sparse_jacobian(in.data(), out.data(), atomicFun);
+    }
+
+    ASSERT_TRUE(compareValues(jac, out0));
+
+    ASSERT_EQ(cppadcg_thpool_get_n_imbalance_meas(), 10u);
+    ASSERT_GE(cppadcg_thpool_get_last_imbalance(), 0);
+    ASSERT_GE(cppadcg_thpool_get_avg_imbalance(), 0);
+
+    cppadcg_thpool_set_rebalance_period(32);
+}
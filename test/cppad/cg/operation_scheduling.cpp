@@ -0,0 +1,166 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGOperationTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace CppAD {
+namespace cg {
+
+class CppADCGSchedulingTest : public CppADCGOperationTest {
+protected:
+
+    /**
+     * A model where the default evaluation order keeps all sin(x[k])
+     * alive until the end (they are used by the last dependents)
+     */
+    static std::vector<CGD> model(std::vector<CGD>& x) {
+        size_t n = x.size();
+
+        std::vector<CGD> y(2 * n);
+        std::vector<CGD> t(n);
+        CGD s = x[0];
+        for (size_t k = 0; k < n; ++k) {
+            t[k] = sin(x[k]);
+            s = s + t[k];
+            y[k] = cos(s);
+        }
+        for (size_t k = 0; k < n; ++k) {
+            y[n + k] = t[k] * x[k];
+        }
+        return y;
+    }
+
+    /**
+     * Generates and compiles the source code for the model
+     *
+     * @return the number of temporary variables
+     */
+    size_t compileModel(size_t n,
+                        bool schedule,
+                        const std::string& library) {
+        CodeHandler<double> handler(10 + 4 * n);
+        handler.setScheduleOperations(schedule);
+
+        std::vector<CGD> x(n);
+        handler.makeVariables(x);
+        std::vector<CGD> y = model(x);
+
+        LanguageC<double> langC("double");
+        LangCDefaultVariableNameGenerator<double> nameGen;
+
+        std::ostringstream code;
+        handler.generateCode(code, langC, y, nameGen);
+
+        std::string source = "#include <math.h>\n\n"
+                             "void model(const double* x, double* y) {\n" +
+                             langC.generateTemporaryVariableDeclaration() +
+                             code.str() +
+                             "}\n";
+
+        compile(source, library);
+
+        return handler.getTemporaryVariableCount();
+    }
+
+    /**
+     * Evaluates a compiled model
+     */
+    void evaluate(const std::string& library,
+                  const std::vector<double>& x,
+                  std::vector<double>& y) {
+        void* libHandle = loadLibrary(library);
+
+        void (*fn)(const double*, double*) = nullptr;
+        try {
+            *(void **) (&fn) = getFunction(libHandle, "model");
+        } catch (const std::exception& ex) {
+            closeLibrary(libHandle);
+            throw;
+        }
+
+        (*fn)(&x[0], &y[0]);
+
+        closeLibrary(libHandle);
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+TEST_F(CppADCGSchedulingTest, LiveTemporaries) {
+    const size_t n = 20;
+
+    size_t tmpDefault = compileModel(n, false, "./tmp/schedule_off.so");
+    size_t tmpScheduled = compileModel(n, true, "./tmp/schedule_on.so");
+
+    ASSERT_LT(tmpScheduled, tmpDefault);
+
+    std::vector<double> x(n);
+    for (size_t j = 0; j < n; ++j)
+        x[j] = 0.1 * j - 0.7;
+
+    // reference values
+    CodeHandler<double> handler;
+    std::vector<CGD> xcg(n);
+    handler.makeVariables(xcg);
+    std::vector<CGD> ycg = model(xcg);
+    Evaluator<double, double> evaluator(handler);
+    std::vector<double> yRef = evaluator.evaluate(x, ycg);
+
+    std::vector<double> yDefault(2 * n);
+    std::vector<double> yScheduled(2 * n);
+    evaluate("./tmp/schedule_off.so", x, yDefault);
+    evaluate("./tmp/schedule_on.so", x, yScheduled);
+
+    for (size_t i = 0; i < 2 * n; ++i) {
+        ASSERT_TRUE(nearEqual(yRef[i], yDefault[i], 1e-14, 1e-14));
+        ASSERT_TRUE(nearEqual(yRef[i], yScheduled[i], 1e-14, 1e-14));
+    }
+}
+
+/**
+ * The number of temporary variables required by the scheduled order does
+ * not grow with the size of the model (apart from small differences at the
+ * boundaries of the scheduling window)
+ */
+TEST_F(CppADCGSchedulingTest, TemporariesIndependentOfSize) {
+    std::vector<size_t> tmpScheduled;
+
+    for (size_t n : {10, 100}) {
+        CodeHandler<double> handler(10 + 4 * n);
+        handler.setScheduleOperations(true);
+
+        std::vector<CGD> x(n);
+        handler.makeVariables(x);
+        std::vector<CGD> y = model(x);
+
+        LanguageC<double> langC("double");
+        LangCDefaultVariableNameGenerator<double> nameGen;
+
+        std::ostringstream code;
+        handler.generateCode(code, langC, y, nameGen);
+
+        if (this->verbose_) {
+            std::cout << "n = " << n << ": " << handler.getTemporaryVariableCount() << " temporaries" << std::endl;
+        }
+
+        tmpScheduled.push_back(handler.getTemporaryVariableCount());
+    }
+
+    // the default order requires at least n temporaries
+    ASSERT_LE(tmpScheduled[1], tmpScheduled[0] + 2);
+}
@@ -0,0 +1,91 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGOperationTest.hpp"
+#include "exp.hpp"
+#include "log.hpp"
+#include "pow.hpp"
+#include "tan.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+namespace CppAD {
+namespace cg {
+
+/**
+ * Operation tests using the approximate implementations of exp, log, pow,
+ * and tanh in the generated code
+ */
+class CppADCGApproximateMathTest : public CppADCGOperationTest {
+public:
+    inline CppADCGApproximateMathTest() {
+        approximateMath_ = true;
+    }
+};
+
+} // END cg namespace
+} // END CppAD namespace
+
+TEST_F(CppADCGApproximateMathTest, Exp) {
+    double eps = 1e-12;
+
+    std::vector<double> u{1};
+    test0nJac("ApproxExpTestOne", &ExpTestOneFunc<double >, &ExpTestOneFunc<CG<double> >, u, eps, eps);
+
+    u = {-30.5};
+    test0nJac("ApproxExpTestTwo", &ExpTestTwoFunc<double >, &ExpTestTwoFunc<CG<double> >, u, eps, eps);
+}
+
+TEST_F(CppADCGApproximateMathTest, Log) {
+    double eps = 1e-12;
+
+    std::vector<double> u{2};
+    test0nJac("ApproxLogTestOne", &LogTestOneFunc<double >, &LogTestOneFunc<CG<double> >, u, eps, eps);
+
+    u = {1.5};
+    test0nJac("ApproxLogTestTwo", &LogTestTwoFunc<double >, &LogTestTwoFunc<CG<double> >, u, eps, eps);
+}
+
+TEST_F(CppADCGApproximateMathTest, Pow) {
+    double eps = 1e-11;
+
+    std::vector<double> u{0.5, 2.0};
+    test0nJac("ApproxPowTestOne", &PowTestOneFunc<double >, &PowTestOneFunc<CG<double> >, u, eps, eps);
+
+    u = {2., 3.};
+    test0nJac("ApproxPowTestTwo", &PowTestTwoFunc<double >, &PowTestTwoFunc<CG<double> >, u, eps, eps);
+
+    u = {-2}; // negative base with integer exponents
+    test0nJac("ApproxPowTestFour", &PowTestFourFunc<double >, &PowTestFourFunc<CG<double> >, u, eps, eps);
+
+    u = {1.5};
+    test0nJac("ApproxPowTestSix", &PowTestSixFunc<double >, &PowTestSixFunc<CG<double> >, u, eps, eps);
+}
+
+TEST_F(CppADCGApproximateMathTest, Tanh) {
+    double eps = 1e-12;
+
+    std::vector<double> u{.5};
+    test0nJac("ApproxTanhFirst", &tanhFirstFunc<double >, &tanhFirstFunc<CG<double> >, u, eps, eps);
+
+    u = {-3e-4};
+    test0nJac("ApproxTanhLast", &tanhLastFunc<double >, &tanhLastFunc<CG<double> >, u, eps, eps);
+}
+
+TEST_F(CppADCGApproximateMathTest, OnlyDouble) {
+    LanguageC<float> langC("float");
+    ASSERT_THROW(langC.setApproximateMath(true), CGException);
+    ASSERT_FALSE(langC.isApproximateMath());
+}
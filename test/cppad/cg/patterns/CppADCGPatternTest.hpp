@@ -41,6 +41,8 @@ protected:
     Base hessianEpsilonR_;
     std::vector<std::set<size_t> > customJacSparsity_;
     std::vector<std::set<size_t> > customHessSparsity_;
+    size_t generationThreads_;
+    bool loopVectorization_;
 private:
     std::unique_ptr<DefaultPatternTestModel<CG<Base> > > modelMem_;
 public:
@@ -54,7 +56,9 @@ public:
         epsilonA_(std::numeric_limits<Base>::epsilon() * 1e2),
         epsilonR_(std::numeric_limits<Base>::epsilon() * 1e2),
         hessianEpsilonA_(std::numeric_limits<Base>::epsilon() * 1e2),
-        hessianEpsilonR_(std::numeric_limits<Base>::epsilon() * 1e2) {
+        hessianEpsilonR_(std::numeric_limits<Base>::epsilon() * 1e2),
+        generationThreads_(1),
+        loopVectorization_(false) {
         //this->verbose_ = true;
     }
 
@@ -397,6 +401,8 @@ public:
         compHelpL.setRelatedDependents(relatedDepCandidates);
         compHelpL.setTypicalIndependentValues(xTypical);
         compHelpL.setParameterPrecision(std::numeric_limits<Base>::digits10 + 4);
+        compHelpL.setGenerationThreads(generationThreads_);
+        compHelpL.setLoopVectorization(loopVectorization_);
 
         if (!customJacSparsity_.empty())
             compHelpL.setCustomSparseJacobianElements(customJacSparsity_);
@@ -406,6 +412,8 @@ public:
 
         GccCompiler<double> compiler;
         prepareTestCompilerFlags(compiler);
+        if (loopVectorization_)
+            compiler.addCompileFlag("-fopenmp-simd");
         compiler.setSourcesFolder("sources_" + libBaseName);
         compiler.setSaveToDiskFirst(true);
 
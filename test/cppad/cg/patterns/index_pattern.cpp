@@ -0,0 +1,76 @@
+/* --------------------------------------------------------------------------
+ *  CppADCodeGen: C++ Algorithmic Differentiation with Source Code Generation:
+ *    Copyright (C) 2020 Joao Leal
+ *
+ *  CppADCodeGen is distributed under multiple licenses:
+ *
+ *   - Eclipse Public License Version 1.0 (EPL1), and
+ *   - GNU General Public License Version 3 (GPL3).
+ *
+ *  EPL1 terms and conditions can be found in the file "epl-v10.txt", while
+ *  terms and conditions for the GPL3 can be found in the file "gpl3.txt".
+ * ----------------------------------------------------------------------------
+ * Author: Joao Leal
+ */
+#include "CppADCGTest.hpp"
+
+using namespace CppAD;
+using namespace CppAD::cg;
+
+/**
+ * @test the elements of a 3D grid (e.g. collocation points, finite elements,
+ *       and components) stored in a different order
+ */
+TEST_F(CppADCGTest, IndexPatternAffineND) {
+    const size_t n0 = 3; // innermost
+    const size_t n1 = 4;
+    const size_t n2 = 5;
+
+    std::vector<size_t> x2y(n0 * n1 * n2);
+    for (size_t i2 = 0; i2 < n2; ++i2) {
+        for (size_t i1 = 0; i1 < n1; ++i1) {
+            for (size_t i0 = 0; i0 < n0; ++i0) {
+                x2y[(i2 * n1 + i1) * n0 + i0] = 7 + i0 * 20 + i1 * 5 + i2;
+            }
+        }
+    }
+
+    std::unique_ptr<IndexPattern> ip(IndexPattern::detect(x2y));
+    ASSERT_EQ(IndexPatternType::AffineND, ip->getType());
+
+    const auto& aip = static_cast<const AffineNDIndexPattern&> (*ip);
+    ASSERT_EQ(3u, aip.getDimensions());
+    for (size_t x = 0; x < x2y.size(); ++x) {
+        ASSERT_EQ(long(x2y[x]), aip.evaluate(long(x)));
+    }
+
+    ASSERT_EQ("(j % 3) * 20 + ((j / 3) % 4) * 5 + j / 12 + 7", LanguageC<double>::indexPattern2String(aip, "j"));
+}
+
+TEST_F(CppADCGTest, IndexPatternAffineNDStrided) {
+    std::map<size_t, size_t> x2y;
+    for (size_t i1 = 0; i1 < 10; ++i1) {
+        for (size_t i0 = 0; i0 < 4; ++i0) {
+            size_t x = 3 + 2 * (i1 * 4 + i0);
+            x2y[x] = 10 * i0 + i1;
+        }
+    }
+
+    std::unique_ptr<IndexPattern> ip(IndexPattern::detect(x2y));
+    ASSERT_EQ(IndexPatternType::AffineND, ip->getType());
+
+    const auto& aip = static_cast<const AffineNDIndexPattern&> (*ip);
+    ASSERT_EQ(2u, aip.getDimensions());
+    ASSERT_EQ(3, aip.getXOffset());
+    ASSERT_EQ(2, aip.getStrideDx());
+    for (const auto& p : x2y) {
+        ASSERT_EQ(long(p.second), aip.evaluate(long(p.first)));
+    }
+}
+
+TEST_F(CppADCGTest, IndexPatternRandom) {
+    std::vector<size_t> x2y{5, 1, 9, 2, 7, 3, 8, 0, 6, 4, 11, 10, 15, 12, 14, 13};
+
+    std::unique_ptr<IndexPattern> ip(IndexPattern::detect(x2y));
+    ASSERT_EQ(IndexPatternType::Random1D, ip->getType());
+}
@@ -145,6 +145,67 @@ TEST_F(CppADCGPatternTest, DependentPatternMatcher) {
     testLibCreation("model1", m, n, 6);
 }
 
+TEST_F(CppADCGPatternTest, DependentPatternMatcherParallelGeneration) {
+    size_t m = 2;
+    size_t n = 2;
+
+    setModel(model1);
+    generationThreads_ = 3;
+    testLibCreation("model1Parallel", m, n, 6);
+}
+
+TEST_F(CppADCGPatternTest, DependentPatternMatcherLoopVectorization) {
+    size_t m = 2;
+    size_t n = 2;
+
+    setModel(model1);
+    loopVectorization_ = true;
+    testLibCreation("model1Simd", m, n, 6);
+
+    // the loop of the zero order forward mode is marked for vectorization
+    std::string source = readStringFromFile("sources_model1SimddF/model1SimddFLoops_forward_zero.c");
+    ASSERT_FALSE(source.empty());
+    ASSERT_NE(source.find("#pragma omp simd"), std::string::npos);
+    ASSERT_NE(source.find("restrict"), std::string::npos);
+}
+
+TEST_F(CppADCGPatternTest, DependentPatternMatcherNoLoopVectorization) {
+    size_t m = 2;
+    size_t n = 2;
+
+    setModel(model1);
+    testJacobian_ = false;
+    testHessian_ = false;
+    testLibCreation("model1NoSimd", m, n, 6);
+
+    std::string source = readStringFromFile("sources_model1NoSimd/model1NoSimdLoops_forward_zero.c");
+    ASSERT_FALSE(source.empty());
+    ASSERT_EQ(source.find("#pragma omp simd"), std::string::npos);
+}
+
+TEST_F(CppADCGPatternTest, AutomaticRelatedDependents) {
+    size_t m = 2;
+    size_t n = 2;
+    size_t repeat = 6;
+
+    setModel(model1);
+
+    std::vector<Base> xb(n * repeat, 0.5);
+    std::unique_ptr<ADFun<CGD> > fun(tapeModel(repeat, xb));
+
+    CodeHandler<double> h;
+    std::vector<CGD> xx(fun->Domain());
+    h.makeVariables(xx);
+    std::vector<CGD> yy = fun->Forward(0, xx);
+
+    std::vector<std::set<size_t> > related = DependentStructureHasher<double>::findRelatedDependents(h, yy);
+
+    ASSERT_EQ(related, createRelatedDepCandidates(m, repeat));
+
+    testPatternDetection(xb, repeat, related);
+    testLibCreation("model1Auto", related, repeat, xb);
+}
+
 /**
  * @test Some variables not indexed -> one constant temporary (defined outside 
  *       loop)